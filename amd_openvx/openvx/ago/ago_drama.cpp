@@ -518,7 +518,8 @@ int agoOptimizeDrama(AgoGraph * agraph)
 	// perform divide
 	if (agoOptimizeDramaCheckArgs(agraph))
 		return -1;
-	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_DIVIDE)) { 
+	// NOTE: a graph imported from a compiled graph has been divided and pruned already
+	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_DIVIDE) && !agraph->precompiled) { 
 		if(agoOptimizeDramaDivide(agraph)) 
 			return -1;
 	}
@@ -532,7 +533,7 @@ int agoOptimizeDrama(AgoGraph * agraph)
 	// perform remove
 	if (agoOptimizeDramaCheckArgs(agraph))
 		return -1;
-	if (agoOptimizeDramaRemove(agraph))
+	if (!agraph->precompiled && agoOptimizeDramaRemove(agraph))
 		return -1;
 #if ENABLE_DEBUG_MESSAGES
 	agoWriteGraph(agraph, NULL, 0, stdout, "after-remove");
@@ -471,7 +471,7 @@ static int agoOptimizeDramaAllocGpuResources(AgoGraph * graph)
 }
 #endif
 
-static int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
+int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
 {
 	// get unused GPU group ID
 	vx_uint32 nextAvailGroupId = 1;
@@ -766,6 +766,166 @@ static int agoOptimizeDramaAllocMergeSuperNodes(AgoGraph * graph)
 }
 #endif
 
+static int agoOptimizeDramaAllocCpuArena(AgoGraph * agraph)
+{
+	// pick the virtual images and pyramids that can be placed in the arena: all the
+	// image buffers must be owned by the data (or its children) and written by the graph.
+	// just like GPU buffer merging, pixels outside the valid region may hold stale values
+	auto isArenaImage = [=](AgoData * data) -> bool {
+		return data->ref.type == VX_TYPE_IMAGE && !data->buffer && !data->children &&
+			!data->u.img.isROI && !data->u.img.isUniform;
+	};
+	auto isArenaData = [=](AgoData * data) -> bool {
+		if (!data->isVirtual || data->parent || data->buffer || agoIsPartOfDelay(data) ||
+			(data->device_type_unused & AGO_TARGET_AFFINITY_CPU))
+			return false;
+		if (data->ref.type == VX_TYPE_IMAGE && !data->children)
+			return isArenaImage(data);
+		if (data->ref.type != VX_TYPE_IMAGE && data->ref.type != VX_TYPE_PYRAMID)
+			return false;
+		for (vx_uint32 i = 0; i < data->numChildren; i++) {
+			if (!data->children[i] || !isArenaImage(data->children[i]))
+				return false;
+		}
+		return data->numChildren > 0;
+	};
+	std::map<AgoData *, size_t> index;
+	std::vector<AgoData *> D;
+	for (AgoData * data = agraph->dataList.head; data; data = data->next) {
+		if (isArenaData(data)) {
+			index[data] = D.size();
+			D.push_back(data);
+		}
+	}
+	// ROI master images keep their own allocation since ROIs alias into them
+	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
+		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
+			if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) {
+				AgoData * master = data->u.img.roiMasterImage;
+				if (master && master->parent)
+					master = master->parent;
+				auto it = index.find(master);
+				if (it != index.end())
+					D[it->second] = nullptr;
+			}
+		}
+	}
+
+	// mark hierarchical level (start,end) of the candidates: nodes merged into a
+	// supernode run at the level range of the supernode
+	std::vector<bool> written(D.size(), false);
+	for (AgoData * data : D) {
+		if (data) {
+			data->hierarchical_life_start = INT_MAX;
+			data->hierarchical_life_end = 0;
+		}
+	}
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		vx_uint32 level_start = node->hierarchical_level, level_end = node->hierarchical_level;
+		if (node->cpu_supernode) {
+			level_start = node->cpu_supernode->hierarchical_level_start;
+			level_end = node->cpu_supernode->hierarchical_level_end;
+		}
+#if ENABLE_OPENCL
+		else if (node->supernode) {
+			level_start = node->supernode->hierarchical_level_start;
+			level_end = node->supernode->hierarchical_level_end;
+		}
+#endif
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data) {
+				auto it = index.find(data->parent ? data->parent : data);
+				if (it != index.end() && D[it->second]) {
+					data = D[it->second];
+					data->hierarchical_life_start = min(data->hierarchical_life_start, level_start);
+					data->hierarchical_life_end = max(data->hierarchical_life_end, level_end);
+					if (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)
+						written[it->second] = true;
+				}
+			}
+		}
+	}
+
+	// get the size of each block: child images are packed back to back with padding
+	// on both sides, same as agoAllocMemory
+	auto getBlockSize = [=](AgoData * data) -> vx_size {
+		vx_size size = 0;
+		if (data->numChildren > 0) {
+			for (vx_uint32 i = 0; i < data->numChildren; i++)
+				size += ALIGN32(data->children[i]->size) + AGO_MEMORY_ALLOC_EXTRA_PADDING;
+		}
+		else {
+			size = ALIGN32(data->size) + AGO_MEMORY_ALLOC_EXTRA_PADDING;
+		}
+		return size;
+	};
+	std::vector<AgoData *> B;
+	for (size_t i = 0; i < D.size(); i++) {
+		if (D[i] && written[i] && D[i]->hierarchical_life_start <= D[i]->hierarchical_life_end) {
+			B.push_back(D[i]);
+		}
+	}
+	if (B.size() < 2)
+		return 0;
+	std::stable_sort(B.begin(), B.end(), [=](AgoData * a, AgoData * b) { return getBlockSize(a) > getBlockSize(b); });
+
+	// place the largest blocks first at the lowest offset that doesn't overlap with any
+	// block whose lifetime intersects with the current block
+	std::vector<vx_size> Boffset(B.size(), 0);
+	vx_size arenaSize = 0, naiveSize = 0;
+	for (size_t i = 0; i < B.size(); i++) {
+		vx_size size = getBlockSize(B[i]);
+		std::vector< std::pair<vx_size, vx_size> > busy;
+		for (size_t j = 0; j < i; j++) {
+			if (B[j]->hierarchical_life_start <= B[i]->hierarchical_life_end &&
+				B[i]->hierarchical_life_start <= B[j]->hierarchical_life_end)
+			{
+				busy.push_back(std::make_pair(Boffset[j], Boffset[j] + getBlockSize(B[j])));
+			}
+		}
+		std::sort(busy.begin(), busy.end());
+		vx_size offset = 0;
+		for (auto& range : busy) {
+			if (offset + size <= range.first)
+				break;
+			offset = max(offset, range.second);
+		}
+		Boffset[i] = offset;
+		arenaSize = max(arenaSize, offset + size);
+		naiveSize += size;
+	}
+
+	// allocate the arena and hand out the buffers: each data holds a reference to the
+	// arena so that it stays valid as long as any of its data is alive
+	vx_uint8 * arena = (vx_uint8 *)agoAllocMemory(arenaSize + AGO_MEMORY_ALLOC_EXTRA_PADDING);
+	if (!arena) {
+		agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaAllocCpuArena: agoAllocMemory(%d) failed\n", (vx_uint32)arenaSize);
+		return -1;
+	}
+	for (size_t i = 0; i < B.size(); i++) {
+		vx_uint8 * buffer = arena + AGO_MEMORY_ALLOC_EXTRA_PADDING + Boffset[i];
+		AgoData * data = B[i];
+		if (data->numChildren > 0) {
+			for (vx_uint32 child = 0; child < data->numChildren; child++) {
+				data->children[child]->buffer = buffer;
+				data->children[child]->buffer_allocated = arena;
+				agoRetainMemory(arena);
+				buffer += ALIGN32(data->children[child]->size) + AGO_MEMORY_ALLOC_EXTRA_PADDING;
+			}
+		}
+		else {
+			data->buffer = buffer;
+			data->buffer_allocated = arena;
+			agoRetainMemory(arena);
+		}
+	}
+	agoReleaseMemory(arena);
+	agoAddLogEntry(&agraph->ref, VX_SUCCESS, "OK: OpenVX CPU arena of %d bytes holds %d virtual buffers that need %d bytes without reuse\n",
+		(vx_uint32)arenaSize, (vx_uint32)B.size(), (vx_uint32)naiveSize);
+	return 0;
+}
+
 int agoOptimizeDramaAlloc(AgoGraph * agraph)
 {
 	// return success if there is nothing to do
@@ -814,6 +974,13 @@ int agoOptimizeDramaAlloc(AgoGraph * agraph)
 	// remove unused data
 	if (agoOptimizeDramaAllocRemoveUnusedData(agraph)) return -1;
 
+	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_CPU_ARENA_ALLOC)) {
+		// pack virtual CPU buffers with disjoint lifetimes into one arena
+		if (agoOptimizeDramaAllocCpuArena(agraph) < 0) {
+			return -1;
+		}
+	}
+
 	// make sure all buffers are allocated and initialized
 	for (AgoData * adata = agraph->dataList.head; adata; adata = adata->next) {
 		if (agoAllocData(adata)) {
@@ -23,6 +23,208 @@ THE SOFTWARE.
 
 #include "ago_internal.h"
 
+// checks if an image can be accessed one row strip at a time through a view with an offset buffer
+static bool agoOptimizeDramaMergeIsStripImage(AgoData * data)
+{
+	return data->ref.type == VX_TYPE_IMAGE && !data->parent && !data->numChildren &&
+		!data->u.img.isROI && !data->u.img.isUniform && !agoIsPartOfDelay(data);
+}
+
+// checks if a node is an element-wise CPU kernel that can be executed one row strip at a time:
+// all its parameters shall be inputs or output images of identical dimensions
+static bool agoOptimizeDramaMergeIsStripNode(AgoNode * node, vx_uint32 width, vx_uint32 height)
+{
+	AgoKernel * kernel = node->akernel;
+	if (node->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU || !kernel->func ||
+		kernel->kernOpType != AGO_KERNEL_OP_TYPE_ELEMENT_WISE || kernel->opencl_buffer_access_enable)
+		return false;
+	bool hasOutput = false;
+	for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+		AgoData * data = node->paramList[arg];
+		if (!data)
+			continue;
+		bool isInput = (kernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG) ? true : false;
+		bool isOutput = (kernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG) ? true : false;
+		if (isInput && isOutput)
+			return false;
+		if (data->ref.type == VX_TYPE_IMAGE) {
+			if (!agoOptimizeDramaMergeIsStripImage(data) || data->u.img.width != width || data->u.img.height != height)
+				return false;
+			hasOutput |= isOutput;
+		}
+		else if (isOutput)
+			return false;
+	}
+	return hasOutput;
+}
+
+// checks if a virtual image is only used within the nodes of a supernode, so it doesn't need more than a strip buffer
+static bool agoOptimizeDramaMergeIsStripLocal(AgoGraph * agraph, const std::vector<AgoNode *>& nodeList, AgoData * data)
+{
+	if (!data->isVirtual || data->outputUsageCount != 1 || data->inoutUsageCount != 0)
+		return false;
+	vx_uint32 inputUsageCount = 0, outputUsageCount = 0;
+	for (AgoNode * node : nodeList) {
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			if (node->paramList[arg] == data && (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG))
+				inputUsageCount++;
+			if (node->paramList[arg] == data && (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
+				outputUsageCount++;
+		}
+	}
+	if (outputUsageCount != 1 || inputUsageCount == 0 || inputUsageCount != data->inputUsageCount)
+		return false;
+	// an image with ROIs needs its full buffer
+	for (AgoData * pdata = agraph->dataList.head; pdata; pdata = pdata->next) {
+		if (pdata->ref.type == VX_TYPE_IMAGE && pdata->u.img.isROI && pdata->u.img.roiMasterImage == data)
+			return false;
+	}
+	return true;
+}
+
+static int agoOptimizeDramaMergeCpuSuperNode(AgoGraph * agraph, const std::vector<AgoNode *>& nodeList, vx_uint32 width, vx_uint32 height)
+{
+	AgoSuperNode * supernode = new AgoSuperNode;
+	supernode->width = width;
+	supernode->height = height;
+	supernode->nodeList = nodeList;
+	supernode->hierarchical_level_start = nodeList.front()->hierarchical_level;
+	supernode->hierarchical_level_end = nodeList.back()->hierarchical_level;
+	supernode->next = agraph->cpuSupernodeList;
+	agraph->cpuSupernodeList = supernode;
+
+	// get the images used by the supernode and mark the images that can live in the strip buffer
+	std::vector<bool> dataIsLocal;
+	for (AgoNode * node : nodeList) {
+		node->cpu_supernode = supernode;
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data && data->ref.type == VX_TYPE_IMAGE) {
+				if (std::find(supernode->dataList.begin(), supernode->dataList.end(), data) == supernode->dataList.end()) {
+					if (!data->buffer && agoDataSanityCheckAndUpdate(data)) {
+						return -1;
+					}
+					supernode->dataList.push_back(data);
+					dataIsLocal.push_back(agoOptimizeDramaMergeIsStripLocal(agraph, nodeList, data));
+				}
+			}
+		}
+	}
+
+	// pick the strip height such that one strip of all images fits into the cache
+	vx_size bytesPerRow = 0;
+	for (AgoData * data : supernode->dataList) {
+		bytesPerRow += data->u.img.stride_in_bytes;
+	}
+	vx_size strip_height = max((vx_size)CONFIG_CPU_SUPERNODE_MIN_STRIP_ROWS, CONFIG_CPU_SUPERNODE_STRIP_SIZE / bytesPerRow);
+	supernode->strip_height = (vx_uint32)min(strip_height, (vx_size)supernode->height);
+
+	// the strip-local images are placed in one strip buffer, so that the regular allocation skips them:
+	// an extra row per image keeps SIMD over-reads of the last row of a strip inside of its own image
+	vx_size size = 0;
+	for (size_t i = 0; i < supernode->dataList.size(); i++) {
+		if (dataIsLocal[i])
+			size += ALIGN32(supernode->dataList[i]->u.img.stride_in_bytes * (supernode->strip_height + 1));
+	}
+	if (size > 0) {
+		supernode->strip_buffer_allocated = (vx_uint8 *)agoAllocMemory(size);
+		if (!supernode->strip_buffer_allocated) {
+			agoAddLogEntry(&agraph->ref, VX_ERROR_NO_MEMORY, "ERROR: agoOptimizeDramaMerge: memory allocation (%d) failed for CPU supernode\n", (int)size);
+			return -1;
+		}
+		vx_uint8 * buffer = supernode->strip_buffer_allocated;
+		for (size_t i = 0; i < supernode->dataList.size(); i++) {
+			AgoData * data = supernode->dataList[i];
+			if (dataIsLocal[i]) {
+				data->buffer = buffer;
+				buffer += ALIGN32(data->u.img.stride_in_bytes * (supernode->strip_height + 1));
+			}
+		}
+	}
+
+	// create a row strip view for every image parameter of the nodes
+	for (AgoNode * node : nodeList) {
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data && data->ref.type == VX_TYPE_IMAGE) {
+				size_t i = std::find(supernode->dataList.begin(), supernode->dataList.end(), data) - supernode->dataList.begin();
+				AgoData * view = new AgoData;
+				agoResetReference(&view->ref, VX_TYPE_IMAGE, data->ref.context, data->ref.scope);
+				view->isVirtual = data->isVirtual;
+				view->u.img = data->u.img;
+				view->u.img.rect_valid.start_x = 0;
+				view->u.img.rect_valid.start_y = 0;
+				view->u.img.rect_valid.end_x = data->u.img.width;
+				view->u.img.rect_valid.end_y = supernode->strip_height;
+				AgoSuperNodeStripParam param = { node, arg, data, view, dataIsLocal[i] };
+				supernode->stripParamList.push_back(param);
+			}
+		}
+	}
+	return 0;
+}
+
+// merges chains of element-wise CPU nodes into supernodes that execute all of their nodes on one row strip
+// before moving to the next one: the intermediate virtual images of a chain then only need a strip buffer
+// that stays in the cache instead of a full image buffer
+static int agoOptimizeDramaMergeCpuSuperNodes(AgoGraph * agraph)
+{
+	// the target assignments are needed to know which nodes run on CPU
+	if (agoOptimizeDramaAllocSetDefaultTargets(agraph) < 0) {
+		return -1;
+	}
+
+	for (AgoNode * head = agraph->nodeList.head; head; head = head->next) {
+		AgoData * image = nullptr;
+		for (vx_uint32 arg = 0; !image && arg < head->paramCount; arg++) {
+			if (head->paramList[arg] && head->paramList[arg]->ref.type == VX_TYPE_IMAGE)
+				image = head->paramList[arg];
+		}
+		if (head->cpu_supernode || !image || !agoOptimizeDramaMergeIsStripNode(head, image->u.img.width, image->u.img.height))
+			continue;
+		// grow the chain with the first consumer of a virtual output of its last node, as long as all other
+		// inputs of the consumer are available before the first node of the chain gets executed
+		std::vector<AgoNode *> nodeList = { head };
+		std::vector<AgoData *> outputList;
+		for (AgoNode * tail = head; tail;) {
+			for (vx_uint32 arg = 0; arg < tail->paramCount; arg++) {
+				if (tail->paramList[arg] && (tail->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
+					outputList.push_back(tail->paramList[arg]);
+			}
+			AgoNode * next = nullptr;
+			for (vx_uint32 arg = 0; !next && arg < tail->paramCount; arg++) {
+				AgoData * data = tail->paramList[arg];
+				if (!data || !data->isVirtual || !(tail->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
+					continue;
+				for (AgoNode * node = tail->next; !next && node; node = node->next) {
+					bool isConsumer = false, isReady = true;
+					for (vx_uint32 i = 0; i < node->paramCount; i++) {
+						AgoData * idata = node->paramList[i];
+						if (idata && (node->akernel->argConfig[i] & AGO_KERNEL_ARG_INPUT_FLAG)) {
+							bool isChainOutput = std::find(outputList.begin(), outputList.end(), idata) != outputList.end();
+							isConsumer |= (idata == data);
+							isReady &= (isChainOutput || idata->hierarchical_level <= head->hierarchical_level);
+						}
+					}
+					if (isConsumer) {
+						if (isReady && !node->cpu_supernode && agoOptimizeDramaMergeIsStripNode(node, image->u.img.width, image->u.img.height))
+							next = node;
+						break;
+					}
+				}
+			}
+			if (next)
+				nodeList.push_back(next);
+			tail = next;
+		}
+		if (nodeList.size() > 1) {
+			if (agoOptimizeDramaMergeCpuSuperNode(agraph, nodeList, image->u.img.width, image->u.img.height) < 0)
+				return -1;
+		}
+	}
+	return 0;
+}
+
 int agoOptimizeDramaMerge(AgoGraph * agraph)
 {
 	for (int graphGotModified = !0; graphGotModified;)
@@ -33,5 +235,22 @@ int agoOptimizeDramaMerge(AgoGraph * agraph)
 		// TBD
 		graphGotModified = 0;
 	}
+
+	// release the supernodes of CPU nodes from an earlier verification of the graph
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		node->cpu_supernode = nullptr;
+	}
+	while (agraph->cpuSupernodeList) {
+		AgoSuperNode * next = agraph->cpuSupernodeList->next;
+		delete agraph->cpuSupernodeList;
+		agraph->cpuSupernodeList = next;
+	}
+
+	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_CPU_SUPERNODE_MERGE)) {
+		// merge element-wise CPU nodes into row strip supernodes
+		if (agoOptimizeDramaMergeCpuSuperNodes(agraph) < 0) {
+			return -1;
+		}
+	}
 	return 0;
 }
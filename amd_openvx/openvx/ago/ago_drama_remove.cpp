@@ -834,6 +834,15 @@ static AgoNodeMergeRule s_merge_rule[] = {
 				{ VX_KERNEL_AMD_SET_FF_U8, { 2 } },
 			}
 		},
+		{ // MINMAX and MEANSTDDEV of the same image in one pass
+			{
+				{ VX_KERNEL_AMD_MIN_MAX_DATA_U8, { 1, 3 } },
+				{ VX_KERNEL_AMD_MEAN_STD_DEV_DATA_U8, { 2, 3 } },
+			},
+			{
+				{ VX_KERNEL_AMD_MIN_MAX_MEAN_STD_DEV_DATADATA_U8, { 1, 2, 3 } },
+			}
+		},
 };
 static vx_uint32 s_merge_rule_count = sizeof(s_merge_rule) / sizeof(s_merge_rule[0]);
 
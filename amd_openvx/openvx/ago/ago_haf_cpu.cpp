@@ -23,6 +23,87 @@ THE SOFTWARE.
 
 #include "ago_internal.h"
 
+// SSE4 kernels until HafCpu_InitDispatchTable() picks the kernels for the CPU at the first context creation
+AgoHafCpuDispatchTable g_hafCpuDispatch = {
+	HafCpu_ChannelExtract_U8_U24_Pos0,
+	HafCpu_ChannelExtract_U8_U24_Pos1,
+	HafCpu_ChannelExtract_U8_U24_Pos2,
+	HafCpu_ChannelExtract_U8_U32_Pos0,
+	HafCpu_ChannelExtract_U8_U32_Pos1,
+	HafCpu_ChannelExtract_U8_U32_Pos2,
+	HafCpu_ChannelExtract_U8_U32_Pos3,
+	HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX,
+	HafCpu_ColorConvert_RGB_RGBX,
+	HafCpu_ColorConvert_RGBX_RGB,
+	HafCpu_Box_U8_U8_3x3,
+	HafCpu_Dilate_U8_U8_3x3,
+	HafCpu_Erode_U8_U8_3x3,
+	HafCpu_Gaussian_U8_U8_3x3,
+	HafCpu_ScaleImage_U8_U8_Bilinear,
+	HafCpu_WarpAffine_U8_U8_Bilinear,
+	HafCpu_GeometricTable_U8_U8
+};
+
+void HafCpu_InitDispatchTable(int isa)
+{
+	// built aside and published with a single assignment: called once per process, see agoCreateContextFromPlatform()
+	AgoHafCpuDispatchTable table;
+	table.ChannelExtract_U8_U24_Pos0 = HafCpu_ChannelExtract_U8_U24_Pos0;
+	table.ChannelExtract_U8_U24_Pos1 = HafCpu_ChannelExtract_U8_U24_Pos1;
+	table.ChannelExtract_U8_U24_Pos2 = HafCpu_ChannelExtract_U8_U24_Pos2;
+	table.ChannelExtract_U8_U32_Pos0 = HafCpu_ChannelExtract_U8_U32_Pos0;
+	table.ChannelExtract_U8_U32_Pos1 = HafCpu_ChannelExtract_U8_U32_Pos1;
+	table.ChannelExtract_U8_U32_Pos2 = HafCpu_ChannelExtract_U8_U32_Pos2;
+	table.ChannelExtract_U8_U32_Pos3 = HafCpu_ChannelExtract_U8_U32_Pos3;
+	table.ChannelCombine_U32_U8U8U8U8_RGBX = HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX;
+	table.ColorConvert_RGB_RGBX = HafCpu_ColorConvert_RGB_RGBX;
+	table.ColorConvert_RGBX_RGB = HafCpu_ColorConvert_RGBX_RGB;
+	table.Box_U8_U8_3x3 = HafCpu_Box_U8_U8_3x3;
+	table.Dilate_U8_U8_3x3 = HafCpu_Dilate_U8_U8_3x3;
+	table.Erode_U8_U8_3x3 = HafCpu_Erode_U8_U8_3x3;
+	table.Gaussian_U8_U8_3x3 = HafCpu_Gaussian_U8_U8_3x3;
+	table.ScaleImage_U8_U8_Bilinear = HafCpu_ScaleImage_U8_U8_Bilinear;
+	table.WarpAffine_U8_U8_Bilinear = HafCpu_WarpAffine_U8_U8_Bilinear;
+	table.GeometricTable_U8_U8 = HafCpu_GeometricTable_U8_U8;
+	if (isa >= HAFCPU_ISA_AVX2) {
+		table.ChannelExtract_U8_U24_Pos0 = HafCpu_ChannelExtract_U8_U24_Pos0_AVX2;
+		table.ChannelExtract_U8_U24_Pos1 = HafCpu_ChannelExtract_U8_U24_Pos1_AVX2;
+		table.ChannelExtract_U8_U24_Pos2 = HafCpu_ChannelExtract_U8_U24_Pos2_AVX2;
+		table.ChannelExtract_U8_U32_Pos0 = HafCpu_ChannelExtract_U8_U32_Pos0_AVX2;
+		table.ChannelExtract_U8_U32_Pos1 = HafCpu_ChannelExtract_U8_U32_Pos1_AVX2;
+		table.ChannelExtract_U8_U32_Pos2 = HafCpu_ChannelExtract_U8_U32_Pos2_AVX2;
+		table.ChannelExtract_U8_U32_Pos3 = HafCpu_ChannelExtract_U8_U32_Pos3_AVX2;
+		table.ChannelCombine_U32_U8U8U8U8_RGBX = HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX_AVX2;
+		table.ColorConvert_RGB_RGBX = HafCpu_ColorConvert_RGB_RGBX_AVX2;
+		table.ColorConvert_RGBX_RGB = HafCpu_ColorConvert_RGBX_RGB_AVX2;
+		table.Box_U8_U8_3x3 = HafCpu_Box_U8_U8_3x3_AVX2;
+		table.Dilate_U8_U8_3x3 = HafCpu_Dilate_U8_U8_3x3_AVX2;
+		table.Erode_U8_U8_3x3 = HafCpu_Erode_U8_U8_3x3_AVX2;
+		table.Gaussian_U8_U8_3x3 = HafCpu_Gaussian_U8_U8_3x3_AVX2;
+		table.ScaleImage_U8_U8_Bilinear = HafCpu_ScaleImage_U8_U8_Bilinear_AVX2;
+		table.WarpAffine_U8_U8_Bilinear = HafCpu_WarpAffine_U8_U8_Bilinear_AVX2;
+		table.GeometricTable_U8_U8 = HafCpu_GeometricTable_U8_U8_AVX2;
+	}
+	if (isa >= HAFCPU_ISA_AVX512BW) {
+		// ScaleImage, WarpAffine and GeometricTable are gather bound: keep the AVX2 kernels
+		table.ChannelExtract_U8_U24_Pos0 = HafCpu_ChannelExtract_U8_U24_Pos0_AVX512;
+		table.ChannelExtract_U8_U24_Pos1 = HafCpu_ChannelExtract_U8_U24_Pos1_AVX512;
+		table.ChannelExtract_U8_U24_Pos2 = HafCpu_ChannelExtract_U8_U24_Pos2_AVX512;
+		table.ChannelExtract_U8_U32_Pos0 = HafCpu_ChannelExtract_U8_U32_Pos0_AVX512;
+		table.ChannelExtract_U8_U32_Pos1 = HafCpu_ChannelExtract_U8_U32_Pos1_AVX512;
+		table.ChannelExtract_U8_U32_Pos2 = HafCpu_ChannelExtract_U8_U32_Pos2_AVX512;
+		table.ChannelExtract_U8_U32_Pos3 = HafCpu_ChannelExtract_U8_U32_Pos3_AVX512;
+		table.ChannelCombine_U32_U8U8U8U8_RGBX = HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX_AVX512;
+		table.ColorConvert_RGB_RGBX = HafCpu_ColorConvert_RGB_RGBX_AVX512;
+		table.ColorConvert_RGBX_RGB = HafCpu_ColorConvert_RGBX_RGB_AVX512;
+		table.Box_U8_U8_3x3 = HafCpu_Box_U8_U8_3x3_AVX512;
+		table.Dilate_U8_U8_3x3 = HafCpu_Dilate_U8_U8_3x3_AVX512;
+		table.Erode_U8_U8_3x3 = HafCpu_Erode_U8_U8_3x3_AVX512;
+		table.Gaussian_U8_U8_3x3 = HafCpu_Gaussian_U8_U8_3x3_AVX512;
+	}
+	g_hafCpuDispatch = table;
+}
+
 int HafCpu_ColorConvert_IU_RGB
 	(
 		vx_uint32     dstWidth,
@@ -198,37 +279,3 @@ int HafCpu_CannyEdgeTrace_U8_U8
 	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
 }
 
-int HafCpu_Convolve_U8_U8_MxN
-	(
-		vx_uint32     dstWidth,
-		vx_uint32     dstHeight,
-		vx_uint8    * pDstImage,
-		vx_uint32     dstImageStrideInBytes,
-		vx_uint8    * pSrcImage,
-		vx_uint32     srcImageStrideInBytes,
-		vx_int16    * convMatrix,
-		vx_uint32     convolutionWidth,
-		vx_uint32     convolutionHeight,
-		vx_int32      shift
-	)
-{
-	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
-}
-
-int HafCpu_Convolve_S16_U8_MxN
-	(
-		vx_uint32     dstWidth,
-		vx_uint32     dstHeight,
-		vx_int16    * pDstImage,
-		vx_uint32     dstImageStrideInBytes,
-		vx_uint8    * pSrcImage,
-		vx_uint32     srcImageStrideInBytes,
-		vx_int16    * convMatrix,
-		vx_uint32     convolutionWidth,
-		vx_uint32     convolutionHeight,
-		vx_int32      shift
-	)
-{
-	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
-}
-
@@ -64,6 +64,12 @@ typedef struct {
 	vx_float32 matrix[3][3];
 } ago_perspective_matrix_t;
 
+struct AgoConfigScaleMatrix {
+	vx_float32 xscale;
+	vx_float32 yscale;
+	vx_float32 xoffset;
+	vx_float32 yoffset;
+};
 typedef struct AgoConfigScaleMatrix ago_scale_matrix_t;
 
 typedef struct {
@@ -72,6 +78,17 @@ typedef struct {
 	vx_float32 s; // stregnth
 } ago_keypoint_xys_t;
 
+// coordinate/weight table entry of the table-driven bilinear geometric kernels, one per destination pixel:
+// the destination pixel is the blend of the 2x2 source neighborhood at offset with 7-bit weights,
+// where the neighbors flagged in outside are replaced by the border value
+typedef struct {
+	vx_int32 offset;   // byte offset of the top-left pixel of the 2x2 source neighborhood
+	vx_uint8 fx;       // weight of the right column (0..128)
+	vx_uint8 outside;  // bit 0: top-left, bit 1: top-right, bit 2: bottom-left, bit 3: bottom-right neighbor is outside the image
+	vx_uint8 fy;       // weight of the bottom row (0..128)
+	vx_uint8 reserved;
+} ago_geometric_table_entry_t;
+
 typedef struct {
 	vx_uint32      width;
 	vx_uint32      height;
@@ -1989,6 +2006,36 @@ int HafCpu_Convolve_S16_U8_MxN
 		vx_uint32     convolutionHeight,
 		vx_int32      shift
 	);
+int HafCpu_ConvolveSeparable_U8_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * rowCoeff,
+		vx_uint32     convolutionWidth,
+		vx_int16    * colCoeff,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_int32    * pRing
+	);
+int HafCpu_ConvolveSeparable_S16_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * rowCoeff,
+		vx_uint32     convolutionWidth,
+		vx_int16    * colCoeff,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_int32    * pRing
+	);
 int HafCpu_SobelMagnitude_S16_U8_3x3
 	(
 		vx_uint32     dstWidth,
@@ -2536,6 +2583,44 @@ int HafCpu_WarpPerspective_U8_U8_Bilinear_Constant
 		vx_uint8                   border,
 		vx_uint8				 * pLocalData
 	);
+int HafCpu_GeometricTable_Remap
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint32                     srcWidth,
+		vx_uint32                     srcHeight,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_coord2d_ushort_t        * pMap,
+		vx_uint32                     mapStrideInBytes,
+		vx_uint32                     mapFractionalBits,
+		vx_bool                       invalidAsBorder
+	);
+int HafCpu_GeometricTable_WarpPerspective
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		vx_uint32                     dstY,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint32                     srcWidth,
+		vx_uint32                     srcHeight,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_perspective_matrix_t    * matrix
+	);
+int HafCpu_GeometricTable_U8_U8
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		vx_uint8                    * pDstImage,
+		vx_uint32                     dstImageStrideInBytes,
+		vx_uint8                    * pSrcImage,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint8                      border
+	);
 int HafCpu_ScaleImage_U8_U8_Nearest
 	(
 		vx_uint32            dstWidth,
@@ -2753,6 +2838,17 @@ int HafCpu_MinMaxMerge_DATA_DATA
 		vx_int32      srcMinValue[],
 		vx_int32      srcMaxValue[]
 	);
+int HafCpu_MinMaxMeanStdDev_DATA_U8
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_float32  * pSum,
+		vx_float32  * pSumOfSquared,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	);
 int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min
 	(
 		vx_uint32          * pMinLocCount,
@@ -3022,4 +3118,69 @@ int HafCpu_FastAtan2_Canny
 	vx_int16      Gy
 );
 
+// instruction set levels for the runtime dispatch of HAF CPU kernels
+#define HAFCPU_ISA_SSE4_1      0 // baseline: 128-bit SSE4.1/SSE4.2 kernels
+#define HAFCPU_ISA_AVX2        1 // 256-bit AVX2 kernels
+#define HAFCPU_ISA_AVX512BW    2 // 512-bit AVX-512F/BW kernels
+
+// HAF CPU kernels with more than one implementation: the entries point to the
+// implementation for the best instruction set available on this CPU.
+// to add a kernel: add an entry here, the variants below, and set it in HafCpu_InitDispatchTable
+struct AgoHafCpuDispatchTable {
+	decltype(HafCpu_ChannelExtract_U8_U24_Pos0)     * ChannelExtract_U8_U24_Pos0;
+	decltype(HafCpu_ChannelExtract_U8_U24_Pos1)     * ChannelExtract_U8_U24_Pos1;
+	decltype(HafCpu_ChannelExtract_U8_U24_Pos2)     * ChannelExtract_U8_U24_Pos2;
+	decltype(HafCpu_ChannelExtract_U8_U32_Pos0)     * ChannelExtract_U8_U32_Pos0;
+	decltype(HafCpu_ChannelExtract_U8_U32_Pos1)     * ChannelExtract_U8_U32_Pos1;
+	decltype(HafCpu_ChannelExtract_U8_U32_Pos2)     * ChannelExtract_U8_U32_Pos2;
+	decltype(HafCpu_ChannelExtract_U8_U32_Pos3)     * ChannelExtract_U8_U32_Pos3;
+	decltype(HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX) * ChannelCombine_U32_U8U8U8U8_RGBX;
+	decltype(HafCpu_ColorConvert_RGB_RGBX)          * ColorConvert_RGB_RGBX;
+	decltype(HafCpu_ColorConvert_RGBX_RGB)          * ColorConvert_RGBX_RGB;
+	decltype(HafCpu_Box_U8_U8_3x3)                  * Box_U8_U8_3x3;
+	decltype(HafCpu_Dilate_U8_U8_3x3)               * Dilate_U8_U8_3x3;
+	decltype(HafCpu_Erode_U8_U8_3x3)                * Erode_U8_U8_3x3;
+	decltype(HafCpu_Gaussian_U8_U8_3x3)             * Gaussian_U8_U8_3x3;
+	decltype(HafCpu_ScaleImage_U8_U8_Bilinear)      * ScaleImage_U8_U8_Bilinear;
+	decltype(HafCpu_WarpAffine_U8_U8_Bilinear)      * WarpAffine_U8_U8_Bilinear;
+	decltype(HafCpu_GeometricTable_U8_U8)           * GeometricTable_U8_U8;
+};
+extern AgoHafCpuDispatchTable g_hafCpuDispatch;
+void HafCpu_InitDispatchTable(int isa);
+
+// AVX2 variants (ago_haf_cpu_avx2.cpp)
+decltype(HafCpu_ChannelExtract_U8_U24_Pos0)       HafCpu_ChannelExtract_U8_U24_Pos0_AVX2;
+decltype(HafCpu_ChannelExtract_U8_U24_Pos1)       HafCpu_ChannelExtract_U8_U24_Pos1_AVX2;
+decltype(HafCpu_ChannelExtract_U8_U24_Pos2)       HafCpu_ChannelExtract_U8_U24_Pos2_AVX2;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos0)       HafCpu_ChannelExtract_U8_U32_Pos0_AVX2;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos1)       HafCpu_ChannelExtract_U8_U32_Pos1_AVX2;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos2)       HafCpu_ChannelExtract_U8_U32_Pos2_AVX2;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos3)       HafCpu_ChannelExtract_U8_U32_Pos3_AVX2;
+decltype(HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX) HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX_AVX2;
+decltype(HafCpu_ColorConvert_RGB_RGBX)            HafCpu_ColorConvert_RGB_RGBX_AVX2;
+decltype(HafCpu_ColorConvert_RGBX_RGB)            HafCpu_ColorConvert_RGBX_RGB_AVX2;
+decltype(HafCpu_Box_U8_U8_3x3)                    HafCpu_Box_U8_U8_3x3_AVX2;
+decltype(HafCpu_Dilate_U8_U8_3x3)                 HafCpu_Dilate_U8_U8_3x3_AVX2;
+decltype(HafCpu_Erode_U8_U8_3x3)                  HafCpu_Erode_U8_U8_3x3_AVX2;
+decltype(HafCpu_Gaussian_U8_U8_3x3)               HafCpu_Gaussian_U8_U8_3x3_AVX2;
+decltype(HafCpu_ScaleImage_U8_U8_Bilinear)        HafCpu_ScaleImage_U8_U8_Bilinear_AVX2;
+decltype(HafCpu_WarpAffine_U8_U8_Bilinear)        HafCpu_WarpAffine_U8_U8_Bilinear_AVX2;
+decltype(HafCpu_GeometricTable_U8_U8)             HafCpu_GeometricTable_U8_U8_AVX2;
+
+// AVX-512BW variants (ago_haf_cpu_avx512.cpp)
+decltype(HafCpu_ChannelExtract_U8_U24_Pos0)       HafCpu_ChannelExtract_U8_U24_Pos0_AVX512;
+decltype(HafCpu_ChannelExtract_U8_U24_Pos1)       HafCpu_ChannelExtract_U8_U24_Pos1_AVX512;
+decltype(HafCpu_ChannelExtract_U8_U24_Pos2)       HafCpu_ChannelExtract_U8_U24_Pos2_AVX512;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos0)       HafCpu_ChannelExtract_U8_U32_Pos0_AVX512;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos1)       HafCpu_ChannelExtract_U8_U32_Pos1_AVX512;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos2)       HafCpu_ChannelExtract_U8_U32_Pos2_AVX512;
+decltype(HafCpu_ChannelExtract_U8_U32_Pos3)       HafCpu_ChannelExtract_U8_U32_Pos3_AVX512;
+decltype(HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX) HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX_AVX512;
+decltype(HafCpu_ColorConvert_RGB_RGBX)            HafCpu_ColorConvert_RGB_RGBX_AVX512;
+decltype(HafCpu_ColorConvert_RGBX_RGB)            HafCpu_ColorConvert_RGBX_RGB_AVX512;
+decltype(HafCpu_Box_U8_U8_3x3)                    HafCpu_Box_U8_U8_3x3_AVX512;
+decltype(HafCpu_Dilate_U8_U8_3x3)                 HafCpu_Dilate_U8_U8_3x3_AVX512;
+decltype(HafCpu_Erode_U8_U8_3x3)                  HafCpu_Erode_U8_U8_3x3_AVX512;
+decltype(HafCpu_Gaussian_U8_U8_3x3)               HafCpu_Gaussian_U8_U8_3x3_AVX512;
+
 #endif // __ago_haf_cpu_h__
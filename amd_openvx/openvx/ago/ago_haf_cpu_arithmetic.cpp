@@ -6394,16 +6394,17 @@ int HafCpu_MeanStdDev_DATA_U8
 	)
 {
 	unsigned char * pLocalSrc;
-	__m128i pixels, pixels_16, pixels_32, pixels_64;
+	__m128i pixels, pixels_lo, pixels_hi, row_squared;
 	__m128i zeromask = _mm_setzero_si128();
-	__m128i sum = _mm_setzero_si128();
-	__m128i sum_squared = _mm_setzero_si128();
+	__m128i sum = _mm_setzero_si128();										// 64-bit sums
+	__m128i sum_squared = _mm_setzero_si128();								// 64-bit sums of squares
 	
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - prefixWidth - postfixWidth;
-	unsigned int prefixSum = 0, postfixSum = 0;
+	unsigned long long prefixSum = 0, postfixSum = 0;
 	unsigned long long prefixSumSquared = 0, postfixSumSquared = 0;
 
 	int height = (int) srcHeight;
@@ -6413,74 +6414,38 @@ int HafCpu_MeanStdDev_DATA_U8
 
 		for (int x = 0; x < prefixWidth; x++, pLocalSrc++)
 		{
-			prefixSum += (unsigned int) *pLocalSrc;
+			prefixSum += (unsigned long long)*pLocalSrc;
 			prefixSumSquared += (unsigned long long)*pLocalSrc * (unsigned long long)*pLocalSrc;
 		}
+		row_squared = _mm_setzero_si128();									// 32-bit sums of squares of the row
 		int width = (int) (alignedWidth >> 4);								// 16 pixels processed at a time
 		while (width)
 		{
 			pixels = _mm_load_si128((__m128i *) pLocalSrc);
-			pixels_16 = _mm_unpackhi_epi8(pixels, zeromask);				// 15, 14, 13, 12, 11, 10, 9, 8
-			pixels_32 = _mm_unpackhi_epi16(pixels_16, zeromask);			// 15, 14, 13, 12
-
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 15, 14, 13, 12
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 15, 14
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 13, 12
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pixels_32 = _mm_cvtepi16_epi32(pixels_16);
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 11, 10, 9, 8
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 11, 10
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 9, 8
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pixels_16 = _mm_cvtepu8_epi16(pixels);							// 7, 6, 5, 4, 3, 2, 1, 0
-			pixels_32 = _mm_unpackhi_epi16(pixels_16, zeromask);			// 7, 6, 5, 4
-
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 7, 6, 5, 4
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 7, 6
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 5, 4
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pixels_32 = _mm_cvtepi16_epi32(pixels_16);
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 3, 2, 1, 0
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 3, 2
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 1, 0
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
+			sum = _mm_add_epi64(sum, _mm_sad_epu8(pixels, zeromask));		// sums of 8 pixels
+			pixels_lo = _mm_unpacklo_epi8(pixels, zeromask);
+			pixels_hi = _mm_unpackhi_epi8(pixels, zeromask);
+			row_squared = _mm_add_epi32(row_squared, _mm_madd_epi16(pixels_lo, pixels_lo));	// sums of squares of 2 pixels
+			row_squared = _mm_add_epi32(row_squared, _mm_madd_epi16(pixels_hi, pixels_hi));
 
 			pLocalSrc += 16;
 			width--;
 		}
+		sum_squared = _mm_add_epi64(sum_squared, _mm_unpacklo_epi32(row_squared, zeromask));
+		sum_squared = _mm_add_epi64(sum_squared, _mm_unpackhi_epi32(row_squared, zeromask));
 
 		for (int x = 0; x < postfixWidth; x++, pLocalSrc++)
 		{
-			postfixSum += (unsigned int)*pLocalSrc;
+			postfixSum += (unsigned long long)*pLocalSrc;
 			postfixSumSquared += (unsigned long long)*pLocalSrc * (unsigned long long)*pLocalSrc;
 		}
 
 		pSrcImage += srcImageStrideInBytes;
 		height--;
 	}
-	
-	sum = _mm_hadd_epi32(sum, sum);											// Lowest int of sum has sum of last two ints of sum
-	sum = _mm_hadd_epi32(sum, sum);											// Lowest int of sum has the sum of all four ints
-	pixels = _mm_srli_si128(sum_squared, 8);
-	sum_squared = _mm_add_epi64(sum_squared, pixels);
 
-	*pSum = (vx_float32)(M128I(sum).m128i_u32[0] + prefixSum + postfixSum);
-	*pSumOfSquared = (vx_float32)(M128I(sum_squared).m128i_u64[0] + prefixSumSquared + postfixSumSquared);
+	*pSum = (vx_float32)(M128I(sum).m128i_u64[0] + M128I(sum).m128i_u64[1] + prefixSum + postfixSum);
+	*pSumOfSquared = (vx_float32)(M128I(sum_squared).m128i_u64[0] + M128I(sum_squared).m128i_u64[1] + prefixSumSquared + postfixSumSquared);
 
 	return AGO_SUCCESS;
 }
@@ -6512,6 +6477,69 @@ int HafCpu_MeanStdDevMerge_DATA_DATA
 	return AGO_SUCCESS;
 }
 
+// computes min, max, sum, and sum of squares of an image in one pass over the pixels
+int HafCpu_MinMaxMeanStdDev_DATA_U8
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_float32  * pSum,
+		vx_float32  * pSumOfSquared,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	__m128i zeromask = _mm_setzero_si128();
+	__m128i minVal_xmm = _mm_set1_epi8((char)0xFF);
+	__m128i maxVal_xmm = _mm_setzero_si128();
+	__m128i sum = _mm_setzero_si128();									// 64-bit sums
+	__m128i sum_squared = _mm_setzero_si128();							// 64-bit sums of squares
+	unsigned char minVal = 255, maxVal = 0;
+	unsigned long long postfixSum = 0, postfixSumSquared = 0;
+	int alignedWidth = (int)srcWidth & ~15;
+
+	for (unsigned int y = 0; y < srcHeight; y++)
+	{
+		unsigned char * pLocalSrc = pSrcImage + y * srcImageStrideInBytes;
+		__m128i row_squared = _mm_setzero_si128();							// 32-bit sums of squares of the row
+		for (int x = 0; x < alignedWidth; x += 16)
+		{
+			__m128i pixels = _mm_loadu_si128((__m128i *)(pLocalSrc + x));
+			minVal_xmm = _mm_min_epu8(minVal_xmm, pixels);
+			maxVal_xmm = _mm_max_epu8(maxVal_xmm, pixels);
+			sum = _mm_add_epi64(sum, _mm_sad_epu8(pixels, zeromask));
+			__m128i pixels_lo = _mm_unpacklo_epi8(pixels, zeromask);
+			__m128i pixels_hi = _mm_unpackhi_epi8(pixels, zeromask);
+			row_squared = _mm_add_epi32(row_squared, _mm_madd_epi16(pixels_lo, pixels_lo));
+			row_squared = _mm_add_epi32(row_squared, _mm_madd_epi16(pixels_hi, pixels_hi));
+		}
+		sum_squared = _mm_add_epi64(sum_squared, _mm_unpacklo_epi32(row_squared, zeromask));
+		sum_squared = _mm_add_epi64(sum_squared, _mm_unpackhi_epi32(row_squared, zeromask));
+
+		for (int x = alignedWidth; x < (int)srcWidth; x++)
+		{
+			minVal = min(minVal, pLocalSrc[x]);
+			maxVal = max(maxVal, pLocalSrc[x]);
+			postfixSum += (unsigned long long)pLocalSrc[x];
+			postfixSumSquared += (unsigned long long)pLocalSrc[x] * (unsigned long long)pLocalSrc[x];
+		}
+	}
+
+	for (int i = 0; i < 16; i++)
+	{
+		minVal = min(minVal, M128I(minVal_xmm).m128i_u8[i]);
+		maxVal = max(maxVal, M128I(maxVal_xmm).m128i_u8[i]);
+	}
+
+	*pDstMinValue = (vx_int32)minVal;
+	*pDstMaxValue = (vx_int32)maxVal;
+	*pSum = (vx_float32)(M128I(sum).m128i_u64[0] + M128I(sum).m128i_u64[1] + postfixSum);
+	*pSumOfSquared = (vx_float32)(M128I(sum_squared).m128i_u64[0] + M128I(sum_squared).m128i_u64[1] + postfixSumSquared);
+
+	return AGO_SUCCESS;
+}
+
 int HafCpu_IntegralImage_U32_U8
 (
 	vx_uint32     dstWidth,
@@ -6817,7 +6845,7 @@ int HafCpu_HistogramMerge_DATA_DATA
 		__m128i sum1 = _mm_setzero_si128();
 		__m128i sum2 = _mm_setzero_si128();
 		for (unsigned int i = 0; i < numPartitions; i++){
-			__m128i *phist = (__m128i *)&pPartSrcHist[i];
+			__m128i *phist = (__m128i *)pPartSrcHist[i];
 			pixels1 = _mm_load_si128(&phist[(n >> 2)]);
 			pixels2 = _mm_load_si128(&phist[(n >> 2)+1]);
 			sum1 = _mm_add_epi32(sum1, pixels1);
@@ -8948,7 +8976,7 @@ int HafCpu_MinMaxMerge_DATA_DATA
 	for (int i = 1; i < (int) numDataPartitions; i++)
 	{
 		minVal = min(minVal, srcMinValue[i]);
-		maxVal = min(minVal, srcMaxValue[i]);
+		maxVal = max(maxVal, srcMaxValue[i]);
 	}
 
 	*pDstMinValue = minVal;
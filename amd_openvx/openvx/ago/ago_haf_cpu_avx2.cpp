@@ -0,0 +1,962 @@
+/* 
+Copyright (c) 2015 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+
+// This file is compiled with AVX2 code generation and is only reached through g_hafCpuDispatch
+// on CPUs that support AVX2. Keep it free of headers with inline functions or static objects,
+// so that no AVX2 code can get linked into (or run from) the rest of the library.
+// Each kernel keeps the SSE4 prefix/postfix split and arithmetic so that the outputs are bit-exact.
+#include "ago_haf_cpu.h"
+#include <immintrin.h>
+
+#define AGO_SUCCESS     0 // same as in ago_internal.h
+#define FP_BITS         18
+#define FP_MUL          (1<<FP_BITS)
+
+extern unsigned char dataChannelExtract[];
+extern unsigned char dataColorConvert[];
+
+static inline __m256i loadu2_si256(const vx_uint8 * hi, const vx_uint8 * lo)
+{
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)lo)), _mm_loadu_si128((const __m128i *)hi), 1);
+}
+
+static inline void storeu2_si256(vx_uint8 * hi, vx_uint8 * lo, __m256i v)
+{
+	_mm_storeu_si128((__m128i *)lo, _mm256_castsi256_si128(v));
+	_mm_storeu_si128((__m128i *)hi, _mm256_extracti128_si256(v, 1));
+}
+
+static inline __m256i broadcast_si256(const vx_uint8 * table, int index)
+{
+	return _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)table + index));
+}
+
+/* The SSE shuffle masks are applied to each 128-bit lane: lane 1 extracts pixels 16..31 */
+static inline int ChannelExtract_U8_U24_AVX2
+	(
+		int           pos,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~31;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m256i mask1 = broadcast_si256(dataChannelExtract, 4 + 3 * pos);
+	__m256i mask2 = broadcast_si256(dataChannelExtract, 5 + 3 * pos);
+	__m256i mask3 = broadcast_si256(dataChannelExtract, 6 + 3 * pos);
+	__m256i r0, r1, r2;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 32)
+		{
+			r0 = loadu2_si256(pLocalSrc + 48, pLocalSrc);
+			r1 = loadu2_si256(pLocalSrc + 64, pLocalSrc + 16);
+			r2 = loadu2_si256(pLocalSrc + 80, pLocalSrc + 32);
+			r0 = _mm256_shuffle_epi8(r0, mask1);
+			r1 = _mm256_shuffle_epi8(r1, mask2);
+			r2 = _mm256_shuffle_epi8(r2, mask3);
+			r0 = _mm256_or_si256(r0, r1);
+			r0 = _mm256_or_si256(r0, r2);
+			_mm256_storeu_si256((__m256i *)pLocalDst, r0);
+
+			pLocalSrc += 96;
+			pLocalDst += 32;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = pLocalSrc[pos];
+			pLocalSrc += 3;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ChannelExtract_U8_U24_Pos0_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U24_AVX2(0, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U24_Pos1_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U24_AVX2(1, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U24_Pos2_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U24_AVX2(2, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+/* The packs interleave the 128-bit lanes, the final permute puts the 4-pixel groups back in order */
+static inline int ChannelExtract_U8_U32_AVX2
+	(
+		int           pos,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~31;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	const __m256i mask = _mm256_set1_epi32(0xFF);
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	__m256i r0, r1, r2, r3;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 32)
+		{
+			r0 = _mm256_loadu_si256((__m256i *)pLocalSrc);
+			r1 = _mm256_loadu_si256((__m256i *)(pLocalSrc + 32));
+			r2 = _mm256_loadu_si256((__m256i *)(pLocalSrc + 64));
+			r3 = _mm256_loadu_si256((__m256i *)(pLocalSrc + 96));
+			r0 = _mm256_and_si256(_mm256_srli_epi32(r0, 8 * pos), mask);
+			r1 = _mm256_and_si256(_mm256_srli_epi32(r1, 8 * pos), mask);
+			r2 = _mm256_and_si256(_mm256_srli_epi32(r2, 8 * pos), mask);
+			r3 = _mm256_and_si256(_mm256_srli_epi32(r3, 8 * pos), mask);
+			r0 = _mm256_packus_epi32(r0, r1);
+			r2 = _mm256_packus_epi32(r2, r3);
+			r0 = _mm256_packus_epi16(r0, r2);
+			r0 = _mm256_permutevar8x32_epi32(r0, order);
+			_mm256_storeu_si256((__m256i *)pLocalDst, r0);
+
+			pLocalSrc += 128;
+			pLocalDst += 32;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = pLocalSrc[pos];
+			pLocalSrc += 4;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos0_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX2(0, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos1_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX2(1, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos2_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX2(2, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos3_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX2(3, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage0,
+		vx_uint32     srcImage0StrideInBytes,
+		vx_uint8    * pSrcImage1,
+		vx_uint32     srcImage1StrideInBytes,
+		vx_uint8    * pSrcImage2,
+		vx_uint32     srcImage2StrideInBytes,
+		vx_uint8    * pSrcImage3,
+		vx_uint32     srcImage3StrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~31;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m256i r, g, b, x, rg, bx, pixels0, pixels1, pixels2, pixels3;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc0 = pSrcImage0;
+		vx_uint8 * pLocalSrc1 = pSrcImage1;
+		vx_uint8 * pLocalSrc2 = pSrcImage2;
+		vx_uint8 * pLocalSrc3 = pSrcImage3;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 32)
+		{
+			r = _mm256_loadu_si256((__m256i *)pLocalSrc0);
+			g = _mm256_loadu_si256((__m256i *)pLocalSrc1);
+			b = _mm256_loadu_si256((__m256i *)pLocalSrc2);
+			x = _mm256_loadu_si256((__m256i *)pLocalSrc3);
+
+			rg = _mm256_unpacklo_epi8(r, g);
+			bx = _mm256_unpacklo_epi8(b, x);
+			pixels0 = _mm256_unpacklo_epi16(rg, bx);		// pixels 0..3   | 16..19
+			pixels1 = _mm256_unpackhi_epi16(rg, bx);		// pixels 4..7   | 20..23
+			rg = _mm256_unpackhi_epi8(r, g);
+			bx = _mm256_unpackhi_epi8(b, x);
+			pixels2 = _mm256_unpacklo_epi16(rg, bx);		// pixels 8..11  | 24..27
+			pixels3 = _mm256_unpackhi_epi16(rg, bx);		// pixels 12..15 | 28..31
+
+			_mm256_storeu_si256((__m256i *)pLocalDst, _mm256_permute2x128_si256(pixels0, pixels1, 0x20));
+			_mm256_storeu_si256((__m256i *)(pLocalDst + 32), _mm256_permute2x128_si256(pixels2, pixels3, 0x20));
+			_mm256_storeu_si256((__m256i *)(pLocalDst + 64), _mm256_permute2x128_si256(pixels0, pixels1, 0x31));
+			_mm256_storeu_si256((__m256i *)(pLocalDst + 96), _mm256_permute2x128_si256(pixels2, pixels3, 0x31));
+
+			pLocalSrc0 += 32;
+			pLocalSrc1 += 32;
+			pLocalSrc2 += 32;
+			pLocalSrc3 += 32;
+			pLocalDst += 128;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = *pLocalSrc0++;
+			*pLocalDst++ = *pLocalSrc1++;
+			*pLocalDst++ = *pLocalSrc2++;
+			*pLocalDst++ = *pLocalSrc3++;
+		}
+
+		pSrcImage0 += srcImage0StrideInBytes;
+		pSrcImage1 += srcImage1StrideInBytes;
+		pSrcImage2 += srcImage2StrideInBytes;
+		pSrcImage3 += srcImage3StrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ColorConvert_RGB_RGBX_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~31;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m256i mask_1_1 = broadcast_si256(dataColorConvert, 8);
+	__m256i mask_1_2 = broadcast_si256(dataColorConvert, 9);
+	__m256i mask_2_2 = broadcast_si256(dataColorConvert, 10);
+	__m256i mask_2_3 = broadcast_si256(dataColorConvert, 11);
+	__m256i mask_3_3 = broadcast_si256(dataColorConvert, 12);
+	__m256i mask_3_4 = broadcast_si256(dataColorConvert, 13);
+	__m256i pixels1, pixels2, pixels3, pixels4;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 32)
+		{
+			pixels1 = loadu2_si256(pLocalSrc + 64, pLocalSrc);
+			pixels2 = loadu2_si256(pLocalSrc + 80, pLocalSrc + 16);
+			pixels3 = loadu2_si256(pLocalSrc + 96, pLocalSrc + 32);
+			pixels4 = loadu2_si256(pLocalSrc + 112, pLocalSrc + 48);
+
+			pixels4 = _mm256_or_si256(_mm256_shuffle_epi8(pixels4, mask_3_4), _mm256_shuffle_epi8(pixels3, mask_3_3));
+			pixels3 = _mm256_or_si256(_mm256_shuffle_epi8(pixels3, mask_2_3), _mm256_shuffle_epi8(pixels2, mask_2_2));
+			pixels2 = _mm256_or_si256(_mm256_shuffle_epi8(pixels2, mask_1_2), _mm256_shuffle_epi8(pixels1, mask_1_1));
+
+			storeu2_si256(pLocalDst + 48, pLocalDst, pixels2);
+			storeu2_si256(pLocalDst + 64, pLocalDst + 16, pixels3);
+			storeu2_si256(pLocalDst + 80, pLocalDst + 32, pixels4);
+
+			pLocalSrc += 128;
+			pLocalDst += 96;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = *pLocalSrc++;
+			*pLocalDst++ = *pLocalSrc++;
+			*pLocalDst++ = *pLocalSrc++;
+			pLocalSrc++;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ColorConvert_RGBX_RGB_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~31;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m256i mask_1_1 = broadcast_si256(dataColorConvert, 14);
+	__m256i mask_2_1 = broadcast_si256(dataColorConvert, 15);
+	__m256i mask_2_2 = broadcast_si256(dataColorConvert, 16);
+	__m256i mask_3_2 = broadcast_si256(dataColorConvert, 17);
+	__m256i mask_3_3 = broadcast_si256(dataColorConvert, 18);
+	__m256i mask_4_3 = broadcast_si256(dataColorConvert, 19);
+	__m256i mask_fill = broadcast_si256(dataColorConvert, 20);
+	__m256i pixels1, pixels2, pixels3, pixels4;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 32)
+		{
+			pixels1 = loadu2_si256(pLocalSrc + 48, pLocalSrc);
+			pixels2 = loadu2_si256(pLocalSrc + 64, pLocalSrc + 16);
+			pixels3 = loadu2_si256(pLocalSrc + 80, pLocalSrc + 32);
+
+			pixels4 = _mm256_shuffle_epi8(pixels3, mask_4_3);
+			pixels3 = _mm256_or_si256(_mm256_shuffle_epi8(pixels3, mask_3_3), _mm256_shuffle_epi8(pixels2, mask_3_2));
+			pixels2 = _mm256_or_si256(_mm256_shuffle_epi8(pixels2, mask_2_2), _mm256_shuffle_epi8(pixels1, mask_2_1));
+			pixels1 = _mm256_shuffle_epi8(pixels1, mask_1_1);
+
+			storeu2_si256(pLocalDst + 64, pLocalDst, _mm256_or_si256(pixels1, mask_fill));
+			storeu2_si256(pLocalDst + 80, pLocalDst + 16, _mm256_or_si256(pixels2, mask_fill));
+			storeu2_si256(pLocalDst + 96, pLocalDst + 32, _mm256_or_si256(pixels3, mask_fill));
+			storeu2_si256(pLocalDst + 112, pLocalDst + 48, _mm256_or_si256(pixels4, mask_fill));
+
+			pLocalSrc += 96;
+			pLocalDst += 128;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = *pLocalSrc++;					// R
+			*pLocalDst++ = *pLocalSrc++;					// G
+			*pLocalDst++ = *pLocalSrc++;					// B
+			*pLocalDst++ = (unsigned char)255;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+/* 3x3 filters: the prefix and postfix pixels up to 16-byte destination alignment are
+   computed with the same scalar code as the SSE versions, the aligned part in 32 and 16 pixel steps.
+   The function assumes at least one pixel padding on the top, left, right and bottom */
+static inline void Get3x3AlignedWidths(vx_uint32 dstWidth, vx_uint8 * pDstImage, int& prefixWidth, int& postfixWidth, int& alignedWidth)
+{
+	prefixWidth = intptr_t(pDstImage) & 15;
+	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	postfixWidth = ((int)dstWidth - prefixWidth) & 15;
+	alignedWidth = (int)dstWidth - prefixWidth - postfixWidth;
+}
+
+static inline int Morphology_U8_U8_3x3_AVX2
+	(
+		bool          isDilate,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int prefixWidth, postfixWidth, alignedWidth;
+	Get3x3AlignedWidths(dstWidth, pDstImage, prefixWidth, postfixWidth, alignedWidth);
+	int stride = (int)srcImageStrideInBytes;
+
+	auto op = [isDilate](vx_uint8 a, vx_uint8 b) -> vx_uint8 { return isDilate ? (a > b ? a : b) : (a < b ? a : b); };
+	auto op3x3 = [&](const vx_uint8 * p) -> vx_uint8 {
+		vx_uint8 temp1 = op(op(p[-stride - 1], p[-stride]), p[-stride + 1]);
+		vx_uint8 temp2 = op(op(p[-1], p[0]), p[1]);
+		temp1 = op(temp1, temp2);
+		temp2 = op(op(p[stride - 1], p[stride]), p[stride + 1]);
+		return op(temp1, temp2);
+	};
+	auto op_ymm = [isDilate](__m256i a, __m256i b) -> __m256i { return isDilate ? _mm256_max_epu8(a, b) : _mm256_min_epu8(a, b); };
+	auto op_xmm = [isDilate](__m128i a, __m128i b) -> __m128i { return isDilate ? _mm_max_epu8(a, b) : _mm_min_epu8(a, b); };
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int x = 0; x < prefixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = op3x3(pLocalSrc);
+
+		int x = 0;
+		for (; x + 32 <= alignedWidth; x += 32, pLocalSrc += 32, pLocalDst += 32)
+		{
+			__m256i row0 = _mm256_loadu_si256((__m256i *)(pLocalSrc - stride));
+			row0 = op_ymm(row0, _mm256_loadu_si256((__m256i *)(pLocalSrc - stride - 1)));
+			row0 = op_ymm(row0, _mm256_loadu_si256((__m256i *)(pLocalSrc - stride + 1)));
+			__m256i row1 = _mm256_loadu_si256((__m256i *)pLocalSrc);
+			row1 = op_ymm(row1, _mm256_loadu_si256((__m256i *)(pLocalSrc - 1)));
+			row1 = op_ymm(row1, _mm256_loadu_si256((__m256i *)(pLocalSrc + 1)));
+			__m256i row2 = _mm256_loadu_si256((__m256i *)(pLocalSrc + stride));
+			row2 = op_ymm(row2, _mm256_loadu_si256((__m256i *)(pLocalSrc + stride - 1)));
+			row2 = op_ymm(row2, _mm256_loadu_si256((__m256i *)(pLocalSrc + stride + 1)));
+			_mm256_storeu_si256((__m256i *)pLocalDst, op_ymm(op_ymm(row0, row1), row2));
+		}
+		for (; x < alignedWidth; x += 16, pLocalSrc += 16, pLocalDst += 16)
+		{
+			__m128i row0 = _mm_loadu_si128((__m128i *)(pLocalSrc - stride));
+			row0 = op_xmm(row0, _mm_loadu_si128((__m128i *)(pLocalSrc - stride - 1)));
+			row0 = op_xmm(row0, _mm_loadu_si128((__m128i *)(pLocalSrc - stride + 1)));
+			__m128i row1 = _mm_loadu_si128((__m128i *)pLocalSrc);
+			row1 = op_xmm(row1, _mm_loadu_si128((__m128i *)(pLocalSrc - 1)));
+			row1 = op_xmm(row1, _mm_loadu_si128((__m128i *)(pLocalSrc + 1)));
+			__m128i row2 = _mm_loadu_si128((__m128i *)(pLocalSrc + stride));
+			row2 = op_xmm(row2, _mm_loadu_si128((__m128i *)(pLocalSrc + stride - 1)));
+			row2 = op_xmm(row2, _mm_loadu_si128((__m128i *)(pLocalSrc + stride + 1)));
+			_mm_store_si128((__m128i *)pLocalDst, op_xmm(op_xmm(row0, row1), row2));
+		}
+
+		for (int x = 0; x < postfixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = op3x3(pLocalSrc);
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Dilate_U8_U8_3x3_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return Morphology_U8_U8_3x3_AVX2(true, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_Erode_U8_U8_3x3_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return Morphology_U8_U8_3x3_AVX2(false, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+/* Box and Gaussian sum the 3x3 neighborhood directly in 16-bit lanes instead of keeping
+   horizontal sums in pScratch: the sums, and hence the outputs, are the same as the SSE versions.
+   unpacklo/unpackhi split each 128-bit lane and packus joins them back in the same order. */
+static inline __m256i Sum3x3_AVX2(bool isGaussian, const vx_uint8 * p, int stride, __m256i& hi)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i lo = _mm256_setzero_si256();
+	hi = _mm256_setzero_si256();
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			__m256i v = _mm256_loadu_si256((__m256i *)(p + y * stride + x));
+			__m256i vlo = _mm256_unpacklo_epi8(v, zero);
+			__m256i vhi = _mm256_unpackhi_epi8(v, zero);
+			if (isGaussian) {
+				int shift = (x == 0) + (y == 0);
+				vlo = _mm256_slli_epi16(vlo, shift);
+				vhi = _mm256_slli_epi16(vhi, shift);
+			}
+			lo = _mm256_add_epi16(lo, vlo);
+			hi = _mm256_add_epi16(hi, vhi);
+		}
+	}
+	return lo;
+}
+
+static inline __m128i Sum3x3_SSE(bool isGaussian, const vx_uint8 * p, int stride, __m128i& hi)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_setzero_si128();
+	hi = _mm_setzero_si128();
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			__m128i v = _mm_loadu_si128((__m128i *)(p + y * stride + x));
+			__m128i vlo = _mm_unpacklo_epi8(v, zero);
+			__m128i vhi = _mm_unpackhi_epi8(v, zero);
+			if (isGaussian) {
+				int shift = (x == 0) + (y == 0);
+				vlo = _mm_slli_epi16(vlo, shift);
+				vhi = _mm_slli_epi16(vhi, shift);
+			}
+			lo = _mm_add_epi16(lo, vlo);
+			hi = _mm_add_epi16(hi, vhi);
+		}
+	}
+	return lo;
+}
+
+static inline vx_uint32 Sum3x3(bool isGaussian, const vx_uint8 * p, int stride)
+{
+	vx_uint32 sum = 0;
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			vx_uint32 v = p[y * stride + x];
+			sum += isGaussian ? (v << ((x == 0) + (y == 0))) : v;
+		}
+	}
+	return sum;
+}
+
+static inline int Smooth_U8_U8_3x3_AVX2
+	(
+		bool          isGaussian,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int prefixWidth, postfixWidth, alignedWidth;
+	Get3x3AlignedWidths(dstWidth, pDstImage, prefixWidth, postfixWidth, alignedWidth);
+	int stride = (int)srcImageStrideInBytes;
+
+	// box: multiply by ceil((2^16)/9) in the vector code and divide in float in the scalar code, same as SSE
+	const __m256i divFactor_ymm = _mm256_set1_epi16((short)7282);
+	const __m128i divFactor_xmm = _mm_set1_epi16((short)7282);
+	auto scalar = [isGaussian](vx_uint32 sum) -> vx_uint8 { return isGaussian ? (vx_uint8)(sum >> 4) : (vx_uint8)((float)sum / 9.0f); };
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int x = 0; x < prefixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = scalar(Sum3x3(isGaussian, pLocalSrc, stride));
+
+		int x = 0;
+		for (; x + 32 <= alignedWidth; x += 32, pLocalSrc += 32, pLocalDst += 32)
+		{
+			__m256i hi, lo = Sum3x3_AVX2(isGaussian, pLocalSrc, stride, hi);
+			if (isGaussian) {
+				lo = _mm256_srli_epi16(lo, 4);
+				hi = _mm256_srli_epi16(hi, 4);
+			}
+			else {
+				lo = _mm256_mulhi_epi16(lo, divFactor_ymm);
+				hi = _mm256_mulhi_epi16(hi, divFactor_ymm);
+			}
+			_mm256_storeu_si256((__m256i *)pLocalDst, _mm256_packus_epi16(lo, hi));
+		}
+		for (; x < alignedWidth; x += 16, pLocalSrc += 16, pLocalDst += 16)
+		{
+			__m128i hi, lo = Sum3x3_SSE(isGaussian, pLocalSrc, stride, hi);
+			if (isGaussian) {
+				lo = _mm_srli_epi16(lo, 4);
+				hi = _mm_srli_epi16(hi, 4);
+			}
+			else {
+				lo = _mm_mulhi_epi16(lo, divFactor_xmm);
+				hi = _mm_mulhi_epi16(hi, divFactor_xmm);
+			}
+			_mm_store_si128((__m128i *)pLocalDst, _mm_packus_epi16(lo, hi));
+		}
+
+		for (int x = 0; x < postfixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = scalar(Sum3x3(isGaussian, pLocalSrc, stride));
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Box_U8_U8_3x3_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes, vx_uint8 * pScratch)
+{
+	return Smooth_U8_U8_3x3_AVX2(false, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_Gaussian_U8_U8_3x3_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes, vx_uint8 * pScratch)
+{
+	return Smooth_U8_U8_3x3_AVX2(true, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+/* Same tables and fixed point math as the SSE version: 16 pixels per step, with the
+   two source pixels of each destination pixel fetched with a 32-bit gather */
+int HafCpu_ScaleImage_U8_U8_Bilinear_AVX2
+	(
+		vx_uint32            dstWidth,
+		vx_uint32            dstHeight,
+		vx_uint8           * pDstImage,
+		vx_uint32            dstImageStrideInBytes,
+		vx_uint32            srcWidth,
+		vx_uint32            srcHeight,
+		vx_uint8           * pSrcImage,
+		vx_uint32            srcImageStrideInBytes,
+		ago_scale_matrix_t * matrix
+	)
+{
+	int xinc, yinc, xoffs, yoffs;
+
+	yinc = (int)(FP_MUL * matrix->yscale);		// to convert to fixed point
+	xinc = (int)(FP_MUL * matrix->xscale);
+	yoffs = (int)(FP_MUL * matrix->yoffset);		// to convert to fixed point
+	xoffs = (int)(FP_MUL * matrix->xoffset);
+
+	int alignW = (dstWidth + 15)&~15;
+	unsigned short *Xmap = (unsigned short *)((vx_uint8*)matrix + sizeof(AgoConfigScaleMatrix));
+	unsigned short *Xfrac = Xmap + alignW;
+	unsigned short *One_min_xf = Xfrac + alignW;
+
+	int xpos = xoffs;
+	for (unsigned int x = 0; x < dstWidth; x++, xpos += xinc)
+	{
+		int xf;
+		int xmap = (xpos >> FP_BITS);
+		if (xmap >= (int)(srcWidth - 1)){
+			Xmap[x] = (unsigned short)(srcWidth - 1);
+		}
+		Xmap[x] = (xmap<0)? 0: (unsigned short)xmap;
+		xf = ((xpos & 0x3ffff)+0x200)>>10;
+		Xfrac[x] = xf;
+		One_min_xf[x] = (0x100 - xf);
+	}
+
+	const __m256i mask = _mm256_set1_epi16((short)0xff);
+	const __m256i round = _mm256_set1_epi16((short)0x80);
+	const __m256i lowWord = _mm256_set1_epi32(0xffff);
+	const __m128i mask_xmm = _mm_set1_epi16((short)0xff);
+	const __m128i round_xmm = _mm_set1_epi16((short)0x80);
+	unsigned int newDstWidth = dstWidth & ~7;	// nearest multiple of 8
+
+	for (int y = 0, ypos = yoffs; y < (int)dstHeight; y++, ypos += yinc)
+	{
+		int ym, yf, one_min_yf;
+		vx_uint8 *pSrc1, *pSrc2;
+
+		ym = (ypos >> FP_BITS);
+		yf = ((ypos & 0x3ffff)+0x200)>>10;
+		one_min_yf = (0x100 - yf);
+		if (ym < 0){
+			pSrc1 = pSrc2 = pSrcImage;
+		}
+		else if (ym >= (int)(srcHeight - 1)){
+			ym = srcHeight - 1;
+			pSrc1 = pSrc2 = pSrcImage + ym*srcImageStrideInBytes;
+		}
+		else
+		{
+			pSrc1 = pSrcImage + ym*srcImageStrideInBytes;
+			pSrc2 = pSrc1 + srcImageStrideInBytes;
+		}
+		unsigned int x = 0;
+		__m256i ryf1 = _mm256_set1_epi16((unsigned short)one_min_yf);
+		__m256i ryf = _mm256_set1_epi16((unsigned short)yf);
+		for (; x + 16 <= newDstWidth; x += 16)
+		{
+			// load the pixel pairs for 16 destination pixels: the packs interleave the lanes, the permute fixes the order
+			__m256i mapx0 = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)&Xmap[x]));
+			__m256i mapx1 = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)&Xmap[x + 8]));
+			__m256i pp1 = _mm256_packus_epi32(_mm256_and_si256(_mm256_i32gather_epi32((const int *)pSrc1, mapx0, 1), lowWord),
+				_mm256_and_si256(_mm256_i32gather_epi32((const int *)pSrc1, mapx1, 1), lowWord));
+			__m256i pp2 = _mm256_packus_epi32(_mm256_and_si256(_mm256_i32gather_epi32((const int *)pSrc2, mapx0, 1), lowWord),
+				_mm256_and_si256(_mm256_i32gather_epi32((const int *)pSrc2, mapx1, 1), lowWord));
+			pp1 = _mm256_permute4x64_epi64(pp1, 0xD8);
+			pp2 = _mm256_permute4x64_epi64(pp2, 0xD8);
+
+			__m256i rxmm1 = _mm256_and_si256(pp1, mask);		// p1
+			pp1 = _mm256_srli_epi16(pp1, 8);					// p2
+			__m256i rxmm4 = _mm256_and_si256(pp2, mask);		// p3
+			pp2 = _mm256_srli_epi16(pp2, 8);					// p4
+
+			__m256i rxmm2 = _mm256_loadu_si256((__m256i *)&Xfrac[x]);			// xf
+			__m256i rxmm3 = _mm256_loadu_si256((__m256i *)&One_min_xf[x]);		// 1-xf
+
+			rxmm1 = _mm256_add_epi16(_mm256_mullo_epi16(rxmm1, rxmm3), _mm256_mullo_epi16(pp1, rxmm2));
+			rxmm1 = _mm256_srli_epi16(_mm256_add_epi16(rxmm1, round), 8);
+			rxmm4 = _mm256_add_epi16(_mm256_mullo_epi16(rxmm4, rxmm3), _mm256_mullo_epi16(pp2, rxmm2));
+			rxmm4 = _mm256_srli_epi16(_mm256_add_epi16(rxmm4, round), 8);
+
+			rxmm1 = _mm256_add_epi16(_mm256_mullo_epi16(rxmm1, ryf1), _mm256_mullo_epi16(rxmm4, ryf));
+			rxmm1 = _mm256_srli_epi16(_mm256_add_epi16(rxmm1, round), 8);
+			rxmm1 = _mm256_permute4x64_epi64(_mm256_packus_epi16(rxmm1, rxmm1), 0xD8);
+			_mm_storeu_si128((__m128i *)(pDstImage + x), _mm256_castsi256_si128(rxmm1));
+		}
+		for (; x < newDstWidth; x += 8)
+		{
+			__m256i mapx0 = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)&Xmap[x]));
+			__m256i pp = _mm256_and_si256(_mm256_i32gather_epi32((const int *)pSrc1, mapx0, 1), lowWord);
+			__m128i pp1 = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(pp, pp), 0xD8));
+			pp = _mm256_and_si256(_mm256_i32gather_epi32((const int *)pSrc2, mapx0, 1), lowWord);
+			__m128i pp2 = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(pp, pp), 0xD8));
+
+			__m128i rxmm1 = _mm_and_si128(pp1, mask_xmm);		// p1
+			pp1 = _mm_srli_epi16(pp1, 8);						// p2
+			__m128i rxmm4 = _mm_and_si128(pp2, mask_xmm);		// p3
+			pp2 = _mm_srli_epi16(pp2, 8);						// p4
+
+			__m128i rxmm2 = _mm_loadu_si128((__m128i *)&Xfrac[x]);			// xf
+			__m128i rxmm3 = _mm_loadu_si128((__m128i *)&One_min_xf[x]);		// 1-xf
+
+			rxmm1 = _mm_add_epi16(_mm_mullo_epi16(rxmm1, rxmm3), _mm_mullo_epi16(pp1, rxmm2));
+			rxmm1 = _mm_srli_epi16(_mm_add_epi16(rxmm1, round_xmm), 8);
+			rxmm4 = _mm_add_epi16(_mm_mullo_epi16(rxmm4, rxmm3), _mm_mullo_epi16(pp2, rxmm2));
+			rxmm4 = _mm_srli_epi16(_mm_add_epi16(rxmm4, round_xmm), 8);
+
+			rxmm1 = _mm_add_epi16(_mm_mullo_epi16(rxmm1, _mm256_castsi256_si128(ryf1)), _mm_mullo_epi16(rxmm4, _mm256_castsi256_si128(ryf)));
+			rxmm1 = _mm_srli_epi16(_mm_add_epi16(rxmm1, round_xmm), 8);
+			_mm_storel_epi64((__m128i *)(pDstImage + x), _mm_packus_epi16(rxmm1, rxmm1));
+		}
+		for (x = newDstWidth; x < dstWidth; x++) {
+			const unsigned char *p0 = pSrc1 + Xmap[x];
+			const unsigned char *p1 = pSrc2 + Xmap[x];
+			pDstImage[x] = ((One_min_xf[x] * one_min_yf*p0[0]) + (Xfrac[x] * one_min_yf*p0[1]) + (One_min_xf[x] * yf*p1[0]) + (Xfrac[x] * yf*p1[1]) + 0x8000) >> 16;
+		}
+
+		pDstImage += dstImageStrideInBytes;
+	}
+
+	return AGO_SUCCESS;
+}
+
+/* Same float math as the SSE version, 8 pixels per step with gathers for the 2x2 source pixels.
+   The last step covers 4 pixels when the SSE version would, so the same table entries
+   are read and the same destination bytes are written. */
+int HafCpu_WarpAffine_U8_U8_Bilinear_AVX2
+	(
+		vx_uint32             dstWidth,
+		vx_uint32             dstHeight,
+		vx_uint8            * pDstImage,
+		vx_uint32             dstImageStrideInBytes,
+		vx_uint32             srcWidth,
+		vx_uint32             srcHeight,
+		vx_uint8            * pSrcImage,
+		vx_uint32             srcImageStrideInBytes,
+		ago_affine_matrix_t * matrix,
+		vx_uint8			* pLocalData
+	)
+{
+	const float r00 = matrix->matrix[0][0];
+	const float r10 = matrix->matrix[0][1];
+	const float r01 = matrix->matrix[1][0];
+	const float r11 = matrix->matrix[1][1];
+	const float const1 = matrix->matrix[2][0];
+	const float const2 = matrix->matrix[2][1];
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256i zeromask = _mm256_setzero_si256();
+	const __m256 srcbx = _mm256_cvtepi32_ps(_mm256_set1_epi32(srcWidth));
+	const __m256 srcby = _mm256_cvtepi32_ps(_mm256_set1_epi32(srcHeight));
+	const __m256i p0mask = _mm256_set1_epi32((int)0xFF);
+	const __m256 oneFloat = _mm256_set1_ps(1.0);
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	const __m256i lowHalf = _mm256_setr_epi32(-1, -1, -1, -1, 0, 0, 0, 0);
+
+	unsigned int x, y;
+	float *r00_x = (float*)pLocalData;
+	float *r10_x = (float *)((((size_t)(r00_x + dstWidth)) + 15) & ~15);
+	for (x = 0; x<dstWidth; x++){
+		r00_x[x] = r00 * x;
+		r10_x[x] = r10 * x;
+	}
+	bool bBoder = (const1 < 0) | (const2 < 0) | (const1 >= srcWidth) | (const2 >= srcHeight);
+	// check for (dstWidth, 0)
+	float x1 = (r00*dstWidth  + const1);
+	float y1 = (r10*dstWidth  + const2);
+	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
+	// check for (0, dstHeight)
+	x1 = (r01*dstHeight + const1);
+	y1 = (r11*dstHeight + const2);
+	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
+	// check for (dstWidth, dstHeight)
+	x1 = (r00*dstWidth + r01*dstHeight + const1);
+	y1 = (r10*dstWidth + r11*dstHeight + const2);
+	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
+
+	const __m256i srcb = _mm256_set1_epi32((srcHeight-1)*srcImageStrideInBytes - 1);
+	const __m256i src_s = _mm256_set1_epi32(srcImageStrideInBytes);
+
+	for (y = 0; y < dstHeight; y++)
+	{
+		// calculate (y*m[0][1] + m[0][2]) for x and y
+		__m256 xdest = _mm256_set1_ps(y*r01 + const1);
+		__m256 ydest = _mm256_set1_ps(y*r11 + const2);
+
+		for (x = 0; x < dstWidth; x += 8)
+		{
+			bool fullStep = (dstWidth - x) > 4;
+			__m256 xmap, ymap;
+			if (fullStep) {
+				xmap = _mm256_loadu_ps(&r00_x[x]);
+				ymap = _mm256_loadu_ps(&r10_x[x]);
+			}
+			else {
+				xmap = _mm256_insertf128_ps(zero, _mm_loadu_ps(&r00_x[x]), 0);
+				ymap = _mm256_insertf128_ps(zero, _mm_loadu_ps(&r10_x[x]), 0);
+			}
+			xmap = _mm256_add_ps(xmap, xdest);
+			ymap = _mm256_add_ps(ymap, ydest);
+
+			// convert to integer with rounding towards zero
+			__m256i xint = _mm256_cvttps_epi32(xmap);
+			__m256i yint = _mm256_cvttps_epi32(ymap);
+			__m256 xFraction = _mm256_sub_ps(xmap, _mm256_cvtepi32_ps(xint));
+			__m256 yFraction = _mm256_sub_ps(ymap, _mm256_cvtepi32_ps(yint));
+			__m256 one_minus_xFraction = _mm256_sub_ps(oneFloat, xFraction);
+			__m256 one_minus_yFraction = _mm256_sub_ps(oneFloat, yFraction);
+
+			__m256i p0, p2, mask = zeromask;
+			if (bBoder) {
+				mask = _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(xmap, zero, _CMP_GE_OS), _mm256_cmp_ps(xmap, srcbx, _CMP_LT_OS)));
+				mask = _mm256_and_si256(mask, _mm256_castps_si256(_mm256_cmp_ps(ymap, zero, _CMP_GE_OS)));
+				mask = _mm256_and_si256(mask, _mm256_castps_si256(_mm256_cmp_ps(ymap, srcby, _CMP_LT_OS)));
+				// clip for boundary
+				yint = _mm256_add_epi32(_mm256_mullo_epi32(yint, src_s), xint);
+				yint = _mm256_max_epi32(_mm256_min_epi32(yint, srcb), zeromask);
+				p0 = _mm256_i32gather_epi32((const int *)pSrcImage, yint, 1);
+				p2 = _mm256_i32gather_epi32((const int *)(pSrcImage + srcImageStrideInBytes), yint, 1);
+			}
+			else {
+				yint = _mm256_add_epi32(_mm256_mullo_epi32(yint, src_s), xint);
+				__m256i lanes = fullStep ? _mm256_set1_epi32(-1) : lowHalf;
+				p0 = _mm256_mask_i32gather_epi32(zeromask, (const int *)pSrcImage, yint, lanes, 1);
+				p2 = _mm256_mask_i32gather_epi32(zeromask, (const int *)(pSrcImage + srcImageStrideInBytes), yint, lanes, 1);
+			}
+
+			// get p0, p1, p2, p3 by masking and shifting
+			__m256i p1 = _mm256_and_si256(_mm256_srli_epi32(p0, 8), p0mask);
+			__m256i p3 = _mm256_and_si256(_mm256_srli_epi32(p2, 8), p0mask);
+			p0 = _mm256_and_si256(p0, p0mask);
+			p2 = _mm256_and_si256(p2, p0mask);
+
+			__m256 p0_f = _mm256_cvtepi32_ps(p0);
+			__m256 p1_f = _mm256_cvtepi32_ps(p1);
+			__m256 p2_f = _mm256_cvtepi32_ps(p2);
+			__m256 p3_f = _mm256_cvtepi32_ps(p3);
+
+			p0_f = _mm256_mul_ps(_mm256_mul_ps(p0_f, one_minus_xFraction), one_minus_yFraction);
+			p1_f = _mm256_mul_ps(_mm256_mul_ps(p1_f, xFraction), one_minus_yFraction);
+			p2_f = _mm256_mul_ps(_mm256_mul_ps(p2_f, one_minus_xFraction), yFraction);
+			p3_f = _mm256_mul_ps(_mm256_mul_ps(p3_f, xFraction), yFraction);
+
+			p0_f = _mm256_add_ps(p0_f, p1_f);
+			p2_f = _mm256_add_ps(p2_f, p3_f);
+			p0_f = _mm256_add_ps(p0_f, p2_f);
+			p0 = _mm256_cvtps_epi32(p0_f);
+			if (bBoder) {
+				// mask for boundary
+				p0 = _mm256_and_si256(mask, p0);
+			}
+
+			// convert to unsigned char and write to dst
+			p0 = _mm256_packus_epi32(p0, zeromask);
+			p0 = _mm256_packus_epi16(p0, zeromask);
+			p0 = _mm256_permutevar8x32_epi32(p0, order);
+			if (fullStep)
+				_mm_storel_epi64((__m128i *)(pDstImage + x), _mm256_castsi256_si128(p0));
+			else
+				*(unsigned int *)(pDstImage + x) = (unsigned int)_mm_cvtsi128_si32(_mm256_castsi256_si128(p0));
+		}
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+/* Same blend as HafCpu_GeometricTable_U8_U8, with the 2x2 neighborhoods of 8 pixels fetched by two 32-bit gathers:
+   the top row at offset and the bottom row at offset + stride - 2, so that no gather reads past the neighborhood */
+int HafCpu_GeometricTable_U8_U8_AVX2
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		vx_uint8                    * pDstImage,
+		vx_uint32                     dstImageStrideInBytes,
+		vx_uint8                    * pSrcImage,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint8                      border
+	)
+{
+	const __m256i pborder = _mm256_set1_epi8((char)border);
+	const __m256i c128 = _mm256_set1_epi32(128);
+	const __m256i bias = _mm256_set1_epi8((char)0x80);
+	const __m256i cFF = _mm256_set1_epi32(0xFF);
+	const __m256i bits = _mm256_set1_epi32(0x08040201);
+	const __m256i round = _mm256_set1_epi32((128 << 14) + (1 << 13));
+	const __m256i outsideShuffle = _mm256_setr_epi8(1, 1, 1, 1, 5, 5, 5, 5, 9, 9, 9, 9, 13, 13, 13, 13,
+		1, 1, 1, 1, 5, 5, 5, 5, 9, 9, 9, 9, 13, 13, 13, 13);
+	const int * pSrcRow0 = (const int *)pSrcImage;
+	const int * pSrcRow1 = (const int *)(pSrcImage + srcImageStrideInBytes - 2);
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const ago_geometric_table_entry_t * entry = (const ago_geometric_table_entry_t *)((vx_uint8 *)pTable + y * tableStrideInBytes);
+		vx_uint8 * pDst = pDstImage + y * dstImageStrideInBytes;
+		vx_uint32 x = 0;
+		for (; x + 8 <= dstWidth; x += 8, entry += 8) {
+			// de-interleave the offsets and weights of 8 entries
+			__m256 e0 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *)entry));
+			__m256 e1 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *)(entry + 4)));
+			__m256i offsets = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(e0, e1, _MM_SHUFFLE(2, 0, 2, 0))), 0xD8);
+			__m256i weights = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(e0, e1, _MM_SHUFFLE(3, 1, 3, 1))), 0xD8);
+			__m256i pix = _mm256_blend_epi16(_mm256_i32gather_epi32(pSrcRow0, offsets, 1), _mm256_i32gather_epi32(pSrcRow1, offsets, 1), 0xAA);
+			__m256i fx = _mm256_and_si256(weights, cFF);
+			__m256i fy = _mm256_and_si256(_mm256_srli_epi32(weights, 16), cFF);
+			__m256i wx = _mm256_or_si256(_mm256_sub_epi32(c128, fx), _mm256_slli_epi32(fx, 8));
+			wx = _mm256_or_si256(wx, _mm256_slli_epi32(wx, 16));
+			__m256i wy = _mm256_or_si256(_mm256_sub_epi32(c128, fy), _mm256_slli_epi32(fy, 16));
+			__m256i outside = _mm256_shuffle_epi8(weights, outsideShuffle);
+			outside = _mm256_cmpeq_epi8(_mm256_and_si256(outside, bits), bits);
+			pix = _mm256_xor_si256(_mm256_blendv_epi8(pix, pborder, outside), bias);
+			__m256i sum = _mm256_madd_epi16(_mm256_maddubs_epi16(wx, pix), wy);
+			sum = _mm256_srli_epi32(_mm256_add_epi32(sum, round), 14);
+			sum = _mm256_packus_epi32(sum, sum);
+			sum = _mm256_packus_epi16(sum, sum);
+			_mm_storel_epi64((__m128i *)(pDst + x), _mm_unpacklo_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+		}
+		for (; x < dstWidth; x++, entry++) {
+			const vx_uint8 * p = pSrcImage + entry->offset;
+			int p00 = (entry->outside & 1) ? border : p[0];
+			int p01 = (entry->outside & 2) ? border : p[1];
+			int p10 = (entry->outside & 4) ? border : p[srcImageStrideInBytes];
+			int p11 = (entry->outside & 8) ? border : p[srcImageStrideInBytes + 1];
+			int r0 = p00 * (128 - entry->fx) + p01 * entry->fx;
+			int r1 = p10 * (128 - entry->fx) + p11 * entry->fx;
+			pDst[x] = (vx_uint8)((r0 * (128 - entry->fy) + r1 * entry->fy + (1 << 13)) >> 14);
+		}
+	}
+	return AGO_SUCCESS;
+}
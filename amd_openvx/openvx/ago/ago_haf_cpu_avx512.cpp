@@ -0,0 +1,602 @@
+/* 
+Copyright (c) 2015 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+
+// This file is compiled with AVX-512 (F and BW) code generation and is only reached through
+// g_hafCpuDispatch on CPUs that support AVX512BW. Keep it free of headers with inline functions
+// or static objects, so that no AVX-512 code can get linked into (or run from) the rest of the library.
+// Each kernel keeps the SSE4 prefix/postfix split and arithmetic so that the outputs are bit-exact.
+#include "ago_haf_cpu.h"
+#include <immintrin.h>
+
+#define AGO_SUCCESS     0 // same as in ago_internal.h
+
+extern unsigned char dataChannelExtract[];
+extern unsigned char dataColorConvert[];
+
+// the unmasked forms of the broadcast, extract, shift and convert intrinsics start from an undefined register in
+// the GCC headers, which -Wall reports as uninitialized: the zero-masked forms with every lane enabled are used instead
+#define ALL_LANES_8   ((__mmask8)0xff)
+#define ALL_LANES_16  ((__mmask16)0xffff)
+
+// lane k of the result is loaded from p[k]
+static inline __m512i loadu4_si512(const vx_uint8 * p0, const vx_uint8 * p1, const vx_uint8 * p2, const vx_uint8 * p3)
+{
+	__m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)p0));
+	v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)p1), 1);
+	v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)p2), 2);
+	return _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)p3), 3);
+}
+
+// lane k of v is stored at p[k]
+static inline void storeu4_si512(vx_uint8 * p0, vx_uint8 * p1, vx_uint8 * p2, vx_uint8 * p3, __m512i v)
+{
+	_mm512_mask_storeu_epi32(p0, (__mmask16)0x000f, v);
+	_mm_storeu_si128((__m128i *)p1, _mm512_maskz_extracti32x4_epi32(ALL_LANES_8, v, 1));
+	_mm_storeu_si128((__m128i *)p2, _mm512_maskz_extracti32x4_epi32(ALL_LANES_8, v, 2));
+	_mm_storeu_si128((__m128i *)p3, _mm512_maskz_extracti32x4_epi32(ALL_LANES_8, v, 3));
+}
+
+static inline __m512i broadcast_si512(const vx_uint8 * table, int index)
+{
+	return _mm512_maskz_broadcast_i32x4(ALL_LANES_16, _mm_load_si128((const __m128i *)table + index));
+}
+
+/* The SSE shuffle masks are applied to each 128-bit lane: lane k extracts pixels 16k..16k+15 */
+static inline int ChannelExtract_U8_U24_AVX512
+	(
+		int           pos,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~63;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m512i mask1 = broadcast_si512(dataChannelExtract, 4 + 3 * pos);
+	__m512i mask2 = broadcast_si512(dataChannelExtract, 5 + 3 * pos);
+	__m512i mask3 = broadcast_si512(dataChannelExtract, 6 + 3 * pos);
+	__m512i r0, r1, r2;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 64)
+		{
+			r0 = loadu4_si512(pLocalSrc, pLocalSrc + 48, pLocalSrc + 96, pLocalSrc + 144);
+			r1 = loadu4_si512(pLocalSrc + 16, pLocalSrc + 64, pLocalSrc + 112, pLocalSrc + 160);
+			r2 = loadu4_si512(pLocalSrc + 32, pLocalSrc + 80, pLocalSrc + 128, pLocalSrc + 176);
+			r0 = _mm512_shuffle_epi8(r0, mask1);
+			r1 = _mm512_shuffle_epi8(r1, mask2);
+			r2 = _mm512_shuffle_epi8(r2, mask3);
+			r0 = _mm512_or_si512(r0, r1);
+			r0 = _mm512_or_si512(r0, r2);
+			_mm512_storeu_si512((void *)pLocalDst, r0);
+
+			pLocalSrc += 192;
+			pLocalDst += 64;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = pLocalSrc[pos];
+			pLocalSrc += 3;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ChannelExtract_U8_U24_Pos0_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U24_AVX512(0, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U24_Pos1_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U24_AVX512(1, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U24_Pos2_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U24_AVX512(2, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+static inline int ChannelExtract_U8_U32_AVX512
+	(
+		int           pos,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~63;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 64)
+		{
+			// the truncating down-convert keeps the low byte of each pixel after the shift
+			for (int i = 0; i < 4; i++)
+			{
+				__m512i r = _mm512_loadu_si512((const void *)(pLocalSrc + 64 * i));
+				_mm_storeu_si128((__m128i *)(pLocalDst + 16 * i), _mm512_maskz_cvtepi32_epi8(ALL_LANES_16, _mm512_maskz_srli_epi32(ALL_LANES_16, r, 8 * pos)));
+			}
+
+			pLocalSrc += 256;
+			pLocalDst += 64;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = pLocalSrc[pos];
+			pLocalSrc += 4;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos0_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX512(0, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos1_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX512(1, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos2_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX512(2, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelExtract_U8_U32_Pos3_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return ChannelExtract_U8_U32_AVX512(3, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX_AVX512
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage0,
+		vx_uint32     srcImage0StrideInBytes,
+		vx_uint8    * pSrcImage1,
+		vx_uint32     srcImage1StrideInBytes,
+		vx_uint8    * pSrcImage2,
+		vx_uint32     srcImage2StrideInBytes,
+		vx_uint8    * pSrcImage3,
+		vx_uint32     srcImage3StrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~15;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m512i r, g, b, x;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc0 = pSrcImage0;
+		vx_uint8 * pLocalSrc1 = pSrcImage1;
+		vx_uint8 * pLocalSrc2 = pSrcImage2;
+		vx_uint8 * pLocalSrc3 = pSrcImage3;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 16)
+		{
+			r = _mm512_maskz_cvtepu8_epi32(ALL_LANES_16, _mm_loadu_si128((__m128i *)pLocalSrc0));
+			g = _mm512_maskz_cvtepu8_epi32(ALL_LANES_16, _mm_loadu_si128((__m128i *)pLocalSrc1));
+			b = _mm512_maskz_cvtepu8_epi32(ALL_LANES_16, _mm_loadu_si128((__m128i *)pLocalSrc2));
+			x = _mm512_maskz_cvtepu8_epi32(ALL_LANES_16, _mm_loadu_si128((__m128i *)pLocalSrc3));
+			r = _mm512_or_si512(r, _mm512_maskz_slli_epi32(ALL_LANES_16, g, 8));
+			b = _mm512_or_si512(_mm512_maskz_slli_epi32(ALL_LANES_16, b, 16), _mm512_maskz_slli_epi32(ALL_LANES_16, x, 24));
+			_mm512_storeu_si512((void *)pLocalDst, _mm512_or_si512(r, b));
+
+			pLocalSrc0 += 16;
+			pLocalSrc1 += 16;
+			pLocalSrc2 += 16;
+			pLocalSrc3 += 16;
+			pLocalDst += 64;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = *pLocalSrc0++;
+			*pLocalDst++ = *pLocalSrc1++;
+			*pLocalDst++ = *pLocalSrc2++;
+			*pLocalDst++ = *pLocalSrc3++;
+		}
+
+		pSrcImage0 += srcImage0StrideInBytes;
+		pSrcImage1 += srcImage1StrideInBytes;
+		pSrcImage2 += srcImage2StrideInBytes;
+		pSrcImage3 += srcImage3StrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ColorConvert_RGB_RGBX_AVX512
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~63;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m512i mask_1_1 = broadcast_si512(dataColorConvert, 8);
+	__m512i mask_1_2 = broadcast_si512(dataColorConvert, 9);
+	__m512i mask_2_2 = broadcast_si512(dataColorConvert, 10);
+	__m512i mask_2_3 = broadcast_si512(dataColorConvert, 11);
+	__m512i mask_3_3 = broadcast_si512(dataColorConvert, 12);
+	__m512i mask_3_4 = broadcast_si512(dataColorConvert, 13);
+	__m512i pixels1, pixels2, pixels3, pixels4;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 64)
+		{
+			pixels1 = loadu4_si512(pLocalSrc, pLocalSrc + 64, pLocalSrc + 128, pLocalSrc + 192);
+			pixels2 = loadu4_si512(pLocalSrc + 16, pLocalSrc + 80, pLocalSrc + 144, pLocalSrc + 208);
+			pixels3 = loadu4_si512(pLocalSrc + 32, pLocalSrc + 96, pLocalSrc + 160, pLocalSrc + 224);
+			pixels4 = loadu4_si512(pLocalSrc + 48, pLocalSrc + 112, pLocalSrc + 176, pLocalSrc + 240);
+
+			pixels4 = _mm512_or_si512(_mm512_shuffle_epi8(pixels4, mask_3_4), _mm512_shuffle_epi8(pixels3, mask_3_3));
+			pixels3 = _mm512_or_si512(_mm512_shuffle_epi8(pixels3, mask_2_3), _mm512_shuffle_epi8(pixels2, mask_2_2));
+			pixels2 = _mm512_or_si512(_mm512_shuffle_epi8(pixels2, mask_1_2), _mm512_shuffle_epi8(pixels1, mask_1_1));
+
+			storeu4_si512(pLocalDst, pLocalDst + 48, pLocalDst + 96, pLocalDst + 144, pixels2);
+			storeu4_si512(pLocalDst + 16, pLocalDst + 64, pLocalDst + 112, pLocalDst + 160, pixels3);
+			storeu4_si512(pLocalDst + 32, pLocalDst + 80, pLocalDst + 128, pLocalDst + 176, pixels4);
+
+			pLocalSrc += 256;
+			pLocalDst += 192;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = *pLocalSrc++;
+			*pLocalDst++ = *pLocalSrc++;
+			*pLocalDst++ = *pLocalSrc++;
+			pLocalSrc++;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ColorConvert_RGBX_RGB_AVX512
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int alignedWidth = dstWidth & ~63;
+	int postfixWidth = (int)dstWidth - alignedWidth;
+
+	__m512i mask_1_1 = broadcast_si512(dataColorConvert, 14);
+	__m512i mask_2_1 = broadcast_si512(dataColorConvert, 15);
+	__m512i mask_2_2 = broadcast_si512(dataColorConvert, 16);
+	__m512i mask_3_2 = broadcast_si512(dataColorConvert, 17);
+	__m512i mask_3_3 = broadcast_si512(dataColorConvert, 18);
+	__m512i mask_4_3 = broadcast_si512(dataColorConvert, 19);
+	__m512i mask_fill = broadcast_si512(dataColorConvert, 20);
+	__m512i pixels1, pixels2, pixels3, pixels4;
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int width = 0; width < alignedWidth; width += 64)
+		{
+			pixels1 = loadu4_si512(pLocalSrc, pLocalSrc + 48, pLocalSrc + 96, pLocalSrc + 144);
+			pixels2 = loadu4_si512(pLocalSrc + 16, pLocalSrc + 64, pLocalSrc + 112, pLocalSrc + 160);
+			pixels3 = loadu4_si512(pLocalSrc + 32, pLocalSrc + 80, pLocalSrc + 128, pLocalSrc + 176);
+
+			pixels4 = _mm512_shuffle_epi8(pixels3, mask_4_3);
+			pixels3 = _mm512_or_si512(_mm512_shuffle_epi8(pixels3, mask_3_3), _mm512_shuffle_epi8(pixels2, mask_3_2));
+			pixels2 = _mm512_or_si512(_mm512_shuffle_epi8(pixels2, mask_2_2), _mm512_shuffle_epi8(pixels1, mask_2_1));
+			pixels1 = _mm512_shuffle_epi8(pixels1, mask_1_1);
+
+			storeu4_si512(pLocalDst, pLocalDst + 64, pLocalDst + 128, pLocalDst + 192, _mm512_or_si512(pixels1, mask_fill));
+			storeu4_si512(pLocalDst + 16, pLocalDst + 80, pLocalDst + 144, pLocalDst + 208, _mm512_or_si512(pixels2, mask_fill));
+			storeu4_si512(pLocalDst + 32, pLocalDst + 96, pLocalDst + 160, pLocalDst + 224, _mm512_or_si512(pixels3, mask_fill));
+			storeu4_si512(pLocalDst + 48, pLocalDst + 112, pLocalDst + 176, pLocalDst + 240, _mm512_or_si512(pixels4, mask_fill));
+
+			pLocalSrc += 192;
+			pLocalDst += 256;
+		}
+
+		for (int width = 0; width < postfixWidth; width++)
+		{
+			*pLocalDst++ = *pLocalSrc++;					// R
+			*pLocalDst++ = *pLocalSrc++;					// G
+			*pLocalDst++ = *pLocalSrc++;					// B
+			*pLocalDst++ = (unsigned char)255;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+/* 3x3 filters: the prefix and postfix pixels up to 16-byte destination alignment are
+   computed with the same scalar code as the SSE versions, the aligned part in 64 and 16 pixel steps.
+   The function assumes at least one pixel padding on the top, left, right and bottom */
+static inline void Get3x3AlignedWidths(vx_uint32 dstWidth, vx_uint8 * pDstImage, int& prefixWidth, int& postfixWidth, int& alignedWidth)
+{
+	prefixWidth = intptr_t(pDstImage) & 15;
+	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	postfixWidth = ((int)dstWidth - prefixWidth) & 15;
+	alignedWidth = (int)dstWidth - prefixWidth - postfixWidth;
+}
+
+static inline int Morphology_U8_U8_3x3_AVX512
+	(
+		bool          isDilate,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int prefixWidth, postfixWidth, alignedWidth;
+	Get3x3AlignedWidths(dstWidth, pDstImage, prefixWidth, postfixWidth, alignedWidth);
+	int stride = (int)srcImageStrideInBytes;
+
+	auto op = [isDilate](vx_uint8 a, vx_uint8 b) -> vx_uint8 { return isDilate ? (a > b ? a : b) : (a < b ? a : b); };
+	auto op3x3 = [&](const vx_uint8 * p) -> vx_uint8 {
+		vx_uint8 temp1 = op(op(p[-stride - 1], p[-stride]), p[-stride + 1]);
+		vx_uint8 temp2 = op(op(p[-1], p[0]), p[1]);
+		temp1 = op(temp1, temp2);
+		temp2 = op(op(p[stride - 1], p[stride]), p[stride + 1]);
+		return op(temp1, temp2);
+	};
+	auto op_zmm = [isDilate](__m512i a, __m512i b) -> __m512i { return isDilate ? _mm512_max_epu8(a, b) : _mm512_min_epu8(a, b); };
+	auto op_xmm = [isDilate](__m128i a, __m128i b) -> __m128i { return isDilate ? _mm_max_epu8(a, b) : _mm_min_epu8(a, b); };
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int x = 0; x < prefixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = op3x3(pLocalSrc);
+
+		int x = 0;
+		for (; x + 64 <= alignedWidth; x += 64, pLocalSrc += 64, pLocalDst += 64)
+		{
+			__m512i row0 = _mm512_loadu_si512((const void *)(pLocalSrc - stride));
+			row0 = op_zmm(row0, _mm512_loadu_si512((const void *)(pLocalSrc - stride - 1)));
+			row0 = op_zmm(row0, _mm512_loadu_si512((const void *)(pLocalSrc - stride + 1)));
+			__m512i row1 = _mm512_loadu_si512((const void *)pLocalSrc);
+			row1 = op_zmm(row1, _mm512_loadu_si512((const void *)(pLocalSrc - 1)));
+			row1 = op_zmm(row1, _mm512_loadu_si512((const void *)(pLocalSrc + 1)));
+			__m512i row2 = _mm512_loadu_si512((const void *)(pLocalSrc + stride));
+			row2 = op_zmm(row2, _mm512_loadu_si512((const void *)(pLocalSrc + stride - 1)));
+			row2 = op_zmm(row2, _mm512_loadu_si512((const void *)(pLocalSrc + stride + 1)));
+			_mm512_storeu_si512((void *)pLocalDst, op_zmm(op_zmm(row0, row1), row2));
+		}
+		for (; x < alignedWidth; x += 16, pLocalSrc += 16, pLocalDst += 16)
+		{
+			__m128i row0 = _mm_loadu_si128((__m128i *)(pLocalSrc - stride));
+			row0 = op_xmm(row0, _mm_loadu_si128((__m128i *)(pLocalSrc - stride - 1)));
+			row0 = op_xmm(row0, _mm_loadu_si128((__m128i *)(pLocalSrc - stride + 1)));
+			__m128i row1 = _mm_loadu_si128((__m128i *)pLocalSrc);
+			row1 = op_xmm(row1, _mm_loadu_si128((__m128i *)(pLocalSrc - 1)));
+			row1 = op_xmm(row1, _mm_loadu_si128((__m128i *)(pLocalSrc + 1)));
+			__m128i row2 = _mm_loadu_si128((__m128i *)(pLocalSrc + stride));
+			row2 = op_xmm(row2, _mm_loadu_si128((__m128i *)(pLocalSrc + stride - 1)));
+			row2 = op_xmm(row2, _mm_loadu_si128((__m128i *)(pLocalSrc + stride + 1)));
+			_mm_store_si128((__m128i *)pLocalDst, op_xmm(op_xmm(row0, row1), row2));
+		}
+
+		for (int x = 0; x < postfixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = op3x3(pLocalSrc);
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Dilate_U8_U8_3x3_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return Morphology_U8_U8_3x3_AVX512(true, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_Erode_U8_U8_3x3_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes)
+{
+	return Morphology_U8_U8_3x3_AVX512(false, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+/* Box and Gaussian sum the 3x3 neighborhood directly in 16-bit lanes, see the AVX2 versions */
+static inline __m512i Sum3x3_AVX512(bool isGaussian, const vx_uint8 * p, int stride, __m512i& hi)
+{
+	const __m512i zero = _mm512_setzero_si512();
+	__m512i lo = _mm512_setzero_si512();
+	hi = _mm512_setzero_si512();
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			__m512i v = _mm512_loadu_si512((const void *)(p + y * stride + x));
+			__m512i vlo = _mm512_unpacklo_epi8(v, zero);
+			__m512i vhi = _mm512_unpackhi_epi8(v, zero);
+			if (isGaussian) {
+				unsigned int shift = (x == 0) + (y == 0);
+				vlo = _mm512_slli_epi16(vlo, shift);
+				vhi = _mm512_slli_epi16(vhi, shift);
+			}
+			lo = _mm512_add_epi16(lo, vlo);
+			hi = _mm512_add_epi16(hi, vhi);
+		}
+	}
+	return lo;
+}
+
+static inline __m128i Sum3x3_SSE(bool isGaussian, const vx_uint8 * p, int stride, __m128i& hi)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_setzero_si128();
+	hi = _mm_setzero_si128();
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			__m128i v = _mm_loadu_si128((__m128i *)(p + y * stride + x));
+			__m128i vlo = _mm_unpacklo_epi8(v, zero);
+			__m128i vhi = _mm_unpackhi_epi8(v, zero);
+			if (isGaussian) {
+				int shift = (x == 0) + (y == 0);
+				vlo = _mm_slli_epi16(vlo, shift);
+				vhi = _mm_slli_epi16(vhi, shift);
+			}
+			lo = _mm_add_epi16(lo, vlo);
+			hi = _mm_add_epi16(hi, vhi);
+		}
+	}
+	return lo;
+}
+
+static inline vx_uint32 Sum3x3(bool isGaussian, const vx_uint8 * p, int stride)
+{
+	vx_uint32 sum = 0;
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			vx_uint32 v = p[y * stride + x];
+			sum += isGaussian ? (v << ((x == 0) + (y == 0))) : v;
+		}
+	}
+	return sum;
+}
+
+static inline int Smooth_U8_U8_3x3_AVX512
+	(
+		bool          isGaussian,
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	int prefixWidth, postfixWidth, alignedWidth;
+	Get3x3AlignedWidths(dstWidth, pDstImage, prefixWidth, postfixWidth, alignedWidth);
+	int stride = (int)srcImageStrideInBytes;
+
+	// box: multiply by ceil((2^16)/9) in the vector code and divide in float in the scalar code, same as SSE
+	const __m512i divFactor_zmm = _mm512_set1_epi16((short)7282);
+	const __m128i divFactor_xmm = _mm_set1_epi16((short)7282);
+	auto scalar = [isGaussian](vx_uint32 sum) -> vx_uint8 { return isGaussian ? (vx_uint8)(sum >> 4) : (vx_uint8)((float)sum / 9.0f); };
+
+	for (int height = 0; height < (int)dstHeight; height++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage;
+		vx_uint8 * pLocalDst = pDstImage;
+
+		for (int x = 0; x < prefixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = scalar(Sum3x3(isGaussian, pLocalSrc, stride));
+
+		int x = 0;
+		for (; x + 64 <= alignedWidth; x += 64, pLocalSrc += 64, pLocalDst += 64)
+		{
+			__m512i hi, lo = Sum3x3_AVX512(isGaussian, pLocalSrc, stride, hi);
+			if (isGaussian) {
+				lo = _mm512_srli_epi16(lo, 4);
+				hi = _mm512_srli_epi16(hi, 4);
+			}
+			else {
+				lo = _mm512_mulhi_epi16(lo, divFactor_zmm);
+				hi = _mm512_mulhi_epi16(hi, divFactor_zmm);
+			}
+			_mm512_storeu_si512((void *)pLocalDst, _mm512_packus_epi16(lo, hi));
+		}
+		for (; x < alignedWidth; x += 16, pLocalSrc += 16, pLocalDst += 16)
+		{
+			__m128i hi, lo = Sum3x3_SSE(isGaussian, pLocalSrc, stride, hi);
+			if (isGaussian) {
+				lo = _mm_srli_epi16(lo, 4);
+				hi = _mm_srli_epi16(hi, 4);
+			}
+			else {
+				lo = _mm_mulhi_epi16(lo, divFactor_xmm);
+				hi = _mm_mulhi_epi16(hi, divFactor_xmm);
+			}
+			_mm_store_si128((__m128i *)pLocalDst, _mm_packus_epi16(lo, hi));
+		}
+
+		for (int x = 0; x < postfixWidth; x++, pLocalSrc++)
+			*pLocalDst++ = scalar(Sum3x3(isGaussian, pLocalSrc, stride));
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Box_U8_U8_3x3_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes, vx_uint8 * pScratch)
+{
+	return Smooth_U8_U8_3x3_AVX512(false, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
+
+int HafCpu_Gaussian_U8_U8_3x3_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes, vx_uint8 * pScratch)
+{
+	return Smooth_U8_U8_3x3_AVX512(true, dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes);
+}
@@ -2721,6 +2721,7 @@ int HafCpu_Convolve_S16_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -2816,10 +2817,10 @@ int HafCpu_Convolve_S16_U8_3xN
 				result0 = _mm_add_epi32(result0, temp0);
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -2842,6 +2843,7 @@ int HafCpu_Convolve_S16_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -2901,6 +2903,7 @@ int HafCpu_Convolve_U8_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -2995,10 +2998,10 @@ int HafCpu_Convolve_U8_U8_3xN
 				result0 = _mm_add_epi32(result0, temp0);
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3021,6 +3024,7 @@ int HafCpu_Convolve_U8_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3082,6 +3086,7 @@ int HafCpu_Convolve_S16_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3128,10 +3133,10 @@ int HafCpu_Convolve_S16_U8_5xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3154,6 +3159,7 @@ int HafCpu_Convolve_S16_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3213,6 +3219,7 @@ int HafCpu_Convolve_U8_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3259,10 +3266,10 @@ int HafCpu_Convolve_U8_U8_5xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3285,6 +3292,7 @@ int HafCpu_Convolve_U8_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3343,9 +3351,10 @@ int HafCpu_Convolve_S16_U8_7xN
 			{
 				for (int j = -3; j <= 3; j++)
 				{
-					temp += ((int)pLocalSrc[i*srcStride - j] * (int)convMatrix[idx--]);
+					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3392,10 +3401,10 @@ int HafCpu_Convolve_S16_U8_7xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3418,6 +3427,7 @@ int HafCpu_Convolve_S16_U8_7xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3477,6 +3487,7 @@ int HafCpu_Convolve_U8_U8_7xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3523,10 +3534,10 @@ int HafCpu_Convolve_U8_U8_7xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3549,6 +3560,7 @@ int HafCpu_Convolve_U8_U8_7xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3610,6 +3622,7 @@ int HafCpu_Convolve_S16_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3656,10 +3669,10 @@ int HafCpu_Convolve_S16_U8_9xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3682,6 +3695,7 @@ int HafCpu_Convolve_S16_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3741,6 +3755,7 @@ int HafCpu_Convolve_U8_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3787,10 +3802,10 @@ int HafCpu_Convolve_U8_U8_9xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = _mm_srai_epi32(result0, shift);
+			result1 = _mm_srai_epi32(result1, shift);
+			result2 = _mm_srai_epi32(result2, shift);
+			result3 = _mm_srai_epi32(result3, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3813,6 +3828,7 @@ int HafCpu_Convolve_U8_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp >>= shift;
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3826,6 +3842,254 @@ int HafCpu_Convolve_U8_U8_9xN
 	return AGO_SUCCESS;
 }
 
+// stores 8 int32 convolution sums after the arithmetic down shift, saturated to the destination type
+static inline void HafCpu_ConvolveStore8(vx_uint8 * pDst, __m128i sumL, __m128i sumH, __m128i shift)
+{
+	__m128i pix = _mm_packs_epi32(_mm_sra_epi32(sumL, shift), _mm_sra_epi32(sumH, shift));
+	_mm_storel_epi64((__m128i *)pDst, _mm_packus_epi16(pix, pix));
+}
+
+static inline void HafCpu_ConvolveStore8(vx_int16 * pDst, __m128i sumL, __m128i sumH, __m128i shift)
+{
+	_mm_storeu_si128((__m128i *)pDst, _mm_packs_epi32(_mm_sra_epi32(sumL, shift), _mm_sra_epi32(sumH, shift)));
+}
+
+static inline void HafCpu_ConvolveStore1(vx_uint8 * pDst, vx_int32 sum, vx_int32 shift)
+{
+	*pDst = (vx_uint8)max(min(sum >> shift, 255), 0);
+}
+
+static inline void HafCpu_ConvolveStore1(vx_int16 * pDst, vx_int32 sum, vx_int32 shift)
+{
+	*pDst = (vx_int16)max(min(sum >> shift, 32767), -32768);
+}
+
+// multiplies 8 U8 pixels with a 16-bit coefficient and accumulates the exact 32-bit products
+static inline void HafCpu_ConvolveMulAdd8(__m128i& sumL, __m128i& sumH, const vx_uint8 * pSrc, __m128i coeff)
+{
+	__m128i pix = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)pSrc));
+	__m128i lo = _mm_mullo_epi16(pix, coeff);
+	__m128i hi = _mm_mulhi_epi16(pix, coeff);
+	sumL = _mm_add_epi32(sumL, _mm_unpacklo_epi16(lo, hi));
+	sumH = _mm_add_epi32(sumH, _mm_unpackhi_epi16(lo, hi));
+}
+
+/* Direct convolution with any odd convolutionWidth x convolutionHeight matrix.
+Only the columns [M, dstWidth-M) are computed, so that no pixels outside the source rows are read;
+the border columns are left unmodified (border mode undefined).
+*/
+template <typename T>
+static int HafCpu_Convolve_MxN
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		T           * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * convMatrix,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift
+	)
+{
+	vx_uint32 M = convolutionWidth >> 1, N = convolutionHeight >> 1;
+	if (dstWidth <= 2 * M)
+		return AGO_SUCCESS;
+	vx_uint32 xEnd = dstWidth - M;
+	vx_int16 * pLastCoeff = convMatrix + convolutionWidth * convolutionHeight - 1;
+	__m128i shiftReg = _mm_cvtsi32_si128(shift);
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		T * pDst = (T *)((vx_uint8 *)pDstImage + y * dstImageStrideInBytes);
+		// pSrc points to the top-left tap of the first interior column
+		vx_uint8 * pSrc = pSrcImage + y * srcImageStrideInBytes - N * srcImageStrideInBytes;
+		vx_uint32 x = M;
+		for (; x + 8 <= xEnd; x += 8) {
+			__m128i sumL = _mm_setzero_si128(), sumH = _mm_setzero_si128();
+			vx_int16 * pCoeff = pLastCoeff;
+			for (vx_uint32 i = 0; i < convolutionHeight; i++) {
+				for (vx_uint32 j = 0; j < convolutionWidth; j++) {
+					HafCpu_ConvolveMulAdd8(sumL, sumH, pSrc + i * srcImageStrideInBytes + x - M + j, _mm_set1_epi16(*pCoeff--));
+				}
+			}
+			HafCpu_ConvolveStore8(pDst + x, sumL, sumH, shiftReg);
+		}
+		for (; x < xEnd; x++) {
+			vx_int32 sum = 0;
+			vx_int16 * pCoeff = pLastCoeff;
+			for (vx_uint32 i = 0; i < convolutionHeight; i++) {
+				for (vx_uint32 j = 0; j < convolutionWidth; j++) {
+					sum += (vx_int32)pSrc[i * srcImageStrideInBytes + x - M + j] * (vx_int32)*pCoeff--;
+				}
+			}
+			HafCpu_ConvolveStore1(pDst + x, sum, shift);
+		}
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Convolve_U8_U8_MxN
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * convMatrix,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift
+	)
+{
+	return HafCpu_Convolve_MxN(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes,
+		convMatrix, convolutionWidth, convolutionHeight, shift);
+}
+
+int HafCpu_Convolve_S16_U8_MxN
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * convMatrix,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift
+	)
+{
+	return HafCpu_Convolve_MxN(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes,
+		convMatrix, convolutionWidth, convolutionHeight, shift);
+}
+
+// horizontal pass of the separable convolution: pRow[x] = sum(rowCoeff[j] * pSrc[x + j]) for x in [0, width)
+static inline void HafCpu_ConvolveSeparable_Row(vx_int32 * pRow, const vx_uint8 * pSrc, vx_uint32 width, const vx_int16 * rowCoeff, vx_uint32 convolutionWidth)
+{
+	vx_uint32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m128i sumL = _mm_setzero_si128(), sumH = _mm_setzero_si128();
+		for (vx_uint32 j = 0; j < convolutionWidth; j++) {
+			HafCpu_ConvolveMulAdd8(sumL, sumH, pSrc + x + j, _mm_set1_epi16(rowCoeff[j]));
+		}
+		_mm_storeu_si128((__m128i *)(pRow + x), sumL);
+		_mm_storeu_si128((__m128i *)(pRow + x + 4), sumH);
+	}
+	for (; x < width; x++) {
+		vx_int32 sum = 0;
+		for (vx_uint32 j = 0; j < convolutionWidth; j++)
+			sum += (vx_int32)pSrc[x + j] * (vx_int32)rowCoeff[j];
+		pRow[x] = sum;
+	}
+}
+
+/* Separable convolution with a rank-1 matrix given by its (flipped) row and column factors:
+	dst(x,y) = (sum_i colCoeff[i] * sum_j rowCoeff[j] * src(x-M+j, y-N+i)) >> shift
+The image is processed in column tiles of CONFIG_CPU_CONVOLVE_TILE_WIDTH pixels: each source row of a tile is
+filtered horizontally once into a ring of convolutionHeight 32-bit rows (pRing), that stays in L1 cache, and every
+output row is the vertical pass over the ring. The sums are exactly those of the direct convolution.
+Only the columns [M, dstWidth-M) are computed, the border columns are left unmodified (border mode undefined).
+*/
+template <typename T>
+static int HafCpu_ConvolveSeparable
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		T           * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * rowCoeff,
+		vx_uint32     convolutionWidth,
+		vx_int16    * colCoeff,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_int32    * pRing
+	)
+{
+	vx_uint32 M = convolutionWidth >> 1, N = convolutionHeight >> 1;
+	if (dstWidth <= 2 * M)
+		return AGO_SUCCESS;
+	vx_uint32 xEnd = dstWidth - M;
+	__m128i shiftReg = _mm_cvtsi32_si128(shift);
+	for (vx_uint32 x0 = M; x0 < xEnd; x0 += CONFIG_CPU_CONVOLVE_TILE_WIDTH) {
+		vx_uint32 tileWidth = min(xEnd - x0, (vx_uint32)CONFIG_CPU_CONVOLVE_TILE_WIDTH);
+		// ring row s holds the horizontal pass of source row s-N of the tile, in slot s % convolutionHeight
+		vx_uint8 * pSrcTile = pSrcImage + x0 - M - N * srcImageStrideInBytes;
+		for (vx_uint32 s = 0; s < convolutionHeight - 1; s++) {
+			HafCpu_ConvolveSeparable_Row(pRing + s * CONFIG_CPU_CONVOLVE_TILE_WIDTH, pSrcTile + s * srcImageStrideInBytes, tileWidth, rowCoeff, convolutionWidth);
+		}
+		for (vx_uint32 y = 0; y < dstHeight; y++) {
+			vx_uint32 s = y + convolutionHeight - 1;
+			HafCpu_ConvolveSeparable_Row(pRing + (s % convolutionHeight) * CONFIG_CPU_CONVOLVE_TILE_WIDTH, pSrcTile + s * srcImageStrideInBytes, tileWidth, rowCoeff, convolutionWidth);
+			T * pDst = (T *)((vx_uint8 *)pDstImage + y * dstImageStrideInBytes) + x0;
+			vx_uint32 slot0 = y % convolutionHeight;
+			vx_uint32 x = 0;
+			for (; x + 8 <= tileWidth; x += 8) {
+				__m128i sumL = _mm_setzero_si128(), sumH = _mm_setzero_si128();
+				for (vx_uint32 i = 0, slot = slot0; i < convolutionHeight; i++) {
+					const vx_int32 * pRow = pRing + slot * CONFIG_CPU_CONVOLVE_TILE_WIDTH + x;
+					__m128i coeff = _mm_set1_epi32(colCoeff[i]);
+					sumL = _mm_add_epi32(sumL, _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)pRow), coeff));
+					sumH = _mm_add_epi32(sumH, _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(pRow + 4)), coeff));
+					if (++slot == convolutionHeight) slot = 0;
+				}
+				HafCpu_ConvolveStore8(pDst + x, sumL, sumH, shiftReg);
+			}
+			for (; x < tileWidth; x++) {
+				vx_int32 sum = 0;
+				for (vx_uint32 i = 0, slot = slot0; i < convolutionHeight; i++) {
+					sum += pRing[slot * CONFIG_CPU_CONVOLVE_TILE_WIDTH + x] * (vx_int32)colCoeff[i];
+					if (++slot == convolutionHeight) slot = 0;
+				}
+				HafCpu_ConvolveStore1(pDst + x, sum, shift);
+			}
+		}
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ConvolveSeparable_U8_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * rowCoeff,
+		vx_uint32     convolutionWidth,
+		vx_int16    * colCoeff,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_int32    * pRing
+	)
+{
+	return HafCpu_ConvolveSeparable(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes,
+		rowCoeff, convolutionWidth, colCoeff, convolutionHeight, shift, pRing);
+}
+
+int HafCpu_ConvolveSeparable_S16_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * rowCoeff,
+		vx_uint32     convolutionWidth,
+		vx_int16    * colCoeff,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_int32    * pRing
+	)
+{
+	return HafCpu_ConvolveSeparable(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes,
+		rowCoeff, convolutionWidth, colCoeff, convolutionHeight, shift, pRing);
+}
+
 static inline void CompareAndSwap(__m128i& p1, __m128i& p2)
 {
 	__m128i First = _mm_min_epu8(p1, p2);
@@ -1856,6 +1856,204 @@ vx_uint8				 * pLocalData
 	return AGO_SUCCESS;
 }
 
+/*
+Table-driven bilinear geometric kernels
+The source coordinates of every destination pixel are converted once into a coordinate/weight table
+(ago_geometric_table_entry_t) that HafCpu_GeometricTable_U8_U8 then applies to each frame. Each entry
+addresses a 2x2 neighborhood clamped into the source image, so that all reads are in bounds; a neighbor
+that lies outside the image is flagged and replaced by the border value. When the neighborhood had to be
+shifted to stay inside, the column (row) weights are swapped so that the flagged neighbor gets the weight
+of the missing pixel. The weights have 7 bits of fraction. The source image must be at least 2x2 pixels.
+*/
+static inline void HafCpu_GeometricTableEntry
+	(
+		ago_geometric_table_entry_t * entry,
+		vx_int32                      x,
+		vx_int32                      fx,
+		vx_int32                      y,
+		vx_int32                      fy,
+		vx_int32                      srcWidth,
+		vx_int32                      srcHeight,
+		vx_uint32                     srcImageStrideInBytes
+	)
+{
+	vx_uint32 outside = 0;
+	if (x < -1 || x >= srcWidth || y < -1 || y >= srcHeight) {
+		x = y = fx = fy = 0;
+		outside = 15;
+	}
+	else {
+		if (x < 0) {
+			x = 0; fx = 128 - fx; outside |= 10;
+		}
+		else if (x == srcWidth - 1) {
+			x--; fx = 128 - fx; outside |= 5;
+		}
+		if (y < 0) {
+			y = 0; fy = 128 - fy; outside |= 12;
+		}
+		else if (y == srcHeight - 1) {
+			y--; fy = 128 - fy; outside |= 3;
+		}
+	}
+	entry->offset = y * (vx_int32)srcImageStrideInBytes + x;
+	entry->fx = (vx_uint8)fx;
+	entry->outside = (vx_uint8)outside;
+	entry->fy = (vx_uint8)fy;
+	entry->reserved = 0;
+}
+
+/*
+The map table has mapFractionalBits (0..3) bits of fraction. A 0xffff coordinate marks a pixel outside the source
+image: with invalidAsBorder it takes the border value, otherwise the coordinate is replaced by 1 like in
+HafCpu_Remap_U8_U8_Bilinear (HafCpu_Remap_U8_U8_Bilinear_Constant uses the border value only for 0xffff in x). With 3 bits of fraction the results are the same as HafCpu_Remap_U8_U8_Bilinear,
+except for the coordinates with a fraction in the last column (row) and the coordinates beyond the image: the
+old kernel reads past the edge of the image there, the table uses the border value for the missing neighbors.
+*/
+int HafCpu_GeometricTable_Remap
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint32                     srcWidth,
+		vx_uint32                     srcHeight,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_coord2d_ushort_t        * pMap,
+		vx_uint32                     mapStrideInBytes,
+		vx_uint32                     mapFractionalBits,
+		vx_bool                       invalidAsBorder
+	)
+{
+	vx_int32 fracMask = (1 << mapFractionalBits) - 1, fracShift = 7 - mapFractionalBits;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		ago_geometric_table_entry_t * entry = (ago_geometric_table_entry_t *)((vx_uint8 *)pTable + y * tableStrideInBytes);
+		ago_coord2d_ushort_t * map = (ago_coord2d_ushort_t *)((vx_uint8 *)pMap + y * mapStrideInBytes);
+		for (vx_uint32 x = 0; x < dstWidth; x++, entry++, map++) {
+			vx_int32 mx = map->x, my = map->y;
+			if (!invalidAsBorder) {
+				if (mx == 0xffff) mx = 1 << mapFractionalBits;
+				if (my == 0xffff) my = 1 << mapFractionalBits;
+			}
+			if (mx == 0xffff || my == 0xffff)
+				HafCpu_GeometricTableEntry(entry, -2, 0, -2, 0, srcWidth, srcHeight, srcImageStrideInBytes);
+			else
+				HafCpu_GeometricTableEntry(entry, mx >> mapFractionalBits, (mx & fracMask) << fracShift, my >> mapFractionalBits, (my & fracMask) << fracShift,
+					srcWidth, srcHeight, srcImageStrideInBytes);
+		}
+	}
+	return AGO_SUCCESS;
+}
+
+/*
+Same mapping as HafCpu_WarpPerspective_U8_U8_Bilinear, with the source coordinates rounded to 1/128 pixel.
+dstY is the destination row of the first table row.
+*/
+int HafCpu_GeometricTable_WarpPerspective
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		vx_uint32                     dstY,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint32                     srcWidth,
+		vx_uint32                     srcHeight,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_perspective_matrix_t    * matrix
+	)
+{
+	const float a = matrix->matrix[0][0], d = matrix->matrix[0][1], g = matrix->matrix[0][2];
+	const float b = matrix->matrix[1][0], e = matrix->matrix[1][1], h = matrix->matrix[1][2];
+	const float c = matrix->matrix[2][0], f = matrix->matrix[2][1], i = matrix->matrix[2][2];
+	for (vx_uint32 y = dstY; y < dstY + dstHeight; y++) {
+		ago_geometric_table_entry_t * entry = (ago_geometric_table_entry_t *)((vx_uint8 *)pTable + (y - dstY) * tableStrideInBytes);
+		float xdest = y * b + c, ydest = y * e + f, zdest = y * h + i;
+		for (vx_uint32 x = 0; x < dstWidth; x++, entry++) {
+			float z = 1.0f / (g * x + zdest);
+			float xmap = (a * x + xdest) * z;
+			float ymap = (d * x + ydest) * z;
+			// the range check also rejects NaN coordinates
+			if (!(xmap > -2.0f && xmap < (float)srcWidth + 1.0f && ymap > -2.0f && ymap < (float)srcHeight + 1.0f))
+				HafCpu_GeometricTableEntry(entry, -2, 0, -2, 0, srcWidth, srcHeight, srcImageStrideInBytes);
+			else {
+				vx_int32 xfp = (vx_int32)floorf(xmap * 128.0f + 0.5f), yfp = (vx_int32)floorf(ymap * 128.0f + 0.5f);
+				HafCpu_GeometricTableEntry(entry, xfp >> 7, xfp & 127, yfp >> 7, yfp & 127, srcWidth, srcHeight, srcImageStrideInBytes);
+			}
+		}
+	}
+	return AGO_SUCCESS;
+}
+
+// blends the 2x2 neighborhoods of 4 pixels: pix has the bytes [top-left, top-right, bottom-left, bottom-right] of each
+// pixel and weights the second word of its table entry; returns the 32-bit results.
+// The pixels are biased to signed bytes, so that the 8-bit weights (128-fx, fx) fit the unsigned operand of maddubs.
+static inline __m128i HafCpu_GeometricTableBlend4(__m128i pix, __m128i weights, __m128i border)
+{
+	const __m128i c128 = _mm_set1_epi32(128);
+	const __m128i cFF = _mm_set1_epi32(0xFF);
+	const __m128i bits = _mm_set1_epi32(0x08040201);
+	__m128i fx = _mm_and_si128(weights, cFF);
+	__m128i fy = _mm_and_si128(_mm_srli_epi32(weights, 16), cFF);
+	__m128i wx = _mm_or_si128(_mm_sub_epi32(c128, fx), _mm_slli_epi32(fx, 8));	// bytes [128-fx, fx, 0, 0]
+	wx = _mm_or_si128(wx, _mm_slli_epi32(wx, 16));								// bytes [128-fx, fx, 128-fx, fx]
+	__m128i wy = _mm_or_si128(_mm_sub_epi32(c128, fy), _mm_slli_epi32(fy, 16));	// words [128-fy, fy]
+	// replace the neighbors outside the image by the border value
+	__m128i outside = _mm_shuffle_epi8(weights, _mm_setr_epi8(1, 1, 1, 1, 5, 5, 5, 5, 9, 9, 9, 9, 13, 13, 13, 13));
+	outside = _mm_cmpeq_epi8(_mm_and_si128(outside, bits), bits);
+	pix = _mm_blendv_epi8(pix, border, outside);
+	pix = _mm_xor_si128(pix, _mm_set1_epi8((char)0x80));						// p - 128
+	__m128i sum = _mm_madd_epi16(_mm_maddubs_epi16(wx, pix), wy);
+	return _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32((128 << 14) + (1 << 13))), 14);
+}
+
+static inline vx_uint32 HafCpu_GeometricTableGather(const vx_uint8 * pSrc, vx_uint32 srcImageStrideInBytes, vx_int32 offset)
+{
+	return *(const vx_uint16 *)(pSrc + offset) | ((vx_uint32)*(const vx_uint16 *)(pSrc + offset + srcImageStrideInBytes) << 16);
+}
+
+int HafCpu_GeometricTable_U8_U8
+	(
+		vx_uint32                     dstWidth,
+		vx_uint32                     dstHeight,
+		vx_uint8                    * pDstImage,
+		vx_uint32                     dstImageStrideInBytes,
+		vx_uint8                    * pSrcImage,
+		vx_uint32                     srcImageStrideInBytes,
+		ago_geometric_table_entry_t * pTable,
+		vx_uint32                     tableStrideInBytes,
+		vx_uint8                      border
+	)
+{
+	const __m128i pborder = _mm_set1_epi8((char)border);
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const ago_geometric_table_entry_t * entry = (const ago_geometric_table_entry_t *)((vx_uint8 *)pTable + y * tableStrideInBytes);
+		vx_uint8 * pDst = pDstImage + y * dstImageStrideInBytes;
+		vx_uint32 x = 0;
+		for (; x + 4 <= dstWidth; x += 4, entry += 4) {
+			__m128 e01 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)entry));
+			__m128 e23 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)(entry + 2)));
+			__m128i weights = _mm_castps_si128(_mm_shuffle_ps(e01, e23, _MM_SHUFFLE(3, 1, 3, 1)));
+			__m128i pix = _mm_cvtsi32_si128(HafCpu_GeometricTableGather(pSrcImage, srcImageStrideInBytes, entry[0].offset));
+			pix = _mm_insert_epi32(pix, HafCpu_GeometricTableGather(pSrcImage, srcImageStrideInBytes, entry[1].offset), 1);
+			pix = _mm_insert_epi32(pix, HafCpu_GeometricTableGather(pSrcImage, srcImageStrideInBytes, entry[2].offset), 2);
+			pix = _mm_insert_epi32(pix, HafCpu_GeometricTableGather(pSrcImage, srcImageStrideInBytes, entry[3].offset), 3);
+			pix = HafCpu_GeometricTableBlend4(pix, weights, pborder);
+			pix = _mm_packus_epi32(pix, pix);
+			*(vx_uint32 *)(pDst + x) = (vx_uint32)_mm_cvtsi128_si32(_mm_packus_epi16(pix, pix));
+		}
+		for (; x < dstWidth; x++, entry++) {
+			const vx_uint8 * p = pSrcImage + entry->offset;
+			vx_int32 p00 = (entry->outside & 1) ? border : p[0];
+			vx_int32 p01 = (entry->outside & 2) ? border : p[1];
+			vx_int32 p10 = (entry->outside & 4) ? border : p[srcImageStrideInBytes];
+			vx_int32 p11 = (entry->outside & 8) ? border : p[srcImageStrideInBytes + 1];
+			vx_int32 r0 = p00 * (128 - entry->fx) + p01 * entry->fx;
+			vx_int32 r1 = p10 * (128 - entry->fx) + p11 * entry->fx;
+			pDst[x] = (vx_uint8)((r0 * (128 - entry->fy) + r1 * entry->fy + (1 << 13)) >> 14);
+		}
+	}
+	return AGO_SUCCESS;
+}
 
 int HafCpu_ScaleImage_U8_U8_Nearest
 (
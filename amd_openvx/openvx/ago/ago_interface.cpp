@@ -24,30 +24,42 @@ THE SOFTWARE.
 #include "ago_internal.h"
 #include <mutex>
 
-#if _WIN32
-static DWORD WINAPI agoGraphThreadFunction(LPVOID graph_)
-#else
-static void agoGraphThreadFunction(LPVOID graph_)
-#endif
+// runs the scheduled frames of a graph in order
+static void agoGraphScheduleThread(AgoGraph * graph)
 {
-	AgoGraph * graph = (AgoGraph *)graph_;
-	while (WaitForSingleObject(graph->hSemToThread, INFINITE) == WAIT_OBJECT_0) {
-		if (graph->threadThreadTerminationState)
+	std::unique_lock<std::mutex> lock(graph->scheduleMutex);
+	for (;;) {
+		graph->scheduleRequested.wait(lock, [graph] {
+			return graph->scheduleTerminate || graph->scheduleCompleteCount < graph->scheduleCount;
+		});
+		if (graph->scheduleTerminate)
 			break;
 
 		// execute graph
-		graph->status = agoProcessGraph(graph);
+		lock.unlock();
+		vx_status status = agoProcessGraph(graph);
+		lock.lock();
 
-		// inform caller
-		graph->threadExecuteCount++;
-		ReleaseSemaphore(graph->hSemFromThread, 1, nullptr);
+		// inform callers
+		graph->status = status;
+		graph->scheduleCompleteCount++;
+		if (status != VX_SUCCESS)
+			graph->scheduleFailures[graph->scheduleCompleteCount] = status;
+		graph->scheduleCompleted.notify_all();
+	}
+}
+
+// stops the schedule thread of a graph after its frame in flight
+static void agoStopGraphScheduleThread(AgoGraph * graph)
+{
+	if (graph->scheduleThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(graph->scheduleMutex);
+			graph->scheduleTerminate = true;
+		}
+		graph->scheduleRequested.notify_one();
+		graph->scheduleThread.join();
 	}
-	// inform caller about termination
-	graph->threadThreadTerminationState = 2;
-	ReleaseSemaphore(graph->hSemFromThread, 1, nullptr);
-#if _WIN32
-    return 0;
-#endif
 }
 
 AgoContext * agoCreateContextFromPlatform(struct _vx_platform * platform)
@@ -61,6 +73,21 @@ AgoContext * agoCreateContextFromPlatform(struct _vx_platform * platform)
 		return NULL;
 	}
 
+	// pick the HAF CPU kernels for the instruction set of this CPU: AGO_CPU_ISA can lower it
+	// (0: SSE4, 1: AVX2, 2: AVX-512BW) to compare or work around the wider kernels.
+	// the table is process-wide and read by graphs of other contexts, so it's set up only once
+	static std::once_flag dispatchTableInitialized;
+	std::call_once(dispatchTableInitialized, []() {
+		int cpuIsa = agoGetCpuInstructionSet();
+		char isaText[64];
+		if (agoGetEnvironmentVariable("AGO_CPU_ISA", isaText, sizeof(isaText))) {
+			int isaLimit = atoi(isaText);
+			if (isaLimit >= 0 && isaLimit < cpuIsa)
+				cpuIsa = isaLimit;
+		}
+		HafCpu_InitDispatchTable(cpuIsa);
+	});
+
 	// create context and initialize
 	AgoContext * acontext = new AgoContext;
 	if (acontext) {
@@ -80,7 +107,13 @@ AgoContext * agoCreateContextFromPlatform(struct _vx_platform * platform)
 		// initialize thread config
 		char textBuffer[1024];
 		if (agoGetEnvironmentVariable("AGO_THREAD_CONFIG", textBuffer, sizeof(textBuffer))) {
-			acontext->thread_config = atoi(textBuffer);
+			acontext->thread_config = (vx_uint32)strtoul(textBuffer, nullptr, 0);
+		}
+		if (acontext->thread_config & (CONFIG_THREAD_PARALLEL_NODES | CONFIG_THREAD_TILED_KERNELS)) {
+			size_t threadCount = (acontext->thread_config & CONFIG_THREAD_POOL_SIZE_MASK) >> CONFIG_THREAD_POOL_SIZE_SHIFT;
+			if (threadCount == 0)
+				threadCount = std::max(1u, std::thread::hardware_concurrency());
+			acontext->thread_pool = new AgoThreadPool(threadCount);
 		}
 	}
 	return (AgoContext *)acontext;
@@ -110,6 +143,7 @@ AgoGraph * agoCreateGraph(AgoContext * acontext)
 	// initialize
 	agoResetReference(&agraph->ref, VX_TYPE_GRAPH, acontext, NULL);
 	agraph->attr_affinity = acontext->attr_affinity;
+	agraph->enable_performance_profiling = acontext->enable_performance_profiling;
 	char textBuffer[256];
 	if (agoGetEnvironmentVariable("VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_FLAGS", textBuffer, sizeof(textBuffer))) {
 		if (sscanf(textBuffer, "%i", &agraph->optimizer_flags) == 1) {
@@ -123,25 +157,11 @@ AgoGraph * agoCreateGraph(AgoContext * acontext)
 		agraph->ref.external_count++;
 	}
 
-	if (acontext->thread_config & 1) {
-		// create semaphore and thread for graph scheduling: limit 1000 pending requests
-		agraph->hSemToThread = CreateSemaphore(nullptr, 0, 1000, nullptr);
-		agraph->hSemFromThread = CreateSemaphore(nullptr, 0, 1000, nullptr);
-		if (agraph->hSemToThread == NULL || agraph->hSemFromThread == NULL) { 
-			agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: CreateSemaphore() failed\n");
-			agoReleaseGraph(agraph); 
-			return nullptr; 
-		}
-		agraph->hThread = CreateThread(NULL, 0, agoGraphThreadFunction, agraph, 0, NULL);
-#if _WIN32 // TBD: need to enable this check for non-windows platforms
-		if (agraph->hThread == NULL) { 
-			agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: CreateThread() failed\n");
-			agoReleaseGraph(agraph); 
-			return nullptr; 
-		}
+	if (acontext->thread_config & CONFIG_THREAD_GRAPH_SCHEDULING) {
+		// create thread for graph scheduling: any number of frames can be scheduled
+		agraph->scheduleThread = std::thread(agoGraphScheduleThread, agraph);
 #if _DEBUG
 		agoAddLogEntry(&agraph->ref, VX_SUCCESS, "OK: enabled graph scheduling in separate threads\n");
-#endif
 #endif
 	}
 
@@ -150,29 +170,17 @@ AgoGraph * agoCreateGraph(AgoContext * acontext)
 
 int agoReleaseGraph(AgoGraph * agraph)
 {
+	if (agraph->ref.external_count == 1) {
+		// the frames in flight may need the graph and context locks: stop them before taking the locks
+		agoStopGraphScheduleThread(agraph);
+		agoStopGraphPipeline(agraph);
+	}
 	CAgoLock lock(agraph->ref.context->cs);
 
 	int status = 0;
 	agraph->ref.external_count--;
 	if (agraph->ref.external_count == 0) {
         EnterCriticalSection(&agraph->cs);
-        // stop graph thread
-        if (agraph->hThread) {
-            agraph->threadThreadTerminationState = 1;
-            ReleaseSemaphore(agraph->hSemToThread, 1, nullptr);
-            while (agraph->threadThreadTerminationState == 1) {
-                // give a chance for the thread to run in case it is waititng
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                ReleaseSemaphore(agraph->hSemToThread, 1, nullptr);
-            }
-            if (agraph->hSemToThread) {
-                CloseHandle(agraph->hSemToThread);
-            }
-            if (agraph->hSemFromThread) {
-                CloseHandle(agraph->hSemFromThread);
-            }
-            CloseHandle(agraph->hThread);
-        }
         // deinitialize the graph
         for (AgoNode * node = agraph->nodeList.head; node; node = node->next)
         {
@@ -587,6 +595,9 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 				}
 				data->name = arg[1];
 				agoAddData(data->isVirtual ? &agraph->dataList : &context->dataList, data);
+				if (!agraph->cache_file.empty()) {
+					agraph->cache_statements.push_back(std::string("data ") + arg[1] + " = " + arg[3]);
+				}
 				// if data has children (e.g., pyramid, delay, image), add them too
 				if (data->children) {
 					for (vx_uint32 i = 0; i < data->numChildren; i++) {
@@ -740,6 +751,11 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 							int index = atoi(&arg[2 + p][1]) - 1;
 							if (index >= 0 && index < num_ref) {
 								data = (AgoData *)ref[index];
+								// $N[i][j] picks a child of the argument (e.g., pyramid level or image plane)
+								for (const char * sub = strchr(arg[2 + p], '['); data && sub; sub = strchr(sub + 1, '[')) {
+									vx_int32 child = atoi(sub + 1);
+									data = (child >= 0 && child < (vx_int32)data->numChildren) ? data->children[child] : NULL;
+								}
 							}
 						}
 						else if (strcmp(arg[2 + p], "null") != 0) {
@@ -788,7 +804,8 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 								node->paramList[p] = data;
 								// check if specified data type is correct
 								// NOTE: kernel can specify to ignore this checking by setting argType[] to ZERO
-								if (akernel->argType[p] && (akernel->argType[p] != data->ref.type)) {
+								// NOTE: drama output in a compiled graph can use other types that are checked by the kernel validator
+								if (akernel->argType[p] && (akernel->argType[p] != data->ref.type) && !agraph->precompiled) {
 									char type_expected_buf[64], type_specified_buf[64];
 									const char * type_expected = agoEnum2Name(akernel->argType[p]);
 									const char * type_specified = agoEnum2Name(data->ref.type);
@@ -824,6 +841,9 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 					agraph->status = -1;
 					break;
 				}
+				if (!agraph->cache_file.empty()) {
+					agraph->cache_statements.push_back(std::string("import ") + module_name);
+				}
 			}
 			else if (narg == 3 && !strcmp(arg[0], "type") && !strncmp(arg[2], "userstruct:", 11)) {
 				vx_enum user_struct_id = 0;
@@ -837,6 +857,9 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 				if (agoAddUserStruct(context, size, name) == VX_TYPE_INVALID) {
 					agraph->status = -1;
 				}
+				if (!agraph->cache_file.empty()) {
+					agraph->cache_statements.push_back(std::string("type ") + name + " " + arg[2]);
+				}
 			}
 			else if (narg == 2 && !strcmp(arg[0], "def-macro")) {
 				char macro_name[256]; strncpy(macro_name, arg[1], sizeof(macro_name));
@@ -866,6 +889,8 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 					if (agraph->status)
 						break;
 					else {
+						// macros are not part of a compiled graph: don't cache the graph
+						agraph->cache_file.clear();
 						MacroData macro;
 						macro.text = macro.text_allocated = (char *)calloc(1, str_end - str_begin + 1);
 						strncpy(macro.name, macro_name, sizeof(macro.name) - 1);
@@ -993,6 +1018,8 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 					agraph->status = -1;
 					break;
 				}
+				// compiled graph can't replay new arguments: don't cache the graph
+				agraph->cache_file.clear();
 				// clear all previous arguments
 				for (int i = 0; i < num_ref; i++) {
 					// TBD handle memory leaks
@@ -1033,6 +1060,9 @@ static void agoReadGraphFromStringInternal(AgoGraph * agraph, AgoReference * * r
 					if (directive) {
 						agraph->status = agoDirective((vx_reference)data, directive);
 					}
+					if (!agraph->status && !agraph->cache_file.empty()) {
+						agraph->cache_statements.push_back(std::string("directive ") + name1 + " " + name2);
+					}
 				}
 				if (agraph->status) {
 					agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoReadGraph: line %d: invalid object or directive: directive %s %s\n>>>> %s\n", lineno, name1, name2, lineCopy);
@@ -1948,6 +1978,167 @@ int agoUpdateDelaySlots(AgoNode * node)
 	return 0;
 }
 
+// prepares a CPU node for execution: waits for the GPU work it depends on and synchronizes its inputs
+static int agoPrepareCpuNodeExecution(AgoGraph * graph, AgoNode * node, bool& opencl_buffer_access_enable, vx_uint32& nodeLaunchHierarchicalLevel)
+{
+	int status = VX_SUCCESS;
+#if ENABLE_OPENCL
+	opencl_buffer_access_enable |= (node->akernel->opencl_buffer_access_enable ? true : false);
+	if (!node->akernel->opencl_buffer_access_enable) {
+		agoPerfProfileEntry(graph, ago_profile_type_wait_begin, &node->ref);
+		if (nodeLaunchHierarchicalLevel > 0 && nodeLaunchHierarchicalLevel < node->hierarchical_level) {
+			status = agoWaitForNodesCompletion(graph);
+			if (status != VX_SUCCESS) {
+				agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoWaitForNodesCompletion failed (%d:%s)\n", status, agoEnum2Name(status));
+				return status;
+			}
+			nodeLaunchHierarchicalLevel = 0;
+		}
+		if(opencl_buffer_access_enable) {
+			cl_int err = clFinish(graph->opencl_cmdq);
+			if (err) {
+				agoAddLogEntry(NULL, VX_FAILURE, "ERROR: clFinish(graph) => %d\n", err);
+				return VX_FAILURE;
+			}
+			opencl_buffer_access_enable = false;
+		}
+		agoPerfProfileEntry(graph, ago_profile_type_wait_end, &node->ref);
+	}
+	agoPerfProfileEntry(graph, ago_profile_type_copy_begin, &node->ref);
+	// make sure that all input buffers are synched
+	if (node->akernel->opencl_buffer_access_enable) {
+		for (vx_uint32 i = 0; i < node->paramCount; i++) {
+			AgoData * data = node->paramList[i];
+			if (data && data->opencl_buffer &&
+				(node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
+			{
+				auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+				if (dataToSync->buffer_sync_flags & (AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE | AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT) &&
+				    dataToSync->opencl_buffer && !(dataToSync->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED))
+				{
+					status = agoDirective((vx_reference)dataToSync, VX_DIRECTIVE_AMD_COPY_TO_OPENCL);
+					if(status != VX_SUCCESS) {
+						agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDirective(*,VX_DIRECTIVE_AMD_COPY_TO_OPENCL) failed (%d:%s)\n", status, agoEnum2Name(status));
+						return status;
+					}
+				}
+			}
+		}
+	}
+	else {
+		// the inputs of all nodes of a CPU supernode are needed when its first node gets executed
+		std::vector<AgoNode *> syncNodeList(1, node);
+		if (node->cpu_supernode && node == node->cpu_supernode->nodeList.front())
+			syncNodeList = node->cpu_supernode->nodeList;
+		for (AgoNode * snode : syncNodeList) {
+			for (vx_uint32 i = 0; i < snode->paramCount; i++) {
+				AgoData * data = snode->paramList[i];
+				if (data && (snode->parameters[i].direction == VX_INPUT || snode->parameters[i].direction == VX_BIDIRECTIONAL)) {
+					auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+					status = agoDataSyncFromGpuToCpu(graph, snode, dataToSync);
+					for (vx_uint32 j = 0; !status && j < dataToSync->numChildren; j++) {
+						AgoData * jdata = dataToSync->children[j];
+						if (jdata)
+							status = agoDataSyncFromGpuToCpu(graph, snode, jdata);
+					}
+					if (status) {
+						agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDataSyncFromGpuToCpu failed (%d:%s) for node(%s) arg#%d data(%s)\n", status, agoEnum2Name(status), snode->akernel->name, i, data->name.c_str());
+						return status;
+					}
+				}
+			}
+		}
+	}
+	agoPerfProfileEntry(graph, ago_profile_type_copy_end, &node->ref);
+#endif
+	return status;
+}
+
+// runs the kernel of a CPU node
+static int agoExecuteCpuNodeKernel(AgoNode * node)
+{
+	AgoKernel * kernel = node->akernel;
+	int status = VX_SUCCESS;
+	if (kernel->func) {
+		status = kernel->func(node, ago_kernel_cmd_execute);
+		if (status == AGO_ERROR_KERNEL_NOT_IMPLEMENTED)
+			status = VX_ERROR_NOT_IMPLEMENTED;
+	}
+	else if (kernel->kernel_f) {
+		status = kernel->kernel_f(node, (vx_reference *)node->paramList, node->paramCount);
+	}
+	return status;
+}
+
+// runs the nodes of a CPU supernode back to back on one row strip at a time
+static int agoExecuteCpuSuperNode(AgoSuperNode * supernode)
+{
+	int status = VX_SUCCESS;
+	// the images come from the node parameters: the frames of a pipelined graph use their own
+	for (auto& param : supernode->stripParamList) {
+		param.data = param.node->paramList[param.index];
+	}
+	for (vx_uint32 y = 0; status == VX_SUCCESS && y < supernode->height; y += supernode->strip_height) {
+		vx_uint32 rows = min(supernode->strip_height, supernode->height - y);
+		for (auto& param : supernode->stripParamList) {
+			param.view->buffer = param.local ? param.data->buffer : param.data->buffer + y * param.data->u.img.stride_in_bytes;
+			param.view->u.img.height = rows;
+			param.view->u.img.rect_valid.end_y = rows;
+			param.node->paramList[param.index] = param.view;
+		}
+		for (AgoNode * node : supernode->nodeList) {
+			status = agoExecuteCpuNodeKernel(node);
+			if (status != VX_SUCCESS) {
+				agoAddLogEntry(&node->ref, status, "ERROR: kernel %s exec failed on rows %d..%d of CPU supernode\n", node->akernel->name, y, y + rows - 1);
+				break;
+			}
+		}
+		for (auto& param : supernode->stripParamList) {
+			param.node->paramList[param.index] = param.data;
+		}
+	}
+	return status;
+}
+
+// runs a CPU node: all nodes of a CPU supernode get executed with its first node
+static int agoExecuteCpuNode(AgoNode * node)
+{
+	if (!node->cpu_supernode)
+		return agoExecuteCpuNodeKernel(node);
+	else if (node == node->cpu_supernode->nodeList.front())
+		return agoExecuteCpuSuperNode(node->cpu_supernode);
+	return VX_SUCCESS;
+}
+
+// marks the outputs of an executed CPU node as dirty and invokes the node callback
+static int agoCompleteCpuNodeExecution(AgoGraph * graph, AgoNode * node)
+{
+#if ENABLE_OPENCL
+	// mark that node outputs are dirty
+	for (vx_uint32 i = 0; i < node->paramCount; i++) {
+		AgoData * data = node->paramList[i];
+		if (data && data->opencl_buffer &&
+			(node->parameters[i].direction == VX_OUTPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
+		{
+			auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+			dataToSync->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
+			dataToSync->buffer_sync_flags |=
+				((node->akernel->opencl_buffer_access_enable || data->u.img.enableUserBufferOpenCL)
+					? AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL
+					: AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE);
+		}
+	}
+#endif
+	// node callback
+	if (node->callback) {
+		vx_action action = node->callback(node);
+		if (action == VX_ACTION_ABANDON) {
+			return VX_ERROR_GRAPH_ABANDONED;
+		}
+	}
+	return VX_SUCCESS;
+}
+
 int agoExecuteGraph(AgoGraph * graph)
 {
 	if (graph->detectedInvalidNode) {
@@ -2012,11 +2203,15 @@ int agoExecuteGraph(AgoGraph * graph)
 	}
 #if ENABLE_OPENCL
 	graph->opencl_nodeListQueued.clear();
-	vx_uint32 nodeLaunchHierarchicalLevel = 0;
 	memset(&graph->opencl_perf, 0, sizeof(graph->opencl_perf));
 #endif
 	// execute one nodes in one hierarchical level at a time
+	vx_uint32 nodeLaunchHierarchicalLevel = 0;
 	bool opencl_buffer_access_enable = false;
+	AgoThreadPool * thread_pool = graph->ref.context->thread_pool;
+	std::vector<AgoNode *> cpuNodes;
+	std::vector<int> cpuNodeStatus;
+	std::vector<std::thread::id> cpuNodeThread;
 	for (auto enode = graph->nodeList.head; enode;) {
 		// get snode..enode with next hierarchical_level 
 		auto hierarchical_level = enode->hierarchical_level;
@@ -2057,113 +2252,64 @@ int agoExecuteGraph(AgoGraph * graph)
 		}
 #endif
 		// process CPU nodes at current hierarchical level
+		cpuNodes.clear();
 		for (auto node = snode; node != enode; node = node->next) {
-			if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU) {
+			if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU)
+				cpuNodes.push_back(node);
+		}
+		if (thread_pool && cpuNodes.size() > 1) {
+			// nodes at the same hierarchical level don't depend on each other: prepare them in order,
+			// run their kernels concurrently on the context thread pool and complete them in order
+			for (auto node : cpuNodes) {
+				status = agoPrepareCpuNodeExecution(graph, node, opencl_buffer_access_enable, nodeLaunchHierarchicalLevel);
+				if (status != VX_SUCCESS)
+					return status;
+			}
+			cpuNodeStatus.assign(cpuNodes.size(), VX_SUCCESS);
+			cpuNodeThread.resize(cpuNodes.size());
+			thread_pool->run(cpuNodes.size(), [&](size_t i) {
+				AgoNode * node = cpuNodes[i];
+				cpuNodeThread[i] = std::this_thread::get_id();
+				agoPerfCaptureStart(&node->perf);
+				cpuNodeStatus[i] = agoExecuteCpuNode(node);
+				if (cpuNodeStatus[i] == VX_SUCCESS)
+					agoPerfCaptureStop(&node->perf);
+			});
+			for (size_t i = 0; i < cpuNodes.size(); i++) {
+				AgoNode * node = cpuNodes[i];
+				if (cpuNodeStatus[i]) {
+					agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", node->akernel->name, cpuNodeStatus[i], agoEnum2Name(cpuNodeStatus[i]));
+					return cpuNodeStatus[i];
+				}
+				agoPerfProfileEntry(graph, ago_profile_type_exec_begin, &node->ref, node->perf.beg, cpuNodeThread[i]);
+				agoPerfProfileEntry(graph, ago_profile_type_exec_end, &node->ref, node->perf.end, cpuNodeThread[i]);
 #if ENABLE_OPENCL
+				// the preparation of a later node of the level may have cleared it before this node was run
 				opencl_buffer_access_enable |= (node->akernel->opencl_buffer_access_enable ? true : false);
-				if (!node->akernel->opencl_buffer_access_enable) {
-					agoPerfProfileEntry(graph, ago_profile_type_wait_begin, &node->ref);
-					if (nodeLaunchHierarchicalLevel > 0 && nodeLaunchHierarchicalLevel < node->hierarchical_level) {
-						status = agoWaitForNodesCompletion(graph);
-						if (status != VX_SUCCESS) {
-							agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoWaitForNodesCompletion failed (%d:%s)\n", status, agoEnum2Name(status));
-							return status;
-						}
-						nodeLaunchHierarchicalLevel = 0;
-					}
-					if(opencl_buffer_access_enable) {
-						cl_int err = clFinish(graph->opencl_cmdq);
-						if (err) {
-							agoAddLogEntry(NULL, VX_FAILURE, "ERROR: clFinish(graph) => %d\n", err);
-							return VX_FAILURE;
-						}
-						opencl_buffer_access_enable = false;
-					}
-					agoPerfProfileEntry(graph, ago_profile_type_wait_end, &node->ref);
-				}
-				agoPerfProfileEntry(graph, ago_profile_type_copy_begin, &node->ref);
-				// make sure that all input buffers are synched
-				if (node->akernel->opencl_buffer_access_enable) {
-					for (vx_uint32 i = 0; i < node->paramCount; i++) {
-						AgoData * data = node->paramList[i];
-						if (data && data->opencl_buffer &&
-							(node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
-						{
-							auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-							if (dataToSync->buffer_sync_flags & (AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE | AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT) &&
-							    dataToSync->opencl_buffer && !(dataToSync->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED))
-							{
-								status = agoDirective((vx_reference)dataToSync, VX_DIRECTIVE_AMD_COPY_TO_OPENCL);
-								if(status != VX_SUCCESS) {
-									agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDirective(*,VX_DIRECTIVE_AMD_COPY_TO_OPENCL) failed (%d:%s)\n", status, agoEnum2Name(status));
-									return status;
-								}
-							}
-						}
-					}
-				}
-				else {
-					for (vx_uint32 i = 0; i < node->paramCount; i++) {
-						AgoData * data = node->paramList[i];
-						if (data && (node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL)) {
-							auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-							status = agoDataSyncFromGpuToCpu(graph, node, dataToSync);
-							for (vx_uint32 j = 0; !status && j < dataToSync->numChildren; j++) {
-								AgoData * jdata = dataToSync->children[j];
-								if (jdata)
-									status = agoDataSyncFromGpuToCpu(graph, node, jdata);
-							}
-							if (status) {
-								agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDataSyncFromGpuToCpu failed (%d:%s) for node(%s) arg#%d data(%s)\n", status, agoEnum2Name(status), node->akernel->name, i, data->name.c_str());
-								return status;
-							}
-						}
-					}
-				}
-				agoPerfProfileEntry(graph, ago_profile_type_copy_end, &node->ref);
 #endif
+				status = agoCompleteCpuNodeExecution(graph, node);
+				if (status != VX_SUCCESS)
+					return status;
+			}
+		}
+		else {
+			for (auto node : cpuNodes) {
+				status = agoPrepareCpuNodeExecution(graph, node, opencl_buffer_access_enable, nodeLaunchHierarchicalLevel);
+				if (status != VX_SUCCESS)
+					return status;
 				// execute node
 				agoPerfProfileEntry(graph, ago_profile_type_exec_begin, &node->ref);
 				agoPerfCaptureStart(&node->perf);
-				AgoKernel * kernel = node->akernel;
-				status = VX_SUCCESS;
-				if (kernel->func) {
-					status = kernel->func(node, ago_kernel_cmd_execute);
-					if (status == AGO_ERROR_KERNEL_NOT_IMPLEMENTED)
-						status = VX_ERROR_NOT_IMPLEMENTED;
-				}
-				else if (kernel->kernel_f) {
-					status = kernel->kernel_f(node, (vx_reference *)node->paramList, node->paramCount);
-				}
+				status = agoExecuteCpuNode(node);
 				if (status) {
-					agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", kernel->name, status, agoEnum2Name(status));
+					agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", node->akernel->name, status, agoEnum2Name(status));
 					return status;
 				}
 				agoPerfCaptureStop(&node->perf);
 				agoPerfProfileEntry(graph, ago_profile_type_exec_end, &node->ref);
-#if ENABLE_OPENCL
-				// mark that node outputs are dirty
-				for (vx_uint32 i = 0; i < node->paramCount; i++) {
-					AgoData * data = node->paramList[i];
-					if (data && data->opencl_buffer &&
-						(node->parameters[i].direction == VX_OUTPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
-					{
-						auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-						dataToSync->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
-						dataToSync->buffer_sync_flags |=
-							((node->akernel->opencl_buffer_access_enable || data->u.img.enableUserBufferOpenCL)
-								? AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL
-								: AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE);
-					}
-				}
-#endif
-				// node callback
-				if (node->callback) {
-					vx_action action = node->callback(node);
-					if (action == VX_ACTION_ABANDON) {
-						return VX_ERROR_GRAPH_ABANDONED;
-					}
-				}
+				status = agoCompleteCpuNodeExecution(graph, node);
+				if (status != VX_SUCCESS)
+					return status;
 			}
 		}
 	}
@@ -2394,12 +2540,105 @@ vx_status agoGraphDumpPerformanceProfile(AgoGraph * graph, const char * fileName
 	return VX_SUCCESS;
 }
 
+// gets the name of a profile entry object for the performance trace: JSON special characters are dropped
+static void agoGetPerformanceTraceName(char * name, size_t size, vx_reference ref)
+{
+	char text[256] = "GRAPH";
+	if (ref->type == VX_TYPE_NODE) strncpy(text, ((AgoNode *)ref)->akernel->name, sizeof(text) - 1);
+	else if (ref->type != VX_TYPE_GRAPH) agoGetDataName(text, (AgoData *)ref);
+	size_t len = 0;
+	for (const char * s = text; *s && len < size - 1; s++) {
+		if (*s != '"' && *s != '\\' && (unsigned char)*s >= ' ')
+			name[len++] = *s;
+	}
+	name[len] = 0;
+}
+
+vx_status agoGraphDumpPerformanceTrace(AgoGraph * graph, const char * fileName)
+{
+	FILE * fp = fopen(fileName, "w");
+	if (!fp) {
+		agoAddLogEntry(NULL, VX_FAILURE, "ERROR: unable to create: %s\n", fileName);
+		return VX_FAILURE;
+	}
+	// Chrome trace-event format: one track per thread, a complete event per begin/end pair of the profile
+	fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"OpenVX graph\"}}");
+	if (graph->performance_profile.size() > 0) {
+		static const char * type_str[] = { "launch", "wait", "copy", "exec" };
+		double factor = 1000000.0 / (double)agoGetClockFrequency(); // to convert clock counter to us
+		int64_t stime = graph->performance_profile[0].time;
+		std::vector<std::thread::id> threads;
+		std::map<std::tuple<vx_reference, int, std::thread::id>, std::vector<const AgoProfileEntry *>> open;
+		for (auto& entry : graph->performance_profile) {
+			// thread track
+			size_t tid = std::find(threads.begin(), threads.end(), entry.thread) - threads.begin();
+			if (tid == threads.size()) {
+				threads.push_back(entry.thread);
+				fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}", (int)tid, (int)tid);
+			}
+			// begin entries wait for the end entry of the same object and thread
+			int kind = (int)entry.type >> 1;
+			auto& stack = open[std::make_tuple(entry.ref, kind, entry.thread)];
+			if (!((int)entry.type & 1)) {
+				stack.push_back(&entry);
+				continue;
+			}
+			if (stack.empty() || kind > 3)
+				continue;
+			const AgoProfileEntry * begin = stack.back();
+			stack.pop_back();
+			char name[256];
+			agoGetPerformanceTraceName(name, sizeof(name), entry.ref);
+			fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%d",
+				entry.ref->type == VX_TYPE_GRAPH && kind == 3 ? "frame" : name,
+				entry.ref->type == VX_TYPE_GRAPH && kind == 3 ? "frame" : type_str[kind],
+				(int)tid, (double)(begin->time - stime) * factor, (double)(entry.time - begin->time) * factor, begin->id);
+			if (entry.ref->type == VX_TYPE_NODE) {
+				// bytes of the node parameters
+				AgoNode * node = (AgoNode *)entry.ref;
+				vx_size inputSize = 0, outputSize = 0;
+				for (vx_uint32 i = 0; i < node->paramCount; i++) {
+					if (node->paramList[i]) {
+						if (node->parameters[i].direction == VX_INPUT) inputSize += node->paramList[i]->size;
+						else outputSize += node->paramList[i]->size;
+					}
+				}
+				fprintf(fp, ",\"device\":\"%s\",\"input_bytes\":%zu,\"output_bytes\":%zu",
+					node->attr_affinity.device_type == AGO_TARGET_AFFINITY_GPU ? "GPU" : "CPU", inputSize, outputSize);
+			}
+			fprintf(fp, "}}");
+		}
+		// clear the profiling data
+		graph->performance_profile.clear();
+	}
+	fprintf(fp, "\n]}\n");
+	fclose(fp);
+	return VX_SUCCESS;
+}
+
+// checks whether every queued parameter of a pipelined graph has an object for the next frame
+static bool agoIsGraphPipelineFrameReady(AgoGraphPipeline * pipeline)
+{
+	for (auto& param : pipeline->params) {
+		if (param.ready.empty())
+			return false;
+	}
+	return true;
+}
+
 int agoProcessGraph(AgoGraph * graph)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
 	if (agoIsValidGraph(graph)) {
 		CAgoLock lock(graph->cs);
 
+		// the frames of a pipelined graph are started by the queued parameters
+		if (graph->pipeline) {
+			agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoProcessGraph: not supported on a pipelined graph\n");
+			return VX_ERROR_NOT_SUPPORTED;
+		}
+
 		// make sure that graph is verified
 		status = VX_SUCCESS;
 		if (!graph->verified) {
@@ -2421,12 +2660,21 @@ int agoProcessGraph(AgoGraph * graph)
 }
 
 int agoScheduleGraph(AgoGraph * graph)
+{
+	vx_uint64 frame;
+	return agoScheduleGraphFrame(graph, &frame);
+}
+
+int agoScheduleGraphFrame(AgoGraph * graph, vx_uint64 * frame)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
 	if (agoIsValidGraph(graph)) {
+		if (graph->pipeline) {
+			agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoScheduleGraph: not supported on a pipelined graph\n");
+			return VX_ERROR_NOT_SUPPORTED;
+		}
 		status = VX_SUCCESS;
-		graph->threadScheduleCount++;
-		if (graph->hThread) {
+		if (graph->scheduleThread.joinable()) {
 			if (!graph->verified) {
 				// make sure to verify the graph in master thread
 				CAgoLock lock(graph->cs);
@@ -2434,13 +2682,21 @@ int agoScheduleGraph(AgoGraph * graph)
 			}
 			if (status == VX_SUCCESS) {
 				// inform graph thread to execute
-				if (!ReleaseSemaphore(graph->hSemToThread, 1, nullptr)) {
-					status = VX_ERROR_NO_RESOURCES;
+				{
+					std::lock_guard<std::mutex> lock(graph->scheduleMutex);
+					*frame = ++graph->scheduleCount;
 				}
+				graph->scheduleRequested.notify_one();
 			}
 		}
 		else {
 			status = agoProcessGraph(graph);
+			std::lock_guard<std::mutex> lock(graph->scheduleMutex);
+			*frame = ++graph->scheduleCount;
+			graph->scheduleCompleteCount++;
+			graph->status = status;
+			if (status != VX_SUCCESS)
+				graph->scheduleFailures[*frame] = status;
 		}
 	}
 	return status;
@@ -2450,20 +2706,713 @@ int agoWaitGraph(AgoGraph * graph)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
 	if (agoIsValidGraph(graph)) {
+		if (graph->pipeline && graph->pipeline->running) {
+			// wait until the frames in flight completed and no other frame can start
+			AgoGraphPipeline * pipeline = graph->pipeline;
+			std::unique_lock<std::mutex> lock(pipeline->mtx);
+			pipeline->cv.wait(lock, [pipeline] {
+				return pipeline->framesCompleted == pipeline->framesLaunched && !agoIsGraphPipelineFrameReady(pipeline);
+			});
+			graph->status = pipeline->status;
+		}
+		else {
+			// wait for all the scheduled frames: the failures are reported by the graph status
+			std::unique_lock<std::mutex> lock(graph->scheduleMutex);
+			graph->scheduleCompleted.wait(lock, [graph] { return graph->scheduleCompleteCount == graph->scheduleCount; });
+			graph->scheduleFailures.clear();
+		}
+		status = graph->status;
+	}
+	return status;
+}
+
+int agoWaitGraphFrame(AgoGraph * graph, vx_uint64 frame)
+{
+	vx_status status = VX_ERROR_INVALID_REFERENCE;
+	if (agoIsValidGraph(graph)) {
+		std::unique_lock<std::mutex> lock(graph->scheduleMutex);
+		if (frame < 1 || frame > graph->scheduleCount)
+			return VX_ERROR_INVALID_PARAMETERS;
+		graph->scheduleCompleted.wait(lock, [graph, frame] { return graph->scheduleCompleteCount >= frame; });
 		status = VX_SUCCESS;
-		graph->threadWaitCount++;
-		if (graph->hThread) {
-			while (graph->threadExecuteCount != graph->threadScheduleCount) {
-				if (WaitForSingleObject(graph->hSemFromThread, INFINITE) != WAIT_OBJECT_0) {
-					agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoWaitGraph: WaitForSingleObject failed\n");
-					status = VX_FAILURE;
+		auto it = graph->scheduleFailures.find(frame);
+		if (it != graph->scheduleFailures.end()) {
+			status = it->second;
+			graph->scheduleFailures.erase(it);
+		}
+	}
+	return status;
+}
+
+int agoSetGraphPipelineConfig(AgoGraph * graph, vx_uint32 depth, vx_uint32 numParams, const AgoGraphParameterQueueInfo * params)
+{
+	if (graph->verified) {
+		agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoSetGraphPipelineConfig: graph is already verified\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (depth < 1 || depth > AGO_MAX_GRAPH_PIPELINE_DEPTH || numParams < 1 || !params)
+		return VX_ERROR_INVALID_PARAMETERS;
+	std::vector<AgoGraphPipelineParam> queued(numParams);
+	for (vx_uint32 i = 0; i < numParams; i++) {
+		vx_uint32 index = params[i].graph_parameter_index;
+		if (index >= graph->parameters.size() || !graph->parameters[index] || params[i].refs_list_size < 1 || !params[i].refs_list)
+			return VX_ERROR_INVALID_PARAMETERS;
+		for (vx_uint32 j = 0; j < i; j++) {
+			if (queued[j].index == index)
+				return VX_ERROR_INVALID_PARAMETERS;
+		}
+		queued[i].index = index;
+		queued[i].data = nullptr;
+		for (vx_uint32 k = 0; k < params[i].refs_list_size; k++) {
+			AgoData * data = (AgoData *)params[i].refs_list[k];
+			if (!agoIsValidData(data, graph->parameters[index]->type)) {
+				agoAddLogEntry(&graph->ref, VX_ERROR_INVALID_PARAMETERS, "ERROR: agoSetGraphPipelineConfig: invalid object #%d of graph parameter #%d\n", k, index);
+				return VX_ERROR_INVALID_PARAMETERS;
+			}
+			queued[i].refs.push_back(data);
+		}
+	}
+	agoStopGraphPipeline(graph);
+	delete graph->pipeline;
+	graph->pipeline = new AgoGraphPipeline;
+	graph->pipeline->depth = depth;
+	graph->pipeline->params = std::move(queued);
+	return VX_SUCCESS;
+}
+
+// gets the path of the children indices from root to data (leaf first, as used by agoGetDataFromTrace)
+static bool agoGetGraphPipelineTrace(AgoData * root, AgoData * data, int trace[], int& traceCount)
+{
+	for (traceCount = 0; data && data != root; data = data->parent) {
+		if (traceCount == AGO_MAX_DEPTH_FROM_DELAY_OBJECT)
+			return false;
+		trace[traceCount++] = data->siblingIndex;
+	}
+	return data == root;
+}
+
+// runs the frames of a pipelined graph on one slot: frame N runs on slot N % depth and
+// executes a hierarchical level after frame N-1 completed it
+static void agoGraphPipelineSlotThread(AgoGraph * graph, vx_uint32 slotIndex)
+{
+	AgoGraphPipeline * pipeline = graph->pipeline;
+	AgoGraphPipelineSlot& slot = pipeline->slots[slotIndex];
+	AgoThreadPool * thread_pool = graph->ref.context->thread_pool;
+	std::vector<AgoNode *> cpuNodes;
+	std::vector<int> cpuNodeStatus;
+	for (;;) {
+		{ // wait for the turn of the slot and an object on every queued parameter
+			std::unique_lock<std::mutex> lock(pipeline->mtx);
+			pipeline->cv.wait(lock, [pipeline, slotIndex] {
+				return pipeline->terminate ||
+					(pipeline->framesLaunched % pipeline->depth == slotIndex && agoIsGraphPipelineFrameReady(pipeline));
+			});
+			if (pipeline->terminate)
+				return;
+			for (size_t i = 0; i < pipeline->params.size(); i++) {
+				slot.refs[i] = pipeline->params[i].ready.front();
+				pipeline->params[i].ready.pop_front();
+			}
+			slot.frame = pipeline->framesLaunched++;
+		}
+		pipeline->cv.notify_all();
+		for (auto& binding : pipeline->bindings) {
+			slot.nodeParams[binding.node][binding.arg] = agoGetDataFromTrace(slot.refs[binding.param], binding.trace, binding.traceCount);
+		}
+		int status = VX_SUCCESS;
+		size_t levelCount = pipeline->levelStart.size() - 1;
+		for (size_t level = 0; level < levelCount; level++) {
+			{ // wait for the previous frame to complete the level
+				std::unique_lock<std::mutex> lock(pipeline->mtx);
+				pipeline->cv.wait(lock, [pipeline, level, &slot] {
+					return pipeline->terminate || pipeline->levelFrameCount[level] == slot.frame;
+				});
+				if (pipeline->terminate)
+					return;
+			}
+			// bind the node parameters of the frame: all nodes of a CPU supernode get executed with its first node
+			cpuNodes.clear();
+			for (size_t k = pipeline->levelStart[level]; k < pipeline->levelStart[level + 1]; k++) {
+				AgoNode * node = pipeline->nodes[k];
+				if (!node->cpu_supernode) {
+					std::copy(slot.nodeParams[k].begin(), slot.nodeParams[k].end(), node->paramList);
+					cpuNodes.push_back(node);
+				}
+				else if (node == node->cpu_supernode->nodeList.front()) {
+					for (AgoNode * snode : node->cpu_supernode->nodeList) {
+						auto& nodeParams = slot.nodeParams[pipeline->nodeIndex[snode]];
+						std::copy(nodeParams.begin(), nodeParams.end(), snode->paramList);
+					}
+					cpuNodes.push_back(node);
+				}
+			}
+			// execute the level, unless the frame failed already
+			if (status == VX_SUCCESS) {
+				cpuNodeStatus.assign(cpuNodes.size(), VX_SUCCESS);
+				if (thread_pool && cpuNodes.size() > 1) {
+					thread_pool->run(cpuNodes.size(), [&](size_t i) {
+						cpuNodeStatus[i] = agoExecuteCpuNode(cpuNodes[i]);
+					});
+				}
+				else {
+					for (size_t i = 0; i < cpuNodes.size(); i++)
+						cpuNodeStatus[i] = agoExecuteCpuNode(cpuNodes[i]);
+				}
+				for (size_t i = 0; status == VX_SUCCESS && i < cpuNodes.size(); i++) {
+					status = cpuNodeStatus[i];
+					if (status != VX_SUCCESS)
+						agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", cpuNodes[i]->akernel->name, status, agoEnum2Name(status));
+				}
+				for (size_t k = pipeline->levelStart[level]; status == VX_SUCCESS && k < pipeline->levelStart[level + 1]; k++) {
+					status = agoCompleteCpuNodeExecution(graph, pipeline->nodes[k]);
+				}
+			}
+			{ // the last level returns the objects of the frame in frame order
+				std::lock_guard<std::mutex> lock(pipeline->mtx);
+				if (level == levelCount - 1) {
+					for (size_t i = 0; i < pipeline->params.size(); i++)
+						pipeline->params[i].done.push_back(slot.refs[i]);
+					if (status != VX_SUCCESS && pipeline->status == VX_SUCCESS)
+						pipeline->status = status;
+					pipeline->framesCompleted++;
+					graph->execFrameCount++;
+				}
+				pipeline->levelFrameCount[level] = slot.frame + 1;
+			}
+			pipeline->cv.notify_all();
+		}
+	}
+}
+
+int agoInitializeGraphPipeline(AgoGraph * graph)
+{
+	AgoGraphPipeline * pipeline = graph->pipeline;
+	AgoContext * context = graph->ref.context;
+
+	// only CPU nodes without delays: GPU nodes and delays share their state across frames
+	pipeline->nodes.clear();
+	pipeline->nodeIndex.clear();
+	pipeline->levelStart.clear();
+	for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+		if (node->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU) {
+			agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoInitializeGraphPipeline: GPU node %s can't be pipelined\n", node->akernel->name);
+			return VX_ERROR_NOT_SUPPORTED;
+		}
+		if (pipeline->nodes.empty() || node->hierarchical_level != pipeline->nodes.back()->hierarchical_level)
+			pipeline->levelStart.push_back(pipeline->nodes.size());
+		pipeline->nodeIndex[node] = pipeline->nodes.size();
+		pipeline->nodes.push_back(node);
+	}
+	pipeline->levelStart.push_back(pipeline->nodes.size());
+	if (pipeline->nodes.empty() || !graph->autoAgeDelayList.empty()) {
+		agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoInitializeGraphPipeline: empty graphs and graphs with delays can't be pipelined\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	for (auto& param : pipeline->params) {
+		char desc[1024], refDesc[1024];
+		agoGetDescriptionFromData(context, desc, param.data);
+		for (AgoData * ref : param.refs) {
+			agoGetDescriptionFromData(context, refDesc, ref);
+			if (strcmp(desc, refDesc) != 0) {
+				agoAddLogEntry(&graph->ref, VX_ERROR_INVALID_PARAMETERS, "ERROR: agoInitializeGraphPipeline: %s doesn't match graph parameter #%d (%s)\n", refDesc, param.index, desc);
+				return VX_ERROR_INVALID_PARAMETERS;
+			}
+		}
+	}
+
+	// images that only exist as strip buffers of CPU supernodes are used by one frame at a time
+	std::vector<AgoData *> stripLocalData;
+	for (AgoSuperNode * supernode = graph->cpuSupernodeList; supernode; supernode = supernode->next) {
+		for (auto& param : supernode->stripParamList) {
+			if (param.local)
+				stripLocalData.push_back(param.data);
+		}
+	}
+
+	// bind the node parameters to the queued parameters and find the written virtual data
+	std::vector<AgoData *> virtualData;
+	pipeline->bindings.clear();
+	pipeline->nodeParams.resize(pipeline->nodes.size());
+	for (size_t k = 0; k < pipeline->nodes.size(); k++) {
+		AgoNode * node = pipeline->nodes[k];
+		pipeline->nodeParams[k].assign(node->paramList, node->paramList + node->paramCount);
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (!data)
+				continue;
+			if (agoIsPartOfDelay(data) || (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI)) {
+				agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoInitializeGraphPipeline: %s of node %s can't be pipelined\n", data->name.c_str(), node->akernel->name);
+				return VX_ERROR_NOT_SUPPORTED;
+			}
+			AgoGraphPipelineBinding binding = { (vx_uint32)k, arg };
+			for (binding.param = 0; binding.param < pipeline->params.size(); binding.param++) {
+				if (agoGetGraphPipelineTrace(pipeline->params[binding.param].data, data, binding.trace, binding.traceCount))
 					break;
+			}
+			if (binding.param < pipeline->params.size()) {
+				pipeline->bindings.push_back(binding);
+				continue;
+			}
+			if (node->parameters[arg].direction == VX_INPUT)
+				continue;
+			AgoData * root = data;
+			while (root->parent)
+				root = root->parent;
+			if (!root->isVirtual) {
+				agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: agoInitializeGraphPipeline: %s written by node %s is not a queued graph parameter\n", data->name.c_str(), node->akernel->name);
+				return VX_ERROR_NOT_SUPPORTED;
+			}
+			if (std::find(stripLocalData.begin(), stripLocalData.end(), root) == stripLocalData.end() &&
+			    std::find(virtualData.begin(), virtualData.end(), root) == virtualData.end())
+			{
+				virtualData.push_back(root);
+			}
+		}
+	}
+
+	// give each slot its own copy of the written virtual data and the node parameters that use it
+	pipeline->slots = std::vector<AgoGraphPipelineSlot>(pipeline->depth);
+	for (vx_uint32 s = 0; s < pipeline->depth; s++) {
+		AgoGraphPipelineSlot& slot = pipeline->slots[s];
+		slot.refs.resize(pipeline->params.size());
+		if (s == 0) {
+			slot.data = virtualData;
+		}
+		else {
+			for (AgoData * data : virtualData) {
+				char desc[1024];
+				agoGetDescriptionFromData(context, desc, data);
+				AgoData * clone = agoCreateDataFromDescription(context, graph, desc, false);
+				if (!clone) {
+					agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoInitializeGraphPipeline: can't create %s\n", desc);
+					return VX_FAILURE;
+				}
+				agoGenerateVirtualDataName(graph, "pipe", clone->name);
+				agoAddData(&graph->dataList, clone);
+				for (vx_uint32 i = 0; i < clone->numChildren; i++) {
+					if (clone->children[i])
+						agoAddData(&graph->dataList, clone->children[i]);
+				}
+				if (agoAllocData(clone)) {
+					agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoInitializeGraphPipeline: can't allocate %s\n", desc);
+					return VX_FAILURE;
 				}
+				slot.data.push_back(clone);
+			}
+		}
+		slot.nodeParams = pipeline->nodeParams;
+		for (auto& nodeParams : slot.nodeParams) {
+			for (auto& data : nodeParams) {
+				int trace[AGO_MAX_DEPTH_FROM_DELAY_OBJECT], traceCount = 0;
+				for (size_t i = 0; data && i < virtualData.size(); i++) {
+					if (agoGetGraphPipelineTrace(virtualData[i], data, trace, traceCount)) {
+						data = agoGetDataFromTrace(slot.data[i], trace, traceCount);
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	// start the slot threads
+	for (auto& param : pipeline->params) {
+		param.ready.clear();
+		param.done.clear();
+	}
+	pipeline->levelFrameCount.assign(pipeline->levelStart.size() - 1, 0);
+	pipeline->framesLaunched = 0;
+	pipeline->framesCompleted = 0;
+	pipeline->terminate = false;
+	pipeline->status = VX_SUCCESS;
+	for (vx_uint32 s = 0; s < pipeline->depth; s++) {
+		pipeline->slots[s].thread = std::thread(agoGraphPipelineSlotThread, graph, s);
+	}
+	pipeline->running = true;
+	return VX_SUCCESS;
+}
+
+void agoStopGraphPipeline(AgoGraph * graph)
+{
+	AgoGraphPipeline * pipeline = graph->pipeline;
+	if (!pipeline)
+		return;
+	if (pipeline->running) {
+		{
+			std::lock_guard<std::mutex> lock(pipeline->mtx);
+			pipeline->terminate = true;
+		}
+		pipeline->cv.notify_all();
+		for (auto& slot : pipeline->slots) {
+			slot.thread.join();
+		}
+		// give the nodes their parameters at verify time back
+		for (size_t k = 0; k < pipeline->nodes.size(); k++) {
+			std::copy(pipeline->nodeParams[k].begin(), pipeline->nodeParams[k].end(), pipeline->nodes[k]->paramList);
+		}
+		pipeline->running = false;
+	}
+	else {
+		// get the objects of the queued parameters before the optimizer replaces the nodes
+		for (auto& param : pipeline->params) {
+			if (!param.data) {
+				vx_parameter parameter = graph->parameters[param.index];
+				param.data = ((AgoNode *)parameter->scope)->paramList[parameter->index];
 			}
 		}
+	}
+}
+
+// gets the queued parameter of a pipelined graph
+static AgoGraphPipelineParam * agoGetGraphPipelineParam(AgoGraph * graph, vx_uint32 index)
+{
+	if (graph->pipeline && graph->pipeline->running) {
+		for (auto& param : graph->pipeline->params) {
+			if (param.index == index)
+				return &param;
+		}
+	}
+	return nullptr;
+}
+
+int agoGraphParameterEnqueueReadyRef(AgoGraph * graph, vx_uint32 index, AgoReference * * refs, vx_uint32 numRefs)
+{
+	vx_status status = VX_ERROR_INVALID_REFERENCE;
+	if (agoIsValidGraph(graph)) {
+		status = VX_SUCCESS;
+		if (!graph->verified) {
+			CAgoLock lock(graph->cs);
+			status = vxVerifyGraph(graph);
+		}
 		if (status == VX_SUCCESS) {
-			status = graph->status;
+			AgoGraphPipelineParam * param = agoGetGraphPipelineParam(graph, index);
+			if (!param || (numRefs > 0 && !refs))
+				return VX_ERROR_INVALID_PARAMETERS;
+			for (vx_uint32 i = 0; i < numRefs; i++) {
+				if (std::find(param->refs.begin(), param->refs.end(), (AgoData *)refs[i]) == param->refs.end())
+					return VX_ERROR_INVALID_PARAMETERS;
+			}
+			{
+				std::lock_guard<std::mutex> lock(graph->pipeline->mtx);
+				for (vx_uint32 i = 0; i < numRefs; i++)
+					param->ready.push_back((AgoData *)refs[i]);
+			}
+			graph->pipeline->cv.notify_all();
 		}
 	}
 	return status;
 }
+
+int agoGraphParameterDequeueDoneRef(AgoGraph * graph, vx_uint32 index, AgoReference * * refs, vx_uint32 maxRefs, vx_uint32 * numRefs)
+{
+	vx_status status = VX_ERROR_INVALID_REFERENCE;
+	if (agoIsValidGraph(graph)) {
+		AgoGraphPipelineParam * param = agoGetGraphPipelineParam(graph, index);
+		if (!param || !refs || maxRefs < 1 || !numRefs)
+			return VX_ERROR_INVALID_PARAMETERS;
+		AgoGraphPipeline * pipeline = graph->pipeline;
+		std::unique_lock<std::mutex> lock(pipeline->mtx);
+		pipeline->cv.wait(lock, [pipeline, param] { return pipeline->terminate || !param->done.empty(); });
+		vx_uint32 count = 0;
+		for (; count < maxRefs && !param->done.empty(); count++) {
+			refs[count] = &param->done.front()->ref;
+			param->done.pop_front();
+		}
+		*numRefs = count;
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+int agoGraphParameterCheckDoneRef(AgoGraph * graph, vx_uint32 index, vx_uint32 * numRefs)
+{
+	vx_status status = VX_ERROR_INVALID_REFERENCE;
+	if (agoIsValidGraph(graph)) {
+		AgoGraphPipelineParam * param = agoGetGraphPipelineParam(graph, index);
+		if (!param || !numRefs)
+			return VX_ERROR_INVALID_PARAMETERS;
+		std::lock_guard<std::mutex> lock(graph->pipeline->mtx);
+		*numRefs = (vx_uint32)param->done.size();
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+static vx_uint64 agoGetCompiledGraphKey(AgoGraph * agraph, AgoReference * * ref, int num_ref, const char * str)
+{
+	// the key covers everything that the drama output depends on: library, optimizer flags,
+	// affinity, the graph text, and the description of each import reference
+	AgoContext * context = agraph->ref.context;
+	char config[256];
+	sprintf(config, AGO_VERSION " %d %u %d,%d,%d %d,%d,%d", AGO_COMPILED_GRAPH_VERSION, agraph->optimizer_flags,
+		agraph->attr_affinity.device_type, agraph->attr_affinity.device_info, agraph->attr_affinity.group,
+		context->attr_affinity.device_type, context->attr_affinity.device_info, context->attr_affinity.group);
+	vx_uint64 key = agoHashFNV1a(0xcbf29ce484222325ull, config, strlen(config) + 1);
+#if ENABLE_OPENCL
+	if (context->opencl_num_devices > 0) {
+		char deviceName[256] = { 0 };
+		clGetDeviceInfo(context->opencl_device_list[0], CL_DEVICE_NAME, sizeof(deviceName) - 1, deviceName, NULL);
+		key = agoHashFNV1a(key, deviceName, strlen(deviceName) + 1);
+	}
+#endif
+	// the builds of this library and of the loaded modules, and the kernels they published: a rebuilt
+	// or upgraded library can divide and merge the same graph differently
+	int64_t stamp[2];
+	if (agoGetModuleFileStamp((const void *)&agoGetCompiledGraphKey, &stamp[0], &stamp[1]))
+		key = agoHashFNV1a(key, stamp, sizeof(stamp));
+	for (vx_uint32 i = 0; i < context->num_active_modules; i++) {
+		const ModuleData & module = context->modules[i];
+		if (!module.hmodule) continue;
+		key = agoHashFNV1a(key, module.module_name, strlen(module.module_name) + 1);
+		void * publish_kernels_f = agoGetFunctionAddress(module.hmodule, "vxPublishKernels");
+		if (publish_kernels_f && agoGetModuleFileStamp(publish_kernels_f, &stamp[0], &stamp[1]))
+			key = agoHashFNV1a(key, stamp, sizeof(stamp));
+	}
+	for (AgoKernel * kernel = context->kernelList.head; kernel; kernel = kernel->next) {
+		key = agoHashFNV1a(key, kernel->name, strlen(kernel->name) + 1);
+		key = agoHashFNV1a(key, &kernel->id, sizeof(kernel->id));
+		key = agoHashFNV1a(key, &kernel->flags, sizeof(kernel->flags));
+		key = agoHashFNV1a(key, &kernel->argCount, sizeof(kernel->argCount));
+		key = agoHashFNV1a(key, kernel->argConfig, kernel->argCount * sizeof(kernel->argConfig[0]));
+		key = agoHashFNV1a(key, kernel->argType, kernel->argCount * sizeof(kernel->argType[0]));
+	}
+	key = agoHashFNV1a(key, str, strlen(str) + 1);
+	for (int i = 0; i < num_ref; i++) {
+		char desc[1024] = "null";
+		if (ref[i]) agoGetDescriptionFromData(context, desc, (AgoData *)ref[i]);
+		key = agoHashFNV1a(key, desc, strlen(desc) + 1);
+	}
+	return key;
+}
+
+// the compiled graph ends with a trailer holding the length and the hash of the text before it
+#define AGO_COMPILED_GRAPH_TRAILER "# ago compiled graph end"
+
+static bool agoIsCompiledGraphComplete(const char * text, size_t size)
+{
+	// a truncated or corrupted file would silently lose nodes
+	if (size < 2 || text[size - 1] != '\n')
+		return false;
+	size_t trailer = size - 1;
+	while (trailer > 0 && text[trailer - 1] != '\n')
+		trailer--;
+	unsigned long long length = 0, hash = 0;
+	if (sscanf(text + trailer, AGO_COMPILED_GRAPH_TRAILER " %llu %llx", &length, &hash) != 2 || length != trailer)
+		return false;
+	return hash == agoHashFNV1a(0xcbf29ce484222325ull, text, trailer);
+}
+
+int agoReadGraphWithCache(AgoGraph * agraph, AgoReference * * ref, int num_ref, ago_data_registry_callback_f callback_f, void * callback_obj, char * str, vx_int32 dumpToConsole, const char * cacheFolder)
+{
+	if (!agraph) return -1;
+	// only an empty graph can be imported from or saved to the compiled graph cache
+	if (!cacheFolder || !cacheFolder[0] || agraph->nodeList.count > 0 || agraph->dataList.count > 0)
+		return agoReadGraphFromString(agraph, ref, num_ref, callback_f, callback_obj, str, dumpToConsole);
+	vx_context context = agraph->ref.context;
+	CAgoLock lock(agraph->cs);
+	CAgoLock lock2(context->cs);
+
+	// load the modules imported by the text first, so that their builds and kernels are part of the key:
+	// failures are reported when the text itself is imported below
+	for (const char * line = str; line && *line;) {
+		char module[256];
+		if (sscanf(line, "import %255s", module) == 1)
+			agoLoadModule(context, module);
+		line = strchr(line, '\n');
+		if (line) line++;
+	}
+
+	// get the compiled graph file name from the key
+	vx_uint64 key = agoGetCompiledGraphKey(agraph, ref, num_ref, str);
+	char header[256], fileName[1024];
+	sprintf(header, "# ago compiled graph %016llx " AGO_VERSION " %d\n", (unsigned long long)key, AGO_COMPILED_GRAPH_VERSION);
+	snprintf(fileName, sizeof(fileName), "%s/ago-graph-%016llx.gdf", cacheFolder, (unsigned long long)key);
+	agraph->cache_folder = cacheFolder;
+
+	// import the compiled graph, if available: the nodes are already divided and pruned by drama
+	FILE * fp = fopen(fileName, "rb");
+	if (fp) {
+		fseek(fp, 0L, SEEK_END); long size = ftell(fp); fseek(fp, 0L, SEEK_SET);
+		char * text = new char[size + 1]();
+		bool valid = (fread(text, sizeof(char), size, fp) == size) && !strncmp(text, header, strlen(header)) &&
+			agoIsCompiledGraphComplete(text, (size_t)size);
+		fclose(fp);
+		if (!valid) {
+			agoAddLogEntry(&agraph->ref, VX_SUCCESS, "WARNING: agoReadGraphWithCache: ignored stale or incomplete compiled graph %s\n", fileName);
+		}
+		if (valid) {
+			agraph->precompiled = true;
+			int status = agoReadGraphFromString(agraph, ref, num_ref, callback_f, callback_obj, text, dumpToConsole);
+			delete[] text;
+			if (!status) {
+				agoAddLogEntry(&agraph->ref, VX_SUCCESS, "OK: imported compiled graph %s\n", fileName);
+			}
+			return status;
+		}
+		delete[] text;
+	}
+
+	// import the text and save the compiled graph after vxVerifyGraph
+	agraph->cache_file = fileName;
+	agraph->cache_ref.assign(ref, ref + num_ref);
+	agraph->cache_statements.clear();
+	int status = agoReadGraphFromString(agraph, ref, num_ref, callback_f, callback_obj, str, dumpToConsole);
+	agraph->cache_node_count = agraph->nodeList.count;
+	if (status) {
+		agraph->cache_file.clear();
+	}
+	return status;
+}
+
+int agoWriteCompiledGraph(AgoGraph * agraph)
+{
+	vx_context context = agraph->ref.context;
+	CAgoLock lock(agraph->cs);
+	CAgoLock lock2(context->cs);
+	std::string fileName = agraph->cache_file;
+	agraph->cache_file.clear();
+	if (fileName.empty())
+		return 0;
+
+	// the header must match the one expected by agoReadGraphWithCache
+	const char * keyStart = strstr(fileName.c_str(), "/ago-graph-");
+	if (!keyStart) return -1;
+	char line[2048];
+	sprintf(line, "# ago compiled graph %16.16s " AGO_VERSION " %d\n", keyStart + 11, AGO_COMPILED_GRAPH_VERSION);
+	std::string text = line;
+	sprintf(line, "def-var AgoOptimizerFlags %u\n", agraph->optimizer_flags);
+	text += line;
+
+	// the statements of the original text that create objects outside the graph are kept as is,
+	// so that the application sees the same data registry callbacks
+	std::map<AgoData *, std::string> rootName;
+	for (auto it = agraph->cache_statements.begin(); it != agraph->cache_statements.end(); it++) {
+		if (!strncmp(it->c_str(), "import ", 7) || !strncmp(it->c_str(), "type ", 5)) {
+			text += *it + "\n";
+		}
+	}
+	for (auto it = agraph->cache_statements.begin(); it != agraph->cache_statements.end(); it++) {
+		char name[256];
+		if (sscanf(it->c_str(), "data %255s", name) == 1) {
+			AgoData * data = agoFindDataByName(context, agraph, name);
+			if (data && !data->isVirtual && !data->parent) {
+				rootName[data] = name;
+				text += *it + "\n";
+			}
+		}
+	}
+
+	// name the remaining objects used by the nodes: import references are $N and children use [index]
+	std::vector<AgoData *> rootList;
+	std::map<AgoData *, int> rootUseCount;
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		for (vx_uint32 i = 0; i < anode->paramCount; i++) {
+			AgoData * data = anode->paramList[i];
+			if (!data) continue;
+			if (data->isDelayed || data->ref.type == VX_TYPE_DELAY) {
+				agoAddLogEntry(&agraph->ref, VX_SUCCESS, "WARNING: agoWriteCompiledGraph: graphs with delays are not cached\n");
+				return -1;
+			}
+			AgoData * root = data;
+			bool isRef = false;
+			for (; root; root = root->parent) {
+				if (std::find(agraph->cache_ref.begin(), agraph->cache_ref.end(), &root->ref) != agraph->cache_ref.end()) {
+					isRef = true;
+					break;
+				}
+				if (!root->parent)
+					break;
+			}
+			if (isRef || rootName.find(root) != rootName.end())
+				continue;
+			if (rootUseCount[root]++ == 0)
+				rootList.push_back(root);
+			if (root != data)
+				rootUseCount[root]++;
+		}
+	}
+	vx_uint32 autoCount = 0;
+	for (auto it = rootList.begin(); it != rootList.end(); it++) {
+		AgoData * data = *it;
+		char desc[1024] = "*ERROR*";
+		agoGetDescriptionFromData(context, desc, data);
+		if (!data->isVirtual && data->name.empty() && rootUseCount[data] == 1) {
+			// constant used by a single node: keep it inline
+			rootName[data] = desc;
+		}
+		else {
+			if (data->name.length() > 0 && data->name[0] != '!')
+				rootName[data] = data->name;
+			else {
+				sprintf(line, "CG!%04d", autoCount++);
+				rootName[data] = line;
+			}
+			text += "data " + rootName[data] + " = " + desc + "\n";
+		}
+	}
+	for (auto it = agraph->cache_statements.begin(); it != agraph->cache_statements.end(); it++) {
+		char name[256];
+		if (sscanf(it->c_str(), "directive %255s", name) == 1 && agoFindDataByName(context, agraph, name)) {
+			text += *it + "\n";
+		}
+	}
+
+	// the drama output: node list with affinity and border mode attributes
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		text += std::string("node ") + anode->akernel->name;
+		vx_uint32 paramCount = anode->paramCount;
+		while (paramCount > 0 && !anode->paramList[paramCount - 1])
+			paramCount--;
+		for (vx_uint32 i = 0; i < paramCount; i++) {
+			std::string index;
+			AgoData * data = anode->paramList[i];
+			for (; data; data = data->parent) {
+				auto ref = std::find(agraph->cache_ref.begin(), agraph->cache_ref.end(), &data->ref);
+				if (ref != agraph->cache_ref.end()) {
+					sprintf(line, "$%d", (int)(ref - agraph->cache_ref.begin()) + 1);
+					index = line + index;
+					break;
+				}
+				if (!data->parent) {
+					index = rootName[data] + index;
+					break;
+				}
+				sprintf(line, "[%d]", data->siblingIndex);
+				index = line + index;
+			}
+			text += " " + (data ? index : std::string("null"));
+		}
+		if (anode->attr_border_mode.mode == VX_BORDER_MODE_REPLICATE) text += " attr:BORDER_MODE:REPLICATE";
+		else if (anode->attr_border_mode.mode == VX_BORDER_MODE_CONSTANT) {
+			sprintf(line, " attr:BORDER_MODE:CONSTANT,0x%08x", anode->attr_border_mode.constant_value.U32);
+			text += line;
+		}
+		if (anode->attr_affinity.device_type) {
+			sprintf(line, " attr:AFFINITY:%s%d,%d", (anode->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_GPU) ? "GPU" : "CPU",
+				anode->attr_affinity.device_info, anode->attr_affinity.group);
+			text += line;
+		}
+		text += "\n";
+	}
+
+	sprintf(line, AGO_COMPILED_GRAPH_TRAILER " %llu %016llx\n", (unsigned long long)text.length(),
+		(unsigned long long)agoHashFNV1a(0xcbf29ce484222325ull, text.c_str(), text.length()));
+	text += line;
+
+	// write into a temporary file first so that a concurrent import never sees a partial graph:
+	// the name is unique to this process and call, so that concurrent writers never share it
+	static std::atomic<vx_uint32> tmpCount(0);
+	sprintf(line, ".%lld.%u.tmp", (long long)agoGetProcessId(), (vx_uint32)tmpCount++);
+	std::string tmpName = fileName + line;
+	FILE * fp = fopen(tmpName.c_str(), "wb");
+	if (!fp) {
+		agoAddLogEntry(&agraph->ref, VX_SUCCESS, "WARNING: agoWriteCompiledGraph: unable to create: %s\n", tmpName.c_str());
+		return -1;
+	}
+	bool written = (fwrite(text.c_str(), sizeof(char), text.length(), fp) == text.length());
+	fclose(fp);
+	if (!written || rename(tmpName.c_str(), fileName.c_str())) {
+		remove(tmpName.c_str());
+		return -1;
+	}
+	return 0;
+}
@@ -35,6 +35,7 @@ THE SOFTWARE.
 
 // version
 #define AGO_VERSION "1.0.1"
+#define AGO_COMPILED_GRAPH_VERSION 2 // bump when the compiled graph cache format or drama output changes
 
 // debug configuration
 #define ENABLE_DEBUG_MESSAGES                 0 // 0:disable 1:enable
@@ -56,6 +57,7 @@ THE SOFTWARE.
 #define USE_AGO_CANNY_SOBEL_SUPP_THRESHOLD    0 // 0:seperate-sobel-and-nonmaxsupression 1:combine-sobel-and-nonmaxsupression
 #define AGO_MEMORY_ALLOC_EXTRA_PADDING       64 // extra bytes to the left and right of buffer allocations
 #define AGO_MAX_DEPTH_FROM_DELAY_OBJECT       4 // number of levels from delay object to low-level object
+#define AGO_MAX_GRAPH_PIPELINE_DEPTH          8 // maximum number of frames of a pipelined graph in flight
 
 // AGO internal error codes for debug
 #define AGO_SUCCESS                           0 // operation is successful
@@ -123,6 +125,8 @@ THE SOFTWARE.
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_NODE_MERGE            0x00000008 // don't perform node merge
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_CONVERT_8BIT_TO_1BIT  0x00000010 // don't convert 8-bit images to 1-bit images
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_SUPERNODE_MERGE       0x00000020 // don't merge supernodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_CPU_SUPERNODE_MERGE   0x00000040 // don't merge element-wise CPU nodes into row strip supernodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_CPU_ARENA_ALLOC       0x00000080 // don't pack virtual CPU buffers into a shared arena
 #define AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT                 0x00000000 // default options
 
 #if ENABLE_OPENCL
@@ -156,6 +160,19 @@ THE SOFTWARE.
 
 // thread scheduling configuration
 #define CONFIG_THREAD_DEFAULT                 1  // 0:disable 1:enable separate threads for graph scheduling
+#define CONFIG_THREAD_GRAPH_SCHEDULING   0x0001  // run graph scheduling in separate threads
+#define CONFIG_THREAD_PARALLEL_NODES     0x0002  // execute the CPU nodes of a hierarchical level concurrently
+#define CONFIG_THREAD_TILED_KERNELS      0x0004  // execute row-local CPU kernels on horizontal bands of their outputs concurrently
+#define CONFIG_THREAD_POOL_SIZE_SHIFT         8  // bits 8..15: number of threads executing CPU nodes (0: one per CPU core)
+#define CONFIG_THREAD_POOL_SIZE_MASK     0xFF00
+#define CONFIG_THREAD_MIN_ROWS_PER_BAND      32  // smallest band worth a thread pool dispatch
+
+// CPU supernode configuration
+#define CONFIG_CPU_SUPERNODE_STRIP_SIZE  (128 * 1024) // bytes of all images of a CPU supernode touched by one row strip
+#define CONFIG_CPU_SUPERNODE_MIN_STRIP_ROWS       8  // smallest row strip of a CPU supernode
+
+// CPU convolution configuration
+#define CONFIG_CPU_CONVOLVE_TILE_WIDTH      256  // columns of the row ring buffer of the separable CPU convolution
 
 // module specific
 #define MAX_MODULE_NAME_SIZE 256
@@ -215,6 +232,7 @@ struct AgoProfileEntry {
 	AgoProfileEntryType type;
 	vx_reference        ref;
 	int64_t             time;
+	std::thread::id     thread;
 };
 struct AgoNode;
 struct AgoContext;
@@ -313,6 +331,7 @@ struct AgoConfigRemap {
 	vx_uint32 dst_width;
 	vx_uint32 dst_height;
 	vx_uint32 remap_fractional_bits;
+	vx_uint32 version; // incremented on every update of the table, so that kernels can cache data derived from it
 };
 struct AgoConfigScalar {
 	vx_enum type;
@@ -350,12 +369,6 @@ struct AgoConfigCannyStack {
 	vx_uint32 count;
 	vx_uint32 stackTop;
 };
-struct AgoConfigScaleMatrix {
-	vx_float32 xscale;
-	vx_float32 yscale;
-	vx_float32 xoffset;
-	vx_float32 yoffset;
-};
 struct AgoTargetAffinityInfo_ { // NOTE: make sure that this data structure is identical to AgoTargetAffinityInfo in vx_amd_ext.h
 	vx_uint32 device_type;
 	vx_uint32 device_info;
@@ -495,6 +508,13 @@ struct AgoSuperNodeDataInfo {
 	vx_uint32 argument_usage[3]; // VX_INPUT, VX_OUTPUT, VX_BIDIRECTIONAL
 	vx_uint32 local_buffer_size_in_bytes;
 };
+struct AgoSuperNodeStripParam {
+	AgoNode * node;
+	vx_uint32 index;  // node parameter index
+	AgoData * data;   // image in the graph
+	AgoData * view;   // current row strip of the image
+	bool local;       // image only exists as the strip buffer of the supernode
+};
 struct AgoSuperNode {
 	AgoSuperNode * next;
 	vx_uint32 group;
@@ -507,6 +527,9 @@ struct AgoSuperNode {
 	std::string opencl_code;
 	bool launched;
 	bool isGpuOclSuperNode;
+	vx_uint32 strip_height;
+	std::vector<AgoSuperNodeStripParam> stripParamList;
+	vx_uint8 * strip_buffer_allocated;
 #if ENABLE_OPENCL
 	cl_command_queue opencl_cmdq;
 	cl_program opencl_program;
@@ -542,6 +565,7 @@ struct AgoNode {
 	vx_int32 funcExchange[AGO_MAX_PARAMS];
 	vx_nodecomplete_f callback;
 	AgoSuperNode * supernode;
+	AgoSuperNode * cpu_supernode;
 	bool initialized;
 	bool drama_divide_invoked;
 	vx_uint32 valid_rect_num_inputs;
@@ -595,12 +619,58 @@ struct AgoNodeList {
 	AgoNode * tail;
 	AgoNode * trash;
 };
+struct AgoGraphPipelineParam {
+	vx_uint32 index;                         // graph parameter index
+	AgoData * data;                          // graph parameter object at verify time
+	std::vector<AgoData *> refs;             // objects that can be enqueued
+	std::deque<AgoData *> ready;             // enqueued objects waiting for a frame
+	std::deque<AgoData *> done;              // objects of completed frames waiting to be dequeued
+};
+struct AgoGraphPipelineBinding {
+	vx_uint32 node;                          // index into AgoGraphPipeline::nodes
+	vx_uint32 arg;                           // node parameter index
+	vx_uint32 param;                         // index into AgoGraphPipeline::params
+	int trace[AGO_MAX_DEPTH_FROM_DELAY_OBJECT], traceCount; // path from the parameter object to the node parameter
+};
+struct AgoGraphPipelineSlot {
+	std::vector<std::vector<AgoData *>> nodeParams; // node parameters of the frames run by the slot
+	std::vector<AgoData *> data;             // written virtual data of the slot (the originals on the first slot)
+	std::vector<AgoData *> refs;             // objects of the queued parameters of the current frame
+	vx_uint64 frame;
+	std::thread thread;
+};
+struct AgoGraphPipeline {
+	vx_uint32 depth;
+	std::vector<AgoGraphPipelineParam> params;
+	std::vector<AgoGraphPipelineBinding> bindings;
+	std::vector<AgoGraphPipelineSlot> slots; // frame N runs on slots[N % depth]
+	std::vector<AgoNode *> nodes;            // nodes in hierarchical level order
+	std::map<AgoNode *, size_t> nodeIndex;   // index of each node in nodes
+	std::vector<std::vector<AgoData *>> nodeParams; // node parameters at verify time
+	std::vector<size_t> levelStart;          // first node of each hierarchical level, followed by nodes.size()
+	std::vector<vx_uint64> levelFrameCount;  // number of frames that completed each hierarchical level
+	std::mutex mtx;
+	std::condition_variable cv;
+	vx_uint64 framesLaunched;
+	vx_uint64 framesCompleted;
+	bool running;
+	bool terminate;
+	vx_status status;
+public:
+	AgoGraphPipeline();
+};
 struct AgoGraph {
 	AgoReference ref;
 	AgoGraph * next;
 	CRITICAL_SECTION cs;
-	HANDLE hThread, hSemToThread, hSemFromThread;
-	vx_int32 threadScheduleCount, threadExecuteCount, threadWaitCount, threadThreadTerminationState;
+	std::thread scheduleThread;                 // runs the scheduled frames when CONFIG_THREAD_GRAPH_SCHEDULING is set
+	std::mutex scheduleMutex;
+	std::condition_variable scheduleRequested;  // signaled when a frame is scheduled or the schedule thread has to stop
+	std::condition_variable scheduleCompleted;  // signaled when a scheduled frame completed
+	vx_uint64 scheduleCount;                    // number of scheduled frames: frame N (1..scheduleCount) is the handle of a schedule
+	vx_uint64 scheduleCompleteCount;            // number of scheduled frames that completed (in order)
+	std::map<vx_uint64, vx_status> scheduleFailures; // status of the failed frames that haven't been waited for
+	bool scheduleTerminate;
 	AgoDataList dataList;
 	AgoNodeList nodeList;
 	vx_bool isReadyToExecute;
@@ -617,8 +687,16 @@ struct AgoGraph {
 	vx_uint32 virtualDataGenerationCount;
 	vx_uint32 optimizer_flags;
 	bool verified;
+	bool precompiled;                           // imported from a compiled graph: drama divide and remove were done earlier
+	std::string cache_folder;                   // folder of compiled graphs and OpenCL program binaries (empty: no caching)
+	std::string cache_file;                     // compiled graph to be saved by vxVerifyGraph (empty: nothing to save)
+	std::vector<AgoReference *> cache_ref;      // import references ($1..$N) of the compiled graph
+	std::vector<std::string> cache_statements;  // import, type, data, and directive statements of the imported text
+	vx_uint32 cache_node_count;                 // number of nodes right after the import
 	std::vector<vx_parameter> parameters;
 	std::vector<AgoData *> autoAgeDelayList;
+	AgoSuperNode * cpuSupernodeList;
+	AgoGraphPipeline * pipeline;                // pipelined execution requested by vxSetGraphPipelineConfig (nullptr: not pipelined)
 #if ENABLE_OPENCL
 	std::vector<AgoNode *> opencl_nodeListQueued;
 	AgoSuperNode * supernodeList;
@@ -674,6 +752,8 @@ struct AgoContext {
 	vx_log_callback_f callback_log;
 	vx_bool callback_reentrant;
 	vx_uint32 thread_config;
+	AgoThreadPool * thread_pool;
+	bool enable_performance_profiling; // profile capture of all graphs (VX_CONTEXT_ATTRIBUTE_AMD_PERFORMANCE_PROFILE)
 	vx_char extensions[256];
 	std::vector<ModuleData> modules;
 	std::vector<MacroData> macros;
@@ -772,6 +852,7 @@ int agoSetImageComponentsAndPlanes(AgoContext * acontext, vx_df_image format, vx
 int agoGetImageComponentsAndPlanes(AgoContext * acontext, vx_df_image format, vx_size * pComponents, vx_size * pPlanes, vx_uint32 * pPixelSizeInBitsNum, vx_uint32 * pPixelSizeInBitsDenom, vx_color_space_e * pColorSpace, vx_channel_range_e * pChannelRange);
 int agoGetImagePlaneFormat(AgoContext * acontext, vx_df_image format, vx_uint32 width, vx_uint32 height, vx_uint32 plane, vx_df_image *pFormat, vx_uint32 * pWidth, vx_uint32 * pHeight);
 void agoGetDataName(vx_char * name, AgoData * data);
+vx_uint64 agoHashFNV1a(vx_uint64 hash, const void * data, size_t size);
 int agoAllocData(AgoData * data);
 void agoRetainData(AgoGraph * graph, AgoData * data, bool isForExternalUse);
 int agoReleaseData(AgoData * data, bool isForExternalUse);
@@ -802,6 +883,7 @@ int agoOptimizeDramaRemove(AgoGraph * agraph);
 int agoOptimizeDramaAnalyze(AgoGraph * agraph);
 int agoOptimizeDramaMerge(AgoGraph * agraph);
 int agoOptimizeDramaAlloc(AgoGraph * agraph);
+int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph);
 // import
 void agoImportKernelConfig(AgoKernel * kernel, vx_kernel vxkernel);
 void agoImportNodeConfig(AgoNode * node, vx_node vxnode);
@@ -810,6 +892,8 @@ void agoImportDataConfig(AgoData * data, vx_reference vxref, AgoGraph * graph);
 void agoEvaluateIntegerExpression(char * expr);
 // performance
 void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_reference ref);
+void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_reference ref, int64_t time);
+void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_reference ref, int64_t time, std::thread::id thread);
 void agoPerfCaptureReset(vx_perf_t * perf);
 void agoPerfCaptureStart(vx_perf_t * perf);
 void agoPerfCaptureStop(vx_perf_t * perf);
@@ -857,12 +941,23 @@ int agoAgeDelay(AgoData * delay);
 int agoProcessGraph(AgoGraph * agraph);
 int agoScheduleGraph(AgoGraph * agraph);
 int agoWaitGraph(AgoGraph * agraph);
+int agoScheduleGraphFrame(AgoGraph * agraph, vx_uint64 * frame);
+int agoWaitGraphFrame(AgoGraph * agraph, vx_uint64 frame);
+int agoSetGraphPipelineConfig(AgoGraph * agraph, vx_uint32 depth, vx_uint32 numParams, const AgoGraphParameterQueueInfo * params);
+int agoInitializeGraphPipeline(AgoGraph * agraph);
+void agoStopGraphPipeline(AgoGraph * agraph);
+int agoGraphParameterEnqueueReadyRef(AgoGraph * agraph, vx_uint32 index, AgoReference * * refs, vx_uint32 numRefs);
+int agoGraphParameterDequeueDoneRef(AgoGraph * agraph, vx_uint32 index, AgoReference * * refs, vx_uint32 maxRefs, vx_uint32 * numRefs);
+int agoGraphParameterCheckDoneRef(AgoGraph * agraph, vx_uint32 index, vx_uint32 * numRefs);
 int agoWriteGraph(AgoGraph * agraph, AgoReference * * ref, int num_ref, FILE * fp, const char * comment);
 int agoReadGraph(AgoGraph * agraph, AgoReference * * ref, int num_ref, ago_data_registry_callback_f callback_f, void * callback_obj, FILE * fp, vx_int32 dumpToConsole);
 int agoReadGraphFromString(AgoGraph * agraph, AgoReference * * ref, int num_ref, ago_data_registry_callback_f callback_f, void * callback_obj, char * str, vx_int32 dumpToConsole);
+int agoReadGraphWithCache(AgoGraph * agraph, AgoReference * * ref, int num_ref, ago_data_registry_callback_f callback_f, void * callback_obj, char * str, vx_int32 dumpToConsole, const char * cacheFolder);
+int agoWriteCompiledGraph(AgoGraph * agraph);
 int agoLoadModule(AgoContext * context, const char * module);
 int agoUnloadModule(AgoContext * context, const char * module);
 vx_status agoGraphDumpPerformanceProfile(AgoGraph * graph, const char * fileName);
+vx_status agoGraphDumpPerformanceTrace(AgoGraph * graph, const char * fileName);
 vx_status agoDirective(vx_reference reference, vx_enum directive);
 
 ///////////////////////////////////////////////////////////
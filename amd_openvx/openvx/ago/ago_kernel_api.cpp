@@ -312,6 +312,60 @@ static int ValidateArguments_OpticalFlowPyrLK_XY_XY(AgoNode * node)
 	return VX_SUCCESS;
 }
 
+// returns the maximum number of row bands a node's output is split into by agoExecuteRowBands
+static vx_uint32 agoGetRowBandCount(AgoNode * node)
+{
+	AgoContext * context = node->ref.context;
+	if (!context->thread_pool || !(context->thread_config & CONFIG_THREAD_TILED_KERNELS))
+		return 1;
+	return (vx_uint32)context->thread_pool->threadCount();
+}
+
+// executes a row-local HAF kernel on horizontal bands of the output rows [0, height) using the context thread pool:
+//   band(y, rows, localData) processes the output rows y..y+rows-1 and reads the neighbouring input rows it needs (halo) in place
+//   bands start at a multiple of rowAlignment, so that sub-sampled chroma rows are never shared by two bands
+//   each band gets its own localDataBandSize bytes of node->localDataPtr as scratch memory
+static int agoExecuteRowBands(AgoNode * node, vx_uint32 height, vx_uint32 rowAlignment, vx_size localDataBandSize,
+	const std::function<int(vx_uint32 y, vx_uint32 rows, vx_uint8 * localData)>& band)
+{
+	vx_uint32 bandCount = min(agoGetRowBandCount(node), height / CONFIG_THREAD_MIN_ROWS_PER_BAND);
+	if (bandCount < 2)
+		return band(0, height, node->localDataPtr);
+	vx_uint32 bandHeight = (height + bandCount - 1) / bandCount;
+	bandHeight = (bandHeight + rowAlignment - 1) / rowAlignment * rowAlignment;
+	bandCount = (height + bandHeight - 1) / bandHeight;
+	std::vector<int> bandStatus(bandCount, VX_SUCCESS);
+	node->ref.context->thread_pool->run(bandCount, [&](size_t i) {
+		vx_uint32 y = (vx_uint32)i * bandHeight;
+		bandStatus[i] = band(y, min(bandHeight, height - y), node->localDataPtr ? node->localDataPtr + i * localDataBandSize : nullptr);
+	});
+	for (auto status : bandStatus) {
+		if (status)
+			return status;
+	}
+	return VX_SUCCESS;
+}
+
+// executes a statistics HAF kernel on horizontal bands of the rows [0, height) using the context thread pool:
+//   band(y, rows, partial) reduces the rows y..y+rows-1 into its own partialSize bytes of node->localDataPtr
+//   partials receives the partial results of all bands for the merge
+//   node->localDataSize must be at least agoGetRowBandCount(node) * partialSize
+static int agoExecuteRowBandReduction(AgoNode * node, vx_uint32 height, vx_size partialSize,
+	const std::function<int(vx_uint32 y, vx_uint32 rows, vx_uint8 * partial)>& band, std::vector<vx_uint8 *>& partials)
+{
+	std::vector<vx_uint8 *> bandPartials(agoGetRowBandCount(node), nullptr);
+	int status = agoExecuteRowBands(node, height, 1, partialSize, [&](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+		bandPartials[(localData - node->localDataPtr) / partialSize] = localData;
+		return band(y, rows, localData);
+	});
+	partials.clear();
+	for (auto partial : bandPartials) {
+		if (partial)
+			partials.push_back(partial);
+	}
+	return status;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // OpenVX 1.0 built-in kernels
 //
@@ -9077,7 +9131,7 @@ int agoKernel_ChannelExtract_U8_U24_Pos0(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U24_Pos0(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U24_Pos0(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -9126,7 +9180,7 @@ int agoKernel_ChannelExtract_U8_U24_Pos1(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U24_Pos1(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U24_Pos1(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -9175,7 +9229,7 @@ int agoKernel_ChannelExtract_U8_U24_Pos2(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U24_Pos2(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U24_Pos2(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -9224,7 +9278,7 @@ int agoKernel_ChannelExtract_U8_U32_Pos0(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U32_Pos0(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U32_Pos0(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -9304,7 +9358,7 @@ int agoKernel_ChannelExtract_U8_U32_Pos1(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U32_Pos1(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U32_Pos1(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -9383,7 +9437,7 @@ int agoKernel_ChannelExtract_U8_U32_Pos2(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U32_Pos2(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U32_Pos2(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -9461,7 +9515,7 @@ int agoKernel_ChannelExtract_U8_U32_Pos3(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ChannelExtract_U8_U32_Pos3(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		if (g_hafCpuDispatch.ChannelExtract_U8_U32_Pos3(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -10000,7 +10054,7 @@ int agoKernel_ChannelCombine_U32_U8U8U8U8_RGBX(AgoNode * node, AgoKernelCommand
 		AgoData * iImg2 = node->paramList[2];
 		AgoData * iImg3 = node->paramList[3];
 		AgoData * iImg4 = node->paramList[4];
-		if (HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, 
+		if (g_hafCpuDispatch.ChannelCombine_U32_U8U8U8U8_RGBX(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, 
 			                                        iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes, 
 													iImg3->buffer, iImg3->u.img.stride_in_bytes, iImg4->buffer, iImg4->u.img.stride_in_bytes))
 		{
@@ -10248,11 +10302,10 @@ int agoKernel_ColorConvert_RGB_RGBX(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ColorConvert_RGB_RGBX(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										 iImg->buffer, iImg->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return g_hafCpuDispatch.ColorConvert_RGB_RGBX(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											 iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGB, VX_DF_IMAGE_RGBX);
@@ -10396,12 +10449,11 @@ int agoKernel_ColorConvert_RGB_IYUV(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * iImg1 = node->paramList[1];
 		AgoData * iImg2 = node->paramList[2];
 		AgoData * iImg3 = node->paramList[3];
-		if (HafCpu_ColorConvert_RGB_IYUV(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										 iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes,
-										 iImg3->buffer, iImg3->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_RGB_IYUV(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											 iImg1->buffer + iImg1->u.img.stride_in_bytes * y, iImg1->u.img.stride_in_bytes, iImg2->buffer + iImg2->u.img.stride_in_bytes * (y >> 1), iImg2->u.img.stride_in_bytes,
+											 iImg3->buffer + iImg3->u.img.stride_in_bytes * (y >> 1), iImg3->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -10456,11 +10508,10 @@ int agoKernel_ColorConvert_RGB_NV12(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg1 = node->paramList[1];
 		AgoData * iImg2 = node->paramList[2];
-		if (HafCpu_ColorConvert_RGB_NV12(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										 iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_RGB_NV12(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											 iImg1->buffer + iImg1->u.img.stride_in_bytes * y, iImg1->u.img.stride_in_bytes, iImg2->buffer + iImg2->u.img.stride_in_bytes * (y >> 1), iImg2->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -10514,11 +10565,10 @@ int agoKernel_ColorConvert_RGB_NV21(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg1 = node->paramList[1];
 		AgoData * iImg2 = node->paramList[2];
-		if (HafCpu_ColorConvert_RGB_NV21(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										 iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_RGB_NV21(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											 iImg1->buffer + iImg1->u.img.stride_in_bytes * y, iImg1->u.img.stride_in_bytes, iImg2->buffer + iImg2->u.img.stride_in_bytes * (y >> 1), iImg2->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -10571,11 +10621,10 @@ int agoKernel_ColorConvert_RGBX_RGB(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ColorConvert_RGBX_RGB(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										 iImg->buffer, iImg->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return g_hafCpuDispatch.ColorConvert_RGBX_RGB(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											 iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGBX, VX_DF_IMAGE_RGB);
@@ -10723,12 +10772,11 @@ int agoKernel_ColorConvert_RGBX_IYUV(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * iImg1 = node->paramList[1];
 		AgoData * iImg2 = node->paramList[2];
 		AgoData * iImg3 = node->paramList[3];
-		if (HafCpu_ColorConvert_RGBX_IYUV(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										  iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes,
-										  iImg3->buffer, iImg3->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_RGBX_IYUV(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											  iImg1->buffer + iImg1->u.img.stride_in_bytes * y, iImg1->u.img.stride_in_bytes, iImg2->buffer + iImg2->u.img.stride_in_bytes * (y >> 1), iImg2->u.img.stride_in_bytes,
+											  iImg3->buffer + iImg3->u.img.stride_in_bytes * (y >> 1), iImg3->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -10783,11 +10831,10 @@ int agoKernel_ColorConvert_RGBX_NV12(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg1 = node->paramList[1];
 		AgoData * iImg2 = node->paramList[2];
-		if (HafCpu_ColorConvert_RGBX_NV12(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										  iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_RGBX_NV12(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											  iImg1->buffer + iImg1->u.img.stride_in_bytes * y, iImg1->u.img.stride_in_bytes, iImg2->buffer + iImg2->u.img.stride_in_bytes * (y >> 1), iImg2->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -10841,11 +10888,10 @@ int agoKernel_ColorConvert_RGBX_NV21(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg1 = node->paramList[1];
 		AgoData * iImg2 = node->paramList[2];
-		if (HafCpu_ColorConvert_RGBX_NV21(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										  iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_RGBX_NV21(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes,
+											  iImg1->buffer + iImg1->u.img.stride_in_bytes * y, iImg1->u.img.stride_in_bytes, iImg2->buffer + iImg2->u.img.stride_in_bytes * (y >> 1), iImg2->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -11208,12 +11254,11 @@ int agoKernel_ColorConvert_IYUV_RGB(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImgU = node->paramList[1];
 		AgoData * oImgV = node->paramList[2];
 		AgoData * iImg = node->paramList[3];
-		if (HafCpu_ColorConvert_IYUV_RGB(oImgY->u.img.width, oImgY->u.img.height, oImgY->buffer, oImgY->u.img.stride_in_bytes,
-										 oImgU->buffer, oImgU->u.img.stride_in_bytes, oImgV->buffer, oImgV->u.img.stride_in_bytes,
-										 iImg->buffer, iImg->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImgY->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_IYUV_RGB(oImgY->u.img.width, rows, oImgY->buffer + oImgY->u.img.stride_in_bytes * y, oImgY->u.img.stride_in_bytes,
+											 oImgU->buffer + oImgU->u.img.stride_in_bytes * (y >> 1), oImgU->u.img.stride_in_bytes, oImgV->buffer + oImgV->u.img.stride_in_bytes * (y >> 1), oImgV->u.img.stride_in_bytes,
+											 iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -11286,12 +11331,11 @@ int agoKernel_ColorConvert_IYUV_RGBX(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImgU = node->paramList[1];
 		AgoData * oImgV = node->paramList[2];
 		AgoData * iImg = node->paramList[3];
-		if (HafCpu_ColorConvert_IYUV_RGBX(oImgY->u.img.width, oImgY->u.img.height, oImgY->buffer, oImgY->u.img.stride_in_bytes,
-										  oImgU->buffer, oImgU->u.img.stride_in_bytes, oImgV->buffer, oImgV->u.img.stride_in_bytes,
-										  iImg->buffer, iImg->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImgY->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_IYUV_RGBX(oImgY->u.img.width, rows, oImgY->buffer + oImgY->u.img.stride_in_bytes * y, oImgY->u.img.stride_in_bytes,
+											  oImgU->buffer + oImgU->u.img.stride_in_bytes * (y >> 1), oImgU->u.img.stride_in_bytes, oImgV->buffer + oImgV->u.img.stride_in_bytes * (y >> 1), oImgV->u.img.stride_in_bytes,
+											  iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -11586,11 +11630,10 @@ int agoKernel_ColorConvert_NV12_RGB(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImgY = node->paramList[0];
 		AgoData * oImgC = node->paramList[1];
 		AgoData * iImg  = node->paramList[2];
-		if (HafCpu_ColorConvert_NV12_RGB(oImgY->u.img.width, oImgY->u.img.height, oImgY->buffer, oImgY->u.img.stride_in_bytes,
-										 oImgC->buffer, oImgC->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImgY->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_NV12_RGB(oImgY->u.img.width, rows, oImgY->buffer + oImgY->u.img.stride_in_bytes * y, oImgY->u.img.stride_in_bytes,
+											 oImgC->buffer + oImgC->u.img.stride_in_bytes * (y >> 1), oImgC->u.img.stride_in_bytes, iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -11653,11 +11696,10 @@ int agoKernel_ColorConvert_NV12_RGBX(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImgY = node->paramList[0];
 		AgoData * oImgC = node->paramList[1];
 		AgoData * iImg  = node->paramList[2];
-		if (HafCpu_ColorConvert_NV12_RGBX(oImgY->u.img.width, oImgY->u.img.height, oImgY->buffer, oImgY->u.img.stride_in_bytes,
-										  oImgC->buffer, oImgC->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImgY->u.img.height, 2, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_NV12_RGBX(oImgY->u.img.width, rows, oImgY->buffer + oImgY->u.img.stride_in_bytes * y, oImgY->u.img.stride_in_bytes,
+											  oImgC->buffer + oImgC->u.img.stride_in_bytes * (y >> 1), oImgC->u.img.stride_in_bytes, iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -11898,9 +11940,9 @@ int agoKernel_ColorConvert_Y_RGB(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ColorConvert_Y_RGB(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_Y_RGB(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes, iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_RGB);
@@ -11947,9 +11989,9 @@ int agoKernel_ColorConvert_Y_RGBX(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ColorConvert_Y_RGBX(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg->buffer, iImg->u.img.stride_in_bytes)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_ColorConvert_Y_RGBX(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * y, oImg->u.img.stride_in_bytes, iImg->buffer + iImg->u.img.stride_in_bytes * y, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_RGBX);
@@ -12648,17 +12690,17 @@ int agoKernel_Box_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Box_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, node->localDataSize / agoGetRowBandCount(node), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return g_hafCpuDispatch.Box_U8_U8_3x3(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y), oImg->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes, localData) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth * sizeof(vx_uint16);				// Three rows (+some extra) worth of scratch memory			
+		node->localDataSize = agoGetRowBandCount(node) * 3 * alignedWidth * sizeof(vx_uint16);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -12702,10 +12744,10 @@ int agoKernel_Dilate_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Dilate_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return g_hafCpuDispatch.Dilate_U8_U8_3x3(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y), oImg->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -12747,10 +12789,10 @@ int agoKernel_Erode_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Erode_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return g_hafCpuDispatch.Erode_U8_U8_3x3(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y), oImg->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -12792,10 +12834,10 @@ int agoKernel_Median_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Median_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes, 
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, 0, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_Median_U8_U8_3x3(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y), oImg->u.img.stride_in_bytes, 
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -12837,17 +12879,17 @@ int agoKernel_Gaussian_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Gaussian_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, node->localDataSize / agoGetRowBandCount(node), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return g_hafCpuDispatch.Gaussian_U8_U8_3x3(oImg->u.img.width, rows, oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y), oImg->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes, localData) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth * sizeof(vx_uint16);				// Three rows (+some extra) worth of scratch memory			
+		node->localDataSize = agoGetRowBandCount(node) * 3 * alignedWidth * sizeof(vx_uint16);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -13083,6 +13125,60 @@ int agoKernel_ScaleGaussianOrb_U8_U8_5x5(AgoNode * node, AgoKernelCommand cmd)
 	return status;
 }
 
+// checks whether a rank-1 convolution matrix of this size is cheaper as separate horizontal and vertical passes
+static bool agoUseSeparableConvolution(AgoData * conv)
+{
+	vx_size columns = conv->u.conv.columns, rows = conv->u.conv.rows;
+	return columns * rows >= 2 * (columns + rows);
+}
+
+// factors a rank-1 convolution matrix into its flipped row and column coefficients, so that
+//   dst(x,y) = sum_i colCoeff[i] * sum_j rowCoeff[j] * src(x-M+j, y-N+i)
+// gives exactly the sums of the direct convolution; returns false when the matrix isn't separable
+static bool agoGetSeparableConvolution(AgoData * conv, std::vector<vx_int16>& rowCoeff, std::vector<vx_int16>& colCoeff)
+{
+	vx_uint32 columns = (vx_uint32)conv->u.conv.columns, rows = (vx_uint32)conv->u.conv.rows;
+	const vx_int16 * matrix = (const vx_int16 *)conv->buffer;
+	// the first non-zero row divided by the gcd of its coefficients is the row factor
+	vx_uint32 r0 = 0, c0 = 0;
+	for (; r0 < rows; r0++) {
+		for (c0 = 0; c0 < columns && !matrix[r0 * columns + c0]; c0++)
+			;
+		if (c0 < columns)
+			break;
+	}
+	if (r0 == rows)
+		return false;
+	vx_int32 g = 0;
+	for (vx_uint32 c = 0; c < columns; c++) {
+		vx_int32 a = abs((vx_int32)matrix[r0 * columns + c]);
+		while (a) { vx_int32 t = g % a; g = a; a = t; }
+	}
+	if (matrix[r0 * columns + c0] < 0)
+		g = -g;
+	std::vector<vx_int32> h(columns), v(rows);
+	for (vx_uint32 c = 0; c < columns; c++) {
+		h[c] = matrix[r0 * columns + c] / g;
+		if (h[c] > 32767)
+			return false;
+	}
+	// every row must be an integer multiple of the row factor
+	for (vx_uint32 r = 0; r < rows; r++) {
+		v[r] = matrix[r * columns + c0] / h[c0];
+		for (vx_uint32 c = 0; c < columns; c++) {
+			if (matrix[r * columns + c] != v[r] * h[c])
+				return false;
+		}
+	}
+	rowCoeff.resize(columns);
+	colCoeff.resize(rows);
+	for (vx_uint32 c = 0; c < columns; c++)
+		rowCoeff[columns - 1 - c] = (vx_int16)h[c];
+	for (vx_uint32 r = 0; r < rows; r++)
+		colCoeff[rows - 1 - r] = (vx_int16)v[r];
+	return true;
+}
+
 int agoKernel_Convolve_U8_U8(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
@@ -13093,31 +13189,45 @@ int agoKernel_Convolve_U8_U8(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * iConv = node->paramList[2];
 		vx_uint32 convolutionWidth = (vx_uint32)iConv->u.conv.columns;
 		vx_uint32 convolutionHeight = (vx_uint32)iConv->u.conv.rows;
-		if (convolutionWidth == 3) {
-			status = HafCpu_Convolve_U8_U8_3xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else if (convolutionWidth == 5) {
-			status = HafCpu_Convolve_U8_U8_5xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else if (convolutionWidth == 7) {
-			status = HafCpu_Convolve_U8_U8_7xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else if (convolutionWidth == 9) {
-			status = HafCpu_Convolve_U8_U8_9xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else {
-			status = HafCpu_Convolve_U8_U8_MxN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionWidth, convolutionHeight, iConv->u.conv.shift);
-		}
+		// the factors are taken from the current coefficients, which can change after the graph has been verified
+		std::vector<vx_int16> rowCoeff, colCoeff;
+		bool separable = node->localDataPtr && agoGetSeparableConvolution(iConv, rowCoeff, colCoeff);
+		vx_size ringSize = separable ? node->localDataSize / agoGetRowBandCount(node) : 0;
+		status = agoExecuteRowBands(node, oImg->u.img.height - convolutionHeight + 1, 1, ringSize, [=, &rowCoeff, &colCoeff](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			int status;
+			if (separable) {
+				status = HafCpu_ConvolveSeparable_U8_U8(oImg->u.img.width, rows,
+					(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes,
+					rowCoeff.data(), convolutionWidth, colCoeff.data(), convolutionHeight, iConv->u.conv.shift, (vx_int32 *)localData);
+			}
+			else if (convolutionWidth == 3) {
+				status = HafCpu_Convolve_U8_U8_3xN(oImg->u.img.width, rows,
+					oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else if (convolutionWidth == 5) {
+				status = HafCpu_Convolve_U8_U8_5xN(oImg->u.img.width, rows,
+					oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else if (convolutionWidth == 7) {
+				status = HafCpu_Convolve_U8_U8_7xN(oImg->u.img.width, rows,
+					oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else if (convolutionWidth == 9) {
+				status = HafCpu_Convolve_U8_U8_9xN(oImg->u.img.width, rows,
+					oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else {
+				status = HafCpu_Convolve_U8_U8_MxN(oImg->u.img.width, rows,
+					oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionWidth, convolutionHeight, iConv->u.conv.shift);
+			}
+			return status;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -13139,7 +13249,13 @@ int agoKernel_Convolve_U8_U8(AgoNode * node, AgoKernelCommand cmd)
 		meta->data.u.img.format = VX_DF_IMAGE_U8;
 		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// ring of horizontally filtered rows for the separable convolution of each row band
+		if (agoUseSeparableConvolution(node->paramList[2]))
+			node->localDataSize = agoGetRowBandCount(node) * node->paramList[2]->u.conv.rows * CONFIG_CPU_CONVOLVE_TILE_WIDTH * sizeof(vx_int32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
 #if ENABLE_OPENCL
@@ -13181,31 +13297,45 @@ int agoKernel_Convolve_S16_U8(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * iConv = node->paramList[2];
 		vx_uint32 convolutionWidth = (vx_uint32)iConv->u.conv.columns;
 		vx_uint32 convolutionHeight = (vx_uint32)iConv->u.conv.rows;
-		if (convolutionWidth == 3) {
-			status = HafCpu_Convolve_S16_U8_3xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1)), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else if (convolutionWidth == 5) {
-			status = HafCpu_Convolve_S16_U8_5xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1)), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else if (convolutionWidth == 7) {
-			status = HafCpu_Convolve_S16_U8_7xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1)), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else if (convolutionWidth == 9) {
-			status = HafCpu_Convolve_S16_U8_9xN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1)), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
-		}
-		else {
-			status = HafCpu_Convolve_S16_U8_MxN(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
-				(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1)), oImg->u.img.stride_in_bytes,
-				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionWidth, convolutionHeight, iConv->u.conv.shift);
-		}
+		// the factors are taken from the current coefficients, which can change after the graph has been verified
+		std::vector<vx_int16> rowCoeff, colCoeff;
+		bool separable = node->localDataPtr && agoGetSeparableConvolution(iConv, rowCoeff, colCoeff);
+		vx_size ringSize = separable ? node->localDataSize / agoGetRowBandCount(node) : 0;
+		status = agoExecuteRowBands(node, oImg->u.img.height - convolutionHeight + 1, 1, ringSize, [=, &rowCoeff, &colCoeff](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			int status;
+			if (separable) {
+				status = HafCpu_ConvolveSeparable_S16_U8(oImg->u.img.width, rows,
+					(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes,
+					rowCoeff.data(), convolutionWidth, colCoeff.data(), convolutionHeight, iConv->u.conv.shift, (vx_int32 *)localData);
+			}
+			else if (convolutionWidth == 3) {
+				status = HafCpu_Convolve_S16_U8_3xN(oImg->u.img.width, rows,
+					(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else if (convolutionWidth == 5) {
+				status = HafCpu_Convolve_S16_U8_5xN(oImg->u.img.width, rows,
+					(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else if (convolutionWidth == 7) {
+				status = HafCpu_Convolve_S16_U8_7xN(oImg->u.img.width, rows,
+					(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else if (convolutionWidth == 9) {
+				status = HafCpu_Convolve_S16_U8_9xN(oImg->u.img.width, rows,
+					(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionHeight, iConv->u.conv.shift);
+			}
+			else {
+				status = HafCpu_Convolve_S16_U8_MxN(oImg->u.img.width, rows,
+					(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y)), oImg->u.img.stride_in_bytes,
+					iImg->buffer + iImg->u.img.stride_in_bytes * ((convolutionHeight >> 1) + y), iImg->u.img.stride_in_bytes, (vx_int16 *)iConv->buffer, convolutionWidth, convolutionHeight, iConv->u.conv.shift);
+			}
+			return status;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -13227,7 +13357,13 @@ int agoKernel_Convolve_S16_U8(AgoNode * node, AgoKernelCommand cmd)
 		meta->data.u.img.format = VX_DF_IMAGE_S16;
 		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// ring of horizontally filtered rows for the separable convolution of each row band
+		if (agoUseSeparableConvolution(node->paramList[2]))
+			node->localDataSize = agoGetRowBandCount(node) * node->paramList[2]->u.conv.rows * CONFIG_CPU_CONVOLVE_TILE_WIDTH * sizeof(vx_int32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
 #if ENABLE_OPENCL
@@ -13585,20 +13721,19 @@ int agoKernel_Sobel_S16S16_U8_3x3_GXY(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg1 = node->paramList[0];
 		AgoData * oImg2 = node->paramList[1];
 		AgoData * iImg = node->paramList[2];
-		if (HafCpu_Sobel_S16S16_U8_3x3_GXY(oImg1->u.img.width, oImg1->u.img.height - 2, 
-			(vx_int16 *)(oImg1->buffer + oImg1->u.img.stride_in_bytes), oImg1->u.img.stride_in_bytes,
-			(vx_int16 *)(oImg2->buffer + oImg2->u.img.stride_in_bytes), oImg2->u.img.stride_in_bytes,
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr))
-		{
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg1->u.img.height - 2, 1, node->localDataSize / agoGetRowBandCount(node), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_Sobel_S16S16_U8_3x3_GXY(oImg1->u.img.width, rows, 
+				(vx_int16 *)(oImg1->buffer + oImg1->u.img.stride_in_bytes * (1 + y)), oImg1->u.img.stride_in_bytes,
+				(vx_int16 *)(oImg2->buffer + oImg2->u.img.stride_in_bytes * (1 + y)), oImg2->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes, localData) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_2OUT_1IN(node, VX_DF_IMAGE_S16, VX_DF_IMAGE_S16, VX_DF_IMAGE_U8, true, 1, 1);
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 6 * alignedWidth * sizeof(vx_int16);				// Three rows (+some extra) worth of scratch memory	- each row is Gx and Gy	
+		node->localDataSize = agoGetRowBandCount(node) * 6 * alignedWidth * sizeof(vx_int16);				// Three rows (+some extra) worth of scratch memory	- each row is Gx and Gy	
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -13643,17 +13778,17 @@ int agoKernel_Sobel_S16_U8_3x3_GX(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Sobel_S16_U8_3x3_GX(oImg->u.img.width, oImg->u.img.height - 2, (vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes), oImg->u.img.stride_in_bytes, 
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, node->localDataSize / agoGetRowBandCount(node), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_Sobel_S16_U8_3x3_GX(oImg->u.img.width, rows, (vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y)), oImg->u.img.stride_in_bytes, 
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes, localData) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_S16, VX_DF_IMAGE_U8, true, 1, 1);
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth * sizeof(vx_int16);				// Three rows (+some extra) worth of scratch memory			
+		node->localDataSize = agoGetRowBandCount(node) * 3 * alignedWidth * sizeof(vx_int16);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -13693,17 +13828,17 @@ int agoKernel_Sobel_S16_U8_3x3_GY(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_Sobel_S16_U8_3x3_GY(oImg->u.img.width, oImg->u.img.height - 2, (vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes), oImg->u.img.stride_in_bytes, 
-			iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr)) {
-			status = VX_FAILURE;
-		}
+		status = agoExecuteRowBands(node, oImg->u.img.height - 2, 1, node->localDataSize / agoGetRowBandCount(node), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+			return HafCpu_Sobel_S16_U8_3x3_GY(oImg->u.img.width, rows, (vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (1 + y)), oImg->u.img.stride_in_bytes, 
+				iImg->buffer + iImg->u.img.stride_in_bytes * (1 + y), iImg->u.img.stride_in_bytes, localData) ? VX_FAILURE : VX_SUCCESS;
+		});
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_S16, VX_DF_IMAGE_U8, true, 1, 1);
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth * sizeof(vx_int16);				// Three rows (+some extra) worth of scratch memory			
+		node->localDataSize = agoGetRowBandCount(node) * 3 * alignedWidth * sizeof(vx_int16);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -15238,6 +15373,76 @@ int agoKernel_NonMaxSupp_XY_ANY_3x3(AgoNode * node, AgoKernelCommand cmd)
 	return status;
 }
 
+// header of the coordinate table of the table-driven bilinear geometric kernels (HafCpu_GeometricTable_*), kept at the
+// start of the node's local data: the table is rebuilt only when the remap or matrix it was built from, or the
+// image layouts, change
+struct AgoGeometricTableHeader {
+	AgoData * source;     // remap or matrix the table was built from
+	vx_uint32 version;    // u.remap.version of the remap
+	vx_float32 matrix[9]; // coefficients of the matrix
+	vx_uint32 dstWidth, dstHeight;
+	vx_uint32 srcWidth, srcHeight, srcStride;
+	bool valid;
+};
+#define AGO_GEOMETRIC_TABLE_OFFSET  ((sizeof(AgoGeometricTableHeader) + 15) & ~15)
+
+// local data size of a table-driven geometric kernel: fallbackDataSize is the scratch memory of the kernel
+// used instead when the source image is smaller than 2x2
+static vx_size agoGetGeometricTableDataSize(AgoNode * node, vx_size fallbackDataSize)
+{
+	vx_size tableSize = AGO_GEOMETRIC_TABLE_OFFSET + (vx_size)node->paramList[0]->u.img.width * node->paramList[0]->u.img.height * sizeof(ago_geometric_table_entry_t);
+	return max(tableSize, fallbackDataSize);
+}
+
+static bool agoUseGeometricTable(AgoNode * node)
+{
+	return node->localDataPtr && node->paramList[1]->u.img.width >= 2 && node->paramList[1]->u.img.height >= 2;
+}
+
+// executes a table-driven geometric kernel on row bands: when the table is stale, build(y, rows, table, tableStrideInBytes)
+// first fills the table rows of the band from source (remap or matrix)
+static int agoExecuteGeometricTable(AgoNode * node, AgoData * source, vx_uint8 border,
+	const std::function<int(vx_uint32 y, vx_uint32 rows, ago_geometric_table_entry_t * table, vx_uint32 tableStrideInBytes)>& build)
+{
+	AgoData * oImg = node->paramList[0];
+	AgoData * iImg = node->paramList[1];
+	AgoGeometricTableHeader * header = (AgoGeometricTableHeader *)node->localDataPtr;
+	bool rebuild = !header->valid || header->source != source ||
+		header->dstWidth != oImg->u.img.width || header->dstHeight != oImg->u.img.height ||
+		header->srcWidth != iImg->u.img.width || header->srcHeight != iImg->u.img.height || header->srcStride != iImg->u.img.stride_in_bytes;
+	if (source->ref.type == VX_TYPE_REMAP)
+		rebuild = rebuild || header->version != source->u.remap.version;
+	else
+		rebuild = rebuild || memcmp(header->matrix, source->buffer, min(source->size, sizeof(header->matrix))) != 0;
+	vx_uint32 tableStrideInBytes = oImg->u.img.width * sizeof(ago_geometric_table_entry_t);
+	vx_uint8 * table = node->localDataPtr + AGO_GEOMETRIC_TABLE_OFFSET;
+	header->valid = header->valid && !rebuild;
+	int status = agoExecuteRowBands(node, oImg->u.img.height, 1, 0, [&](vx_uint32 y, vx_uint32 rows, vx_uint8 * localData) -> int {
+		ago_geometric_table_entry_t * bandTable = (ago_geometric_table_entry_t *)(table + y * tableStrideInBytes);
+		if (rebuild) {
+			int status = build(y, rows, bandTable, tableStrideInBytes);
+			if (status)
+				return status;
+		}
+		return g_hafCpuDispatch.GeometricTable_U8_U8(oImg->u.img.width, rows, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+			iImg->buffer, iImg->u.img.stride_in_bytes, bandTable, tableStrideInBytes, border);
+	});
+	if (rebuild && !status) {
+		header->source = source;
+		if (source->ref.type == VX_TYPE_REMAP)
+			header->version = source->u.remap.version;
+		else
+			memcpy(header->matrix, source->buffer, min(source->size, sizeof(header->matrix)));
+		header->dstWidth = oImg->u.img.width;
+		header->dstHeight = oImg->u.img.height;
+		header->srcWidth = iImg->u.img.width;
+		header->srcHeight = iImg->u.img.height;
+		header->srcStride = iImg->u.img.stride_in_bytes;
+		header->valid = true;
+	}
+	return status;
+}
+
 int agoKernel_Remap_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
@@ -15391,7 +15596,18 @@ int agoKernel_Remap_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMap = node->paramList[2];
-		if (HafCpu_Remap_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+		if (agoUseGeometricTable(node)) {
+			if (agoExecuteGeometricTable(node, iMap, 0, [=](vx_uint32 y, vx_uint32 rows, ago_geometric_table_entry_t * table, vx_uint32 tableStrideInBytes) -> int {
+				vx_uint32 mapStrideInBytes = iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t);
+				return HafCpu_GeometricTable_Remap(oImg->u.img.width, rows, table, tableStrideInBytes,
+					iImg->u.img.width, iImg->u.img.height, iImg->u.img.stride_in_bytes,
+					(ago_coord2d_ushort_t *)(iMap->buffer + y * mapStrideInBytes), mapStrideInBytes, iMap->u.remap.remap_fractional_bits, vx_false_e);
+			}))
+			{
+				status = VX_FAILURE;
+			}
+		}
+		else if (HafCpu_Remap_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
 			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes,
 			(ago_coord2d_ushort_t *)iMap->buffer, iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t)))
 		{
@@ -15412,7 +15628,11 @@ int agoKernel_Remap_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 			meta->data.u.img.format = VX_DF_IMAGE_U8;
 		}
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetGeometricTableDataSize(node, 0);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
 #if ENABLE_OPENCL
@@ -15464,7 +15684,18 @@ int agoKernel_Remap_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelCommand cmd
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMap = node->paramList[2];
-		if (HafCpu_Remap_U8_U8_Bilinear_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+		if (agoUseGeometricTable(node)) {
+			if (agoExecuteGeometricTable(node, iMap, (vx_uint8)node->paramList[3]->u.scalar.u.u, [=](vx_uint32 y, vx_uint32 rows, ago_geometric_table_entry_t * table, vx_uint32 tableStrideInBytes) -> int {
+				vx_uint32 mapStrideInBytes = iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t);
+				return HafCpu_GeometricTable_Remap(oImg->u.img.width, rows, table, tableStrideInBytes,
+					iImg->u.img.width, iImg->u.img.height, iImg->u.img.stride_in_bytes,
+					(ago_coord2d_ushort_t *)(iMap->buffer + y * mapStrideInBytes), mapStrideInBytes, iMap->u.remap.remap_fractional_bits, vx_true_e);
+			}))
+			{
+				status = VX_FAILURE;
+			}
+		}
+		else if (HafCpu_Remap_U8_U8_Bilinear_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
 			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes,
 			(ago_coord2d_ushort_t *)iMap->buffer, iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t), node->paramList[3]->u.scalar.u.u))
 		{
@@ -15487,7 +15718,11 @@ int agoKernel_Remap_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelCommand cmd
 			meta->data.u.img.format = VX_DF_IMAGE_U8;
 		}
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetGeometricTableDataSize(node, 0);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
 #if ENABLE_OPENCL
@@ -16101,7 +16336,7 @@ int agoKernel_WarpAffine_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpAffine_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+		if (g_hafCpuDispatch.WarpAffine_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
 			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer, node->localDataPtr))
 		{
 			status = VX_FAILURE;
@@ -16438,7 +16673,16 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cm
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpPerspective_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+		if (agoUseGeometricTable(node)) {
+			if (agoExecuteGeometricTable(node, iMat, 0, [=](vx_uint32 y, vx_uint32 rows, ago_geometric_table_entry_t * table, vx_uint32 tableStrideInBytes) -> int {
+				return HafCpu_GeometricTable_WarpPerspective(oImg->u.img.width, rows, y, table, tableStrideInBytes,
+					iImg->u.img.width, iImg->u.img.height, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer);
+			}))
+			{
+				status = VX_FAILURE;
+			}
+		}
+		else if (HafCpu_WarpPerspective_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
 			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer, node->localDataPtr))
 		{
 			status = VX_FAILURE;
@@ -16460,7 +16704,7 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cm
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
+		node->localDataSize = agoGetGeometricTableDataSize(node, 3 * alignedWidth*sizeof(float));	// coordinate table, or three rows of scratch memory for the fallback
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16519,7 +16763,16 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelC
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpPerspective_U8_U8_Bilinear_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+		if (agoUseGeometricTable(node)) {
+			if (agoExecuteGeometricTable(node, iMat, (vx_uint8)node->paramList[3]->u.scalar.u.u, [=](vx_uint32 y, vx_uint32 rows, ago_geometric_table_entry_t * table, vx_uint32 tableStrideInBytes) -> int {
+				return HafCpu_GeometricTable_WarpPerspective(oImg->u.img.width, rows, y, table, tableStrideInBytes,
+					iImg->u.img.width, iImg->u.img.height, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer);
+			}))
+			{
+				status = VX_FAILURE;
+			}
+		}
+		else if (HafCpu_WarpPerspective_U8_U8_Bilinear_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
 			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer, node->paramList[3]->u.scalar.u.u, node->localDataPtr))
 		{
 			status = VX_FAILURE;
@@ -16543,7 +16796,7 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelC
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
 		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
+		node->localDataSize = agoGetGeometricTableDataSize(node, 3 * alignedWidth*sizeof(float));	// coordinate table, or three rows of scratch memory for the fallback
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16706,7 +16959,7 @@ int agoKernel_ScaleImage_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_ScaleImage_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+		if (g_hafCpuDispatch.ScaleImage_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
 			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (AgoConfigScaleMatrix *)node->localDataPtr))
 		{
 			status = VX_FAILURE;
@@ -17766,14 +18019,35 @@ int agoKernel_Histogram_DATA_U8(AgoNode * node, AgoKernelCommand cmd)
 		vx_uint32 range = (vx_uint32)oDist->u.dist.range;
 		vx_uint32 window = oDist->u.dist.window;
 		vx_uint32 * histOut = (vx_uint32 *)oDist->buffer;
-		if (HafCpu_HistogramFixedBins_DATA_U8(histOut, numbins, offset, range, window, iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		// each band counts into its own 256-bin histogram, which are then merged into the slot after the last band
+		std::vector<vx_uint8 *> partials;
+		vx_size partialSize = 256 * sizeof(vx_uint32);
+		if (agoExecuteRowBandReduction(node, iImg->u.img.height, partialSize, [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				memset(partial, 0, partialSize);
+				return HafCpu_HistogramFixedBins_DATA_U8((vx_uint32 *)partial, numbins, offset, range, window, iImg->u.img.width, rows,
+					iImg->buffer + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
+		{
 			status = VX_FAILURE;
 		}
+		else {
+			vx_uint32 * histMerged = (vx_uint32 *)(node->localDataPtr + agoGetRowBandCount(node) * partialSize);
+			if (HafCpu_HistogramMerge_DATA_DATA(histMerged, (vx_uint32)partials.size(), (vx_uint32 **)partials.data())) {
+				status = VX_FAILURE;
+			}
+			else {
+				memcpy(histOut, histMerged, numbins * sizeof(vx_uint32));
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1IN(node, VX_DF_IMAGE_U8);
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = (agoGetRowBandCount(node) + 1) * 256 * sizeof(vx_uint32);	// partial histograms of all bands and the merged histogram
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -17792,19 +18066,36 @@ int agoKernel_MeanStdDev_DATA_U8(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oData = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_MeanStdDev_DATA_U8(&((ago_meanstddev_data_t *)oData->buffer)->sum, &((ago_meanstddev_data_t *)oData->buffer)->sumSquared, 
-			iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_uint8 * pSrc = iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, sizeof(ago_meanstddev_data_t), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				return HafCpu_MeanStdDev_DATA_U8(&((ago_meanstddev_data_t *)partial)->sum, &((ago_meanstddev_data_t *)partial)->sumSquared,
+					width, rows, pSrc + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
+		{
 			status = VX_FAILURE;
 		}
 		else {
-			((ago_meanstddev_data_t *)oData->buffer)->sampleCount = (iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x) * (iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y);
+			ago_meanstddev_data_t * data = (ago_meanstddev_data_t *)oData->buffer;
+			data->sum = 0;
+			data->sumSquared = 0;
+			for (auto partial : partials) {
+				data->sum += ((ago_meanstddev_data_t *)partial)->sum;
+				data->sumSquared += ((ago_meanstddev_data_t *)partial)->sumSquared;
+			}
+			data->sampleCount = width * height;
 		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1IN(node, VX_DF_IMAGE_U8);
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * sizeof(ago_meanstddev_data_t);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -17823,16 +18114,38 @@ int agoKernel_MinMax_DATA_U8(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oData = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_MinMax_DATA_U8(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
-			iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_uint8 * pSrc = iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, sizeof(ago_minmaxloc_data_t), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				return HafCpu_MinMax_DATA_U8(&((ago_minmaxloc_data_t *)partial)->min, &((ago_minmaxloc_data_t *)partial)->max,
+					width, rows, pSrc + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
+		{
 			status = VX_FAILURE;
 		}
+		else {
+			std::vector<vx_int32> srcMinValue, srcMaxValue;
+			for (auto partial : partials) {
+				srcMinValue.push_back(((ago_minmaxloc_data_t *)partial)->min);
+				srcMaxValue.push_back(((ago_minmaxloc_data_t *)partial)->max);
+			}
+			if (HafCpu_MinMaxMerge_DATA_DATA(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
+				(vx_uint32)partials.size(), srcMinValue.data(), srcMaxValue.data()))
+			{
+				status = VX_FAILURE;
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1IN(node, VX_DF_IMAGE_U8);
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * sizeof(ago_minmaxloc_data_t);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -17851,16 +18164,108 @@ int agoKernel_MinMax_DATA_S16(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oData = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_MinMax_DATA_S16(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
-			iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_int16 * pSrc = (vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, sizeof(ago_minmaxloc_data_t), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				return HafCpu_MinMax_DATA_S16(&((ago_minmaxloc_data_t *)partial)->min, &((ago_minmaxloc_data_t *)partial)->max,
+					width, rows, (vx_int16 *)((vx_uint8 *)pSrc + y * iImg->u.img.stride_in_bytes), iImg->u.img.stride_in_bytes);
+			}, partials))
+		{
 			status = VX_FAILURE;
 		}
+		else {
+			std::vector<vx_int32> srcMinValue, srcMaxValue;
+			for (auto partial : partials) {
+				srcMinValue.push_back(((ago_minmaxloc_data_t *)partial)->min);
+				srcMaxValue.push_back(((ago_minmaxloc_data_t *)partial)->max);
+			}
+			if (HafCpu_MinMaxMerge_DATA_DATA(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
+				(vx_uint32)partials.size(), srcMinValue.data(), srcMaxValue.data()))
+			{
+				status = VX_FAILURE;
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1IN(node, VX_DF_IMAGE_S16);
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * sizeof(ago_minmaxloc_data_t);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
+	}
+    else if (cmd == ago_kernel_cmd_query_target_support) {
+        node->target_support_flags = 0
+                    | AGO_KERNEL_FLAG_DEVICE_CPU
+                    ;
+        status = VX_SUCCESS;
+    }
+	return status;
+}
+
+int agoKernel_MinMaxMeanStdDev_DATADATA_U8(AgoNode * node, AgoKernelCommand cmd)
+{
+	// INFO: replaces VX_KERNEL_AMD_MIN_MAX_DATA_U8 and VX_KERNEL_AMD_MEAN_STD_DEV_DATA_U8 nodes of the same image
+	//       so that the image is read only once
+	struct Partial {
+		ago_minmaxloc_data_t minmax;
+		ago_meanstddev_data_t meanstddev;
+	};
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oMinMax = node->paramList[0];
+		AgoData * oMeanStdDev = node->paramList[1];
+		AgoData * iImg = node->paramList[2];
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_uint8 * pSrc = iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, sizeof(Partial), [=](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				Partial * part = (Partial *)partial;
+				return HafCpu_MinMaxMeanStdDev_DATA_U8(&part->minmax.min, &part->minmax.max, &part->meanstddev.sum, &part->meanstddev.sumSquared,
+					width, rows, pSrc + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
+		{
+			status = VX_FAILURE;
+		}
+		else {
+			std::vector<vx_int32> srcMinValue, srcMaxValue;
+			ago_meanstddev_data_t * meanstddev = (ago_meanstddev_data_t *)oMeanStdDev->buffer;
+			meanstddev->sum = 0;
+			meanstddev->sumSquared = 0;
+			for (auto partial : partials) {
+				Partial * part = (Partial *)partial;
+				srcMinValue.push_back(part->minmax.min);
+				srcMaxValue.push_back(part->minmax.max);
+				meanstddev->sum += part->meanstddev.sum;
+				meanstddev->sumSquared += part->meanstddev.sumSquared;
+			}
+			meanstddev->sampleCount = width * height;
+			if (HafCpu_MinMaxMerge_DATA_DATA(&((ago_minmaxloc_data_t *)oMinMax->buffer)->min, &((ago_minmaxloc_data_t *)oMinMax->buffer)->max,
+				(vx_uint32)partials.size(), srcMinValue.data(), srcMaxValue.data()))
+			{
+				status = VX_FAILURE;
+			}
+		}
+	}
+	else if (cmd == ago_kernel_cmd_validate) {
+		// validate parameters
+		if (node->paramList[2]->u.img.format != VX_DF_IMAGE_U8)
+			return VX_ERROR_INVALID_FORMAT;
+		else if (!node->paramList[2]->u.img.width || !node->paramList[2]->u.img.height)
+			return VX_ERROR_INVALID_DIMENSION;
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * sizeof(Partial);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18046,13 +18451,24 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min(AgoNode * node, AgoKernel
 			}
 		}
 		AgoData * iImg = node->paramList[1];
-		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_uint8 * pSrc = iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, 2 * sizeof(vx_uint32), [=, &srcMinValue, &srcMaxValue](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				vx_int32 finalMinValue, finalMaxValue;
+				return HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min((vx_uint32 *)partial, &finalMinValue, &finalMaxValue,
+					numDataPartitions, srcMinValue, srcMaxValue, width, rows, pSrc + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
 		{
 			status = VX_FAILURE;
 		}
+		else {
+			node->paramList[0]->u.scalar.u.u = 0;
+			for (auto partial : partials) {
+				node->paramList[0]->u.scalar.u.u += ((vx_uint32 *)partial)[0];
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = VX_SUCCESS;
@@ -18066,7 +18482,11 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min(AgoNode * node, AgoKernel
 		meta = &node->metaList[0];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * 2 * sizeof(vx_uint32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18093,13 +18513,24 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max(AgoNode * node, AgoKernel
 			}
 		}
 		AgoData * iImg = node->paramList[1];
-		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_uint8 * pSrc = iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, 2 * sizeof(vx_uint32), [=, &srcMinValue, &srcMaxValue](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				vx_int32 finalMinValue, finalMaxValue;
+				return HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max((vx_uint32 *)partial, &finalMinValue, &finalMaxValue,
+					numDataPartitions, srcMinValue, srcMaxValue, width, rows, pSrc + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
 		{
 			status = VX_FAILURE;
 		}
+		else {
+			node->paramList[0]->u.scalar.u.u = 0;
+			for (auto partial : partials) {
+				node->paramList[0]->u.scalar.u.u += ((vx_uint32 *)partial)[0];
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = VX_SUCCESS;
@@ -18113,7 +18544,11 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max(AgoNode * node, AgoKernel
 		meta = &node->metaList[0];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * 2 * sizeof(vx_uint32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18140,13 +18575,26 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax(AgoNode * node, AgoKer
 			}
 		}
 		AgoData * iImg = node->paramList[2];
-		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_uint8 * pSrc = iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, 2 * sizeof(vx_uint32), [=, &srcMinValue, &srcMaxValue](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				vx_int32 finalMinValue, finalMaxValue;
+				return HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax((vx_uint32 *)partial, (vx_uint32 *)partial + 1, &finalMinValue, &finalMaxValue,
+					numDataPartitions, srcMinValue, srcMaxValue, width, rows, pSrc + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes);
+			}, partials))
 		{
 			status = VX_FAILURE;
 		}
+		else {
+			node->paramList[0]->u.scalar.u.u = 0;
+			node->paramList[1]->u.scalar.u.u = 0;
+			for (auto partial : partials) {
+				node->paramList[0]->u.scalar.u.u += ((vx_uint32 *)partial)[0];
+				node->paramList[1]->u.scalar.u.u += ((vx_uint32 *)partial)[1];
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = VX_SUCCESS;
@@ -18162,7 +18610,11 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax(AgoNode * node, AgoKer
 		meta = &node->metaList[1];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * 2 * sizeof(vx_uint32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18491,13 +18943,24 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min(AgoNode * node, AgoKerne
 			}
 		}
 		AgoData * iImg = node->paramList[1];
-		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_int16 * pSrc = (vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, 2 * sizeof(vx_uint32), [=, &srcMinValue, &srcMaxValue](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				vx_int32 finalMinValue, finalMaxValue;
+				return HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min((vx_uint32 *)partial, &finalMinValue, &finalMaxValue,
+					numDataPartitions, srcMinValue, srcMaxValue, width, rows, (vx_int16 *)((vx_uint8 *)pSrc + y * iImg->u.img.stride_in_bytes), iImg->u.img.stride_in_bytes);
+			}, partials))
 		{
 			status = VX_FAILURE;
 		}
+		else {
+			node->paramList[0]->u.scalar.u.u = 0;
+			for (auto partial : partials) {
+				node->paramList[0]->u.scalar.u.u += ((vx_uint32 *)partial)[0];
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = VX_SUCCESS;
@@ -18511,7 +18974,11 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min(AgoNode * node, AgoKerne
 		meta = &node->metaList[0];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * 2 * sizeof(vx_uint32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18538,13 +19005,24 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max(AgoNode * node, AgoKerne
 			}
 		}
 		AgoData * iImg = node->paramList[1];
-		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_int16 * pSrc = (vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, 2 * sizeof(vx_uint32), [=, &srcMinValue, &srcMaxValue](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				vx_int32 finalMinValue, finalMaxValue;
+				return HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max((vx_uint32 *)partial, &finalMinValue, &finalMaxValue,
+					numDataPartitions, srcMinValue, srcMaxValue, width, rows, (vx_int16 *)((vx_uint8 *)pSrc + y * iImg->u.img.stride_in_bytes), iImg->u.img.stride_in_bytes);
+			}, partials))
 		{
 			status = VX_FAILURE;
 		}
+		else {
+			node->paramList[0]->u.scalar.u.u = 0;
+			for (auto partial : partials) {
+				node->paramList[0]->u.scalar.u.u += ((vx_uint32 *)partial)[0];
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = VX_SUCCESS;
@@ -18558,7 +19036,11 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max(AgoNode * node, AgoKerne
 		meta = &node->metaList[0];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * 2 * sizeof(vx_uint32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18585,13 +19067,26 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax(AgoNode * node, AgoKe
 			}
 		}
 		AgoData * iImg = node->paramList[2];
-		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 width = iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x;
+		vx_uint32 height = iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y;
+		vx_int16 * pSrc = (vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x;
+		std::vector<vx_uint8 *> partials;
+		if (agoExecuteRowBandReduction(node, height, 2 * sizeof(vx_uint32), [=, &srcMinValue, &srcMaxValue](vx_uint32 y, vx_uint32 rows, vx_uint8 * partial) -> int {
+				vx_int32 finalMinValue, finalMaxValue;
+				return HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax((vx_uint32 *)partial, (vx_uint32 *)partial + 1, &finalMinValue, &finalMaxValue,
+					numDataPartitions, srcMinValue, srcMaxValue, width, rows, (vx_int16 *)((vx_uint8 *)pSrc + y * iImg->u.img.stride_in_bytes), iImg->u.img.stride_in_bytes);
+			}, partials))
 		{
 			status = VX_FAILURE;
 		}
+		else {
+			node->paramList[0]->u.scalar.u.u = 0;
+			node->paramList[1]->u.scalar.u.u = 0;
+			for (auto partial : partials) {
+				node->paramList[0]->u.scalar.u.u += ((vx_uint32 *)partial)[0];
+				node->paramList[1]->u.scalar.u.u += ((vx_uint32 *)partial)[1];
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = VX_SUCCESS;
@@ -18607,7 +19102,11 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax(AgoNode * node, AgoKe
 		meta = &node->metaList[1];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = agoGetRowBandCount(node) * 2 * sizeof(vx_uint32);
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
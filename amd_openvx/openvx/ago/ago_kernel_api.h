@@ -331,6 +331,7 @@ int agoKernel_Histogram_DATA_U8(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_MeanStdDev_DATA_U8(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_MinMax_DATA_U8(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_MinMax_DATA_S16(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_MinMaxMeanStdDev_DATADATA_U8(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_Equalize_DATA_DATA(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_HistogramMerge_DATA_DATA(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_MeanStdDevMerge_DATA_DATA(AgoNode * node, AgoKernelCommand cmd);
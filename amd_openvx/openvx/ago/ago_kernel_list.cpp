@@ -130,6 +130,7 @@ THE SOFTWARE.
 #define ATYPE_DI                               { VX_TYPE_DISTRIBUTION, VX_TYPE_IMAGE }
 #define ATYPE_mI                               { AGO_TYPE_MINMAXLOC_DATA, VX_TYPE_IMAGE }
 #define ATYPE_sI                               { AGO_TYPE_MEANSTDDEV_DATA, VX_TYPE_IMAGE }
+#define ATYPE_msI                              { AGO_TYPE_MINMAXLOC_DATA, AGO_TYPE_MEANSTDDEV_DATA, VX_TYPE_IMAGE }
 #define ATYPE_LDDDDDDDDD                       { VX_TYPE_LUT, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION }
 #define ATYPE_DDDDDDDDDD                       { VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION, VX_TYPE_DISTRIBUTION }
 #define ATYPE_SSssssssss                       { VX_TYPE_SCALAR, VX_TYPE_SCALAR, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA, AGO_TYPE_MEANSTDDEV_DATA }
@@ -472,6 +473,7 @@ static struct {
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_MEAN_STD_DEV_DATA_U8                                    , 1, 0, MeanStdDev_DATA_U8, AOUT_AIN,                                 ATYPE_sI                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_MIN_MAX_DATA_U8                                         , 1, 0, MinMax_DATA_U8, AOUT_AIN,                                     ATYPE_mI                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_MIN_MAX_DATA_S16                                        , 1, 0, MinMax_DATA_S16, AOUT_AIN,                                    ATYPE_mI                , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_MIN_MAX_MEAN_STD_DEV_DATADATA_U8                        , 1, 0, MinMaxMeanStdDev_DATADATA_U8, AOUTx2_AIN,                     ATYPE_msI               , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_EQUALIZE_DATA_DATA                                      , 1, 0, Equalize_DATA_DATA, AOUT_AIN_AOPTINx8,                        ATYPE_LDDDDDDDDD        , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_HISTOGRAM_MERGE_DATA_DATA                               , 1, 0, HistogramMerge_DATA_DATA, AOUT_AIN_AOPTINx8,                  ATYPE_DDDDDDDDDD        , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_MEAN_STD_DEV_MERGE_DATA_DATA                            , 1, 0, MeanStdDevMerge_DATA_DATA, AOUTx2_AIN_AOPTINx7,               ATYPE_SSssssssss        , KOP_UNKNOWN   , false ),
@@ -409,6 +409,9 @@ enum vx_kernel_amd_e {
 	// Sequential: DATA = op S16 (1)
 	VX_KERNEL_AMD_MIN_MAX_DATA_S16,
 
+	// Sequential: DATA DATA = op U8 (1)
+	VX_KERNEL_AMD_MIN_MAX_MEAN_STD_DEV_DATADATA_U8,
+
 	// Sequential: DATA = op DATA (1)
 	VX_KERNEL_AMD_EQUALIZE_DATA_DATA,
 
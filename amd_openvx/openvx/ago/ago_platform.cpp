@@ -22,10 +22,23 @@ THE SOFTWARE.
 
 
 #include "ago_platform.h"
+#if !_WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-// macro to port VisualStudio __cpuid to g++
+// macros to port VisualStudio __cpuid, __cpuidex, and _xgetbv to g++
 #if !_WIN32
 #define __cpuid(out, infoType) asm("cpuid": "=a" (out[0]), "=b" (out[1]), "=c" (out[2]), "=d" (out[3]): "a" (infoType));
+#define __cpuidex(out, infoType, subLeaf) asm("cpuid": "=a" (out[0]), "=b" (out[1]), "=c" (out[2]), "=d" (out[3]): "a" (infoType), "c" (subLeaf));
+static inline uint64_t agoXgetbv(uint32_t index)
+{
+	uint32_t eax, edx;
+	asm volatile("xgetbv" : "=a" (eax), "=d" (edx) : "c" (index));
+	return ((uint64_t)edx << 32) | eax;
+}
+#else
+#define agoXgetbv(index) _xgetbv(index)
 #endif
 
 #if _WIN32 && ENABLE_OPENCL
@@ -46,6 +59,30 @@ bool agoIsCpuHardwareSupported()
 	return isHardwareSupported;
 }
 
+int agoGetCpuInstructionSet()
+{
+	// returns HAFCPU_ISA_* level: the CPU must support the instructions and
+	// the OS must save the YMM (and for AVX-512 also the opmask and ZMM) registers
+	int isa = 0;
+	int CPUInfo[4] = { -1 };
+	__cpuid(CPUInfo, 0);
+	if (CPUInfo[0] >= 7) {
+		__cpuid(CPUInfo, 1);
+		bool osxsave = (CPUInfo[2] & (1 << 27)) != 0;
+		bool avx = (CPUInfo[2] & (1 << 28)) != 0;
+		if (osxsave && avx) {
+			uint64_t xcr0 = agoXgetbv(0);
+			__cpuidex(CPUInfo, 7, 0);
+			if ((xcr0 & 0x6) == 0x6 && (CPUInfo[1] & (1 << 5))) {
+				isa = 1;
+				if ((xcr0 & 0xe6) == 0xe6 && (CPUInfo[1] & (1 << 16)) && (CPUInfo[1] & (1 << 30)))
+					isa = 2;
+			}
+		}
+	}
+	return isa;
+}
+
 uint32_t agoControlFpSetRoundEven()
 {
 	uint32_t state;
@@ -112,6 +149,38 @@ void agoCloseModule(ago_module module)
 #endif
 }
 
+bool agoGetModuleFileStamp(const void * address, int64_t * fileSize, int64_t * fileTime)
+{
+#if _WIN32
+	HMODULE hmodule = NULL;
+	char path[MAX_PATH] = { 0 };
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+	if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)address, &hmodule) ||
+		!GetModuleFileNameA(hmodule, path, MAX_PATH) || !GetFileAttributesExA(path, GetFileExInfoStandard, &attr))
+		return false;
+	*fileSize = ((int64_t)attr.nFileSizeHigh << 32) | attr.nFileSizeLow;
+	*fileTime = ((int64_t)attr.ftLastWriteTime.dwHighDateTime << 32) | attr.ftLastWriteTime.dwLowDateTime;
+	return true;
+#else
+	Dl_info info;
+	struct stat st;
+	if (!dladdr(address, &info) || !info.dli_fname || stat(info.dli_fname, &st))
+		return false;
+	*fileSize = (int64_t)st.st_size;
+	*fileTime = (int64_t)st.st_mtime;
+	return true;
+#endif
+}
+
+int64_t agoGetProcessId()
+{
+#if _WIN32
+	return (int64_t)GetCurrentProcessId();
+#else
+	return (int64_t)getpid();
+#endif
+}
+
 int64_t agoGetClockCounter()
 {
 #if _WIN32
@@ -134,6 +203,77 @@ int64_t agoGetClockFrequency()
 #endif
 }
 
+AgoThreadPool::AgoThreadPool(size_t threadCount)
+	: batchTask{ nullptr }, batchSize{ 0 }, batchId{ 0 }, batchOpen{ false }, activeWorkers{ 0 }, terminate{ false }, nextTask{ 0 }
+{
+	for (size_t i = 1; i < threadCount; i++) {
+		workers.push_back(thread(&AgoThreadPool::worker, this));
+	}
+}
+
+AgoThreadPool::~AgoThreadPool()
+{
+	{
+		lock_guard<mutex> lock(mtx);
+		terminate = true;
+	}
+	cvStart.notify_all();
+	for (auto& th : workers) {
+		th.join();
+	}
+}
+
+void AgoThreadPool::run(size_t taskCount, const function<void(size_t)>& task)
+{
+	unique_lock<mutex> busy(runLock, try_to_lock);
+	if (!busy.owns_lock() || workers.empty() || taskCount < 2) {
+		for (size_t i = 0; i < taskCount; i++)
+			task(i);
+		return;
+	}
+	{
+		lock_guard<mutex> lock(mtx);
+		batchTask = &task;
+		batchSize = taskCount;
+		nextTask = 0;
+		batchOpen = true;
+		batchId++;
+	}
+	cvStart.notify_all();
+	for (size_t i; (i = nextTask.fetch_add(1)) < taskCount;)
+		task(i);
+	// close the batch so that late workers don't join it and wait for the ones still running a task
+	unique_lock<mutex> lock(mtx);
+	batchOpen = false;
+	cvDone.wait(lock, [this] { return activeWorkers == 0; });
+}
+
+void AgoThreadPool::worker()
+{
+	size_t lastBatchId = 0;
+	for (;;) {
+		const function<void(size_t)> * task;
+		size_t taskCount;
+		{
+			unique_lock<mutex> lock(mtx);
+			cvStart.wait(lock, [&] { return terminate || (batchOpen && batchId != lastBatchId); });
+			if (terminate)
+				return;
+			lastBatchId = batchId;
+			task = batchTask;
+			taskCount = batchSize;
+			activeWorkers++;
+		}
+		for (size_t i; (i = nextTask.fetch_add(1)) < taskCount;)
+			(*task)(i);
+		{
+			lock_guard<mutex> lock(mtx);
+			activeWorkers--;
+		}
+		cvDone.notify_one();
+	}
+}
+
 #if !_WIN32
 #include "ago_internal.h"
 
@@ -142,26 +282,11 @@ int64_t agoGetClockFrequency()
 #include <fenv.h>
 #include <dlfcn.h>
 
-#define VX_SEMAPHORE    1
-#define VX_THREAD       2
 #define VX_CRITICAL_SECTION       3
 
-typedef struct {
-	int type; // should be VX_SEMAPHORE
-	int count;
-	mutex mtx;
-	condition_variable cv;
-} vx_semaphore;
-
-typedef struct {
-    int type;   // should be VX_THREAD
-    thread thread_obj;
-    void* thread_param;
-} vx_thread;
-
 typedef struct {
     int type;   // should be VX_CRITICAL_SECTION
-    mutex mtx;
+    recursive_mutex mtx; // critical sections can be re-entered by the owning thread
 } vx_critical_section;
 
 
@@ -169,7 +294,7 @@ typedef struct {
 void EnterCriticalSection(CRITICAL_SECTION* cs)
 {
     vx_critical_section * crit_sec = (vx_critical_section *)*cs;
-    std::lock_guard<std::mutex> lock(crit_sec->mtx);
+    crit_sec->mtx.lock();
 }
 
 // Emulates LeaveCriticalSection for non_windows platform
@@ -195,80 +320,4 @@ void DeleteCriticalSection(CRITICAL_SECTION* cs)
     delete crit_sec;
 }
 
-HANDLE CreateSemaphore(void *, LONG, LONG, void *)
-{
-	vx_semaphore * sem = new vx_semaphore;
-	sem->type = VX_SEMAPHORE;
-	sem->count = 0;
-	return sem;
-}
-
-HANDLE CreateThread(void *, size_t dwStackSize, LPTHREAD_START_ROUTINE lpStartAddress, LPVOID lpParameter, DWORD dwCreationFlags, void *)
-{
-    vx_thread *thd = new vx_thread;
-    thd->type = VX_THREAD;
-    thd->thread_obj = thread(lpStartAddress, lpParameter);
-    return thd;
-}
-
-void CloseHandle(HANDLE h)
-{
-	if(h) {
-		if(*(int*)h == VX_SEMAPHORE) {
-			vx_semaphore * sem = (vx_semaphore *)h;
-			sem->type = 0;
-			delete sem;
-		}
-		else if(*(int*)h == VX_THREAD) {
-            vx_thread * th = (vx_thread *)h;
-            th->type = 0;
-            th->thread_obj.join();
-            delete th;
-        }
-	}
-}
-DWORD WaitForSingleObject(HANDLE h, DWORD dwMilliseconds)
-{
-	if(h) {
-		if(*(int*)h == VX_SEMAPHORE) {
-			vx_semaphore * sem = (vx_semaphore *)h;
-			{
-				unique_lock<mutex> lk(sem->mtx);
-				sem->cv.wait(lk); // TBD: implement with timeout
-			}
-			{
-				lock_guard<mutex> lk(sem->mtx);
-				sem->count--;
-			}
-		}
-    } else
-    {
-        printf("Invalid Handle for WaitObject\n");
-        return -1;
-    }
-	return 0;
-}
-
-BOOL ReleaseSemaphore(HANDLE h, LONG lReleaseCount, LPLONG lpPreviousCount)
-{
-	if(h) {
-		if(*(int*)h == VX_SEMAPHORE) {
-			vx_semaphore * sem = (vx_semaphore *)h;
-			{
-				lock_guard<mutex> lk(sem->mtx);
-				if(lpPreviousCount) *lpPreviousCount = sem->count;
-				sem->count += lReleaseCount;
-			}
-			for(LONG i = 0; i < lReleaseCount; i++) {
-				sem->cv.notify_one();
-			}
-		}
-    } else
-    {
-        printf("Invalid Handle for Semaphore\n");
-        return 0;
-    }
-    return 1;
-}
-
 #endif
@@ -44,11 +44,16 @@ THE SOFTWARE.
 #include <fenv.h>
 #include <vector>
 #include <list>
+#include <deque>
 #include <map>
+#include <tuple>
 #include <algorithm>
 #include <functional>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 using namespace std;
 
 #if _WIN32
@@ -118,6 +123,7 @@ typedef struct _ago_module    * ago_module;
 
 // platform independent functions
 bool       agoIsCpuHardwareSupported();
+int        agoGetCpuInstructionSet(); // returns 0: SSE4, 1: AVX2, 2: AVX-512BW
 uint32_t   agoControlFpSetRoundEven();
 void       agoControlFpReset(uint32_t state);
 int64_t    agoGetClockCounter();
@@ -126,27 +132,40 @@ bool       agoGetEnvironmentVariable(const char * name, char * value, size_t val
 ago_module agoOpenModule(const char * libFileName);
 void *     agoGetFunctionAddress(ago_module module, const char * functionName);
 void       agoCloseModule(ago_module module);
+bool       agoGetModuleFileStamp(const void * address, int64_t * fileSize, int64_t * fileTime); // size and modification time of the library or executable containing address, returns true if success
+int64_t    agoGetProcessId();
+
+// pool of worker threads to run a batch of independent tasks concurrently
+class AgoThreadPool {
+public:
+	AgoThreadPool(size_t threadCount); // threadCount includes the calling thread
+	~AgoThreadPool();
+	size_t threadCount() const { return workers.size() + 1; }
+	// runs task(0) .. task(taskCount-1) on the workers and the calling thread and returns after all of them completed;
+	// the tasks are run on the calling thread alone when another thread is already running a batch on the pool
+	void run(size_t taskCount, const function<void(size_t)>& task);
+private:
+	void worker();
+	vector<thread> workers;
+	mutex runLock;
+	mutex mtx;
+	condition_variable cvStart;
+	condition_variable cvDone;
+	const function<void(size_t)> * batchTask;
+	size_t batchSize;
+	size_t batchId;
+	bool batchOpen;
+	size_t activeWorkers;
+	bool terminate;
+	atomic<size_t> nextTask;
+};
 
 #if !_WIN32
 typedef void * CRITICAL_SECTION;
-typedef void * HANDLE;
-typedef unsigned long DWORD;
-typedef void * LPVOID;
-typedef int BOOL;
-typedef long LONG, * LPLONG;
-typedef void (*LPTHREAD_START_ROUTINE)(LPVOID lpThreadParameter);
 extern void EnterCriticalSection(CRITICAL_SECTION* cs);
 extern void LeaveCriticalSection(CRITICAL_SECTION* cs);
 extern void InitializeCriticalSection(CRITICAL_SECTION* cs);
 extern void DeleteCriticalSection(CRITICAL_SECTION* cs);
-extern void CloseHandle(HANDLE h);
-extern HANDLE CreateSemaphore(void *, LONG, LONG, void *);
-extern HANDLE CreateThread(void *, size_t dwStackSize, LPTHREAD_START_ROUTINE lpStartAddress, LPVOID lpParameter, DWORD dwCreationFlags, void *);
-extern DWORD WaitForSingleObject(HANDLE hHandle, DWORD dwMilliseconds);
-extern BOOL ReleaseSemaphore(HANDLE hSemaphore, LONG lReleaseCount, LPLONG lpPreviousCount);
-#define WINAPI
-#define INFINITE 0xFFFFFFFF
-#define WAIT_OBJECT_0 0
 #endif
 
 #endif
@@ -1372,6 +1372,8 @@ int agoGetDataFromDescription(AgoContext * acontext, AgoGraph * agraph, AgoData
 			agoAddLogEntry(&data->ref, VX_FAILURE, "ERROR: agoGetDataFromDescription: invalid threshold data_type %s\n", data_type);
 			return -1;
 		}
+		// skip "I," written by agoGetDescriptionFromData for initialized thresholds
+		if (s[0] == 'I' && s[1] == ',') s += 2;
 		if (data->u.thr.thresh_type == VX_THRESHOLD_TYPE_BINARY) {
 			if (sscanf(s, "%d", &data->u.thr.threshold_lower) == 1)
 				data->isInitialized = vx_true_e;
@@ -1952,6 +1954,17 @@ void agoGetDataName(vx_char * name, AgoData * data)
 	}
 }
 
+vx_uint64 agoHashFNV1a(vx_uint64 hash, const void * data, size_t size)
+{
+	// 64-bit FNV-1a: start with hash = 0xcbf29ce484222325 and chain the calls
+	const vx_uint8 * p = (const vx_uint8 *)data;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= p[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
 vx_enum agoAddUserStruct(AgoContext * acontext, vx_size size, vx_char * name)
 {
 	CAgoLock lock(acontext->cs);
@@ -2833,13 +2846,28 @@ void agoImportNodeConfig(AgoNode * childnode, AgoNode * anode)
 }
 
 void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_reference ref)
+{
+	if (graph->enable_performance_profiling) {
+		agoPerfProfileEntry(graph, type, ref, agoGetClockCounter(), std::this_thread::get_id());
+	}
+}
+
+void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_reference ref, int64_t time)
+{
+	if (graph->enable_performance_profiling) {
+		agoPerfProfileEntry(graph, type, ref, time, std::this_thread::get_id());
+	}
+}
+
+void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_reference ref, int64_t time, std::thread::id thread)
 {
 	if (graph->enable_performance_profiling) {
 		AgoProfileEntry entry;
 		entry.id = graph->execFrameCount;
 		entry.type = type;
 		entry.ref = ref;
-		entry.time = agoGetClockCounter();
+		entry.time = time;
+		entry.thread = thread;
 		graph->performance_profile.push_back(entry);
 	}
 }
@@ -2992,6 +3020,7 @@ AgoKernel::~AgoKernel()
 }
 AgoSuperNode::AgoSuperNode()
 	: next{ nullptr }, group{ 0 }, width{ 0 }, height{ 0 }, launched{ false }, isGpuOclSuperNode{ false },
+	  strip_height{ 0 }, strip_buffer_allocated{ nullptr },
 #if ENABLE_OPENCL
 	  opencl_cmdq{ nullptr }, opencl_program{ nullptr }, opencl_kernel{ nullptr }, opencl_event{ nullptr },
 #endif
@@ -3005,12 +3034,26 @@ AgoSuperNode::AgoSuperNode()
 	memset(&perf, 0, sizeof(perf));
 }
 AgoSuperNode::~AgoSuperNode()
+{
+	// release row strip views and give the strip-local images back to the regular allocation
+	for (auto& param : stripParamList) {
+		if (param.local)
+			param.data->buffer = nullptr;
+		delete param.view;
+	}
+	if (strip_buffer_allocated) {
+		agoReleaseMemory(strip_buffer_allocated);
+		strip_buffer_allocated = nullptr;
+	}
+}
+AgoGraphPipeline::AgoGraphPipeline()
+	: depth{ 0 }, framesLaunched{ 0 }, framesCompleted{ 0 }, running{ false }, terminate{ false }, status{ VX_SUCCESS }
 {
 }
 AgoNode::AgoNode()
 	: next{ nullptr }, akernel{ nullptr }, flags{ 0 }, localDataSize{ 0 }, localDataPtr{ nullptr }, localDataPtr_allocated{ nullptr }, 
 	  valid_rect_reset{ vx_true_e }, valid_rect_num_inputs{ 0 }, valid_rect_num_outputs{ 0 }, valid_rect_inputs{ nullptr }, valid_rect_outputs{ nullptr },
-	  paramCount{ 0 }, callback{ nullptr }, supernode{ nullptr }, initialized{ false }, target_support_flags{ 0 }, hierarchical_level{ 0 }, status{ VX_SUCCESS }
+	  paramCount{ 0 }, callback{ nullptr }, supernode{ nullptr }, cpu_supernode{ nullptr }, initialized{ false }, target_support_flags{ 0 }, hierarchical_level{ 0 }, status{ VX_SUCCESS }
 	, drama_divide_invoked{ false }
 #if ENABLE_OPENCL
 	, opencl_type{ 0 }, opencl_param_mem2reg_mask{ 0 }, opencl_param_discard_mask{ 0 }, opencl_param_as_value_mask{ 0 },
@@ -3059,14 +3102,15 @@ AgoNode::~AgoNode()
 #endif
 }
 AgoGraph::AgoGraph()
-	: next{ nullptr }, hThread{ nullptr }, hSemToThread{ nullptr }, hSemFromThread{ nullptr },
-	  threadScheduleCount{ 0 }, threadExecuteCount{ 0 }, threadWaitCount{ 0 }, threadThreadTerminationState{ 0 },
+	: next{ nullptr }, scheduleCount{ 0 }, scheduleCompleteCount{ 0 }, scheduleTerminate{ false },
 	  isReadyToExecute{ vx_false_e }, detectedInvalidNode{ false }, status{ VX_SUCCESS },
-	  virtualDataGenerationCount{ 0 }, optimizer_flags{ AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT }, verified{ false }, enable_performance_profiling{ false }, execFrameCount{ 0 }
+	  virtualDataGenerationCount{ 0 }, optimizer_flags{ AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT }, verified{ false }, precompiled{ false }, cache_node_count{ 0 },
+	  cpuSupernodeList{ nullptr }, pipeline{ nullptr }
 #if ENABLE_OPENCL
 	, supernodeList{ nullptr }, opencl_cmdq{ nullptr }, opencl_device{ nullptr }
 	, enable_node_level_opencl_flush{ true }
 #endif
+	, execFrameCount{ 0 }, enable_performance_profiling{ false }
 {
 	memset(&dataList, 0, sizeof(dataList));
 	memset(&nodeList, 0, sizeof(nodeList));
@@ -3094,6 +3138,10 @@ AgoGraph::~AgoGraph()
 	}
 
 	agoResetNodeList(&nodeList);
+	agoResetSuperNodeList(cpuSupernodeList);
+	cpuSupernodeList = NULL;
+	delete pipeline;
+	pipeline = nullptr;
 #if ENABLE_OPENCL
 	agoResetSuperNodeList(supernodeList);
 	supernodeList = NULL;
@@ -3106,7 +3154,7 @@ AgoGraph::~AgoGraph()
 AgoContext::AgoContext()
 	: perfNormFactor{ 0 }, dataGenerationCount{ 0 }, nextUserStructId{ VX_TYPE_USER_STRUCT_START }, nextUserKernelId{ 0 }, nextUserLibraryId{ 1 },
 	  num_active_modules{ 0 }, num_active_references{ 0 }, callback_log{ nullptr }, callback_reentrant{ vx_false_e },
-	  thread_config{ CONFIG_THREAD_DEFAULT }, importing_module_index_plus1{ 0 }, graph_garbage_data{ nullptr }, graph_garbage_node{ nullptr }, graph_garbage_list{ nullptr }
+	  thread_config{ CONFIG_THREAD_DEFAULT }, thread_pool{ nullptr }, enable_performance_profiling{ false }, importing_module_index_plus1{ 0 }, graph_garbage_data{ nullptr }, graph_garbage_node{ nullptr }, graph_garbage_list{ nullptr }
 #if ENABLE_OPENCL
 #if defined(CL_VERSION_2_0)
 	  , opencl_svmcaps{ 0 }
@@ -3158,6 +3206,12 @@ AgoContext::~AgoContext()
 		agraph = next;
 	}
 
+	// stop the CPU node execution threads
+	if (thread_pool) {
+		delete thread_pool;
+		thread_pool = nullptr;
+	}
+
 	for (AgoNode * node = graph_garbage_node; node;) {
 		AgoNode * item = node;
 		node = node->next;
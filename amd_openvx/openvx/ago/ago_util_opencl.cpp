@@ -1563,6 +1563,69 @@ int agoGpuOclSuperNodeUpdate(AgoGraph * graph, AgoSuperNode * supernode)
 	return 0;
 }
 
+static cl_program agoGpuOclLoadProgramBinary(AgoGraph * graph, const char * opencl_code, const char * opencl_build_options, std::string& fileName)
+{
+	// program binaries are cached next to compiled graphs, keyed by the code, build options, device, and driver
+	fileName.clear();
+	if (graph->cache_folder.empty())
+		return NULL;
+	char deviceName[256] = { 0 }, driverVersion[256] = { 0 };
+	clGetDeviceInfo(graph->opencl_device, CL_DEVICE_NAME, sizeof(deviceName) - 1, deviceName, NULL);
+	clGetDeviceInfo(graph->opencl_device, CL_DRIVER_VERSION, sizeof(driverVersion) - 1, driverVersion, NULL);
+	vx_uint64 key = agoHashFNV1a(0xcbf29ce484222325ull, AGO_VERSION, strlen(AGO_VERSION) + 1);
+	key = agoHashFNV1a(key, deviceName, strlen(deviceName) + 1);
+	key = agoHashFNV1a(key, driverVersion, strlen(driverVersion) + 1);
+	key = agoHashFNV1a(key, opencl_build_options, strlen(opencl_build_options) + 1);
+	key = agoHashFNV1a(key, opencl_code, strlen(opencl_code) + 1);
+	char name[64]; sprintf(name, "/ago-opencl-%016llx.bin", (unsigned long long)key);
+	fileName = graph->cache_folder + name;
+
+	// load the binary, if available
+	FILE * fp = fopen(fileName.c_str(), "rb");
+	if (!fp)
+		return NULL;
+	fseek(fp, 0L, SEEK_END); long size = ftell(fp); fseek(fp, 0L, SEEK_SET);
+	unsigned char * binary = new unsigned char[size > 0 ? size : 1];
+	bool valid = (size > 0) && (fread(binary, 1, size, fp) == (size_t)size);
+	fclose(fp);
+	cl_program opencl_program = NULL;
+	if (valid) {
+		size_t binarySize = (size_t)size;
+		const unsigned char * binaries[1] = { binary };
+		cl_int binaryStatus = CL_SUCCESS, err = CL_SUCCESS;
+		opencl_program = clCreateProgramWithBinary(graph->ref.context->opencl_context, 1, &graph->opencl_device, &binarySize, binaries, &binaryStatus, &err);
+		if (opencl_program && (err || binaryStatus || clBuildProgram(opencl_program, 1, &graph->opencl_device, opencl_build_options, NULL, NULL))) {
+			clReleaseProgram(opencl_program);
+			opencl_program = NULL;
+		}
+	}
+	delete[] binary;
+	return opencl_program;
+}
+
+static void agoGpuOclSaveProgramBinary(AgoGraph * graph, cl_program opencl_program, const std::string& fileName)
+{
+	if (fileName.empty())
+		return;
+	size_t binarySize = 0;
+	if (clGetProgramInfo(opencl_program, CL_PROGRAM_BINARY_SIZES, sizeof(binarySize), &binarySize, NULL) || !binarySize)
+		return;
+	unsigned char * binary = new unsigned char[binarySize];
+	unsigned char * binaries[1] = { binary };
+	if (!clGetProgramInfo(opencl_program, CL_PROGRAM_BINARIES, sizeof(binaries), binaries, NULL)) {
+		// write into a temporary file first so that a concurrent load never sees a partial binary
+		std::string tmpName = fileName + ".tmp";
+		FILE * fp = fopen(tmpName.c_str(), "wb");
+		if (fp) {
+			bool written = (fwrite(binary, 1, binarySize, fp) == binarySize);
+			fclose(fp);
+			if (!written || rename(tmpName.c_str(), fileName.c_str()))
+				remove(tmpName.c_str());
+		}
+	}
+	delete[] binary;
+}
+
 int agoGpuOclSuperNodeFinalize(AgoGraph * graph, AgoSuperNode * supernode)
 {
 	// get supernode image dimensions
@@ -2018,22 +2081,27 @@ int agoGpuOclSuperNodeFinalize(AgoGraph * graph, AgoSuperNode * supernode)
 	// create compile the OpenCL code into OpenCL kernel object
 	supernode->opencl_cmdq = graph->opencl_cmdq;
 	cl_int err;
-	supernode->opencl_program = clCreateProgramWithSource(graph->ref.context->opencl_context, 1, &opencl_code, NULL, &err);
-	if (err) { 
-		agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: clCreateProgramWithSource(%p,1,*,NULL,*) failed(%d) for group#%d\n", graph->ref.context->opencl_context, err, supernode->group);
-		return -1; 
-	}
 	std::string opencl_build_options = graph->ref.context->opencl_build_options;
-	err = clBuildProgram(supernode->opencl_program, 1, &graph->opencl_device, opencl_build_options.c_str(), NULL, NULL);
-	if (err) { 
-		agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: clBuildProgram(%p,%s) failed(%d) for group#%d\n", supernode->opencl_program, graph->ref.context->opencl_build_options, err, supernode->group);
+	std::string binaryFileName;
+	supernode->opencl_program = agoGpuOclLoadProgramBinary(graph, opencl_code, opencl_build_options.c_str(), binaryFileName);
+	if (!supernode->opencl_program) {
+		supernode->opencl_program = clCreateProgramWithSource(graph->ref.context->opencl_context, 1, &opencl_code, NULL, &err);
+		if (err) { 
+			agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: clCreateProgramWithSource(%p,1,*,NULL,*) failed(%d) for group#%d\n", graph->ref.context->opencl_context, err, supernode->group);
+			return -1; 
+		}
+		err = clBuildProgram(supernode->opencl_program, 1, &graph->opencl_device, opencl_build_options.c_str(), NULL, NULL);
+		if (err) { 
+			agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: clBuildProgram(%p,%s) failed(%d) for group#%d\n", supernode->opencl_program, graph->ref.context->opencl_build_options, err, supernode->group);
 #if _DEBUG // dump warnings/errors to console in debug build mode
-		size_t logSize = 1024 * 1024; char * log = new char[logSize]; memset(log, 0, logSize);
-		clGetProgramBuildInfo(supernode->opencl_program, graph->opencl_device, CL_PROGRAM_BUILD_LOG, logSize, log, NULL);
-		printf("<<<<\n%s\n>>>>\n", log);
-		delete[] log;
+			size_t logSize = 1024 * 1024; char * log = new char[logSize]; memset(log, 0, logSize);
+			clGetProgramBuildInfo(supernode->opencl_program, graph->opencl_device, CL_PROGRAM_BUILD_LOG, logSize, log, NULL);
+			printf("<<<<\n%s\n>>>>\n", log);
+			delete[] log;
 #endif
-		return -1;
+			return -1;
+		}
+		agoGpuOclSaveProgramBinary(graph, supernode->opencl_program, binaryFileName);
 	}
 	supernode->opencl_kernel = clCreateKernel(supernode->opencl_program, NODE_OPENCL_KERNEL_NAME, &err);
 	if (err) { 
@@ -2169,21 +2237,26 @@ int agoGpuOclSingleNodeFinalize(AgoGraph * graph, AgoNode * node)
 	// create compile the OpenCL code into OpenCL kernel object
 	vx_context context = graph->ref.context;
 	cl_int err;
-	node->opencl_program = clCreateProgramWithSource(context->opencl_context, 1, &opencl_code, NULL, &err);
-	if (err) { 
-		agoAddLogEntry(&node->ref, VX_FAILURE, "ERROR: clCreateProgramWithSource(%p,1,*,NULL,*) failed(%d) for %s\n", context->opencl_context, err, node->akernel->name);
-		return -1; 
-	}
-	err = clBuildProgram(node->opencl_program, 1, &graph->opencl_device, node->opencl_build_options.c_str(), NULL, NULL);
-	if (err) {
-		agoAddLogEntry(&node->ref, VX_FAILURE, "ERROR: clBuildProgram(%p,%s) failed(%d) for %s\n", node->opencl_program, node->opencl_build_options.c_str(), err, node->akernel->name);
+	std::string binaryFileName;
+	node->opencl_program = agoGpuOclLoadProgramBinary(graph, opencl_code, node->opencl_build_options.c_str(), binaryFileName);
+	if (!node->opencl_program) {
+		node->opencl_program = clCreateProgramWithSource(context->opencl_context, 1, &opencl_code, NULL, &err);
+		if (err) { 
+			agoAddLogEntry(&node->ref, VX_FAILURE, "ERROR: clCreateProgramWithSource(%p,1,*,NULL,*) failed(%d) for %s\n", context->opencl_context, err, node->akernel->name);
+			return -1; 
+		}
+		err = clBuildProgram(node->opencl_program, 1, &graph->opencl_device, node->opencl_build_options.c_str(), NULL, NULL);
+		if (err) {
+			agoAddLogEntry(&node->ref, VX_FAILURE, "ERROR: clBuildProgram(%p,%s) failed(%d) for %s\n", node->opencl_program, node->opencl_build_options.c_str(), err, node->akernel->name);
 #if _DEBUG // dump warnings/errors to console in debug build mode
-		size_t logSize = 1024 * 1024; char * log = new char[logSize]; memset(log, 0, logSize);
-		clGetProgramBuildInfo(node->opencl_program, graph->opencl_device, CL_PROGRAM_BUILD_LOG, logSize, log, NULL);
-		printf("<<<<\n%s\n>>>>\n", log);
-		delete[] log;
+			size_t logSize = 1024 * 1024; char * log = new char[logSize]; memset(log, 0, logSize);
+			clGetProgramBuildInfo(node->opencl_program, graph->opencl_device, CL_PROGRAM_BUILD_LOG, logSize, log, NULL);
+			printf("<<<<\n%s\n>>>>\n", log);
+			delete[] log;
 #endif
-		return -1;
+			return -1;
+		}
+		agoGpuOclSaveProgramBinary(graph, node->opencl_program, binaryFileName);
 	}
 	node->opencl_kernel = clCreateKernel(node->opencl_program, node->opencl_name, &err);
 	if (err) { 
@@ -243,6 +243,12 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryContext(vx_context context, vx_enum at
 					status = VX_SUCCESS;
 				}
 				break;
+			case VX_CONTEXT_ATTRIBUTE_AMD_PERFORMANCE_PROFILE:
+				if (size == sizeof(vx_bool)) {
+					*(vx_bool *)ptr = context->enable_performance_profiling ? vx_true_e : vx_false_e;
+					status = VX_SUCCESS;
+				}
+				break;
 #if ENABLE_OPENCL
 			case VX_CONTEXT_ATTRIBUTE_AMD_OPENCL_CONTEXT:
 				if (size == sizeof(cl_context)) {
@@ -352,6 +358,15 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetContextAttribute(vx_context context, vx_
 					context->attr_affinity = *(AgoTargetAffinityInfo_ *)ptr;
 				}
 				break;
+			case VX_CONTEXT_ATTRIBUTE_AMD_PERFORMANCE_PROFILE:
+				if (size == sizeof(vx_bool)) {
+					status = VX_SUCCESS;
+					context->enable_performance_profiling = *(vx_bool *)ptr ? true : false;
+					for (AgoGraph * graph = context->graphList.head; graph; graph = graph->next) {
+						graph->enable_performance_profiling = context->enable_performance_profiling;
+					}
+				}
+				break;
 #if ENABLE_OPENCL
 			case VX_CONTEXT_ATTRIBUTE_AMD_OPENCL_CONTEXT:
 				if (size == sizeof(cl_context)) {
@@ -2435,6 +2450,9 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
 	if (agoIsValidGraph(graph)) {
+		// stop the frames of a pipelined graph before its nodes change: they may need the locks
+		agoStopGraphPipeline(graph);
+
 		CAgoLock lock(graph->cs);
 		CAgoLock lock2(graph->ref.context->cs);
 
@@ -2452,6 +2470,11 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
 			agoWriteGraph(graph, NULL, 0, stdout, "*INPUT*");
 		}
 
+		// a graph modified after the import doesn't match its compiled graph anymore
+		if (!graph->cache_file.empty() && graph->nodeList.count != graph->cache_node_count) {
+			graph->cache_file.clear();
+		}
+
 		// verify graph per OpenVX specification
 		status = agoVerifyGraph(graph);
 		if (status == VX_SUCCESS) {
@@ -2464,9 +2487,17 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
 			else if (agoInitializeGraph(graph)) {
 				status = VX_FAILURE;
 			}
+			// start the frames of a pipelined graph
+			else if (graph->pipeline && (status = agoInitializeGraphPipeline(graph)) != VX_SUCCESS) {
+				agoAddLogEntry(&graph->ref, status, "ERROR: vxVerifyGraph: graph can't be pipelined\n");
+			}
 			// graph is ready to execute
 			else {
 				graph->isReadyToExecute = vx_true_e;
+				// save the optimized graph, if requested by the import
+				if (!graph->cache_file.empty()) {
+					agoWriteCompiledGraph(graph);
+				}
 			}
 		}
 
@@ -2619,6 +2650,9 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribut
 			case VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE:
 				status = agoGraphDumpPerformanceProfile(graph, (const char *)ptr);
 				break;
+			case VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_TRACE:
+				status = agoGraphDumpPerformanceTrace(graph, (const char *)ptr);
+				break;
 #if ENABLE_OPENCL
 			case VX_GRAPH_ATTRIBUTE_AMD_OPENCL_COMMAND_QUEUE:
 				if (size == sizeof(cl_command_queue)) {
@@ -2657,7 +2691,10 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetGraphAttribute(vx_graph graph, vx_enum a
 				if (size == sizeof(AgoGraphImportInfo)) {
 					status = VX_SUCCESS;
 					AgoGraphImportInfo * info = (AgoGraphImportInfo *)ptr;
-					if (agoReadGraphFromString(graph, info->ref, info->num_ref, info->data_registry_callback_f, info->data_registry_callback_obj, info->text, info->dumpToConsole)) {
+					// use the compiled graph cache folder if environment variable AGO_GRAPH_CACHE is specified
+					char cacheFolder[1024] = { 0 };
+					agoGetEnvironmentVariable("AGO_GRAPH_CACHE", cacheFolder, sizeof(cacheFolder));
+					if (agoReadGraphWithCache(graph, info->ref, info->num_ref, info->data_registry_callback_f, info->data_registry_callback_obj, info->text, info->dumpToConsole, cacheFolder)) {
 						status = VX_FAILURE;
 					}
 				}
@@ -6009,6 +6046,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetRemapPoint(vx_remap table,
 				item_fixed->x = 0xffff;
 				item_fixed->y = 0xffff;
 			}
+			data->u.remap.version++;
 			status = VX_SUCCESS;
 			// update sync flags
 			data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
@@ -6985,6 +7023,58 @@ VX_API_ENTRY vx_status VX_API_CALL vxGetReferenceName(vx_reference ref, vx_char
 	return status;
 }
 
+VX_API_ENTRY vx_status VX_API_CALL vxImportGraphWithCache(vx_graph graph, const AgoGraphImportInfo * info, const vx_char * cacheFolder)
+{
+	vx_status status = VX_ERROR_INVALID_GRAPH;
+	if (agoIsValidGraph(graph)) {
+		status = VX_ERROR_INVALID_PARAMETERS;
+		if (info && info->text) {
+			status = VX_SUCCESS;
+			if (agoReadGraphWithCache(graph, info->ref, info->num_ref, info->data_registry_callback_f, info->data_registry_callback_obj, info->text, info->dumpToConsole, cacheFolder)) {
+				status = VX_FAILURE;
+			}
+		}
+	}
+	return status;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxScheduleGraphFrame(vx_graph graph, vx_uint64 * frame_id)
+{
+	if (!frame_id)
+		return VX_ERROR_INVALID_PARAMETERS;
+	return agoScheduleGraphFrame(graph, frame_id);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxWaitGraphFrame(vx_graph graph, vx_uint64 frame_id)
+{
+	return agoWaitGraphFrame(graph, frame_id);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetGraphPipelineConfig(vx_graph graph, vx_uint32 pipeline_depth, vx_uint32 num_params, const AgoGraphParameterQueueInfo * params)
+{
+	vx_status status = VX_ERROR_INVALID_REFERENCE;
+	if (agoIsValidGraph(graph)) {
+		CAgoLock lock(graph->cs);
+		status = agoSetGraphPipelineConfig(graph, pipeline_depth, num_params, params);
+	}
+	return status;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterEnqueueReadyRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_reference * refs, vx_uint32 num_refs)
+{
+	return agoGraphParameterEnqueueReadyRef(graph, graph_parameter_index, refs, num_refs);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterDequeueDoneRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_reference * refs, vx_uint32 max_refs, vx_uint32 * num_refs)
+{
+	return agoGraphParameterDequeueDoneRef(graph, graph_parameter_index, refs, max_refs, num_refs);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterCheckDoneRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_uint32 * num_refs)
+{
+	return agoGraphParameterCheckDoneRef(graph, graph_parameter_index, num_refs);
+}
+
 VX_API_ENTRY vx_status VX_API_CALL vxGetModuleInternalData(vx_context context, const vx_char * module, void ** ptr, vx_size * size)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
@@ -93,6 +93,9 @@ enum vx_context_attribute_amd_e {
 	VX_CONTEXT_MAX_TENSOR_DIMENSIONS = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x05,
 	/*! \brief CL_QUEUE_PROPERTIES to be used for creating OpenCL command queue. Use a <tt>\ref cl_command_queue_properties</tt> parameter. */
 	VX_CONTEXT_CL_QUEUE_PROPERTIES = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x06,
+	/*! \brief profile capture of all graphs in the context, including the graphs created later. Use a <tt>\ref vx_bool</tt> parameter.
+	*   Use \ref VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_TRACE or \ref VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE to get the captured profile.*/
+	VX_CONTEXT_ATTRIBUTE_AMD_PERFORMANCE_PROFILE = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x07,
 };
 
 /*! \brief The AMD kernel attributes list.
@@ -131,6 +134,9 @@ enum vx_graph_attribute_amd_e {
 	VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x07,
 	/*! \brief OpenCL command queue. Use a <tt>\ref cl_command_queue</tt> parameter.*/
 	VX_GRAPH_ATTRIBUTE_AMD_OPENCL_COMMAND_QUEUE         = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x08,
+	/*! \brief graph performance profile as a timeline in Chrome trace-event JSON (chrome://tracing, Perfetto). Use a char * fileName parameter.
+	*   Each thread gets a track with the launch, wait, copy, and exec spans of the nodes within frame spans of the graph.*/
+	VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_TRACE            = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x09,
 };
 
 /*! \brief The AMD node attributes list.
@@ -286,6 +292,16 @@ typedef struct {
 	vx_char comment[64];
 } AgoGraphExportInfo;
 
+/*! \brief AMD data structure to specify a graph parameter whose objects are queued to a pipelined graph.
+**    graph_parameter_index: index of the parameter added by vxAddParameterToGraph
+**    refs_list: objects that can be enqueued to the parameter (same type and attributes as the parameter)
+*/
+typedef struct {
+	vx_uint32 graph_parameter_index;
+	vx_uint32 refs_list_size;
+	vx_reference * refs_list;
+} AgoGraphParameterQueueInfo;
+
 /*! \brief AMD data structure to get internal performance data.
 */
 typedef struct {
@@ -464,6 +480,138 @@ MISCELLANEOUS
 */
 VX_API_ENTRY vx_status VX_API_CALL vxGetReferenceName(vx_reference ref, vx_char name[], vx_size size);
 
+/**
+* \brief Import a graph from text through a cache of compiled graphs.
+* \ingroup vx_framework_reference
+*
+* Same as \ref VX_GRAPH_ATTRIBUTE_AMD_IMPORT_FROM_TEXT, except that the graph optimized by \ref vxVerifyGraph
+* (node list after drama divide and remove, affinity, and data layout) is saved into the cache folder,
+* keyed by a hash of the text, the import references, the optimizer flags, the affinity, and the library version.
+* The next import with the same key loads the optimized graph and \ref vxVerifyGraph skips those passes.
+* OpenCL program binaries are cached in the same folder and reused on the same device and driver.
+* Set the optimizer flags and the affinity before the import: they are part of the key.
+* Graphs that are not empty, have delays, or use def-macro or set-args are imported without caching.
+* Setting the environment variable AGO_GRAPH_CACHE enables the cache for \ref VX_GRAPH_ATTRIBUTE_AMD_IMPORT_FROM_TEXT.
+*
+* \param [in] graph The graph.
+* \param [in] info The graph text and import references.
+* \param [in] cacheFolder The folder of the cache (NULL or empty to disable the cache).
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_GRAPH if graph is not valid.
+* \retval VX_FAILURE if the import failed.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxImportGraphWithCache(vx_graph graph, const AgoGraphImportInfo * info, const vx_char * cacheFolder);
+
+/**
+* \brief Schedule a graph for execution and get a handle to wait for that execution.
+* \ingroup group_graph
+*
+* Same as \ref vxScheduleGraph. Any number of executions of a graph can be outstanding: they run in order.
+*
+* \param [in] graph The graph.
+* \param [out] frame_id The handle of the execution for \ref vxWaitGraphFrame.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS The graph has been scheduled.
+* \retval VX_ERROR_INVALID_REFERENCE if graph is not valid.
+* \retval VX_ERROR_INVALID_PARAMETERS if frame_id is NULL.
+* \retval * See \ref vxScheduleGraph.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxScheduleGraphFrame(vx_graph graph, vx_uint64 * frame_id);
+
+/**
+* \brief Wait for one execution of a graph scheduled by \ref vxScheduleGraphFrame.
+* \ingroup group_graph
+*
+* Returns as soon as that execution completed, while later executions may still be running.
+* The status of a failed execution is returned once: by this function or by \ref vxWaitGraph.
+*
+* \param [in] graph The graph.
+* \param [in] frame_id The handle of the execution.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS The execution completed successfully.
+* \retval VX_ERROR_INVALID_REFERENCE if graph is not valid.
+* \retval VX_ERROR_INVALID_PARAMETERS if frame_id is not the handle of a scheduled execution.
+* \retval * The status of the failed execution.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxWaitGraphFrame(vx_graph graph, vx_uint64 frame_id);
+
+/**
+* \brief Enable pipelined execution of a graph.
+* \ingroup group_graph
+*
+* Up to pipeline_depth frames of the graph are in flight at the same time: the hierarchical levels of
+* successive frames overlap on separate threads, each frame with its own copy of the virtual data.
+* The objects of the queued graph parameters are supplied with \ref vxGraphParameterEnqueueReadyRef and
+* returned in frame order by \ref vxGraphParameterDequeueDoneRef; a frame starts as soon as every queued
+* parameter has a ready object. \ref vxProcessGraph and \ref vxScheduleGraph are not supported on a pipelined
+* graph and \ref vxWaitGraph waits until all the frames that can start have completed.
+* Only graphs with CPU nodes and without delays can be pipelined. All the non-virtual objects written by the
+* nodes must be queued graph parameters. The performance attributes of the graph and its nodes are not updated.
+* This function shall be called before \ref vxVerifyGraph, which fails when the graph can't be pipelined.
+*
+* \param [in] graph The graph.
+* \param [in] pipeline_depth The number of frames in flight (1 to 8).
+* \param [in] num_params The number of queued graph parameters.
+* \param [in] params The queued graph parameters and the objects that can be enqueued to them.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE if graph is not valid.
+* \retval VX_ERROR_INVALID_PARAMETERS if a parameter index, a reference, or the depth is not valid.
+* \retval VX_ERROR_NOT_SUPPORTED if the graph was already verified.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSetGraphPipelineConfig(vx_graph graph, vx_uint32 pipeline_depth, vx_uint32 num_params, const AgoGraphParameterQueueInfo * params);
+
+/**
+* \brief Enqueue objects to a graph parameter of a pipelined graph.
+* \ingroup group_graph
+*
+* The graph gets verified first, if needed. The objects shall not be accessed until they are dequeued.
+*
+* \param [in] graph The graph.
+* \param [in] graph_parameter_index The index of the queued graph parameter.
+* \param [in] refs The objects to enqueue, each from the refs_list of the parameter.
+* \param [in] num_refs The number of objects.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE if graph is not valid.
+* \retval VX_ERROR_INVALID_PARAMETERS if the parameter is not queued or an object is not in its refs_list.
+* \retval * See \ref vxVerifyGraph.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterEnqueueReadyRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_reference * refs, vx_uint32 num_refs);
+
+/**
+* \brief Dequeue the objects of completed frames from a graph parameter of a pipelined graph.
+* \ingroup group_graph
+*
+* Blocks until at least one object is available.
+*
+* \param [in] graph The graph.
+* \param [in] graph_parameter_index The index of the queued graph parameter.
+* \param [out] refs The dequeued objects in frame order.
+* \param [in] max_refs The size of the refs array.
+* \param [out] num_refs The number of dequeued objects.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE if graph is not valid.
+* \retval VX_ERROR_INVALID_PARAMETERS if the parameter is not queued or the graph is not pipelined.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterDequeueDoneRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_reference * refs, vx_uint32 max_refs, vx_uint32 * num_refs);
+
+/**
+* \brief Get the number of objects that can be dequeued without blocking from a graph parameter of a pipelined graph.
+* \ingroup group_graph
+*
+* \param [in] graph The graph.
+* \param [in] graph_parameter_index The index of the queued graph parameter.
+* \param [out] num_refs The number of objects of completed frames.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE if graph is not valid.
+* \retval VX_ERROR_INVALID_PARAMETERS if the parameter is not queued or the graph is not pipelined.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterCheckDoneRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_uint32 * num_refs);
+
 /**
 * \brief Set module internal data.
 * \ingroup vx_framework_reference
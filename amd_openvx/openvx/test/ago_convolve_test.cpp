@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2015 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+/*
+Compares the direct convolution kernels (HafCpu_Convolve_{U8,S16}_U8_{3,5,7,9}xN) with the separable path
+(HafCpu_ConvolveSeparable_{U8,S16}_U8) on rank-1 matrices whose sums are negative, for shifts 0 to 4.
+The separable path leaves the border columns unmodified, so every column of the direct kernels, including the
+scalar columns before and after their SIMD loop, is also checked against a scalar reference. Both paths shift the
+sums arithmetically before saturating to the output type.
+*/
+
+#include "ago_internal.h"
+#include <random>
+#include <vector>
+
+#define WIDTH         77
+#define HEIGHT        20
+#define SRC_STRIDE    128
+#define SRC_PAD       16	// rows and columns around the image read by the kernels
+#define DST_STRIDE    128
+#define DST_OFFSET    3		// unaligned destination, so that the direct kernels have scalar columns before their SIMD loop
+
+typedef int(*ConvolveU8)(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_int16 *, vx_size, vx_int32);
+typedef int(*ConvolveS16)(vx_uint32, vx_uint32, vx_int16 *, vx_uint32, vx_uint8 *, vx_uint32, vx_int16 *, vx_size, vx_int32);
+
+// reference convolution: the matrix is applied flipped, like vxuConvolve
+static vx_int32 Convolve(const vx_uint8 * pSrc, const std::vector<vx_int16>& matrix, vx_uint32 width, vx_uint32 height, vx_int32 shift)
+{
+	vx_int32 M = width >> 1, N = height >> 1, sum = 0;
+	for (vx_int32 i = -N; i <= N; i++)
+		for (vx_int32 j = -M; j <= M; j++)
+			sum += (vx_int32)pSrc[i * SRC_STRIDE + j] * (vx_int32)matrix[(N - i) * width + (M - j)];
+	return sum >> shift;
+}
+
+template <typename T>
+static int CompareOutput(const char * name, vx_uint32 width, vx_uint32 height, vx_int32 shift, const vx_uint8 * pSrc,
+	const std::vector<vx_int16>& matrix, const T * pDirect, const T * pSeparable, vx_int32 minValue, vx_int32 maxValue)
+{
+	vx_uint32 M = width >> 1;
+	int mismatches = 0;
+	for (vx_uint32 y = 0; y < HEIGHT; y++) {
+		for (vx_uint32 x = 0; x < WIDTH; x++) {
+			vx_int32 expected = min(max(Convolve(pSrc + y * SRC_STRIDE + x, matrix, width, height, shift), minValue), maxValue);
+			vx_int32 direct = pDirect[y * DST_STRIDE + x];
+			bool interior = x >= M && x < WIDTH - M;
+			if (direct != expected || (interior && pSeparable[y * DST_STRIDE + x] != direct)) {
+				if (mismatches++ < 8)
+					printf("ERROR: %s %dx%d shift %d: (%d,%d): direct %d separable %d instead of %d\n", name, width, height, shift,
+						x, y, direct, interior ? (vx_int32)pSeparable[y * DST_STRIDE + x] : expected, expected);
+			}
+		}
+	}
+	return mismatches;
+}
+
+int main(int argc, char * argv[])
+{
+	std::mt19937 rng(18);
+	std::vector<vx_uint8> src(SRC_STRIDE * (HEIGHT + 2 * SRC_PAD));
+	for (vx_uint8& pixel : src)
+		pixel = (vx_uint8)rng();
+	vx_uint8 * pSrc = src.data() + SRC_PAD * SRC_STRIDE + SRC_PAD;
+	std::vector<vx_uint8> dstU8(DST_STRIDE * HEIGHT + 16), sepU8(DST_STRIDE * HEIGHT + 16);
+	std::vector<vx_int16> dstS16(DST_STRIDE * HEIGHT + 16), sepS16(DST_STRIDE * HEIGHT + 16);
+	std::vector<vx_int32> ring(CONFIG_CPU_CONVOLVE_TILE_WIDTH * 9);
+	ConvolveU8 convolveU8[4] = { HafCpu_Convolve_U8_U8_3xN, HafCpu_Convolve_U8_U8_5xN, HafCpu_Convolve_U8_U8_7xN, HafCpu_Convolve_U8_U8_9xN };
+	ConvolveS16 convolveS16[4] = { HafCpu_Convolve_S16_U8_3xN, HafCpu_Convolve_S16_U8_5xN, HafCpu_Convolve_S16_U8_7xN, HafCpu_Convolve_S16_U8_9xN };
+	int mismatches = 0;
+	for (vx_uint32 k = 0; k < 4; k++) {
+		vx_uint32 width = 3 + 2 * k;
+		for (vx_uint32 height = 3; height <= 9; height += 2) {
+			for (vx_int32 shift = 0; shift <= 4; shift += 2) {
+				// positive column factors and row factors of negative sum: most outputs are negative before saturation
+				std::vector<vx_int16> rowCoeff(width), colCoeff(height), matrix(width * height);
+				for (vx_int16& c : rowCoeff)
+					c = -(vx_int16)(rng() % 4);
+				rowCoeff[width >> 1] = (vx_int16)(rng() % 4);
+				for (vx_int16& c : colCoeff)
+					c = (vx_int16)(1 + rng() % 3);
+				for (vx_uint32 i = 0; i < height; i++)
+					for (vx_uint32 j = 0; j < width; j++)
+						matrix[i * width + j] = colCoeff[i] * rowCoeff[j];
+				// the separable path takes the factors of the flipped matrix
+				std::vector<vx_int16> rowFlipped(rowCoeff.rbegin(), rowCoeff.rend()), colFlipped(colCoeff.rbegin(), colCoeff.rend());
+				convolveU8[k](WIDTH, HEIGHT, dstU8.data() + DST_OFFSET, DST_STRIDE, pSrc, SRC_STRIDE, matrix.data(), height, shift);
+				HafCpu_ConvolveSeparable_U8_U8(WIDTH, HEIGHT, sepU8.data() + DST_OFFSET, DST_STRIDE, pSrc, SRC_STRIDE,
+					rowFlipped.data(), width, colFlipped.data(), height, shift, ring.data());
+				mismatches += CompareOutput("HafCpu_Convolve_U8_U8", width, height, shift, pSrc, matrix,
+					dstU8.data() + DST_OFFSET, sepU8.data() + DST_OFFSET, 0, 255);
+				convolveS16[k](WIDTH, HEIGHT, dstS16.data() + DST_OFFSET, DST_STRIDE * sizeof(vx_int16), pSrc, SRC_STRIDE, matrix.data(), height, shift);
+				HafCpu_ConvolveSeparable_S16_U8(WIDTH, HEIGHT, sepS16.data() + DST_OFFSET, DST_STRIDE * sizeof(vx_int16), pSrc, SRC_STRIDE,
+					rowFlipped.data(), width, colFlipped.data(), height, shift, ring.data());
+				mismatches += CompareOutput("HafCpu_Convolve_S16_U8", width, height, shift, pSrc, matrix,
+					dstS16.data() + DST_OFFSET, sepS16.data() + DST_OFFSET, -32768, 32767);
+			}
+		}
+	}
+	printf("%s: direct and separable convolution\n", mismatches ? "FAILED" : "OK");
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2015 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/*
+Compares the table-driven remap (HafCpu_GeometricTable_Remap + HafCpu_GeometricTable_U8_U8) with
+HafCpu_Remap_U8_U8_Bilinear and HafCpu_Remap_U8_U8_Bilinear_Constant on maps with 3 bits of fraction that
+cover the interior, the last column and row, the coordinates beyond the image and the 0xffff coordinates.
+The old kernels read past the edge of the image: the padding of the source buffer holds the border value,
+so that they see the same missing neighbors as the table.
+*/
+
+#include "ago_internal.h"
+#include <random>
+#include <vector>
+
+#define SRC_WIDTH     37
+#define SRC_HEIGHT    23
+#define SRC_STRIDE    64
+#define SRC_ROWS      (SRC_HEIGHT + 4)	// rows allocated for the reads past the last row
+#define DST_WIDTH     40
+#define DST_HEIGHT    24
+#define DST_STRIDE    64
+
+static vx_uint16 RandomCoordinate(std::mt19937& rng, vx_uint32 size, bool allowInvalid)
+{
+	switch (rng() % (allowInvalid ? 5 : 4)) {
+	case 0: return (vx_uint16)(rng() % ((size - 1) << 3));		// interior
+	case 1: return (vx_uint16)(((size - 1) << 3) + rng() % 8);	// last column (row)
+	case 2: return (vx_uint16)((size << 3) + rng() % 16);		// beyond the image
+	case 3: return (vx_uint16)((rng() % size) << 3);				// integer coordinate
+	default: return 0xffff;
+	}
+}
+
+static int CompareRemap(const char * name, std::mt19937& rng, vx_uint8 border, vx_bool invalidAsBorder)
+{
+	std::vector<vx_uint8> src(SRC_STRIDE * SRC_ROWS, border);
+	for (vx_uint32 y = 0; y < SRC_HEIGHT; y++)
+		for (vx_uint32 x = 0; x < SRC_WIDTH; x++)
+			src[y * SRC_STRIDE + x] = (vx_uint8)rng();
+	std::vector<ago_coord2d_ushort_t> map(DST_WIDTH * DST_HEIGHT);
+	for (ago_coord2d_ushort_t& m : map) {
+		m.x = RandomCoordinate(rng, SRC_WIDTH, true);
+		// HafCpu_Remap_U8_U8_Bilinear_Constant only checks the x coordinate for 0xffff
+		m.y = RandomCoordinate(rng, SRC_HEIGHT, !invalidAsBorder || m.x == 0xffff);
+	}
+	std::vector<ago_geometric_table_entry_t> table(DST_WIDTH * DST_HEIGHT);
+	std::vector<vx_uint8> dstOld(DST_STRIDE * DST_HEIGHT), dstTable(DST_STRIDE * DST_HEIGHT);
+	vx_uint32 mapStrideInBytes = DST_WIDTH * sizeof(ago_coord2d_ushort_t);
+	vx_uint32 tableStrideInBytes = DST_WIDTH * sizeof(ago_geometric_table_entry_t);
+	if (invalidAsBorder)
+		HafCpu_Remap_U8_U8_Bilinear_Constant(DST_WIDTH, DST_HEIGHT, dstOld.data(), DST_STRIDE, SRC_WIDTH, SRC_HEIGHT, src.data(), SRC_STRIDE,
+			map.data(), mapStrideInBytes, border);
+	else
+		HafCpu_Remap_U8_U8_Bilinear(DST_WIDTH, DST_HEIGHT, dstOld.data(), DST_STRIDE, SRC_WIDTH, SRC_HEIGHT, src.data(), SRC_STRIDE,
+			map.data(), mapStrideInBytes);
+	HafCpu_GeometricTable_Remap(DST_WIDTH, DST_HEIGHT, table.data(), tableStrideInBytes, SRC_WIDTH, SRC_HEIGHT, SRC_STRIDE,
+		map.data(), mapStrideInBytes, 3, invalidAsBorder);
+	HafCpu_GeometricTable_U8_U8(DST_WIDTH, DST_HEIGHT, dstTable.data(), DST_STRIDE, src.data(), SRC_STRIDE, table.data(), tableStrideInBytes, border);
+	int mismatches = 0;
+	for (vx_uint32 y = 0; y < DST_HEIGHT; y++) {
+		for (vx_uint32 x = 0; x < DST_WIDTH; x++) {
+			vx_uint8 a = dstOld[y * DST_STRIDE + x], b = dstTable[y * DST_STRIDE + x];
+			if (a != b) {
+				const ago_coord2d_ushort_t& m = map[y * DST_WIDTH + x];
+				if (mismatches++ < 8)
+					printf("ERROR: %s: (%d,%d) map (0x%04x,0x%04x): %d instead of %d\n", name, x, y, m.x, m.y, b, a);
+			}
+		}
+	}
+	if (mismatches)
+		printf("ERROR: %s: %d of %d pixels differ\n", name, mismatches, DST_WIDTH * DST_HEIGHT);
+	return mismatches;
+}
+
+int main(int argc, char * argv[])
+{
+	std::mt19937 rng(19);
+	int mismatches = 0;
+	for (int iteration = 0; iteration < 16; iteration++) {
+		mismatches += CompareRemap("HafCpu_Remap_U8_U8_Bilinear", rng, 0, vx_false_e);
+		mismatches += CompareRemap("HafCpu_Remap_U8_U8_Bilinear_Constant", rng, (vx_uint8)rng(), vx_true_e);
+	}
+	printf("%s: geometric table remap\n", mismatches ? "FAILED" : "OK");
+	return mismatches ? 1 : 0;
+}
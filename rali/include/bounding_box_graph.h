@@ -21,20 +21,24 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <vector>
 #include "meta_data_graph.h"
+#include "meta_node.h"
+
+//! Moves the bounding boxes along with the pixels through the geometric nodes of the image graph, boxes are clipped
+//! to each node's output image and dropped once they are left outside of it
 class BoundingBoxGraph : public MetaDataGraph
 {
 public:
-    void process() override {};
-    void build() override {};
-    MetaDataBatch * cropMirrorNormalize(MetaDataBatch *input, int w, int h, int, int x, int y, IntParam* mirror) override { return input; };
-    MetaDataBatch * crop_resize(MetaDataBatch *input, unsigned dest_width, unsigned dest_height,
-                                bool is_output,
-                                FloatParam* area,
-                                FloatParam* x_center_drift,
-                                FloatParam* y_center_drift ) override  { return input; };
-
-    MetaDataBatch * resize(MetaDataBatch * input, unsigned dest_width, unsigned dest_height) override  { return input; };
+    void process(MetaDataBatch* meta_data) override;
+    void add_node(const std::shared_ptr<Node>& node) override;
+    void build() override;
 private:
+    void load_boxes(MetaDataBatch* meta_data);
+    void apply(const std::vector<BoxTransform>& transforms);
+    void store_boxes(MetaDataBatch* meta_data);
+    std::vector<std::shared_ptr<MetaNode>> _meta_nodes;
+    std::vector<BoxTransform> _transforms;//!< Transformation of each image of the batch by the node being applied
+    std::vector<float> _x1, _y1, _x2, _y2;//!< Corners of all the boxes of the batch, stored per coordinate so that the transformations vectorize
+    std::vector<size_t> _first_box;//!< Index of the first box of each image in the corners, followed by the total box count
 };
-
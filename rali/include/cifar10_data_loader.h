@@ -38,8 +38,10 @@ public:
     size_t remaining_count() override;
     void reset() override;
     void start_loading() override;
-    std::vector<std::string> get_id() override;
+    const std::vector<std::string>& get_id() override;
+    const std::vector<ROI>& get_decoded_region() override;
     Timing timing() override;
+    void set_prefetch_depth(size_t depth) override { _prefetch_depth = depth; }
 private:
     void increment_loader_idx();
     bool is_out_of_data();
@@ -50,7 +52,6 @@ private:
     std::shared_ptr<Reader> _reader;
 
     const DeviceResources _dev_resources;
-    decoded_image_info _raw_img_info;       // image info to store the names. In this case the ID of image is stored in _roi_width field
     bool _initialized = false;
     RaliMemType _mem_type;
     size_t _output_mem_size;
@@ -61,8 +62,9 @@ private:
     std::vector<unsigned char *> _load_buff;
     std::vector<size_t> _actual_read_size;
     std::vector<std::string> _output_names;
+    std::vector<ROI> _output_decoded_region;
     CircularBuffer _circ_buff;
-    const static size_t CIRC_BUFFER_DEPTH = 3; // Used for circular buffer's internal buffer
+    size_t _prefetch_depth = LoaderOptions::MIN_AUTO_PREFETCH_DEPTH;//!< Depth of the circular buffer
     TimingDBG _file_load_time, _swap_handle_time;
     size_t _loader_idx;
     size_t _shard_count = 1;
@@ -24,29 +24,33 @@ THE SOFTWARE.
 #include <vector>
 #include <condition_variable>
 #include <CL/cl.h>
-#include <queue>
 #include "device_manager.h"
 #include "commons.h"
+#include "cpu_set.h"
+#include "image.h"
 struct decoded_image_info
 {
     std::vector<std::string> _image_names;
     std::vector<uint32_t> _roi_width;
     std::vector<uint32_t> _roi_height;
+    std::vector<ROI> _decoded_region;//!< Region of the original image decoded into the roi, the crop window or the whole image
 };
 
 class CircularBuffer
 {
 public:
-    CircularBuffer(DeviceResources ocl, size_t buffer_depth );
+    explicit CircularBuffer(DeviceResources ocl);
     ~CircularBuffer();
-    void init(RaliMemType output_mem_type, size_t output_mem_size);
+    //! \param buffer_depth Number of batches, the writer can be buffer_depth - 1 batches ahead of the reader
+    //! \param cpu_set The host buffers are first touched by a thread pinned to it, to place them on the NUMA node of the threads writing them
+    void init(RaliMemType output_mem_type, size_t output_mem_size, size_t batch_size, size_t buffer_depth, const CpuSet& cpu_set = CpuSet());
     void sync();// Syncs device buffers with host
     void unblock_reader();// Unblocks the thread currently waiting on a call to get_read_buffer
     void unblock_writer();// Unblocks the thread currently waiting on get_write_buffer
     void push();// The latest write goes through, effectively adds one element to the buffer
     void pop();// The oldest write will be erased and overwritten in upcoming writes
-    void set_image_info(const decoded_image_info& info) { _last_image_info = info; }
-    decoded_image_info& get_image_info();
+    decoded_image_info& get_write_image_info();// Info of the buffer returned by the last call to get_write_buffer, filled in place by the writer
+    decoded_image_info& get_image_info();// Info of the buffer returned by get_read_buffer_x, blocks the caller if the buffer is empty
     cl_mem get_read_buffer_dev();
     unsigned char* get_read_buffer_host();// blocks the caller if the buffer is empty
     unsigned char*  get_write_buffer(); // blocks the caller if the buffer is full
@@ -54,16 +58,16 @@ public:
     void reset();// sets the buffer level to 0
     void block_if_empty();// blocks the caller if the buffer is empty
     void block_if_full();// blocks the caller if the buffer is full
+    BufferOccupancy occupancy();// Returns the depth and the blocking counters of the buffer
 
 private:
     void increment_read_ptr();
     void increment_write_ptr();
     bool full();
     bool empty();    
-    const size_t BUFF_DEPTH;
-    decoded_image_info _last_image_info;
-    std::queue<decoded_image_info> _circ_image_info;//!< Stores the loaded images names, decoded_width and decoded_height(data is stored in the _circ_buff)
-    std::mutex _names_buff_lock;
+    size_t BUFF_DEPTH = 0;
+    BufferOccupancy _occupancy;
+    std::vector<decoded_image_info> _image_info;//!< Stores the loaded images names, decoded_width and decoded_height of each buffer, indexed the same as the buffers
     /*
      *  Pinned memory allocated on the host used for fast host to device memory transactions,
      *  or the regular host memory buffers in the host processing case.
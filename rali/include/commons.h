@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #pragma once
 #include <vector>
+#include <algorithm>
 #include "exception.h"
 #include "log.h"
 
@@ -70,11 +71,33 @@ enum class RaliMemType
     OCL
 };
 
+/*! \brief Counters of a prefetch buffer between two pipeline stages
+ *
+ * The side that blocks more often is waiting on the other one, when the consumer of the output buffer (the user) blocks
+ * often the job is input-bound.
+ */
+struct BufferOccupancy
+{
+    size_t depth = 0;//!< Batches the buffer holds, one of them being read at any time
+    long long unsigned batch_count = 0;//!< Batches pushed by the producer
+    long long unsigned producer_block_count = 0;//!< Times the producer found the buffer full and waited
+    long long unsigned consumer_block_count = 0;//!< Times the consumer found the buffer empty and waited
+    BufferOccupancy& operator+=(const BufferOccupancy& other)
+    {
+        depth = std::max(depth, other.depth);
+        batch_count += other.batch_count;
+        producer_block_count += other.producer_block_count;
+        consumer_block_count += other.consumer_block_count;
+        return *this;
+    }
+};
+
 struct Timing
 {
     // The following timings are accumulated timing not just the most recent activity
     long long unsigned image_read_time= 0;
     long long unsigned image_decode_time= 0;
+    long long unsigned image_read_wait_time= 0;//!< Time decoding spent waiting for the compressed images to be read, accumulated over the images
     long long unsigned to_device_xfer_time= 0;
     long long unsigned from_device_xfer_time= 0;
     long long unsigned copy_to_output = 0;
@@ -84,4 +107,7 @@ struct Timing
     long long unsigned label_load_time= 0;
     long long unsigned bb_load_time= 0;
     long long unsigned mask_load_time = 0;
+    std::vector<float> decoder_utilization;//!< Fraction of the time each decode worker spent decoding since the loader started
+    BufferOccupancy loader_buffer;//!< Between the decoders and the augmentation graph, summed over the internal shards
+    BufferOccupancy output_buffer;//!< Between the augmentation graph and the user
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#pragma once
+#include <vector>
+#include <thread>
+#include <functional>
+#include <sched.h>
+
+//! The stages of the pipeline that can be placed on a set of CPUs
+enum class PipelineStage
+{
+    READ = 0,//!< I/O threads of the loaders
+    DECODE,//!< Decode workers and the loaders' internal threads
+    AUGMENT,//!< The internal processing thread running the augmentation graph
+    OUTPUT_COPY//!< The user's thread while it copies the output out of RALI
+};
+
+/*! \brief A set of CPUs the threads of a pipeline stage are pinned to
+ *
+ * An empty set doesn't restrict the threads. Host buffers written by a stage are first touched by a thread
+ * pinned to its set (run_on()), so that the kernel allocates their pages on the set's NUMA node.
+ */
+class CpuSet
+{
+public:
+    CpuSet() = default;
+    explicit CpuSet(const std::vector<unsigned>& cpus): _cpus(cpus) {}
+    bool empty() const { return _cpus.empty(); }
+    //! Number of CPUs the stage can run on, the ones the process is allowed to run on if the set is empty
+    size_t cpu_count() const;
+    //! Pins the thread to the set, does nothing if the set is empty
+    void apply(std::thread::native_handle_type thread) const;
+    //! Runs the function on a thread pinned to the set, or on the calling thread if the set is empty. Exceptions thrown by the function are rethrown on the calling thread
+    void run_on(const std::function<void()>& function) const;
+    //! The set as a mask, throws if a CPU index is out of range
+    cpu_set_t mask() const;
+private:
+    std::vector<unsigned> _cpus;
+};
+
+/*! \brief Pins the calling thread to the set for the lifetime of the object, then restores its previous affinity
+ *
+ * Does nothing if the set is empty or if the thread is already pinned to exactly the set's CPUs.
+ */
+class ScopedCpuSet
+{
+public:
+    explicit ScopedCpuSet(const CpuSet& cpu_set);
+    ~ScopedCpuSet();
+private:
+    cpu_set_t _previous_mask;
+    bool _applied = false;
+};
@@ -23,6 +23,8 @@ THE SOFTWARE.
 #pragma once
 
 #include <cstddef>
+#include "cpu_set.h"
+#include "parameter.h"
 
 enum class DecoderType
 {
@@ -37,10 +39,26 @@ class DecoderConfig
 public:
     explicit DecoderConfig(DecoderType type):_type(type){}
     virtual DecoderType type() {return _type; };
+    void set_thread_count(size_t thread_count) { _thread_count = thread_count; }
+    size_t thread_count() { return _thread_count; }//!< Number of decode workers, 0 means one per CPU of the cpu_set()
+    void set_cpu_set(const CpuSet& cpu_set) { _cpu_set = cpu_set; }
+    const CpuSet& cpu_set() { return _cpu_set; }//!< CPUs the decode workers run on
     DecoderType _type = DecoderType::TURBO_JPEG;
+    size_t _thread_count = 0;
+    CpuSet _cpu_set;
 };
 
 
+/*! \brief Chooses the region of each image to be decoded, for the pipelines whose crop is done by the decoder */
+class CropWindowGenerator
+{
+public:
+    //! Returns the crop window of an image in its original dimensions, it's called concurrently by the decoders
+    //! The window is a function of the image's position in the stream of samples, not of the order the images are decoded in
+    virtual void crop_window(const SamplePosition& position, unsigned width, unsigned height, size_t& x, size_t& y, size_t& crop_width, size_t& crop_height) = 0;
+    virtual ~CropWindowGenerator() = default;
+};
+
 class Decoder
 {
 public:
@@ -87,5 +105,21 @@ public:
                                    size_t &actual_decoded_width, size_t &actual_decoded_height,
                                    Decoder::ColorFormat desired_decoded_color_format) = 0;
 
+    //! Returns true if the decoder can decode a region of the image without decoding the rest of it, see decode_crop()
+    virtual bool can_decode_crop() { return false; }
+
+    //! Decodes only the part of the image inside the crop window
+    /*!
+      The crop window is given in the original image coordinates. The cropped region is written to the start of the output_buffer (with a row pitch of max_decoded_width pixels), scaled the same way decode() scales the whole image to fit it in max_decoded_width x max_decoded_height.
+      \param actual_decoded_width is set to the width of the decoded region
+      \param actual_decoded_height is set to the height of the decoded region
+    */
+    virtual Decoder::Status decode_crop(unsigned char *input_buffer, size_t input_size, unsigned char *output_buffer,
+                                        size_t max_decoded_width, size_t max_decoded_height,
+                                        size_t original_image_width, size_t original_image_height,
+                                        size_t crop_x, size_t crop_y, size_t crop_width, size_t crop_height,
+                                        size_t &actual_decoded_width, size_t &actual_decoded_height,
+                                        Decoder::ColorFormat desired_decoded_color_format) { return Status::UNSUPPORTED; }
+
     virtual ~Decoder() = default;
 };
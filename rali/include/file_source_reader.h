@@ -54,8 +54,29 @@ public:
     //! Returns the name of the latest file opened
     std::string id() override { return _last_id;};
 
+    std::string path() override { return _last_file_path; }
+
+    std::shared_ptr<const std::vector<std::string>> file_list() override { return _all_file_names; }
+
     unsigned count() override;
 
+    time_t last_modified() override;
+
+    //! Stats the next file, without opening it
+    bool peek_next(std::string& path, size_t& size, time_t& mtime) override;
+
+    void skip_next() override { incremenet_read_ptr(); }
+
+    //! Reads the next file without holding the reader's lock during the I/O, so files can be read concurrently
+    size_t read_next(std::vector<unsigned char>& buf, std::string& id) override;
+
+    bool can_map() override { return true; }
+
+    //! Maps the next file in memory
+    const unsigned char* map_next(size_t& size, std::string& id) override;
+
+    void unmap(const unsigned char* data, size_t size) override;
+
     ~FileSourceReader() override;
 
     int close() override;
@@ -63,18 +84,22 @@ public:
     FileSourceReader();
 
 private:
-    //! opens the folder containnig the images
-    Reader::Status open_folder();
+    //! opens the folder containnig the images and adds them to the file_names
+    Reader::Status open_folder(std::vector<std::string>& file_names);
     Reader::Status subfolder_reading();
+    //! Picks the files of this shard out of the _all_file_names
+    void select_shard_files();
     std::string _folder_path;
     DIR *_src_dir;
     DIR *_sub_dir;
     struct dirent *_entity;
     std::vector<std::string> _file_names;
+    std::shared_ptr<const std::vector<std::string>> _all_file_names;//!< Every file in the folder, shared with the other readers of the same folder
     unsigned  _curr_file_idx;
     FILE* _current_fPtr;
     unsigned _current_file_size;
     std::string _last_id;
+    std::string _last_file_path;
     std::string _last_file_name;
     size_t _shard_id = 0;
     size_t _shard_count = 1;// equivalent of batch size
@@ -91,5 +116,4 @@ private:
     size_t get_file_shard_id();
     void incremenet_file_id() { _file_id++; }
     void replicate_last_image_to_fill_last_shard();
-
 };
\ No newline at end of file
@@ -44,28 +44,34 @@ public:
     void start_loading() override;
     LoaderModuleStatus set_cpu_affinity(cpu_set_t cpu_mask);
     LoaderModuleStatus set_cpu_sched_policy(struct sched_param sched_policy);
-    std::vector<std::string> get_id() override;
+    const std::vector<std::string>& get_id() override;
+    const std::vector<ROI>& get_decoded_region() override;
+    bool set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator) override;
+    void set_prefetch_depth(size_t depth) override { _prefetch_depth = depth; }
 private:
     bool is_out_of_data();
     void de_init();
     void stop_internal_thread();
+    //! Empties the loader and restarts it from the beginning of the media, new_epoch is false when it only discards the batches loaded so far
+    void restart(bool new_epoch);
     std::shared_ptr<ImageReadAndDecode> _image_loader;
     LoaderModuleStatus update_output_image();
     LoaderModuleStatus load_routine();
     Image* _output_image;
     std::vector<std::string> _output_names;//!< image name/ids that are stores in the _output_image
+    std::vector<ROI> _output_decoded_region;//!< Region of the original images decoded into the _output_image
     size_t _output_mem_size;
     bool _internal_thread_running;
     size_t _batch_size;
     std::thread _load_thread;
     RaliMemType _mem_type;
-    decoded_image_info _decoded_img_info;
     CircularBuffer _circ_buff;
+    CpuSet _cpu_set;//!< The internal thread runs on the CPUs of the decode workers
     TimingDBG _swap_handle_time;
     bool _is_initialized;
     bool _stopped = false;
     bool _loop;//<! If true the reader will wrap around at the end of the media (files/images/...) and wouldn't stop
-    const static size_t CIRC_BUFFER_DEPTH = 3; // Used for circular buffer's internal buffer
+    size_t _prefetch_depth = LoaderOptions::MIN_AUTO_PREFETCH_DEPTH;//!< Depth of the circular buffer
     size_t _image_counter = 0;//!< How many images have been loaded already
     size_t _remaining_image_count;//!< How many images are there yet to be loaded
 };
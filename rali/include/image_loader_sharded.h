@@ -38,8 +38,11 @@ public:
     size_t remaining_count() override;
     void reset() override;
     void start_loading() override;
-    std::vector<std::string> get_id() override;
+    const std::vector<std::string>& get_id() override;
+    const std::vector<ROI>& get_decoded_region() override;
+    bool set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator) override;
     Timing timing() override;
+    void set_prefetch_depth(size_t depth) override { _prefetch_depth = depth; }
 private:
     void increment_loader_idx();
     const DeviceResources _dev_resources;
@@ -47,6 +50,7 @@ private:
     std::vector<std::shared_ptr<ImageLoader>> _loaders;
     size_t _loader_idx;
     size_t _shard_count = 1;
+    size_t _prefetch_depth = LoaderOptions::MIN_AUTO_PREFETCH_DEPTH;
     void fast_forward_through_empty_loaders();
 
     Image *_output_image;
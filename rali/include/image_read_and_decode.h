@@ -24,6 +24,12 @@ THE SOFTWARE.
 #include <dirent.h>
 #include <vector>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
 #include "commons.h"
 #include "turbo_jpeg_decoder.h"
 #include "reader_factory.h"
@@ -45,16 +51,18 @@ public:
     ImageReadAndDecode();
     ~ImageReadAndDecode();
     size_t count();
-    void reset();
+    //! Rewinds the reader, new_epoch is false when the batches loaded so far are only discarded and the pipeline hasn't run yet
+    void reset(bool new_epoch = true);
     void create(ReaderConfig reader_config, DecoderConfig decoder_config, int batch_size);
 
-    //! Loads a decompressed batch of images into the buffer indicated by buff
+    //! Loads a decompressed batch of images into the buffer indicated by buff, each image is decoded straight into its slot at buff + i * image size
     /// \param buff User's buffer provided to be filled with decoded image samples
-    /// \param names User's buffer provided to be filled with name of the images decoded
+    /// \param names User's buffer provided to be filled with name of the images decoded, its previous content is swapped in to be reused by the reader
     /// \param max_decoded_width User's buffer maximum width per decoded image. User expects the decoder to downscale the image if image's original width is bigger than max_width
     /// \param max_decoded_height user's buffer maximum height per decoded image. User expects the decoder to downscale the image if image's original height is bigger than max_height
     /// \param roi_width is set by the load() function tp the width of the region that decoded image is located. It's less than max_width and is either equal to the original image width if original image width is smaller than max_width or downscaled if necessary to fit the max_width criterion.
     /// \param roi_height  is set by the load() function tp the width of the region that decoded image is located.It's less than max_height and is either equal to the original image height if original image height is smaller than max_height or downscaled if necessary to fit the max_height criterion.
+    /// \param decoded_region is set by the load() function to the region of each original image that was decoded into the roi, the crop window if the images are cropped by the decoder, the whole image otherwise
     /// \param output_color_format defines what color format user expects decoder to decode images into if capable of doing so supported is
     LoaderModuleStatus load(
             unsigned char* buff,
@@ -63,23 +71,84 @@ public:
             const size_t max_decoded_height,
             std::vector<uint32_t> &roi_width,
             std::vector<uint32_t> &roi_height,
+            std::vector<ROI> &decoded_region,
             RaliColorFormat output_color_format );
 
     //! returns timing info or other status information
     Timing timing();
 
+    //! Makes the decoders decode only a crop window of each image, drawn from the generator, returns false if the decoder can't
+    bool set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator);
+
 private:
-    std::vector<std::shared_ptr<Decoder>> _decoder;
+    //! The state of a batch slot's compressed buffer in the read stage
+    enum class SlotState { PENDING = 0, READY, EMPTY };
+    //! I/O thread routine, keeps reading the next unread slot of the current batch
+    void read_routine();
+    //! Reads the next non-empty item into the slot, returns false if there is no more item to read
+    bool read_slot(size_t slot);
+    //! Blocks the caller until the slot's compressed buffer is read, returns false if nothing was read into it
+    bool wait_for_slot(size_t slot);
+    void stop_read_threads();
+    //! A decode worker's decoder and its queue of the batch's images
+    struct DecodeWorker
+    {
+        std::shared_ptr<Decoder> decoder;
+        std::deque<size_t> images;
+        std::mutex lock;
+        std::atomic<unsigned long long> busy_time {0};//!< in microseconds, time spent decoding since the worker started
+    };
+    //! Decode worker routine, decodes the images of its queue and then steals from the other workers until the batch is done
+    void decode_routine(size_t worker_id);
+    //! Pops the next image from the worker's queue or steals one from another worker, returns false if there is no image left
+    bool next_decode_task(size_t worker_id, size_t& image_idx);
+    //! Decodes the image of the slot into its place in the output buffer, read is false if nothing was read into the slot
+    void decode_image(size_t worker_id, size_t image_idx, bool read);
+    void stop_decode_threads();
+    //! Fraction of the time each decode worker spent decoding since the workers started
+    std::vector<float> decoder_utilization();
+    std::vector<std::unique_ptr<DecodeWorker>> _decode_workers;
+    std::vector<std::thread> _decode_threads;
+    std::mutex _decode_mutex;
+    std::condition_variable _decode_cv;//!< Signals the decode workers that a new batch is to be decoded
+    std::condition_variable _decode_done_cv;//!< Signals load() that all the images of the batch are decoded
+    size_t _decode_batch_id = 0;
+    size_t _images_left_to_decode = 0;
+    bool _decode_threads_running = false;
+    std::chrono::high_resolution_clock::time_point _decode_start_time;
+    // Parameters of the batch being decoded, set by load()
+    size_t _decode_width = 0, _decode_height = 0;
+    Decoder::ColorFormat _decode_color_format = Decoder::ColorFormat::RGB;
+    std::vector<uint32_t>* _decode_roi_width = nullptr;
+    std::vector<uint32_t>* _decode_roi_height = nullptr;
+    std::vector<ROI>* _decoded_region = nullptr;
     std::shared_ptr<Reader> _reader;
     std::vector<std::vector<unsigned char>> _compressed_buff;
+    std::vector<const unsigned char*> _compressed_data;//!< Points either to the slot's _compressed_buff or to the image mapped in memory
+    std::vector<size_t> _mapped_size;//!< Size of the slot's image mapped in memory, 0 if it's not mapped
+    bool _use_mmap = false;//!< The decoders read the images mapped in memory by the reader instead of copies of them
+    std::shared_ptr<CropWindowGenerator> _crop_window_generator = nullptr;//!< If set, only the crop window of the images are decoded
+    // The crop windows are keyed by the position of the images in the stream of samples: the batches of the shards are
+    // taken in turn, so batch k of shard s is the batch k * shard count + s of the epoch
+    size_t _shard_id = 0, _shard_count = 1;
+    unsigned _epoch = 0;//!< Number of times the reader has been reset since the pipeline started
+    unsigned long long _batch_index = 0;//!< Batches of the shard loaded since the beginning of the epoch
+    SamplePosition _batch_position;//!< Position of the first image of the batch being decoded
     std::vector<size_t> _actual_read_size;
     std::vector<std::string> _image_names;
     std::vector<size_t> _compressed_image_size;
     std::vector<unsigned char*> _decompressed_buff_ptrs;
-    std::vector<size_t> _actual_decoded_width;
-    std::vector<size_t> _actual_decoded_height;
     static const size_t MAX_COMPRESSED_SIZE = 1*1024*1024; // 1 Meg
     TimingDBG _file_load_time, _decode_time;
     size_t _batch_size;
+    std::vector<std::thread> _read_threads;//!< The read stage, fills the _compressed_buff slots while the decoders consume them
+    std::mutex _read_mutex;
+    std::condition_variable _read_cv;//!< Signals the read threads that a new batch is to be read
+    std::condition_variable _slot_cv;//!< Signals the decoders that a slot is read
+    std::vector<SlotState> _slot_state;
+    size_t _next_slot_to_read = 0;
+    size_t _slots_done = 0;
+    bool _read_threads_running = false;
+    std::atomic<unsigned long long> _read_wait_time;//!< in microseconds, accumulated since the loader started like the other timings
 };
 
@@ -23,6 +23,8 @@ THE SOFTWARE.
 #pragma once
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <mutex>
 #include "turbo_jpeg_decoder.h"
 #include "reader_factory.h"
 #include "timing_debug.h"
@@ -49,6 +51,26 @@ public:
     size_t max_height();
 
 private:
+    //! Width and height of an image, valid as long as its size and modification time have not changed
+    struct DimensionInfo
+    {
+        unsigned width;
+        unsigned height;
+        size_t size;//!< size of the stored item, see Reader::peek_next()
+        time_t mtime;
+    };
+    using DimensionIndex = std::unordered_map<std::string, DimensionInfo>;
+    //! Scans the images of a single shard, the images' dimensions are looked up in the _cached_index before opening them
+    /*!
+     \param reader The reader of the shard, if nullptr the shard's reader is created from the reader_cfg
+    */
+    void scan_shard(ReaderConfig reader_cfg, std::shared_ptr<Reader> reader, std::vector<std::pair<std::string, DimensionInfo>>& found);
+    //! Reads only as much of the image as needed to find its dimension, the reader is expected to have the image opened
+    bool read_dimension(Reader* reader, Decoder* decoder, size_t size, std::vector<unsigned char>& buff, int& width, int& height);
+    //! The sidecar file keeping the dimension of the images of the dataset found by previous runs
+    std::string index_file_path();
+    void load_index();
+    void save_index(const DimensionIndex& index);
     class FindMaxSize
     {
     public:
@@ -63,9 +85,9 @@ private:
     }; 
     FindMaxSize _width_max; 
     FindMaxSize _height_max;
-    std::shared_ptr<Decoder> _decoder;
-    std::shared_ptr<Reader> _reader;
-    std::vector<unsigned char> _header_buff;
-    static const size_t COMPRESSED_SIZE = 1024 * 1024; // 1 MB
+    ReaderConfig _reader_cfg = ReaderConfig(StorageType::FILE_SYSTEM);
+    DecoderConfig _decoder_cfg = DecoderConfig(DecoderType::TURBO_JPEG);
+    DimensionIndex _cached_index;
+    static const size_t HEADER_READ_SIZE = 4 * 1024; // 4 KB, enough for the SOF marker of most JPEGs without large EXIF data
 };
 
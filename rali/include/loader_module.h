@@ -38,6 +38,33 @@ enum class LoaderModuleStatus
     NOT_INITIALIZED
 };
 
+/*! \brief Pipeline wide settings of the loader modules
+ *
+ * Set by the user through raliSetContextAttribute() before the loader is created
+ */
+struct LoaderOptions
+{
+    size_t read_thread_count = 4;//!< Number of I/O threads per loader reading the images concurrently with decoding
+    size_t decode_thread_count = 0;//!< Number of decode workers shared by all the internal shards, 0 means one per core
+    bool memory_mapped_read = false;//!< Hands the decoders the images mapped in memory instead of copies of them
+    bool crop_on_decode = false;//!< Lets the decoder decode only the crop window when the loader's output is only cropped and resized
+    CpuSet read_cpu_set;//!< CPUs the I/O threads run on
+    CpuSet decode_cpu_set;//!< CPUs the decode workers and the loaders' internal threads run on
+    size_t prefetch_depth = 0;//!< Batches held by each of the loader's buffers (one per internal shard) and by the output buffer, 0 sizes them from prefetch_memory_budget
+    size_t prefetch_memory_budget = DEFAULT_PREFETCH_MEMORY_BUDGET;//!< In bytes, shared equally by the loader's buffers and the output buffer
+    //! Depth of each of buffer_count prefetch buffers holding batches of the given size, that share half of the budget
+    size_t buffer_depth(size_t batch_size_in_bytes, size_t buffer_count = 1) const
+    {
+        if(prefetch_depth)
+            return prefetch_depth;
+        size_t depth = (prefetch_memory_budget / 2) / std::max(buffer_count, (size_t)1) / std::max(batch_size_in_bytes, (size_t)1);
+        return std::min(std::max(depth, MIN_AUTO_PREFETCH_DEPTH), MAX_AUTO_PREFETCH_DEPTH);
+    }
+    const static size_t DEFAULT_PREFETCH_MEMORY_BUDGET = 512 << 20;
+    const static size_t MIN_AUTO_PREFETCH_DEPTH = 3;//!< The depth used before it was configurable, never go below it
+    const static size_t MAX_AUTO_PREFETCH_DEPTH = 8;
+};
+
 /*! \class LoaderModule The interface defining the API and requirements of loader modules*/
 class LoaderModule 
 {
@@ -49,8 +76,11 @@ public:
     virtual size_t remaining_count() = 0; // Returns the number of available images to be loaded
     virtual ~LoaderModule()= default;
     virtual Timing timing() = 0;// Returns timing info
-    virtual std::vector<std::string> get_id() = 0; // returns the id of the last batch of images/frames loaded
+    virtual const std::vector<std::string>& get_id() = 0; // returns the id of the last batch of images/frames loaded, valid until the next call to load_next()
+    virtual const std::vector<ROI>& get_decoded_region() = 0; // returns the region of each original image of the last batch that was decoded into the image's roi, valid until the next call to load_next()
     virtual void start_loading() = 0; // starts internal loading thread
+    virtual bool set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator) { return false; } // decode only the crop window of the images, returns false if not supported
+    virtual void set_prefetch_depth(size_t depth) {} // number of batches the loader can decode ahead, must be called before initialize()
 };
 
 using pLoaderModule = std::shared_ptr<LoaderModule>;
\ No newline at end of file
@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "node_cifar10_loader.h"
 #include "meta_data_reader.h"
 #include "meta_data_graph.h"
+#include "tensor_converter.h"
+#include "parameter_factory.h"
 
 class MasterGraph
 {
@@ -74,14 +76,26 @@ public:
     void set_loop(bool val) { _loop = val; }
     bool empty() { return (remaining_images_count() < _user_batch_size); }
     size_t internal_batch_size() { return _internal_batch_size; }
+    LoaderOptions loader_options() { return _loader_options; }
+    //! Sets the options of the loader, must be called before the loader is created
+    void set_loader_options(const LoaderOptions& options);
+    //! Pins the threads of a pipeline stage to the given CPUs, must be called before the loader is created for the read and decode stages
+    void set_cpu_set(PipelineStage stage, const CpuSet& cpu_set);
+    //! Makes the internal processing thread convert every batch to the tensor format, must be called before build()
+    void set_output_tensor_config(const OutputTensorConfig& config);
+    //! The current batch converted as set by set_output_tensor_config(), valid until the next call to run()
+    void* output_tensor_buffer();
 private:
     Status update_node_parameters();
     Status allocate_output_tensor();
     Status deallocate_output_tensor();
     void create_single_graph();
+    void enable_crop_on_decode();
+    void build_meta_data_graph();//!< Adds the counterparts of the nodes the output images go through to the meta data graph
     void start_processing();
     void stop_processing();
     void output_routine();
+    void convert_output_tensor(TensorConverter& converter, const std::vector<void*>& output_buffers, void* out_ptr, const OutputTensorConfig& config);
     void decrease_image_count();
     bool processing_on_device() { return _output_image_info.mem_type() == RaliMemType::OCL; };
     /// notify_user_thread() is called when the internal processing thread is done with processing all available images
@@ -105,28 +119,43 @@ private:
     pLoaderModule _loader_module; //!< Keeps the loader module used to feed the input the images of the graph
     TimingDBG _convert_time;
     const size_t _user_batch_size;//!< Batch size provided by the user
-    const size_t _cpu_threads;//!< Not in use
+    const size_t _cpu_threads;//!< Decode worker count and the thread budget used to size the internal batch, values less than 2 size them from the available cores
     vx_context _context;
     const RaliMemType _mem_type;//!< Is set according to the _affinity, if GPU, is set to CL, otherwise host
     TimingDBG _process_time;
     std::shared_ptr<MetaDataReader> _meta_data_reader = nullptr;
     std::shared_ptr<MetaDataGraph> _meta_data_graph = nullptr;
     bool _first_run = true;
+    unsigned _epoch = 0;//!< Number of times the graph has been reset, keys the random parameters with the sample index
+    unsigned long long _sample_index = 0;//!< Index of the first sample of the next internal batch since the last reset
+    unsigned _augmentation_node_count = 0;//!< Nodes added by add_node(), numbers the random streams of their parameters
     bool _processing;//!< Indicates if internal processing thread should keep processing or not
-    const static unsigned OUTPUT_RING_BUFFER_DEPTH = 3;
     const static unsigned SAMPLE_SIZE = sizeof(unsigned char);
     int _remaining_images_count;//!< Keeps the count of remaining images yet to be processed for the user,
     bool _loop;//!< Indicates if user wants to indefinitely loops through images or not
-    static size_t compute_optimum_internal_batch_size(size_t user_batch_size, RaliAffinity affinity);
+    static size_t compute_optimum_internal_batch_size(size_t user_batch_size, RaliAffinity affinity, size_t cpu_threads);
     const size_t _internal_batch_size;//!< In the host processing case , internal batch size can be different than _user_batch_size. This batch size used internally throughout.
     const size_t _user_to_internal_batch_ratio;
     bool _output_routine_finished_processing = false;
+    LoaderOptions _loader_options;//!< Set by the user through the context attributes, passed to the loader nodes
+    CpuSet _augment_cpu_set;//!< CPUs the output routine running the augmentation graph is pinned to
+    CpuSet _output_copy_cpu_set;//!< CPUs the copy of the processed images to the user buffers runs on
+    TensorConverter _tensor_converter;//!< Converts the host output images to the user's FP32/FP16 tensors on workers pinned to _output_copy_cpu_set
+    TensorConverter _prefetch_tensor_converter;//!< Converts each processed batch to the output tensor config on workers pinned to _augment_cpu_set
+    OutputTensorConfig _output_tensor_config;
+    bool _output_tensor_config_set = false;//!< When set on host, the ring buffer also keeps every batch converted to _output_tensor_config
+    bool _output_tensor_config_mismatch_reported = false;
 };
 
 template <typename T>
 std::shared_ptr<T> MasterGraph::add_node(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs)
 {
-    auto node = std::make_shared<T>(inputs, outputs);
+    std::shared_ptr<T> node;
+    {
+        // The streams of the node's random parameters only depend on its place in this pipeline
+        NodeStreamScope streams(_augmentation_node_count++);
+        node = std::make_shared<T>(inputs, outputs);
+    }
     _nodes.push_back(node);
 
     for(auto& input: inputs)
@@ -152,8 +181,9 @@ template<> inline std::shared_ptr<ImageLoaderNode> MasterGraph::add_node(const s
 {
     if(_loader_module)
         THROW("A loader already exists, cannot have more than one loader")
-    auto node = std::make_shared<ImageLoaderNode>(outputs[0], _device.resources());
+    auto node = std::make_shared<ImageLoaderNode>(outputs[0], _device.resources(), _loader_options);
     _loader_module = node->get_loader_module();
+    // The prefetch depth depends on the internal shard count, ImageLoaderNode::init() sets it
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _image_map.insert(make_pair(output, node));
@@ -164,8 +194,9 @@ template<> inline std::shared_ptr<ImageLoaderSingleShardNode> MasterGraph::add_n
 {
     if(_loader_module)
         THROW("A loader already exists, cannot have more than one loader")
-    auto node = std::make_shared<ImageLoaderSingleShardNode>(outputs[0], _device.resources());
+    auto node = std::make_shared<ImageLoaderSingleShardNode>(outputs[0], _device.resources(), _loader_options);
     _loader_module = node->get_loader_module();
+    _loader_module->set_prefetch_depth(_loader_options.buffer_depth(outputs[0]->info().data_size()));
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _image_map.insert(make_pair(output, node));
@@ -182,6 +213,7 @@ template<> inline std::shared_ptr<Cifar10LoaderNode> MasterGraph::add_node(const
         THROW("A loader already exists, cannot have more than one loader")
     auto node = std::make_shared<Cifar10LoaderNode>(outputs[0], _device.resources());
     _loader_module = node->get_loader_module();
+    _loader_module->set_prefetch_depth(_loader_options.buffer_depth(outputs[0]->info().data_size()));
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _image_map.insert(make_pair(output, node));
@@ -21,22 +21,17 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <memory>
 #include "meta_data.h"
-#include "parameter_factory.h"
+#include "node.h"
 
 class MetaDataGraph
 {
 public:
     virtual ~MetaDataGraph()= default;
-    virtual void process() = 0;
+    //! Applies the transformations of the nodes to the meta data of the batch the image graph has just processed
+    virtual void process(MetaDataBatch* meta_data) = 0;
+    //! Adds the counterpart of an image node, nodes are added in the order they process the images, starting with the loader
+    virtual void add_node(const std::shared_ptr<Node>& node) = 0;
     virtual void build() = 0;
-    virtual MetaDataBatch * cropMirrorNormalize(MetaDataBatch *input, int w, int h, int, int x, int y, IntParam* mirror) = 0;
-    virtual MetaDataBatch * crop_resize(MetaDataBatch *input, unsigned dest_width, unsigned dest_height,
-                                        bool is_output,
-                                        FloatParam* area,
-                                        FloatParam* x_center_drift,
-                                        FloatParam* y_center_drift )  = 0;
-
-    virtual MetaDataBatch* resize(MetaDataBatch* input, unsigned dest_width, unsigned dest_height) = 0;
 };
-
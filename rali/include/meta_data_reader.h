@@ -31,7 +31,8 @@ enum class MetaDataReaderType
     FOLDER_BASED_LABEL_READER = 0,// Used for imagenet-like dataset
     TEXT_FILE_META_DATA_READER,// Used when metadata is stored in a text file
     COCO_META_DATA_READER,
-    CIFAR10_META_DATA_READER    // meta_data for cifar10 data which is store as part of bin file
+    CIFAR10_META_DATA_READER,    // meta_data for cifar10 data which is store as part of bin file
+    TF_META_DATA_READER         // labels stored in the tf.train.Example records of TFRecord files
 };
 enum class MetaDataType
 {
@@ -0,0 +1,42 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <vector>
+
+//! Transformation of the bounding boxes of an image, a point (x, y) is mapped to (a * x + b * y + c, d * x + e * y + f),
+//! the boxes are then clipped to the [0, width] x [0, height] output image
+struct BoxTransform
+{
+    float a = 1, b = 0, c = 0;
+    float d = 0, e = 1, f = 0;
+    float width = 0, height = 0;
+};
+
+//! The meta data counterpart of an image node, describes how the node moved the pixels of each image of the batch
+class MetaNode
+{
+public:
+    virtual ~MetaNode() = default;
+    //! Fills transforms with the transformation the image node applied to each image of the batch it last processed
+    virtual void update_transforms(std::vector<BoxTransform>& transforms) = 0;
+};
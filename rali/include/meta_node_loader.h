@@ -0,0 +1,38 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <memory>
+#include "meta_node.h"
+#include "loader_module.h"
+
+//! Maps the boxes, given in the original images coordinates, to the images decoded by the loader
+class LoaderMetaNode : public MetaNode
+{
+public:
+    LoaderMetaNode(std::shared_ptr<LoaderModule> loader, Image* output): _loader(std::move(loader)), _output(output) {}
+    LoaderMetaNode() = delete;
+    void update_transforms(std::vector<BoxTransform>& transforms) override;
+private:
+    std::shared_ptr<LoaderModule> _loader;
+    Image* _output;//!< The loader's output image, its roi is the size each region was decoded to
+};
@@ -35,6 +35,7 @@ public:
     void init(unsigned int crop_h, unsigned int crop_w, float x_drift, float y_drift);
     void init(unsigned int crop_h, unsigned int crop_w);
     void init( FloatParam *crop_h_factor, FloatParam *crop_w_factor, FloatParam * x_drift, FloatParam * y_drift);
+    std::shared_ptr<CropParam> get_crop_param() { return _crop_param; }
 protected:
     void create_node() override ;
     void update_node() override;
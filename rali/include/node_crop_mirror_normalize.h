@@ -33,6 +33,9 @@ public:
                             const std::vector<Image *> &outputs);
     CropMirrorNormalizeNode() = delete;
     void init(int crop_h, int crop_w, float start_x, float start_y, float mean, float std_dev, IntParam *mirror);
+    int get_crop_width() const { return _crop_w; }
+    int get_crop_height() const { return _crop_h; }
+    const std::vector<int>& get_mirror() const { return _mirror.get_array(); }
 protected:
     void create_node() override ;
     void update_node() override;
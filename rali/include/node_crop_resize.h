@@ -34,6 +34,10 @@ public:
     CropResizeNode() = delete;
     void init(float area, float aspect_ratio, float x_center_drift, float y_center_drift);
     void init(FloatParam* area, FloatParam *aspect_ratio, FloatParam * x_center_drift, FloatParam * y_center_drift);
+    std::shared_ptr<CropWindowGenerator> crop_window_generator() { return _crop_param; }
+    std::shared_ptr<RandomCropResizeParam> get_crop_param() { return _crop_param; }
+    //! Called when the loader's decoder crops the images using crop_window_generator(), the node then only resizes them
+    void set_cropped_by_decoder() { _crop_param->set_cropped_by_decoder(true); }
 
 protected:
     void create_node() override;
@@ -32,6 +32,7 @@ public:
     FlipNode() = delete;
     void init(int flip_axis);
     void init(IntParam *flip_axis);
+    const std::vector<int>& get_flip_axis() const { return _flip_axis.get_array(); }
 protected:
     void create_node() override;
     void update_node() override;
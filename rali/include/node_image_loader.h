@@ -31,7 +31,7 @@ public:
     /// \param device_resources shard count from user
 
     /// internal_shard_count number of loader/decoders are created and each shard is loaded and decoded using separate and independent resources increasing the parallelism and performance.
-    ImageLoaderNode(Image *output, DeviceResources device_resources);
+    ImageLoaderNode(Image *output, DeviceResources device_resources, LoaderOptions loader_options = LoaderOptions());
     ~ImageLoaderNode() override;
     ImageLoaderNode() = delete;
     ///
@@ -49,4 +49,5 @@ protected:
     void update_node() override {};
 private:
     std::shared_ptr<ImageLoaderSharded> _loader_module = nullptr;
+    LoaderOptions _loader_options;
 };
\ No newline at end of file
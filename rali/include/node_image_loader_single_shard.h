@@ -28,7 +28,7 @@ THE SOFTWARE.
 class ImageLoaderSingleShardNode: public Node
 {
 public:
-    ImageLoaderSingleShardNode(Image *output, DeviceResources device_resources);
+    ImageLoaderSingleShardNode(Image *output, DeviceResources device_resources, LoaderOptions loader_options = LoaderOptions());
     ~ImageLoaderSingleShardNode() override;
 
     /// \param user_shard_count shard count from user
@@ -47,4 +47,5 @@ protected:
     void update_node() override {};
 private:
     std::shared_ptr<ImageLoader> _loader_module = nullptr;
+    LoaderOptions _loader_options;
 };
\ No newline at end of file
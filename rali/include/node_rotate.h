@@ -33,6 +33,7 @@ public:
     RotateNode() = delete;
     void init(float angle);
     void init(FloatParam *angle);
+    const std::vector<float>& get_angle() const { return _angle.get_array(); }
 
 protected:
     void create_node() override;
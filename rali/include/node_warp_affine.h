@@ -33,6 +33,8 @@ public:
     WarpAffineNode() = delete;
     void init(float x0, float x1, float y0, float y1, float o0, float o1);
     void init(FloatParam* x0, FloatParam* x1, FloatParam* y0, FloatParam* y1, FloatParam* o0, FloatParam* o1);
+    //! Six coefficients per image, {x0, y0, x1, y1, o0, o1} mapping (x, y) to (x0 * x + x1 * y + o0, y0 * x + y1 * y + o1)
+    const std::vector<float>& get_affine() const { return _affine; }
 protected:
     void create_node() override;
     void update_node() override;
@@ -45,10 +47,12 @@ private:
     ParameterVX<float> _o1;
 
     std::vector<float> _affine;
+    std::vector<float> _coeff_values;//!< Values of one of the coefficients for the whole batch
     vx_array _dst_roi_width,_dst_roi_height;
     vx_array _affine_array;
     constexpr static float COEFFICIENT_RANGE_0 [2] = {-0.35, 0.35};
     constexpr static float COEFFICIENT_RANGE_1 [2] = {0.65, 1.35};
     constexpr static float COEFFICIENT_RANGE_OFFSET [2] = {-10.0, 10.0};
     void update_affine_array();
+    void generate_affine_values();
 };
@@ -21,6 +21,14 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <cstddef>
+
+//! Position of the first sample of a batch in the stream of samples, the random parameters of a sample are keyed by it
+struct SamplePosition
+{
+    unsigned epoch = 0;//!< Number of times the pipeline has been reset
+    unsigned long long sample = 0;//!< Index of the sample since the beginning of the epoch
+};
 
 template <typename T>
 class Parameter
@@ -34,6 +42,19 @@ public:
     /// used to internally renew state of the parameter if needed (for random parameters)
     virtual void renew() {};
 
+    /// Fills values with the parameter of count consecutive samples, starting at the given position
+    /// For random parameters the value of a sample only depends on the seed, the stream and the position of the
+    /// sample, so the values don't depend on how the samples are batched or on the order batches are generated in
+    /// \param stream identifies the consumer of the parameter, so that each consumer draws independent values
+    virtual void generate(T* values, size_t count, const SamplePosition& position, unsigned stream)
+    {
+        for(size_t i = 0; i < count; i++)
+        {
+            renew();
+            values[i] = get();
+        }
+    }
+
     virtual ~Parameter() {}
     ///
     /// \return returns if this parameter takes a single value (vs a range of values or many values)
@@ -46,6 +46,8 @@ public:
         y_drift_factor     = default_y_drift_factor();
         crop_height_factor = default_crop_height_factor();
         crop_width_factor  = default_crop_width_factor();
+        _crop_height_stream = ParameterFactory::instance()->create_stream();
+        _crop_width_stream = ParameterFactory::instance()->create_stream();
     }
     void set_image_dimensions( const std::vector<uint32_t>& in_width_, const std::vector<uint32_t>& in_height_)
     {
@@ -69,6 +71,7 @@ public:
     void create_array(std::shared_ptr<Graph> graph);
     void update_array();
     void get_crop_dimensions(std::vector<uint32_t> &crop_w_dim, std::vector<uint32_t> &crop_h_dim);
+    void get_crop_origin(std::vector<uint32_t> &x1_dim, std::vector<uint32_t> &y1_dim);
 private:
     constexpr static float CROP_X_DRIFT_RANGE [2]  = {0.01, 0.49}; 
     constexpr static float CROP_Y_DRIFT_RANGE [2]  = {0.01, 0.49};
@@ -80,6 +83,8 @@ private:
     Parameter<float>* default_crop_height_factor();
     Parameter<float>* default_crop_width_factor();
     std::vector<uint32_t> x1_arr_val, y1_arr_val, croph_arr_val, cropw_arr_val, x2_arr_val, y2_arr_val;
+    std::vector<float> _crop_h_factors, _crop_w_factors;//!< Per image crop factors, used by the random crop
+    unsigned _crop_height_stream, _crop_width_stream;
     bool _centric, _random;
     void fill_values();
 };
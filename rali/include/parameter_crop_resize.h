@@ -23,8 +23,9 @@ THE SOFTWARE.
 #pragma once
 #include <VX/vx_types.h>
 #include "parameter_factory.h"
+#include "decoder.h"
 
-class RandomCropResizeParam
+class RandomCropResizeParam : public CropWindowGenerator
 {
 
 // +-----------------------------------------> X direction
@@ -46,6 +47,10 @@ public:
         aspect_ratio_coeff = default_aspect_ratio();
         x_center_drift = default_x_drift();
         y_center_drift = default_y_drift();
+        _area_stream = ParameterFactory::instance()->create_stream();
+        _aspect_ratio_stream = ParameterFactory::instance()->create_stream();
+        _x_drift_stream = ParameterFactory::instance()->create_stream();
+        _y_drift_stream = ParameterFactory::instance()->create_stream();
         //calculate_area(area_coeff->default_value(), x_center_drift->default_value(), y_center_drift->default_value());
     }
     void set_image_dimensions(const std::vector<uint32_t>& in_width_, const std::vector<uint32_t>& in_height_)
@@ -75,6 +80,13 @@ public:
     void create_array(std::shared_ptr<Graph> graph);
     void update_array();
     void update_array_for_cmn();
+    //! Draws the random crop window of the sample at the given position, used when the crop is done by the decoder
+    //! The coefficients come from the same streams as generate_coeffs(), a sample gets the same window whether it's cropped by the decoder or by the node
+    void crop_window(const SamplePosition& position, unsigned width, unsigned height, size_t& x, size_t& y, size_t& crop_width, size_t& crop_height) override;
+    //! If set, the input images are already cropped and update_array() passes the whole input image as the crop area
+    void set_cropped_by_decoder(bool cropped) { _cropped_by_decoder = cropped; }
+    //! Returns the crop window of an image computed by the last update_array(), the whole input image if it was cropped by the decoder
+    void get_crop_window(unsigned image_idx, float& x, float& y, float& width, float& height) const;
 private:
     constexpr static float CROP_AREA_RANGE [2] = {0.05, 0.9};
     constexpr static float CROP_ASPECT_RATIO[2] = {0.7500, 1.333};
@@ -84,7 +96,13 @@ private:
     Parameter<float> *area_coeff, *x_center_drift, *y_center_drift;
     Parameter<float> *aspect_ratio_coeff;
     std::vector<size_t> x1_arr_val,x2_arr_val,y1_arr_val,y2_arr_val;
+    std::vector<float> _area_values, _aspect_ratio_values, _x_drift_values, _y_drift_values;//!< Per image coefficients of the batch
+    unsigned _area_stream, _aspect_ratio_stream, _x_drift_stream, _y_drift_stream;
+    void generate_coeffs();
     void calculate_area_cmn(unsigned image_idx, float area_coeff_, float x_center_drift_, float y_center_drift_, float aspect_ratio_);
+    static void calculate_area(unsigned width, unsigned height, float area_coeff_, float x_center_drift_, float y_center_drift_, float aspect_ratio_,
+                               size_t& x1, size_t& y1, size_t& x2, size_t& y2);
+    bool _cropped_by_decoder = false;
     Parameter<float>* default_area();
     Parameter<float>* default_aspect_ratio();
     Parameter<float>* default_x_drift();
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <atomic>
 #include "parameter_random.h"
 #include "parameter_simple.h"
 
@@ -77,10 +78,20 @@ public:
     void renew_parameters();
     void set_seed(unsigned seed);
     unsigned get_seed();
+    //! Returns a new stream id, consumers of the parameters draw their per sample values from their own stream
+    //! Within a NodeStreamScope the id is made of the node's index in its pipeline and the number of streams the node created before,
+    //! so that it doesn't depend on the other pipelines of the process. Outside of it (raliCreate*Rand parameters) it's taken from a process wide counter
+    unsigned create_stream();
+    //! Makes create_stream() number the streams created on the calling thread after the node, until end_node_streams() is called
+    static void begin_node_streams(unsigned node_index);
+    static void end_node_streams();
+    //! Sets the position of the batch whose parameters are generated next on the calling thread
+    static void set_sample_position(const SamplePosition& position);
+    static SamplePosition sample_position();
 
     template<typename T>
     Parameter<T>* create_uniform_rand_param(T start, T end){
-        auto gen = new UniformRand<T>(start, end, _seed);
+        auto gen = new UniformRand<T>(start, end, _seed, create_stream());
         _parameters.insert(gen);
         return gen;
     }
@@ -105,12 +116,31 @@ public:
     FloatParam* create_single_value_float_param(float value);
 private:
     long long unsigned _seed;
+    std::atomic<unsigned> _stream_count;//!< Streams created outside of a node are numbered in the order they are created, so that they're the same from run to run
+    static constexpr unsigned NODE_STREAM_FLAG = 1u << 31;//!< Keeps the streams of the nodes apart from the ones of the process wide counter
+    static constexpr unsigned NODE_STREAM_BITS = 8;//!< Streams a node can create
+    struct NodeStreams
+    {
+        bool active = false;
+        unsigned node_index = 0;
+        unsigned count = 0;
+    };
+    static thread_local NodeStreams _node_streams;
+    static thread_local SamplePosition _sample_position;
     std::set<pParamCore> _parameters; //<! Keeps the random generators used to randomized the augmentation parameters
     static ParameterFactory* _instance;
     static std::mutex _mutex; 
     ParameterFactory();
 };
 
+/*! \brief Numbers the streams of the parameters created by a node's constructor after the node's index in its pipeline */
+class NodeStreamScope
+{
+public:
+    explicit NodeStreamScope(unsigned node_index) { ParameterFactory::begin_node_streams(node_index); }
+    ~NodeStreamScope() { ParameterFactory::end_node_streams(); }
+};
+
 
 
 
@@ -30,15 +30,42 @@ THE SOFTWARE.
 #include <algorithm> // std::remove_if
 #include <vector>
 #include <thread>
-#include <random>
+#include <atomic>
+#include <mutex>
 #include "parameter.h"
+#include "philox.h"
 #include "log.h"
+//! The random parameters are drawn from counter-based Philox streams, the per sample values are keyed by the seed and
+//! the consumer's stream, and counted by the epoch and the sample index, the values drawn by renew() are counted
+//! by the parameter's own draw count in a separate domain
+namespace random_param
+{
+constexpr uint32_t SAMPLE_DOMAIN = 0;
+constexpr uint32_t RENEW_DOMAIN = 1;
+constexpr size_t WORDS_PER_CHUNK = 256;//!< Random words generated per call to the generator, kept on the stack
+constexpr double WORD_MAX = 4294967295.0;
+
+inline void sample_words(uint32_t* words, size_t count, unsigned long long first_sample, unsigned epoch, unsigned seed, unsigned stream)
+{
+    Philox4x32::fill(words, count, first_sample, {epoch, SAMPLE_DOMAIN}, {seed, stream});
+}
+
+inline uint32_t renew_word(unsigned long long draw, unsigned seed, unsigned stream)
+{
+    uint32_t word;
+    Philox4x32::fill(&word, 1, draw, {0, RENEW_DOMAIN}, {seed, stream});
+    return word;
+}
+}
+
 template <typename T>
 class UniformRand: public Parameter<T>
 {
 public:
 
-    UniformRand(T start, T end, unsigned seed = 0):_generator(seed)
+    UniformRand(T start, T end, unsigned seed = 0, unsigned stream = 0):
+            _seed(seed),
+            _stream(stream)
     {
         update(start, end);
         renew();
@@ -58,21 +85,35 @@ public:
     };
     void renew() override
     {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto val =_generator();
-
-        if(single_value())
+        T start = _start, end = _end;
+        if(start == end)
         {
             // If there is only a single value possible for the random variable
             // don't waste time on calling the rand function , just return it.
-            _updated_val = _start;
+            _updated_val = start;
         } else {
-            _updated_val = static_cast<T>(
-                    ((double)val / (double) _generator.max()) * ((double) _end - (double) _start) + (double) _start);
+            _updated_val = map(random_param::renew_word(_draw_count++, _seed, _stream), start, end);
+        }
+    }
+    void generate(T* values, size_t count, const SamplePosition& position, unsigned stream) override
+    {
+        // The range is read once so that a concurrent update() applies to whole batches
+        T start = _start, end = _end;
+        if(start == end)
+        {
+            std::fill_n(values, count, start);
+            return;
+        }
+        uint32_t words[random_param::WORDS_PER_CHUNK];
+        for(size_t done = 0; done < count; done += random_param::WORDS_PER_CHUNK)
+        {
+            size_t n = std::min(count - done, random_param::WORDS_PER_CHUNK);
+            random_param::sample_words(words, n, position.sample + done, position.epoch, _seed, stream);
+            for(size_t i = 0; i < n; i++)
+                values[done + i] = map(words[i], start, end);
         }
     }
     int update(T start, T end) {
-        std::unique_lock<std::mutex> lock(_lock);
         if(end < start)
             end = start;
 
@@ -85,11 +126,16 @@ public:
         return (_start == _end);
     }
 private:
-    T _start;
-    T _end;
+    static T map(uint32_t word, T start, T end)
+    {
+        return static_cast<T>(((double)word / random_param::WORD_MAX) * ((double) end - (double) start) + (double) start);
+    }
+    std::atomic<T> _start;
+    std::atomic<T> _end;
     T _updated_val;
-    std::mt19937 _generator;
-    std::mutex _lock;
+    const unsigned _seed;
+    const unsigned _stream;//!< Stream of the values drawn by renew()
+    std::atomic<unsigned long long> _draw_count = 0;//!< Number of values drawn by renew()
 };
 
 
@@ -102,7 +148,9 @@ struct CustomRand: public Parameter<T>
     (
         const T values[],
         const double frequencies[],
-        size_t size, unsigned seed = 0):_generator(seed)
+        size_t size, unsigned seed = 0, unsigned stream = 0):
+        _seed(seed),
+        _stream(stream)
     {
         update(values, frequencies, size);
         renew();
@@ -169,16 +217,25 @@ struct CustomRand: public Parameter<T>
             _updated_val =  _values[0];
         }
         else {
-            // Generate a value between [0 1]
-            double rand_val = (double) _generator() / (double) _generator.max();
-
-            // Find the iterators pointing to the first element bigger than idx
-            auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
-
-            // Get the index and return the associated value
-            unsigned idx = std::distance(_comltv_dist.begin(), it);
-
-            _updated_val = _values[idx];
+            _updated_val = sample(random_param::renew_word(_draw_count++, _seed, _stream));
+        }
+    }
+    void generate(T* values, size_t count, const SamplePosition& position, unsigned stream) override
+    {
+        // Locked once per batch, as update() replaces the distribution
+        std::unique_lock<std::mutex> lock(_lock);
+        if(single_value())
+        {
+            std::fill_n(values, count, _values[0]);
+            return;
+        }
+        uint32_t words[random_param::WORDS_PER_CHUNK];
+        for(size_t done = 0; done < count; done += random_param::WORDS_PER_CHUNK)
+        {
+            size_t n = std::min(count - done, random_param::WORDS_PER_CHUNK);
+            random_param::sample_words(words, n, position.sample + done, position.epoch, _seed, stream);
+            for(size_t i = 0; i < n; i++)
+                values[done + i] = sample(words[i]);
         }
     }
     T get() override
@@ -191,11 +248,26 @@ struct CustomRand: public Parameter<T>
         return (_values.size() == 1);
     }
 private:
+    T sample(uint32_t word) const
+    {
+        // Generate a value between [0 1]
+        double rand_val = (double) word / random_param::WORD_MAX;
+
+        // Find the iterators pointing to the first element bigger than idx
+        auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
+
+        // Get the index and return the associated value, rand_val equal to 1 would point past the last value
+        unsigned idx = std::min((size_t)std::distance(_comltv_dist.begin(), it), _values.size() - 1);
+
+        return _values[idx];
+    }
     std::vector<T> _values;//!< Values
     std::vector<double> _frequencies;//!< Probabilities
     std::vector<double> _comltv_dist;//!< commulative probabilities
     double _mean;
     T _updated_val;
-    std::mt19937 _generator;
+    const unsigned _seed;
+    const unsigned _stream;//!< Stream of the values drawn by renew()
+    unsigned long long _draw_count = 0;//!< Number of values drawn by renew()
     std::mutex _lock;
 };
\ No newline at end of file
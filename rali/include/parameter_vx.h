@@ -37,6 +37,7 @@ public:
     {
         _param = ParameterFactory::instance()->create_uniform_rand_param<T>(_DEFAULT_RANGE_START,
                                                                             _DEFAULT_RANGE_END);
+        _stream = ParameterFactory::instance()->create_stream();
     }
     ParameterVX( T default_range_start, T default_range_end):
             _DEFAULT_RANGE_START(default_range_start),
@@ -44,6 +45,7 @@ public:
     {
         _param = ParameterFactory::instance()->create_uniform_rand_param<T>(_DEFAULT_RANGE_START,
                                                                             _DEFAULT_RANGE_END);
+        _stream = ParameterFactory::instance()->create_stream();
     }
     void create(vx_node node)
     {
@@ -85,6 +87,11 @@ public:
     {
         return _array;
     }
+    //! Values of the last update_array(), one per image of the batch
+    const std::vector<T>& get_array() const
+    {
+        return _arrVal;
+    }
     vx_scalar default_scalar(std::shared_ptr<Graph> _graph, vx_enum data_type)
     {
         _scalar = vxCreateScalar(vxGetContext((vx_reference)_graph->get()), data_type, &_val);
@@ -110,14 +117,16 @@ public:
     void update_array( )
     {
         vx_status status;
-        for (uint i=0; i < _batch_size ; i++ )
-        {
-            _arrVal[i] = renew();
-        }
+        generate(_arrVal.data(), _batch_size);
         status = vxCopyArrayRange((vx_array)_array, 0, _batch_size, sizeof(T), _arrVal.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
         if(status != 0)
             THROW(" vxCopyArrayRange failed in update_array (ParameterVX): "+ TOSTR(status))
     }
+    //! Fills values with the parameter of count consecutive samples of the batch being processed
+    void generate(T* values, size_t count)
+    {
+        _param->generate(values, count, ParameterFactory::sample_position(), _stream);
+    }
     T renew()
     {
         _param->renew();
@@ -130,6 +139,7 @@ private:
     T _val;
     std::vector<T> _arrVal;
     unsigned _batch_size;
+    unsigned _stream;//!< Stream of the per sample values of this parameter
     unsigned OVX_PARAM_IDX;
     const T _DEFAULT_RANGE_START;
     const T _DEFAULT_RANGE_END;
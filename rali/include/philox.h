@@ -0,0 +1,43 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//! Counter-based Philox4x32-10 random generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+//! Each block of four random words is a pure function of its 128 bit counter and 64 bit key, so any part of a
+//! random sequence can be generated by any thread, in any order and without a shared state
+class Philox4x32
+{
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+    static constexpr size_t WORDS_PER_BLOCK = 4;
+    //! Returns the four random words of the block at the given counter
+    static Counter block(Counter counter, Key key);
+    //! Fills out with the random words first to first+count-1 of the sequence made of the blocks with the
+    //! counters {n, n>>32, counter_hi[0], counter_hi[1]}, where n is the block index, word i is the word i%4 of block i/4
+    //! The blocks are generated eight at a time with AVX2 when available
+    static void fill(uint32_t* out, size_t count, uint64_t first, std::array<uint32_t, 2> counter_hi, Key key);
+};
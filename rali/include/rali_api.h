@@ -35,10 +35,41 @@ THE SOFTWARE.
 /// \param batch_size
 /// \param affinity
 /// \param gpu_id
-/// \param cpu_thread_count
+/// \param cpu_thread_count Number of decode workers and the thread budget of the host processing, values less than 2 size them from the CPUs the process can run on
 /// \return
 extern "C"  RaliContext  RALI_API_CALL raliCreate(size_t batch_size, RaliProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1);
 
+/// Sets an attribute of the context, loader attributes must be set before the loader is created
+/// \param context
+/// \param attribute
+/// \param value
+/// \return
+extern "C"  RaliStatus RALI_API_CALL raliSetContextAttribute(RaliContext context, RaliContextAttribute attribute, size_t value);
+
+/// Pins the threads of a pipeline stage to a set of CPUs, the host buffers the stage writes are first touched from them so that they are placed on the same NUMA node.
+/// Read and decode sets must be set before the loader is created, the augment set before the first run.
+/// With an output copy set, raliCopyToOutput* calls pin the calling thread to it and restore its affinity before returning. Without one, the affinity of the user's threads is never changed
+/// \param context
+/// \param stage
+/// \param cpus Logical CPU ids, as listed by lscpu
+/// \param cpu_count Number of entries in cpus, zero removes the pinning of the stage
+/// \return
+extern "C"  RaliStatus RALI_API_CALL raliSetStageCpuSet(RaliContext context, RaliPipelineStage stage, const unsigned* cpus, size_t cpu_count);
+
+/// Declares the tensor the output images are copied to, so that the internal processing thread converts each batch ahead of time.
+/// raliCopyToOutputTensor32/16 calls with the same arguments then only copy the converted batch, other calls still convert on the caller's thread.
+/// Must be called before raliVerify, it is ignored for GPU affinity where the conversion runs on the device.
+/// \param context
+/// \param tensor_format
+/// \param tensor_data_type
+/// \param multiplier0 Per channel scale, applied before the offset
+/// \param offset0 Per channel offset
+/// \param reverse_channels
+/// \return
+extern "C"  RaliStatus RALI_API_CALL raliSetOutputTensorConfig(RaliContext context, RaliTensorLayout tensor_format, RaliTensorOutputType tensor_data_type,
+                                                              float multiplier0, float multiplier1, float multiplier2,
+                                                              float offset0, float offset1, float offset2, bool reverse_channels);
+
 ///
 /// \param context
 /// \return
@@ -26,6 +26,7 @@ THE SOFTWARE.
 
 /*! \brief
  *
+ * If a RALI_STAGE_OUTPUT_COPY CPU set is configured, the calling thread runs on it for the duration of the call, the same holds for raliCopyToOutputTensor32/16
 */
 extern "C"  RaliStatus   RALI_API_CALL raliCopyToOutput(RaliContext context, unsigned char * out_ptr, size_t out_size);
 
@@ -43,4 +44,10 @@ extern "C"  RaliStatus   RALI_API_CALL raliCopyToOutputTensor16(RaliContext rali
                                                               float multiplier1, float multiplier2, float offset0,
                                                               float offset1, float offset2,
                                                               bool reverse_channels);
+
+/*! \brief Returns the current batch converted as declared by raliSetOutputTensorConfig, without copying it
+ *
+ * The buffer is owned by RALI and stays valid until the next raliRun call. Returns null on error or when there is no more data.
+*/
+extern "C"  void*   RALI_API_CALL raliGetOutputTensorBuffer(RaliContext rali_context);
 #endif //MIVISIONX_RALI_API_DATA_TRANSFER_H
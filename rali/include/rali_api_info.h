@@ -85,4 +85,21 @@ extern "C" const char* RALI_API_CALL raliGetErrorMessage(RaliContext rali_contex
 /// \return The timing info associated with recent execution.
 extern "C" TimingInfo RALI_API_CALL raliGetTimingInfo(RaliContext rali_context);
 
+/// Helps sizing the decode thread count (RALI_DECODE_THREAD_COUNT context attribute)
+/// \param rali_context
+/// \param utilization User's buffer filled with the fraction of the time each decode worker has spent decoding since the loader started, can be null
+/// \param count Size of the utilization buffer
+/// \return The number of decode workers
+extern "C" size_t RALI_API_CALL raliGetDecoderUtilization(RaliContext rali_context, float* utilization, size_t count);
+
+/// Helps sizing the prefetch depth (RALI_PREFETCH_DEPTH context attribute), the counters are accumulated since the pipeline was built
+/// \param rali_context
+/// \return The occupancy of the buffer between the decoders and the augmentation graph, summed over the internal shards of the loader
+extern "C" RaliBufferOccupancy RALI_API_CALL raliGetLoaderBufferOccupancy(RaliContext rali_context);
+
+/// A high consumer_block_count means the user waits on RALI, the job is input-bound
+/// \param rali_context
+/// \return The occupancy of the buffer between the augmentation graph and the user
+extern "C" RaliBufferOccupancy RALI_API_CALL raliGetOutputBufferOccupancy(RaliContext rali_context);
+
 #endif //MIVISIONX_RALI_API_INFO_H
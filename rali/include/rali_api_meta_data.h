@@ -41,6 +41,12 @@ extern "C" RaliMetaData RALI_API_CALL raliCreateCOCOReader(RaliContext rali_cont
 /// \param source_path path to the file that contains the metadata file
 /// \return RaliMetaData object, can be used to inquire about the rali's output (processed) tensors
 extern "C" RaliMetaData RALI_API_CALL raliCreateTextFileBasedLabelReader(RaliContext rali_context, const char* source_path);
+
+///
+/// \param rali_context
+/// \param source_path path to the folder that contains the TFRecord files, labels are read from the image/class/label feature of the records
+/// \return RaliMetaData object, can be used to inquire about the rali's output (processed) tensors
+extern "C" RaliMetaData RALI_API_CALL raliCreateTFReader(RaliContext rali_context, const char* source_path);
 ///
 /// \param rali_context
 /// \param buf user buffer provided to be filled with output image name
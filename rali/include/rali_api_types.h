@@ -48,6 +48,15 @@ struct TimingInfo
     long long unsigned decode_time;
     long long unsigned process_time;
     long long unsigned transfer_time;
+    long long unsigned read_wait_time;//!< Part of the decode time spent waiting for the compressed images to be read
+};
+/// Counters of a prefetch buffer, the side that blocks more often waits on the other one
+struct RaliBufferOccupancy
+{
+    size_t depth;//!< Batches the buffer holds, one of them being read at any time
+    long long unsigned batch_count;//!< Batches pushed by the producer
+    long long unsigned producer_block_count;//!< Times the producer found the buffer full and waited
+    long long unsigned consumer_block_count;//!< Times the consumer found the buffer empty and waited
 };
 enum RaliStatus
 {
@@ -103,4 +112,22 @@ enum RaliTensorOutputType
     RALI_FP32 = 0,
     RALI_FP16 = 1
 };
+
+enum RaliContextAttribute
+{
+    RALI_READ_THREAD_COUNT = 0,//!< Number of I/O threads per loader reading the images concurrently with decoding
+    RALI_MEMORY_MAPPED_READ = 1,//!< If non-zero, images are memory mapped and decoded in place instead of being copied in, when the reader supports it. Off by default, measure with rali_performance_tests before turning it on
+    RALI_CROP_ON_DECODE = 2,//!< If non-zero and the loaded images are only used by raliCropResize, only the crop window of each image is decoded
+    RALI_DECODE_THREAD_COUNT = 3,//!< Number of decode workers of the loader, 0 (default) means one per core
+    RALI_PREFETCH_DEPTH = 4,//!< Batches held by each of the loader's buffers (one per internal shard) and by the output buffer (at least 2), 0 (default) sizes them from RALI_PREFETCH_MEMORY_BUDGET
+    RALI_PREFETCH_MEMORY_BUDGET = 5//!< In MB, host memory the loader's buffers and the output buffer can use when their depth is sized automatically, 512 by default
+};
+
+enum RaliPipelineStage
+{
+    RALI_STAGE_READ = 0,//!< I/O threads of the loaders
+    RALI_STAGE_DECODE = 1,//!< Decode workers and the loaders' internal threads
+    RALI_STAGE_AUGMENT = 2,//!< Thread running the augmentation graph
+    RALI_STAGE_OUTPUT_COPY = 3//!< Copy of the processed images to the user buffers, runs on the calling thread which is pinned to the set during each raliCopyToOutput* call
+};
 #endif //MIVISIONX_RALI_API_TYPES_H
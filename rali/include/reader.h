@@ -21,6 +21,12 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <ctime>
+#include "cpu_set.h"
 
 enum class StorageType
 {
@@ -29,6 +35,8 @@ enum class StorageType
     UNCOMPRESSED_BINARY_DATA = 3        // experimental: added for supporting cifar10 data set
 };
 
+struct TFRecordIndex;
+
 struct ReaderConfig
 {
     explicit ReaderConfig(StorageType type, std::string path = "", bool loop = false):_type(type), _path(path), _loop(loop) {}
@@ -48,6 +56,21 @@ struct ReaderConfig
     std::string path() { return _path; }
     void set_file_prefix(const std::string &prefix) {_file_prefix = prefix;}
     std::string file_prefix() {return _file_prefix;}
+    /// \param read_thread_count Number of I/O threads the loader uses to read items through the reader concurrently with decoding
+    void set_read_thread_count(size_t read_thread_count) { _read_thread_count = read_thread_count; }
+    size_t read_thread_count() { return _read_thread_count; }
+    /// \param memory_mapped if True the loader maps the items in memory through the reader's map_next() instead of reading copies of them
+    void set_memory_mapped(bool memory_mapped) { _memory_mapped = memory_mapped; }
+    bool memory_mapped() { return _memory_mapped; }
+    /// \param cpu_set CPUs the I/O threads of the loader run on
+    void set_cpu_set(const CpuSet& cpu_set) { _cpu_set = cpu_set; }
+    const CpuSet& cpu_set() { return _cpu_set; }
+    /// \param file_list Files of the source already walked by another reader (see Reader::file_list()), the reader uses it instead of walking the source again
+    void set_file_list(std::shared_ptr<const std::vector<std::string>> file_list) { _file_list = std::move(file_list); }
+    std::shared_ptr<const std::vector<std::string>> file_list() { return _file_list; }
+    /// \param record_index Records of the TFRecord files already indexed by another reader (see Reader::record_index()), the reader uses it instead of indexing the files again
+    void set_record_index(std::shared_ptr<const TFRecordIndex> record_index) { _record_index = std::move(record_index); }
+    std::shared_ptr<const TFRecordIndex> record_index() { return _record_index; }
 private:
     StorageType _type = StorageType::FILE_SYSTEM;
     std::string _path = "";
@@ -56,6 +79,11 @@ private:
     size_t _batch_count = 1;//!< The reader will repeat images if necessary to be able to have images in multiples of the _batch_count.
     bool _loop = false;
     std::string _file_prefix = ""; //!< to read only files with prefix. supported only for cifar10_data_reader
+    size_t _read_thread_count = 4;
+    bool _memory_mapped = false;
+    CpuSet _cpu_set;
+    std::shared_ptr<const std::vector<std::string>> _file_list;
+    std::shared_ptr<const TFRecordIndex> _record_index;
 };
 
 class Reader {
@@ -100,6 +128,68 @@ public:
     //! Returns the number of items remained in this resource
     virtual unsigned count() = 0;
 
+    //! Returns the full path of the last item opened, unlike the id() it's unique across the sub folders of the resource
+    virtual std::string path() { return id(); }
+
+    //! Returns all the files found walking the resource, before sharding, nullptr if the reader does not walk files
+    virtual std::shared_ptr<const std::vector<std::string>> file_list() { return nullptr; }
+
+    //! Returns the records found indexing the TFRecord files of the resource, before sharding, nullptr if the reader does not read TFRecord files
+    virtual std::shared_ptr<const TFRecordIndex> record_index() { return nullptr; }
+
+    //! Tells the path(), the size and the modification time of the next item without opening it
+    /*!
+     \return false if the reader cannot tell them without opening the item, the size is the size of the stored item, not necessarily the one open() returns
+    */
+    virtual bool peek_next(std::string& path, size_t& size, time_t& mtime) { return false; }
+
+    //! Moves past the next item without opening it
+    virtual void skip_next() { open(); close(); }
+
+    //! Returns the modification time of the storage holding the last item opened, 0 if the reader cannot tell
+    virtual time_t last_modified() { return 0; }
+
+    //! Returns true if the reader can hand out items in place through map_next()
+    virtual bool can_map() { return false; }
+
+    //! Like read_next() but hands out the item mapped in memory instead of copying it, can be called from multiple threads at the same time
+    /*!
+     \param size Receives the size of the item
+     \param id Receives the name/identifier of the item, it's set to empty if there is no item left to read
+     \return Pointer to the item's data, valid until it's passed to unmap(), nullptr if failed to access it
+    */
+    virtual const unsigned char* map_next(size_t& size, std::string& id) { size = 0; id.clear(); return nullptr; }
+
+    //! Releases an item handed out by map_next()
+    virtual void unmap(const unsigned char* data, size_t size) {}
+
+    //! Opens the next item, copies all of it into buf and closes it
+    /*!
+     Unlike the open(), read() and close() sequence it can be called from multiple threads at the same time.
+     The default implementation serializes the calls, readers that can access different items concurrently override it.
+     \param buf Receives the item, it's resized if the item is bigger than its size
+     \param id Receives the name/identifier of the item, it's set to empty if there is no item left to read
+     \return Size of the item, if 0 failed to access it
+    */
+    virtual size_t read_next(std::vector<unsigned char>& buf, std::string& id)
+    {
+        std::lock_guard<std::mutex> lock(_read_next_mutex);
+        id.clear();
+        if(count() == 0)
+            return 0;
+        size_t size = open();
+        id = this->id();
+        if(size == 0)
+            return 0;
+        if(buf.size() < size)
+            buf.resize(size);
+        size = read(buf.data(), size);
+        close();
+        return size;
+    }
+
     virtual ~Reader() = default;
+protected:
+    std::mutex _read_next_mutex;
 
 };
\ No newline at end of file
@@ -28,13 +28,14 @@ THE SOFTWARE.
 #include <queue>
 #include "meta_data.h"
 #include "device_manager.h"
+#include "cpu_set.h"
 #include "commons.h"
 
 using MetaDataNamePair = std::pair<ImageNameBatch,pMetaDataBatch>;
 class RingBuffer
 {
 public:
-    explicit RingBuffer(unsigned buffer_depth);
+    RingBuffer();
     ~RingBuffer();
     size_t level();
     bool empty();
@@ -42,9 +43,16 @@ public:
     ///\param dev
     ///\param sub_buffer_size
     ///\param sub_buffer_count
-    void init(RaliMemType mem_type, DeviceResources dev, unsigned sub_buffer_size, unsigned sub_buffer_count);
+    ///\param buffer_depth Number of batches, the writer can be buffer_depth - 1 batches ahead of the reader
+    ///\param cpu_set The host buffers are first touched by a thread pinned to it, to place them on the NUMA node of the augmentation thread writing them
+    ///\param tensor_buffer_size When not zero, a host buffer of this size is kept along with each batch to hold it converted to the user's tensor format
+    void init(RaliMemType mem_type, DeviceResources dev, unsigned sub_buffer_size, unsigned sub_buffer_count, unsigned buffer_depth,
+              const CpuSet& cpu_set = CpuSet(), size_t tensor_buffer_size = 0);
     std::vector<void*> get_read_buffers() ;
     void* get_host_master_read_buffer();
+    void* get_host_tensor_read_buffer();
+    void* get_host_tensor_write_buffer();
+    size_t tensor_buffer_size() { return _tensor_buffer_size; }
     std::vector<void*> get_write_buffers();
     MetaDataNamePair& get_meta_data();
     void set_meta_data(ImageNameBatch names, pMetaDataBatch meta_data);
@@ -57,13 +65,16 @@ public:
     RaliMemType mem_type() { return _mem_type; }
     void block_if_empty();
     void block_if_full();
+    //! Returns the depth and the blocking counters of the buffer
+    BufferOccupancy occupancy();
 private:
     std::queue<MetaDataNamePair> _meta_ring_buffer;
     MetaDataNamePair _last_image_meta_data;
     void increment_read_ptr();
     void increment_write_ptr();
     bool full();
-    const unsigned BUFF_DEPTH;
+    unsigned BUFF_DEPTH = 0;
+    BufferOccupancy _occupancy;
     unsigned _sub_buffer_size;
     unsigned _sub_buffer_count;
     std::mutex _lock;
@@ -72,6 +83,8 @@ private:
     std::vector<std::vector<void*>> _dev_sub_buffer;
     std::vector<void*> _host_master_buffers;
     std::vector<std::vector<void*>> _host_sub_buffers;
+    std::vector<void*> _host_tensor_buffers;
+    size_t _tensor_buffer_size = 0;
     bool _dont_block = false;
     RaliMemType _mem_type;
     DeviceResources _dev;
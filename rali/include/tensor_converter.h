@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include "commons.h"
+#include "cpu_set.h"
+
+//! The format the output images are converted to for the user
+struct OutputTensorConfig
+{
+    RaliTensorFormat format;
+    RaliTensorDataType data_type;
+    float multiplier[3];
+    float offset[3];
+    bool reverse_channels;
+    bool operator==(const OutputTensorConfig& other) const
+    {
+        return format == other.format && data_type == other.data_type && reverse_channels == other.reverse_channels &&
+               std::equal(multiplier, multiplier + 3, other.multiplier) && std::equal(offset, offset + 3, other.offset);
+    }
+};
+
+/*! \brief Converts the U8 output images to the FP32/FP16 tensors handed to the user
+ *
+ * The batch is described as a list of spans, runs of pixels that can be converted independently (usually one
+ * per sample). The spans are spread over a pool of workers pinned to the output copy CPU set, the calling thread
+ * being one of them. Every combination of planar/interleaved source, NCHW/NHWC destination, FP32/FP16 and channel
+ * reversal is vectorized for 1 and 3 channel images, FP16 being converted with F16C when available.
+ */
+class TensorConverter
+{
+public:
+    //! A run of pixels, a plane stride of 0 means the channels of a pixel are interleaved
+    struct Span
+    {
+        const unsigned char* src;
+        size_t src_plane_stride;//!< In bytes, distance between the planes of a planar source
+        void* dst;
+        size_t dst_plane_stride;//!< In elements, distance between the channel planes of an NCHW destination
+        size_t pixel_count;
+    };
+    TensorConverter() = default;
+    ~TensorConverter();
+    //! Pins the workers to the set, they are started again on the next conversion
+    void set_cpu_set(const CpuSet& cpu_set);
+    //! The layout of the destination is given by the spans, config.format isn't used
+    void convert(const std::vector<Span>& spans, size_t channels, const OutputTensorConfig& config);
+private:
+    void start_workers();
+    void stop_workers();
+    void worker_routine(unsigned generation);
+    //! Runs job(i) for every i < count on the workers and the calling thread, returns when all are done
+    void run(size_t count, const std::function<void(size_t)>& job);
+    CpuSet _cpu_set;
+    std::vector<std::thread> _workers;
+    std::mutex _lock;
+    std::condition_variable _job_ready;
+    std::condition_variable _job_done;
+    const std::function<void(size_t)>* _job = nullptr;
+    size_t _job_count = 0;
+    std::atomic<size_t> _next_index;
+    size_t _busy_workers = 0;
+    unsigned _generation = 0;
+    bool _stop = false;
+    bool _started = false;
+    const static size_t MIN_PIXELS_PER_SPAN = 16384;//!< Spans are split to keep the workers busy, but not below this size
+};
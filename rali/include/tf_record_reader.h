@@ -24,41 +24,148 @@ THE SOFTWARE.
 #include <vector>
 #include <string>
 #include <memory>
+#include <dirent.h>
 #include "reader.h"
 
+//! The records of the TFRecord files of a folder, indexed once and shared by all the readers of the folder
+struct TFRecordIndex
+{
+    struct Record
+    {
+        unsigned file_idx;  //!< index into the file_names
+        size_t offset;      //!< offset of the record's data within the file (past the length and crc fields)
+        size_t size;        //!< size of the serialized tf.train.Example
+        size_t record_idx;  //!< index of the record within its file
+    };
+    std::vector<std::string> file_names;
+    std::vector<time_t> file_mtimes;
+    std::vector<Record> records;//!< All the records of all the files, in file order
+};
 
+//! Reads JPEG images packed as tf.train.Example records in TFRecord files
+/*!
+ * Every file in the folder is indexed once at initialize(), only the 12 byte record headers are read for that,
+ * readers of the same folder can share the index through the ReaderConfig::set_record_index().
+ * open() only reads the fields of the tf.train.Example, the encoded image is read by read(). read_next() reads
+ * the records in large sequential blocks, so consecutive records of the same shard are served from memory
+ * instead of issuing a seek and a read per image.
+ */
 class TFRecordReader : public Reader
-        {
+{
 public:
     //! Reads the TFRecord File, and loads the image ids and other necessary info
     /*!
      \param desc  User provided descriptor containing the files' path.
     */
-    Reader::Status initialize(ReaderConfig desc) override { return Reader::Status::OK; }
+    Reader::Status initialize(ReaderConfig desc) override;
     //! Reads the next resource item
     /*!
      \param buf User's provided buffer to receive the loaded images
      \return Size of the loaded resource
     */
-    size_t read(unsigned char* buf, size_t max_size) override { return 0; }
-    //! Opens the next file in the folder
+    size_t read(unsigned char* buf, size_t max_size) override;
+    //! Opens the next record and parses the tf.train.Example in it, without reading the encoded image
     /*!
-     \return The size of the next file, 0 if couldn't access it
+     \return The size of the encoded image in the next record, 0 if couldn't access it
     */
-    size_t open() override { return 0; }
+    size_t open() override;
 
-    //! Resets the object's state to read from the first file in the folder
-    void reset() override { return ; }
+    //! Opens the next record, parsing only the image/filename and image/class/label features of its tf.train.Example
+    /*!
+     \return false if there is no record left, id() and label() are valid otherwise
+    */
+    bool open_label() { return open_record(FILENAME_FIELD | LABEL_FIELD); }
+
+    //! Reads the whole next record, reading ahead the records that follow it in the file
+    size_t read_next(std::vector<unsigned char>& buf, std::string& id) override;
+
+    //! Resets the object's state to read from the first record
+    void reset() override;
+
+    //! Returns the id of the latest record opened, it's the image/filename feature if present, otherwise <record file name>_<record index>
+    std::string id() override { return _last_id;}
+
+    //! Returns <record file path>:<record index> of the latest record opened
+    std::string path() override { return _last_path; }
+
+    //! Returns the image/class/label of the latest record opened, -1 if the record does not have a label
+    int label() { return _last_label; }
+
+    unsigned count() override;
+
+    //! Returns the modification time of the record file the latest record was read from
+    time_t last_modified() override { return _last_modified; }
+
+    std::shared_ptr<const TFRecordIndex> record_index() override { return _index; }
 
-    //! Returns the id of the latest file opened
-    std::string id() override { return "0";}
+    //! Tells the path(), the size of the serialized tf.train.Example and the modification time of the record file of the next record
+    bool peek_next(std::string& path, size_t& size, time_t& mtime) override;
 
-    unsigned count() override { return 0; }
+    void skip_next() override { incremenet_read_ptr(); }
 
-    ~TFRecordReader() override = default;
+    ~TFRecordReader() override;
 
-    int close() override{ return 0; };
+    int close() override;
 
-    TFRecordReader()= default;
+    TFRecordReader();
 
-};
\ No newline at end of file
+private:
+    using RecordInfo = TFRecordIndex::Record;
+    //! Features of the tf.train.Example parse_example() looks for
+    enum ExampleField { IMAGE_FIELD = 1, FILENAME_FIELD = 2, LABEL_FIELD = 4 };
+    //! indexes the record files of the folder
+    std::shared_ptr<TFRecordIndex> index_folder();
+    //! walks the record headers of the file and adds its records to the index
+    void index_file(TFRecordIndex& index, unsigned file_idx);
+    //! picks the records of this shard out of the _index
+    void select_shard_records();
+    //! returns the given bytes of the record file, reads max(size, read_ahead) bytes from the offset if they are not in the _read_buff
+    const unsigned char* fetch(unsigned file_idx, size_t offset, size_t size, size_t read_ahead);
+    bool read_varint(unsigned file_idx, size_t& pos, size_t end, uint64_t& value);
+    //! reads the next field's tag, and if it's length delimited, the bounds of its payload, the payload itself is not read
+    bool read_field(unsigned file_idx, size_t& pos, size_t end, unsigned& field, unsigned& wire_type, size_t& payload, size_t& payload_size);
+    //! finds the first element of the BytesList (field 1) or Int64List (field 3) of the tf.train.Feature
+    bool parse_feature(unsigned file_idx, size_t pos, size_t end, unsigned list_field, size_t& bytes, size_t& bytes_size, int64_t& int_value);
+    //! walks the serialized tf.train.Example until the given fields are found, only the keys and the small features are read
+    unsigned parse_example(const RecordInfo& record, unsigned fields);
+    //! opens the next record, parsing the given fields of its tf.train.Example
+    bool open_record(unsigned fields);
+    size_t read_image(unsigned char* buf, size_t read_size, size_t read_ahead);
+    std::string _folder_path;
+    std::string _file_prefix;
+    DIR *_src_dir;
+    struct dirent *_entity;
+    std::shared_ptr<const TFRecordIndex> _index;
+    std::vector<RecordInfo> _records;//!< records of this shard
+    unsigned  _curr_record_idx;
+    FILE* _current_fPtr;
+    int _current_file_idx;  //!< index of the record file _current_fPtr points to, -1 if none
+    std::vector<unsigned char> _read_buff;
+    size_t _read_buff_offset;   //!< file offset of the first byte in the _read_buff
+    size_t _read_buff_size;     //!< number of valid bytes in the _read_buff
+    int _image_file_idx;        //!< record file of the encoded image of the latest record opened, -1 if none
+    size_t _image_offset;       //!< offset of the encoded image within the record file
+    size_t _image_size;
+    size_t _image_read_offset;//!< consecutive read() calls continue from where the previous one stopped
+    time_t _last_modified;
+    std::string _last_id;
+    std::string _last_path;
+    int _last_label;
+    size_t _shard_id = 0;
+    size_t _shard_count = 1;
+    //!< _batch_count Defines the quantum count of the images to be read. It's usually equal to the user's batch size.
+    /// The loader will repeat images if necessary to be able to have images available in multiples of the load_batch_count,
+    /// for instance if there are 10 images in the dataset and _batch_count is 3, the loader repeats 2 images as if there are 12 images available.
+    size_t _batch_count = 1;
+    size_t _file_id = 0;
+    size_t _in_batch_read_count = 0;
+    bool _loop;
+    int _read_counter = 0;
+    static const size_t READ_BLOCK_SIZE = 8*1024*1024; // 8 Meg
+    static const size_t FIELD_READ_SIZE = 1024; // 1 KB, the fields of a tf.train.Example other than the image are small
+    void incremenet_read_ptr();
+    int release();
+    size_t get_file_shard_id();
+    void incremenet_file_id() { _file_id++; }
+    void replicate_last_image_to_fill_last_shard();
+};
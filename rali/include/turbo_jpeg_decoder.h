@@ -22,8 +22,12 @@ THE SOFTWARE.
 
 #pragma once
 
+#include <cstdio>
+#include <csetjmp>
+#include <vector>
 #include "decoder.h"
 #include <turbojpeg.h>
+#include <jpeglib.h>
 
 class TJDecoder : public Decoder {
 public:
@@ -55,9 +59,29 @@ public:
                            size_t &actual_decoded_width, size_t &actual_decoded_height,
                            Decoder::ColorFormat desired_decoded_color_format) override;
 
+    bool can_decode_crop() override { return true; }
+
+    //! Decodes only the MCU rows and columns covering the crop window, using libjpeg-turbo's jpeg_crop_scanline() and jpeg_skip_scanlines()
+    Decoder::Status decode_crop(unsigned char *input_buffer, size_t input_size, unsigned char *output_buffer,
+                                size_t max_decoded_width, size_t max_decoded_height,
+                                size_t original_image_width, size_t original_image_height,
+                                size_t crop_x, size_t crop_y, size_t crop_width, size_t crop_height,
+                                size_t &actual_decoded_width, size_t &actual_decoded_height,
+                                Decoder::ColorFormat desired_decoded_color_format) override;
+
     ~TJDecoder() override;
 private:
+    //! libjpeg reports errors through a callback that never returns, it jumps back to decode_crop() instead
+    struct ErrorManager
+    {
+        jpeg_error_mgr pub;
+        jmp_buf setjmp_buffer;
+    };
+    static void error_exit(j_common_ptr cinfo);
     tjhandle m_jpegDecompressor;
+    jpeg_decompress_struct _crop_decompressor;//!< The TurboJPEG API cannot decode partially, crops are decoded using the libjpeg API
+    ErrorManager _crop_error_manager;
+    std::vector<unsigned char> _crop_row;//!< A row of the MCU aligned region covering the crop window
     const static unsigned SCALING_FACTORS_COUNT =  16;
     const tjscalingfactor SCALING_FACTORS[SCALING_FACTORS_COUNT] = {
             { 2, 1 },
@@ -101,7 +101,8 @@ namespace rali{
             .def_readwrite("load_time",&TimingInfo::load_time)
             .def_readwrite("decode_time",&TimingInfo::decode_time)
             .def_readwrite("process_time",&TimingInfo::process_time)
-            .def_readwrite("transfer_time",&TimingInfo::transfer_time);
+            .def_readwrite("transfer_time",&TimingInfo::transfer_time)
+            .def_readwrite("read_wait_time",&TimingInfo::read_wait_time);
         py::module types_m = m.def_submodule("types");
         types_m.doc() = "Datatypes and options used by RALI";
         py::enum_<RaliStatus>(types_m, "RaliStatus", "Status info")
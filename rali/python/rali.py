@@ -79,6 +79,30 @@ class RaliGraph():
     def __del__(self):
         self._lib.release(self.handle)
 
+    ContextAttribute = {
+        'READ_THREAD_COUNT' : 0,
+        'MEMORY_MAPPED_READ' : 1,
+        'CROP_ON_DECODE' : 2,
+        'DECODE_THREAD_COUNT' : 3,
+        'PREFETCH_DEPTH' : 4,
+        'PREFETCH_MEMORY_BUDGET' : 5}
+
+    def setContextAttribute(self, attribute, value):
+        return self._lib.setContextAttribute(self.handle, self.ContextAttribute[attribute], value)
+
+    PipelineStage = {
+        'READ' : 0,
+        'DECODE' : 1,
+        'AUGMENT' : 2,
+        'OUTPUT_COPY' : 3}
+
+    def setStageCpuSet(self, stage, cpus):
+        cpu_array = (ctypes.c_uint * len(cpus))(*cpus)
+        return self._lib.setStageCpuSet(self.handle, self.PipelineStage[stage], cpu_array, len(cpus))
+
+    def setOutputTensorConfig(self, tensor_layout, multiplier, offset, reverse_channels, tensor_dtype):
+        return self._lib.setOutputTensorConfig(self.handle, tensor_layout.value, int(tensor_dtype), multiplier[0], multiplier[1], multiplier[2], offset[0], offset[1], offset[2], reverse_channels)
+
     def build(self):
         return self._lib.build(self.handle)
 
@@ -344,6 +368,9 @@ class RaliGraph():
     def raliCreateTextFileBasedLabelReader(self, label_file):
         return self._lib.raliCreateTextFileBasedLabelReader(self.handle, label_file)
 
+    def raliCreateTFReader(self, path):
+        return self._lib.raliCreateTFReader(self.handle, path)
+
     def getImageLabels(self, buffer):
         return self._lib.raliGetImageLabels(self.handle, np.ascontiguousarray(buffer, dtype=np.int32))
 
@@ -34,6 +34,18 @@ class RaliLib:
         self.createPipeline.restype = ctypes.c_void_p
         self.createPipeline.argtypes = [ctypes.c_uint, ctypes.c_int, ctypes.c_int, ctypes.c_uint]
 
+        self.setContextAttribute = self.lib.raliSetContextAttribute
+        self.setContextAttribute.restype = ctypes.c_int
+        self.setContextAttribute.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_size_t]
+
+        self.setStageCpuSet = self.lib.raliSetStageCpuSet
+        self.setStageCpuSet.restype = ctypes.c_int
+        self.setStageCpuSet.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_uint), ctypes.c_size_t]
+
+        self.setOutputTensorConfig = self.lib.raliSetOutputTensorConfig
+        self.setOutputTensorConfig.restype = ctypes.c_int
+        self.setOutputTensorConfig.argtypes = [ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_bool]
+
         self.build = self.lib.raliVerify
         self.build.restype = ctypes.c_int
         self.build.argtypes = [ctypes.c_void_p]
@@ -281,6 +293,10 @@ class RaliLib:
         self.raliCreateTextFileBasedLabelReader.restype = ctypes.c_void_p
         self.raliCreateTextFileBasedLabelReader.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
 
+        self.raliCreateTFReader = self.lib.raliCreateTFReader
+        self.raliCreateTFReader.restype = ctypes.c_void_p
+        self.raliCreateTFReader.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+
         self.raliGetImageLabels = self.lib.raliGetImageLabels
         self.raliGetImageLabels.restype = ctypes.c_void_p
         self.raliGetImageLabels.argtypes = [ctypes.c_void_p, ndpointer(dtype=np.int32, flags="C_CONTIGUOUS")]
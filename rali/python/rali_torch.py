@@ -30,6 +30,8 @@ class PyTorchIterator:
         self.offset = offset
         self.reverse_channels = reverse_channels
         self.tensor_dtype = tensor_dtype
+        # Lets the pipeline convert the batches ahead of the copies in __next__
+        pipeline.setOutputTensorConfig(self.tensor_format, self.multiplier, self.offset, self.reverse_channels, self.tensor_dtype)
         if pipeline.build() != 0:
             raise Exception('Failed to build the augmentation graph')
         self.w = pipeline.getOutputWidth()
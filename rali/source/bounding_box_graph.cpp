@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "bounding_box_graph.h"
+#include "meta_node_loader.h"
+#include "meta_node_resize.h"
+#include "meta_node_crop.h"
+#include "meta_node_crop_resize.h"
+#include "meta_node_flip.h"
+#include "meta_node_rotate.h"
+#include "meta_node_warp_affine.h"
+#include "meta_node_crop_mirror_normalize.h"
+#include "node_image_loader.h"
+#include "node_image_loader_single_shard.h"
+
+void BoundingBoxGraph::add_node(const std::shared_ptr<Node>& node)
+{
+    // The nodes that don't move the pixels leave the boxes unchanged and have no counterpart
+    std::shared_ptr<MetaNode> meta_node = nullptr;
+    if(auto loader = std::dynamic_pointer_cast<ImageLoaderNode>(node))
+        meta_node = std::make_shared<LoaderMetaNode>(loader->get_loader_module(), loader->output()[0]);
+    else if(auto shard_loader = std::dynamic_pointer_cast<ImageLoaderSingleShardNode>(node))
+        meta_node = std::make_shared<LoaderMetaNode>(shard_loader->get_loader_module(), shard_loader->output()[0]);
+    else if(auto resize = std::dynamic_pointer_cast<ResizeNode>(node))
+        meta_node = std::make_shared<ResizeMetaNode>(resize);
+    else if(auto crop = std::dynamic_pointer_cast<CropNode>(node))
+        meta_node = std::make_shared<CropMetaNode>(crop);
+    else if(auto crop_resize = std::dynamic_pointer_cast<CropResizeNode>(node))
+        meta_node = std::make_shared<CropResizeMetaNode>(crop_resize);
+    else if(auto flip = std::dynamic_pointer_cast<FlipNode>(node))
+        meta_node = std::make_shared<FlipMetaNode>(flip);
+    else if(auto rotate = std::dynamic_pointer_cast<RotateNode>(node))
+        meta_node = std::make_shared<RotateMetaNode>(rotate);
+    else if(auto warp_affine = std::dynamic_pointer_cast<WarpAffineNode>(node))
+        meta_node = std::make_shared<WarpAffineMetaNode>(warp_affine);
+    else if(auto cmn = std::dynamic_pointer_cast<CropMirrorNormalizeNode>(node))
+        meta_node = std::make_shared<CropMirrorNormalizeMetaNode>(cmn);
+
+    if(meta_node)
+        _meta_nodes.push_back(meta_node);
+}
+
+void BoundingBoxGraph::build()
+{
+    if(_meta_nodes.empty() || !std::dynamic_pointer_cast<LoaderMetaNode>(_meta_nodes.front()))
+        WRN("Bounding boxes are not mapped from the original images to the decoded ones, the loader is not on the path of the output images")
+}
+
+void BoundingBoxGraph::process(MetaDataBatch* meta_data)
+{
+    if(!meta_data)
+        return;
+    load_boxes(meta_data);
+    _transforms.resize(meta_data->size());
+    for(auto& meta_node: _meta_nodes)
+    {
+        meta_node->update_transforms(_transforms);
+        apply(_transforms);
+    }
+    store_boxes(meta_data);
+}
+
+void BoundingBoxGraph::load_boxes(MetaDataBatch* meta_data)
+{
+    auto& bb_cords = meta_data->get_bb_cords_batch();
+    _first_box.resize(bb_cords.size() + 1);
+    size_t box_count = 0;
+    for(size_t sample = 0; sample < bb_cords.size(); sample++)
+    {
+        _first_box[sample] = box_count;
+        box_count += bb_cords[sample].size();
+    }
+    _first_box[bb_cords.size()] = box_count;
+    _x1.resize(box_count);
+    _y1.resize(box_count);
+    _x2.resize(box_count);
+    _y2.resize(box_count);
+    for(size_t sample = 0; sample < bb_cords.size(); sample++)
+        for(size_t i = 0, box = _first_box[sample]; i < bb_cords[sample].size(); i++, box++)
+        {
+            _x1[box] = bb_cords[sample][i].x;
+            _y1[box] = bb_cords[sample][i].y;
+            _x2[box] = bb_cords[sample][i].x + bb_cords[sample][i].w;
+            _y2[box] = bb_cords[sample][i].y + bb_cords[sample][i].h;
+        }
+}
+
+void BoundingBoxGraph::apply(const std::vector<BoxTransform>& transforms)
+{
+    float* x1 = _x1.data();
+    float* y1 = _y1.data();
+    float* x2 = _x2.data();
+    float* y2 = _y2.data();
+    for(size_t sample = 0; sample < transforms.size(); sample++)
+    {
+        const BoxTransform t = transforms[sample];
+        // Branch free loop over the boxes of the image, the compiler vectorizes it
+        for(size_t box = _first_box[sample]; box < _first_box[sample + 1]; box++)
+        {
+            float ax1 = t.a * x1[box], ax2 = t.a * x2[box], by1 = t.b * y1[box], by2 = t.b * y2[box];
+            float dx1 = t.d * x1[box], dx2 = t.d * x2[box], ey1 = t.e * y1[box], ey2 = t.e * y2[box];
+            // Bounds of the four transformed corners, rotated boxes stay axis aligned and mirrored ones keep x1 <= x2
+            float new_x1 = std::max(std::min(ax1, ax2) + std::min(by1, by2) + t.c, 0.0f);
+            float new_x2 = std::min(std::max(ax1, ax2) + std::max(by1, by2) + t.c, t.width);
+            float new_y1 = std::max(std::min(dx1, dx2) + std::min(ey1, ey2) + t.f, 0.0f);
+            float new_y2 = std::min(std::max(dx1, dx2) + std::max(ey1, ey2) + t.f, t.height);
+            // A box left outside of the image collapses to a point, that no later transformation can grow back
+            bool outside = (new_x2 <= new_x1) | (new_y2 <= new_y1);
+            x1[box] = new_x1;
+            y1[box] = new_y1;
+            x2[box] = outside ? new_x1 : new_x2;
+            y2[box] = outside ? new_y1 : new_y2;
+        }
+    }
+}
+
+void BoundingBoxGraph::store_boxes(MetaDataBatch* meta_data)
+{
+    auto& bb_cords = meta_data->get_bb_cords_batch();
+    auto& bb_labels = meta_data->get_bb_labels_batch();
+    for(size_t sample = 0; sample < bb_cords.size(); sample++)
+    {
+        // The boxes that are still inside the image are compacted in place with their labels
+        size_t kept = 0;
+        for(size_t i = 0, box = _first_box[sample]; i < bb_cords[sample].size(); i++, box++)
+        {
+            if(_x2[box] <= _x1[box] || _y2[box] <= _y1[box])
+                continue;
+            bb_cords[sample][kept] = {_x1[box], _y1[box], _x2[box] - _x1[box], _y2[box] - _y1[box]};
+            bb_labels[sample][kept] = bb_labels[sample][i];
+            kept++;
+        }
+        if(kept == 0)
+        {
+            // Same as the images without annotations, a single empty box with the label 0
+            bb_cords[sample].assign(1, {0, 0, 0, 0});
+            bb_labels[sample].assign(1, 0);
+            continue;
+        }
+        bb_cords[sample].resize(kept);
+        bb_labels[sample].resize(kept);
+    }
+}
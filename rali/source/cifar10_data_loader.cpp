@@ -26,7 +26,7 @@ THE SOFTWARE.
 #include "vx_ext_amd.h"
 
 CIFAR10DataLoader::CIFAR10DataLoader(DeviceResources dev_resources):
-_circ_buff(dev_resources, CIRC_BUFFER_DEPTH),
+_circ_buff(dev_resources),
 _file_load_time("file load time", DBG_TIMING),
 _swap_handle_time("Swap_handle_time", DBG_TIMING)
 {
@@ -130,10 +130,9 @@ CIFAR10DataLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg
         throw;
     }
     _actual_read_size.resize(batch_size);
-    _raw_img_info._image_names.resize(_batch_size);
-    _raw_img_info._roi_width.resize(_batch_size);           // used to store the individual image in a big raw file
-    _raw_img_info._roi_height.resize(batch_size);
-    _circ_buff.init(_mem_type, _output_mem_size);
+    _output_names.resize(_batch_size);
+    _output_decoded_region.resize(_batch_size);
+    _circ_buff.init(_mem_type, _output_mem_size, _batch_size, _prefetch_depth);
     _is_initialized = true;
     LOG("Loader module initialized");
 }
@@ -167,6 +166,7 @@ CIFAR10DataLoader::load_routine()
 
         auto load_status = LoaderModuleStatus::NO_MORE_DATA_TO_READ;
         {
+            auto& image_info = _circ_buff.get_write_image_info();
             unsigned file_counter = 0;
             _file_load_time.start();// Debug timing
 
@@ -179,14 +179,14 @@ CIFAR10DataLoader::load_routine()
                     continue;
                 }
                 _actual_read_size[file_counter] = _reader->read(read_ptr, readSize);
-                _raw_img_info._image_names[file_counter] = _reader->id();
-                _raw_img_info._roi_width[file_counter] = _output_image->info().width();
-                _raw_img_info._roi_height[file_counter] = _output_image->info().height_single();
+                image_info._image_names[file_counter] = _reader->id();
+                image_info._roi_width[file_counter] = _output_image->info().width();
+                image_info._roi_height[file_counter] = _output_image->info().height_single();
+                image_info._decoded_region[file_counter] = {{0, 0}, {_output_image->info().width(), _output_image->info().height_single()}};
                 _reader->close();
                 file_counter++;
             }
             _file_load_time.end();// Debug timing
-            _circ_buff.set_image_info(_raw_img_info);
             _circ_buff.push();
             _image_counter += _output_image->info().batch_size();
             load_status = LoaderModuleStatus::OK;
@@ -255,9 +255,10 @@ CIFAR10DataLoader::update_output_image()
     if(_stopped)
         return LoaderModuleStatus::OK;
 
-    decoded_image_info d_img_info = _circ_buff.get_image_info();
-    _output_names = d_img_info._image_names;
-    _output_image->update_image_roi(d_img_info._roi_width, d_img_info._roi_height);
+    auto& image_info = _circ_buff.get_image_info();
+    _output_names.swap(image_info._image_names);
+    _output_decoded_region.swap(image_info._decoded_region);
+    _output_image->update_image_roi(image_info._roi_width, image_info._roi_height);
 
     _circ_buff.pop();
     if(!_loop)
@@ -271,10 +272,16 @@ Timing CIFAR10DataLoader::timing()
     Timing t;
     t.image_read_time = _file_load_time.get_timing();
     t.image_process_time = _swap_handle_time.get_timing();
+    t.loader_buffer = _circ_buff.occupancy();
     return t;
 }
 
-std::vector<std::string> CIFAR10DataLoader::get_id()
+const std::vector<std::string>& CIFAR10DataLoader::get_id()
 {
     return _output_names;
+}
+
+const std::vector<ROI>& CIFAR10DataLoader::get_decoded_region()
+{
+    return _output_decoded_region;
 }
\ No newline at end of file
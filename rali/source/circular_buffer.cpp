@@ -20,22 +20,17 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <cstring>
 #include "circular_buffer.h"
 #include "log.h"
-CircularBuffer::CircularBuffer(DeviceResources ocl, size_t buffer_depth):
-        BUFF_DEPTH(buffer_depth),
+CircularBuffer::CircularBuffer(DeviceResources ocl):
         _cl_cmdq(ocl.cmd_queue),
         _cl_context(ocl.context),
         _device_id(ocl.device_id),
-        _dev_buffer(BUFF_DEPTH, nullptr),
-        _host_buffer_ptrs(BUFF_DEPTH, nullptr),
         _write_ptr(0),
         _read_ptr(0),
         _level(0)
 {
-    for(size_t bufIdx = 0; bufIdx < BUFF_DEPTH; bufIdx++)
-        _dev_buffer[bufIdx] = nullptr;
-
 }
 
 void CircularBuffer::reset()
@@ -43,8 +38,6 @@ void CircularBuffer::reset()
     _write_ptr = 0;
     _read_ptr = 0;
     _level = 0;
-    while(!_circ_image_info.empty())
-        _circ_image_info.pop();
 }
 
 void CircularBuffer::unblock_reader()
@@ -127,9 +120,7 @@ void CircularBuffer::push()
     if(!_initialized)
         return;
     sync();
-    // Pushing to the _circ_buff and _circ_buff_names must happen all at the same time
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    _circ_image_info.push(_last_image_info);
+    // The image info is written in place, it's published together with the image data
     increment_write_ptr();
 }
 
@@ -137,19 +128,29 @@ void CircularBuffer::pop()
 {
     if(!_initialized)
         return;
-    // Pushing to the _circ_buff and _circ_buff_names must happen all at the same time
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
     increment_read_ptr();
-    _circ_image_info.pop();
 }
-void CircularBuffer::init(RaliMemType output_mem_type, size_t output_mem_size)
+void CircularBuffer::init(RaliMemType output_mem_type, size_t output_mem_size, size_t batch_size, size_t buffer_depth, const CpuSet& cpu_set)
 {
     if(_initialized)
         return;
     _output_mem_type = output_mem_type;
     _output_mem_size = output_mem_size;
-    if(BUFF_DEPTH < 2)
+    if(buffer_depth < 2)
         THROW ("Error internal buffer size for the circular buffer should be greater than one")
+    BUFF_DEPTH = buffer_depth;
+    _occupancy.depth = BUFF_DEPTH;
+    _dev_buffer.assign(BUFF_DEPTH, nullptr);
+    _host_buffer_ptrs.assign(BUFF_DEPTH, nullptr);
+
+    _image_info.resize(BUFF_DEPTH);
+    for(auto& info: _image_info)
+    {
+        info._image_names.resize(batch_size);
+        info._roi_width.resize(batch_size);
+        info._roi_height.resize(batch_size);
+        info._decoded_region.resize(batch_size);
+    }
     
     // Allocating buffers
     if(_output_mem_type== RaliMemType::OCL) 
@@ -192,6 +193,12 @@ void CircularBuffer::init(RaliMemType output_mem_type, size_t output_mem_size)
             // a minimum of extra MEM_ALIGNMENT is allocated
             _host_buffer_ptrs[buffIdx] = (unsigned char*)aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_output_mem_size / MEM_ALIGNMENT + 1));
         }
+        if(!cpu_set.empty())
+            cpu_set.run_on([this]
+            {
+                for(auto buffer: _host_buffer_ptrs)
+                    memset(buffer, 0, _output_mem_size);
+            });
 
 
     }
@@ -229,6 +236,7 @@ void CircularBuffer::increment_write_ptr()
     std::unique_lock<std::mutex> lock(_lock);
     _write_ptr = (_write_ptr+1)%BUFF_DEPTH;
     _level++;
+    _occupancy.batch_count++;
     lock.unlock();
     // Wake up the reader thread (in case waiting) since there is a new load to be read
     _wait_for_load.notify_all();
@@ -239,6 +247,7 @@ void CircularBuffer::block_if_empty()
     std::unique_lock<std::mutex> lock(_lock);
     if(empty()) 
     { // if the current read buffer is being written wait on it
+        _occupancy.consumer_block_count++;
         _wait_for_load.wait(lock);
     }
 }
@@ -249,10 +258,17 @@ void CircularBuffer:: block_if_full()
     // Write the whole buffer except for the last spot which is being read by the reader thread
     if(full()) 
     {
+        _occupancy.producer_block_count++;
         _wait_for_unload.wait(lock);
     }
 }
 
+BufferOccupancy CircularBuffer::occupancy()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    return _occupancy;
+}
+
 CircularBuffer::~CircularBuffer()
 {
     for(size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) 
@@ -281,13 +297,19 @@ CircularBuffer::~CircularBuffer()
     _initialized = false;
 }
 
+decoded_image_info &CircularBuffer::get_write_image_info()
+{
+    if(!_initialized)
+        THROW("Circular buffer not initialized")
+    return _image_info[_write_ptr];
+}
+
 decoded_image_info &CircularBuffer::get_image_info()
 {
+    if(!_initialized)
+        THROW("Circular buffer not initialized")
     block_if_empty();
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    if(_level != _circ_image_info.size())
-        THROW("CircularBuffer internals error, image and image info sizes not the same "+TOSTR(_level) + " != "+TOSTR(_circ_image_info.size()))
-    return  _circ_image_info.front();
+    return _image_info[_read_ptr];
 }
 
 
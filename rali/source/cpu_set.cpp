@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <pthread.h>
+#include <algorithm>
+#include <exception>
+#include "cpu_set.h"
+#include "commons.h"
+
+cpu_set_t CpuSet::mask() const
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for(auto cpu: _cpus)
+    {
+        if(cpu >= CPU_SETSIZE)
+            THROW("CPU index " + TOSTR(cpu) + " is out of range")
+        CPU_SET(cpu, &mask);
+    }
+    return mask;
+}
+
+size_t CpuSet::cpu_count() const
+{
+    if(!empty())
+    {
+        auto cpus = mask();
+        return CPU_COUNT(&cpus);
+    }
+    // Unlike hardware_concurrency(), it honours taskset and cgroup cpusets that other pipelines on the host may be excluded from
+    cpu_set_t allowed;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+        return CPU_COUNT(&allowed);
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void CpuSet::apply(std::thread::native_handle_type thread) const
+{
+    if(empty())
+        return;
+    auto cpus = mask();
+    int ret = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpus);
+    if (ret != 0)
+        WRN("Error calling pthread_setaffinity_np: " + TOSTR(ret));
+}
+
+void CpuSet::run_on(const std::function<void()>& function) const
+{
+    if(empty())
+    {
+        function();
+        return;
+    }
+    // An exception escaping the thread would terminate the process, it is passed on to the caller instead
+    std::exception_ptr error;
+    std::thread thread([this, &function, &error]
+    {
+        try
+        {
+            apply(pthread_self());
+            function();
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+    });
+    thread.join();
+    if(error)
+        std::rethrow_exception(error);
+}
+
+ScopedCpuSet::ScopedCpuSet(const CpuSet& cpu_set)
+{
+    if(cpu_set.empty())
+        return;
+    if(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &_previous_mask) != 0)
+        return;
+    // A thread already pinned to the set, the same user thread copying every batch for instance, is left as it is
+    auto cpus = cpu_set.mask();
+    if(CPU_EQUAL(&cpus, &_previous_mask))
+        return;
+    cpu_set.apply(pthread_self());
+    _applied = true;
+}
+
+ScopedCpuSet::~ScopedCpuSet()
+{
+    if(_applied)
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &_previous_mask);
+}
@@ -21,6 +21,10 @@ THE SOFTWARE.
 */
 
 #include <cassert>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <algorithm>
 #include <commons.h>
 #include "file_source_reader.h"
@@ -57,7 +61,12 @@ Reader::Status FileSourceReader::initialize(ReaderConfig desc)
     _shard_count = desc.get_shard_count();
     _batch_count = desc.get_batch_size();
     _loop = desc.loop();
-    return subfolder_reading();
+    _all_file_names = desc.file_list();
+    auto ret = Reader::Status::OK;
+    if(!_all_file_names)
+        ret = subfolder_reading();
+    select_shard_files();
+    return ret;
 }
 
 void FileSourceReader::incremenet_read_ptr()
@@ -69,6 +78,7 @@ size_t FileSourceReader::open()
 {
     auto file_path = _file_names[_curr_file_idx];// Get next file name
     incremenet_read_ptr();
+    _last_file_path = file_path;
     _last_id= file_path;
     auto last_slash_idx = _last_id.find_last_of("\\/");
     if (std::string::npos != last_slash_idx)
@@ -97,6 +107,98 @@ size_t FileSourceReader::open()
     return _current_file_size;
 }
 
+time_t FileSourceReader::last_modified()
+{
+    struct stat file_stat;
+    if(!_current_fPtr || fstat(fileno(_current_fPtr), &file_stat) != 0)
+        return 0;
+    return file_stat.st_mtime;
+}
+
+bool FileSourceReader::peek_next(std::string& path, size_t& size, time_t& mtime)
+{
+    struct stat file_stat;
+    if(_file_names.empty() || stat(_file_names[_curr_file_idx].c_str(), &file_stat) != 0)
+        return false;
+    path = _file_names[_curr_file_idx];
+    size = file_stat.st_size;
+    mtime = file_stat.st_mtime;
+    return true;
+}
+
+size_t FileSourceReader::read_next(std::vector<unsigned char>& buf, std::string& id)
+{
+    std::string file_path;
+    {
+        // Only picking the next file needs to be serialized, opening and reading it does not
+        std::lock_guard<std::mutex> lock(_read_next_mutex);
+        id.clear();
+        if(count() == 0)
+            return 0;
+        file_path = _file_names[_curr_file_idx];
+        incremenet_read_ptr();
+    }
+    id = file_path;
+    auto last_slash_idx = id.find_last_of("\\/");
+    if (std::string::npos != last_slash_idx)
+    {
+        id.erase(0, last_slash_idx + 1);
+    }
+
+    FILE* fp = fopen(file_path.c_str(), "rb");
+    if(!fp)
+        return 0;
+    fseek(fp, 0 , SEEK_END);
+    size_t file_size = ftell(fp);
+    fseek(fp, 0 , SEEK_SET);
+    if(buf.size() < file_size)
+        buf.resize(file_size);
+    size_t actual_read_size = (file_size == 0) ? 0 : fread(buf.data(), sizeof(unsigned char), file_size, fp);
+    fclose(fp);
+    return actual_read_size;
+}
+
+const unsigned char* FileSourceReader::map_next(size_t& size, std::string& id)
+{
+    std::string file_path;
+    {
+        // Only picking the next file needs to be serialized, mapping it does not
+        std::lock_guard<std::mutex> lock(_read_next_mutex);
+        size = 0;
+        id.clear();
+        if(count() == 0)
+            return nullptr;
+        file_path = _file_names[_curr_file_idx];
+        incremenet_read_ptr();
+    }
+    id = file_path;
+    auto last_slash_idx = id.find_last_of("\\/");
+    if (std::string::npos != last_slash_idx)
+    {
+        id.erase(0, last_slash_idx + 1);
+    }
+
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return nullptr;
+    struct stat file_stat;
+    void* data = MAP_FAILED;
+    // The whole file is decoded right away, MAP_POPULATE maps all of its pages at once instead of faulting them in one by one
+    if(fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+        data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);// The mapping stays valid after closing the file
+    if(data == MAP_FAILED)
+        return nullptr;
+    size = file_stat.st_size;
+    return static_cast<const unsigned char*>(data);
+}
+
+void FileSourceReader::unmap(const unsigned char* data, size_t size)
+{
+    if(data)
+        munmap(const_cast<unsigned char*>(data), size);
+}
+
 size_t FileSourceReader::read(unsigned char* buf, size_t read_size)
 {
     if(!_current_fPtr)
@@ -131,6 +233,7 @@ FileSourceReader::release()
 
 void FileSourceReader::reset()
 {
+    std::lock_guard<std::mutex> lock(_read_next_mutex);
     std::random_shuffle(_file_names.begin(), _file_names.end());
     _read_counter = 0;
     _curr_file_idx = 0;
@@ -154,40 +257,62 @@ Reader::Status FileSourceReader::subfolder_reading()
 
     std::string subfolder_path = _full_path + "/" + entry_name_list[0];
 
+    auto file_names = std::make_shared<std::vector<std::string>>();
     filesys::path pathObj(subfolder_path);
     auto ret = Reader::Status::OK;
     if(filesys::exists(pathObj) && filesys::is_regular_file(pathObj))
     {
-        ret = open_folder();
+        ret = open_folder(*file_names);
     }
     else if(filesys::exists(pathObj) && filesys::is_directory(pathObj))
     {
         for (unsigned dir_count = 0; dir_count < entry_name_list.size(); ++dir_count) {
             std::string subfolder_path = _full_path + "/" + entry_name_list[dir_count];
             _folder_path = subfolder_path;
-            if(open_folder() != Reader::Status::OK)
+            if(open_folder(*file_names) != Reader::Status::OK)
                 WRN("FileReader ShardID ["+ TOSTR(_shard_id)+ "] File reader cannot access the storage at " + _folder_path);
         }
     }
+    _folder_path = _full_path;
+    _all_file_names = file_names;
+
+    closedir(_sub_dir);
+    return ret;
+}
+
+void FileSourceReader::select_shard_files()
+{
+    for(auto& file_path: *_all_file_names)
+    {
+        if(get_file_shard_id() == _shard_id )
+        {
+            _in_batch_read_count++;
+            _in_batch_read_count = (_in_batch_read_count%_batch_count == 0) ? 0 : _in_batch_read_count;
+            _last_file_name = file_path;
+            _file_names.push_back(file_path);
+        }
+        incremenet_file_id();
+    }
+    if(_file_names.empty())
+    {
+        WRN("FileReader ShardID ["+ TOSTR(_shard_id)+ "] Did not load any file from " + _folder_path)
+        return;
+    }
     if(_in_batch_read_count > 0 && _in_batch_read_count < _batch_count)
     {
         replicate_last_image_to_fill_last_shard();
-        LOG("FileReader ShardID [" + TOSTR(_shard_id) + "] Replicated " + _folder_path+_last_file_name + " " + TOSTR((_batch_count - _in_batch_read_count) ) + " times to fill the last batch")
+        LOG("FileReader ShardID [" + TOSTR(_shard_id) + "] Replicated " + _last_file_name + " " + TOSTR((_batch_count - _in_batch_read_count) ) + " times to fill the last batch")
     }
-    if(!_file_names.empty())
-        LOG("FileReader ShardID ["+ TOSTR(_shard_id)+ "] Total of " + TOSTR(_file_names.size()) + " images loaded from " + _full_path )
-
-
-    closedir(_sub_dir);
-    return ret;
+    LOG("FileReader ShardID ["+ TOSTR(_shard_id)+ "] Total of " + TOSTR(_file_names.size()) + " images loaded from " + _folder_path )
 }
+
 void FileSourceReader::replicate_last_image_to_fill_last_shard()
 {
     for(size_t i = _in_batch_read_count; i < _batch_count; i++)
         _file_names.push_back(_last_file_name);
 }
 
-Reader::Status FileSourceReader::open_folder()
+Reader::Status FileSourceReader::open_folder(std::vector<std::string>& file_names)
 {
     if ((_src_dir = opendir (_folder_path.c_str())) == nullptr)
         THROW("FileReader ShardID ["+ TOSTR(_shard_id)+ "] ERROR: Failed opening the directory at " + _folder_path);
@@ -198,22 +323,11 @@ Reader::Status FileSourceReader::open_folder()
         if(_entity->d_type != DT_REG)
             continue;
 
-        if(get_file_shard_id() != _shard_id )
-        {
-            incremenet_file_id();
-            continue;
-        }
-        _in_batch_read_count++;
-        _in_batch_read_count = (_in_batch_read_count%_batch_count == 0) ? 0 : _in_batch_read_count;
         std::string file_path = _folder_path;
         file_path.append("/");
         file_path.append(_entity->d_name);
-        _last_file_name = file_path;
-        _file_names.push_back(file_path);
-        incremenet_file_id();
+        file_names.push_back(file_path);
     }
-    if(_file_names.empty())
-        WRN("FileReader ShardID ["+ TOSTR(_shard_id)+ "] Did not load any file from " + _folder_path)
 
     closedir(_src_dir);
     return Reader::Status::OK;
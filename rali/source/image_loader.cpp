@@ -27,7 +27,7 @@ THE SOFTWARE.
 #include "vx_ext_amd.h"
 
 ImageLoader::ImageLoader(DeviceResources dev_resources):
-_circ_buff(dev_resources, CIRC_BUFFER_DEPTH),
+_circ_buff(dev_resources),
 _swap_handle_time("Swap_handle_time", DBG_TIMING)
 {
     _output_image = nullptr;
@@ -52,6 +52,12 @@ ImageLoader::remaining_count()
 
 void 
 ImageLoader::reset()
+{
+    restart(true);
+}
+
+void
+ImageLoader::restart(bool new_epoch)
 {
     // stop the writer thread and empty the internal circular buffer
     _internal_thread_running = false;
@@ -65,7 +71,7 @@ ImageLoader::reset()
 
     // resetting the reader thread to the start of the media
     _image_counter = 0;
-    _image_loader->reset();
+    _image_loader->reset(new_epoch);
 
     // Start loading (writer thread) again
     start_loading();
@@ -128,10 +134,10 @@ ImageLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg, Rali
         de_init();
         throw;
     }
-    _decoded_img_info._image_names.resize(_batch_size);
-    _decoded_img_info._roi_height.resize(_batch_size);
-    _decoded_img_info._roi_width.resize(batch_size);
-    _circ_buff.init(_mem_type, _output_mem_size);
+    _output_names.resize(_batch_size);
+    _output_decoded_region.resize(_batch_size);
+    _cpu_set = decoder_cfg.cpu_set();
+    _circ_buff.init(_mem_type, _output_mem_size, _batch_size, _prefetch_depth, _cpu_set);
     _is_initialized = true;
     LOG("Loader module initialized");
 }
@@ -145,6 +151,7 @@ ImageLoader::start_loading()
     _remaining_image_count = _image_loader->count();
     _internal_thread_running = true;
     _load_thread = std::thread(&ImageLoader::load_routine, this);
+    _cpu_set.apply(_load_thread.native_handle());
 }
 
 
@@ -163,17 +170,19 @@ ImageLoader::load_routine()
 
         auto load_status = LoaderModuleStatus::NO_MORE_DATA_TO_READ;
         {
+            // Images are decoded directly into their slot of the buffer and their info into the buffer's info
+            auto& image_info = _circ_buff.get_write_image_info();
             load_status = _image_loader->load(data,
-                                             _decoded_img_info._image_names,
+                                             image_info._image_names,
                                              _output_image->info().width(),
                                              _output_image->info().height_single(),
-                                             _decoded_img_info._roi_width,
-                                             _decoded_img_info._roi_height,
+                                             image_info._roi_width,
+                                             image_info._roi_height,
+                                             image_info._decoded_region,
                                              _output_image->info().color_format() );
 
             if(load_status == LoaderModuleStatus::OK)
             {
-                _circ_buff.set_image_info(_decoded_img_info);
                 _circ_buff.push();
                 _image_counter += _output_image->info().batch_size();
             }
@@ -243,9 +252,11 @@ ImageLoader::update_output_image()
     if(_stopped)
         return LoaderModuleStatus::OK;
 
-    decoded_image_info d_img_info = _circ_buff.get_image_info();
-    _output_names = d_img_info._image_names;
-    _output_image->update_image_roi(d_img_info._roi_width, d_img_info._roi_height);
+    auto& image_info = _circ_buff.get_image_info();
+    // Swapping hands the buffer the previous names to be overwritten, instead of copying the strings
+    _output_names.swap(image_info._image_names);
+    _output_decoded_region.swap(image_info._decoded_region);
+    _output_image->update_image_roi(image_info._roi_width, image_info._roi_height);
 
     _circ_buff.pop();
     if(!_loop)
@@ -258,6 +269,7 @@ Timing ImageLoader::timing()
 {
     auto t = _image_loader->timing();
     t.image_process_time = _swap_handle_time.get_timing();
+    t.loader_buffer = _circ_buff.occupancy();
     return t;
 }
 
@@ -288,7 +300,26 @@ LoaderModuleStatus ImageLoader::set_cpu_sched_policy(struct sched_param sched_po
     return LoaderModuleStatus::OK;
 }
 
-std::vector<std::string> ImageLoader::get_id()
+bool ImageLoader::set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator)
+{
+    if(!_is_initialized)
+        THROW("set_crop_window_generator() should be called after initialize() function is called")
+    // stop the writer thread, the batches already decoded are not cropped and get discarded by the reset
+    _internal_thread_running = false;
+    _circ_buff.unblock_writer();
+    if(_load_thread.joinable())
+        _load_thread.join();
+    bool ret = _image_loader->set_crop_window_generator(generator);
+    restart(false);
+    return ret;
+}
+
+const std::vector<std::string>& ImageLoader::get_id()
 {
     return _output_names;
+}
+
+const std::vector<ROI>& ImageLoader::get_decoded_region()
+{
+    return _output_decoded_region;
 }
\ No newline at end of file
@@ -28,18 +28,39 @@ ImageLoaderSharded::ImageLoaderSharded(DeviceResources dev_resources):
     _loader_idx = 0;
 }
 
-std::vector<std::string> ImageLoaderSharded::get_id()
+const std::vector<std::string>& ImageLoaderSharded::get_id()
 {
     if(!_initialized)
         THROW("get_id() should be called after initialize() function");
     return _loaders[_loader_idx]->get_id();
 }
 
+const std::vector<ROI>& ImageLoaderSharded::get_decoded_region()
+{
+    if(!_initialized)
+        THROW("get_decoded_region() should be called after initialize() function");
+    return _loaders[_loader_idx]->get_decoded_region();
+}
+
 ImageLoaderSharded::~ImageLoaderSharded()
 {
     _loaders.clear();
 }
 
+bool ImageLoaderSharded::set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator)
+{
+    if(!_initialized)
+        THROW("set_crop_window_generator() should be called after initialize() function");
+    bool ret = true;
+    for(auto& loader: _loaders)
+        ret = loader->set_crop_window_generator(generator) && ret;
+    // All the shards either crop or decode the whole image
+    if(!ret)
+        for(auto& loader: _loaders)
+            loader->set_crop_window_generator(nullptr);
+    return ret;
+}
+
 void
 ImageLoaderSharded::fast_forward_through_empty_loaders()
 {
@@ -75,6 +96,7 @@ ImageLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cf
     for(size_t i = 0; i < _shard_count; i++)
     {
         auto loader = std::make_shared<ImageLoader>(_dev_resources);
+        loader->set_prefetch_depth(_prefetch_depth);
         _loaders.push_back(loader);
     }
     // Initialize loader modules
@@ -137,6 +159,7 @@ Timing ImageLoaderSharded::timing()
     Timing t;
     long long unsigned  max_decode_time = 0;
     long long unsigned  max_read_time = 0;
+    long long unsigned  max_read_wait_time = 0;
     long long unsigned  swap_handle_time = 0;
 
     // image read and decode runs in parallel using multiple loaders, and the observable latency that the ImageLoaderSharded user
@@ -146,10 +169,14 @@ Timing ImageLoaderSharded::timing()
         auto info = loader->timing();
         max_read_time = (info.image_read_time > max_read_time) ?  info.image_read_time : max_read_time;
         max_decode_time = (info.image_decode_time > max_decode_time) ? info.image_decode_time : max_decode_time;
+        max_read_wait_time = (info.image_read_wait_time > max_read_wait_time) ? info.image_read_wait_time : max_read_wait_time;
         swap_handle_time += info.image_process_time;
+        t.decoder_utilization.insert(t.decoder_utilization.end(), info.decoder_utilization.begin(), info.decoder_utilization.end());
+        t.loader_buffer += info.loader_buffer;
     }
     t.image_decode_time = max_decode_time;
     t.image_read_time = max_read_time;
+    t.image_read_wait_time = max_read_wait_time;
     t.image_process_time = swap_handle_time;
     return t;
 }
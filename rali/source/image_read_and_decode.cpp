@@ -23,6 +23,8 @@ THE SOFTWARE.
 
 #include <iterator>
 #include <cstring>
+#include <algorithm>
+#include <chrono>
 #include "decoder_factory.h"
 #include "image_read_and_decode.h"
 
@@ -53,19 +55,24 @@ ImageReadAndDecode::timing()
     Timing t;
     t.image_decode_time = _decode_time.get_timing();
     t.image_read_time = _file_load_time.get_timing();
+    t.image_read_wait_time = _read_wait_time.load();
+    t.decoder_utilization = decoder_utilization();
     return t;
 }
 
 ImageReadAndDecode::ImageReadAndDecode():
     _file_load_time("FileLoadTime", DBG_TIMING ),
-    _decode_time("DecodeTime", DBG_TIMING)
+    _decode_time("DecodeTime", DBG_TIMING),
+    _read_wait_time(0)
 {
 }
 
 ImageReadAndDecode::~ImageReadAndDecode()
 {
+    stop_decode_threads();
+    stop_read_threads();
     _reader = nullptr;
-    _decoder.clear();
+    _decode_workers.clear();
 }   
 
 void
@@ -74,26 +81,299 @@ ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decoder_con
     // Can initialize it to any decoder types if needed
     _batch_size = batch_size;
     _compressed_buff.resize(batch_size);
-    _decoder.resize(batch_size);
     _actual_read_size.resize(batch_size);
     _image_names.resize(batch_size);
     _compressed_image_size.resize(batch_size);
     _decompressed_buff_ptrs.resize(_batch_size);
-    _actual_decoded_width.resize(_batch_size);
-    _actual_decoded_height.resize(_batch_size);
-    for(int i = 0; i < batch_size; i++)
+    _slot_state.resize(_batch_size, SlotState::EMPTY);
+    _compressed_data.resize(_batch_size, nullptr);
+    _mapped_size.resize(_batch_size, 0);
+    _shard_id = reader_config.get_shard_id();
+    _shard_count = std::max(reader_config.get_shard_count(), (size_t)1);
+    _reader = create_reader(reader_config);
+    _use_mmap = reader_config.memory_mapped() && _reader->can_map();
+    if(reader_config.memory_mapped() && !_use_mmap)
+        WRN("Reader does not support memory mapped reads, images are read into the decoder buffers instead")
+    if(!_use_mmap)
+        for(int i = 0; i < batch_size; i++)
+            _compressed_buff[i].resize(MAX_COMPRESSED_SIZE); // If we don't need MAX_COMPRESSED_SIZE we can remove this & resize in load module
+
+    // A fixed pool of decode workers, each with its own decoder, there is no point in more workers than images in the batch
+    size_t decode_thread_count = decoder_config.thread_count() ? decoder_config.thread_count() : decoder_config.cpu_set().cpu_count();
+    decode_thread_count = std::max((size_t)1, std::min(decode_thread_count, _batch_size));
+    for(size_t i = 0; i < decode_thread_count; i++)
     {
-        _compressed_buff[i].resize(MAX_COMPRESSED_SIZE); // If we don't need MAX_COMPRESSED_SIZE we can remove this & resize in load module
-        _decoder[i] = create_decoder(decoder_config);
+        _decode_workers.emplace_back(std::make_unique<DecodeWorker>());
+        _decode_workers.back()->decoder = create_decoder(decoder_config);
+    }
+    _decode_threads_running = true;
+    _decode_start_time = std::chrono::high_resolution_clock::now();
+    for(size_t i = 0; i < decode_thread_count; i++)
+    {
+        _decode_threads.emplace_back(&ImageReadAndDecode::decode_routine, this, i);
+        decoder_config.cpu_set().apply(_decode_threads.back().native_handle());
+    }
+
+    // Nothing to read yet, the read threads wait for load() to hand them a batch
+    _next_slot_to_read = _batch_size;
+    _slots_done = _batch_size;
+    _read_threads_running = true;
+    size_t read_thread_count = std::max((size_t)1, std::min(reader_config.read_thread_count(), _batch_size));
+    for(size_t i = 0; i < read_thread_count; i++)
+    {
+        _read_threads.emplace_back(&ImageReadAndDecode::read_routine, this);
+        reader_config.cpu_set().apply(_read_threads.back().native_handle());
     }
-    _reader = create_reader(reader_config);
+}
+
+void
+ImageReadAndDecode::stop_read_threads()
+{
+    {
+        std::unique_lock<std::mutex> lock(_read_mutex);
+        _read_threads_running = false;
+    }
+    _read_cv.notify_all();
+    for(auto& thread: _read_threads)
+        if(thread.joinable())
+            thread.join();
+    _read_threads.clear();
+}
+
+void
+ImageReadAndDecode::read_routine()
+{
+    while(true)
+    {
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> lock(_read_mutex);
+            _read_cv.wait(lock, [this] { return !_read_threads_running || _next_slot_to_read < _batch_size; });
+            if(!_read_threads_running)
+                return;
+            // Slots are handed out in order, so the decoder of slot i can start while slot i+k is being read
+            slot = _next_slot_to_read++;
+        }
+        bool read = read_slot(slot);
+        {
+            std::unique_lock<std::mutex> lock(_read_mutex);
+            _slot_state[slot] = read ? SlotState::READY : SlotState::EMPTY;
+            if(++_slots_done == _batch_size)
+                _file_load_time.end();// Debug timing
+        }
+        _slot_cv.notify_all();
+    }
+}
+
+bool
+ImageReadAndDecode::read_slot(size_t slot)
+{
+    while(true)
+    {
+        // read_next() leaves the name empty once there is no item left, count() is not safe to call while other threads read
+        size_t fsize;
+        if(_use_mmap)
+        {
+            _compressed_data[slot] = _reader->map_next(fsize, _image_names[slot]);
+            _mapped_size[slot] = fsize;
+        }
+        else
+        {
+            fsize = _reader->read_next(_compressed_buff[slot], _image_names[slot]);
+            _compressed_data[slot] = _compressed_buff[slot].data();
+        }
+        if(_image_names[slot].empty())
+            break;
+        if (fsize == 0) {
+            WRN("Opened file " + _image_names[slot] + " of size 0");
+            continue;
+        }
+        _actual_read_size[slot] = fsize;
+        _compressed_image_size[slot] = fsize;
+        return true;
+    }
+    return false;
+}
+
+bool
+ImageReadAndDecode::wait_for_slot(size_t slot)
+{
+    std::unique_lock<std::mutex> lock(_read_mutex);
+    if(_slot_state[slot] == SlotState::PENDING)
+    {
+        auto wait_start = std::chrono::high_resolution_clock::now();
+        _slot_cv.wait(lock, [this, slot] { return _slot_state[slot] != SlotState::PENDING; });
+        _read_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - wait_start).count();
+    }
+    return _slot_state[slot] == SlotState::READY;
+}
+
+void
+ImageReadAndDecode::stop_decode_threads()
+{
+    {
+        std::unique_lock<std::mutex> lock(_decode_mutex);
+        _decode_threads_running = false;
+    }
+    _decode_cv.notify_all();
+    for(auto& thread: _decode_threads)
+        if(thread.joinable())
+            thread.join();
+    _decode_threads.clear();
+}
+
+void
+ImageReadAndDecode::decode_routine(size_t worker_id)
+{
+    auto& worker = _decode_workers[worker_id];
+    size_t batch_id = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_decode_mutex);
+            _decode_cv.wait(lock, [this, batch_id] { return !_decode_threads_running || _decode_batch_id != batch_id; });
+            if(!_decode_threads_running)
+                return;
+            batch_id = _decode_batch_id;
+        }
+        size_t image_idx, decoded_count = 0;
+        while(next_decode_task(worker_id, image_idx))
+        {
+            // Waiting for the read stage is not counted as busy time
+            bool read = wait_for_slot(image_idx);
+            auto start_time = std::chrono::high_resolution_clock::now();
+            decode_image(worker_id, image_idx, read);
+            worker->busy_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time).count();
+            decoded_count++;
+        }
+        if(decoded_count)
+        {
+            std::unique_lock<std::mutex> lock(_decode_mutex);
+            _images_left_to_decode -= decoded_count;
+            if(_images_left_to_decode == 0)
+                _decode_done_cv.notify_all();
+        }
+    }
+}
+
+bool
+ImageReadAndDecode::next_decode_task(size_t worker_id, size_t& image_idx)
+{
+    {
+        auto& worker = _decode_workers[worker_id];
+        std::unique_lock<std::mutex> lock(worker->lock);
+        if(!worker->images.empty())
+        {
+            image_idx = worker->images.front();
+            worker->images.pop_front();
+            return true;
+        }
+    }
+    // Steals the last image of the next worker that has any left, it's the one its owner would get to last
+    for(size_t i = 1; i < _decode_workers.size(); i++)
+    {
+        auto& victim = _decode_workers[(worker_id + i) % _decode_workers.size()];
+        std::unique_lock<std::mutex> lock(victim->lock);
+        if(!victim->images.empty())
+        {
+            image_idx = victim->images.back();
+            victim->images.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ImageReadAndDecode::decode_image(size_t worker_id, size_t i, bool read)
+{
+    auto& roi_width = *_decode_roi_width;
+    auto& roi_height = *_decode_roi_height;
+    // initialize the actual decoded height and width with the maximum
+    roi_width[i] = _decode_width;
+    roi_height[i] = _decode_height;
+    auto& decoded_region = (*_decoded_region)[i];
+    decoded_region = {{0, 0}, {(unsigned)_decode_width, (unsigned)_decode_height}};
+
+    if(!read)
+        return;
+    auto decoder = _decode_workers[worker_id]->decoder;
+
+    int original_width, original_height, jpeg_sub_samp;
+    // The decoders don't write to the compressed buffer, it's safe to hand them the read-only mapping
+    auto compressed_data = const_cast<unsigned char*>(_compressed_data[i]);
+    if(decoder->decode_info(compressed_data, _actual_read_size[i], &original_width, &original_height, &jpeg_sub_samp ) != Decoder::Status::OK)
+    {
+        return;
+    }
+#if 0
+    if((unsigned)original_width != _decode_width || (unsigned)original_height != _decode_height)
+        // Seeting the whole buffer to zero in case resizing to exact output dimension is not possible.
+        memset(_decompressed_buff_ptrs[i],0 , image_size);
+#endif
+
+    // decode the image and get the actual decoded image width and height
+    size_t scaledw, scaledh;
+    if(_crop_window_generator)
+    {
+        // Only the MCUs covering the crop window are decoded, the crop node then only resizes
+        size_t crop_x, crop_y, crop_width, crop_height;
+        _crop_window_generator->crop_window({_batch_position.epoch, _batch_position.sample + i}, original_width, original_height,
+                                            crop_x, crop_y, crop_width, crop_height);
+        if(decoder->decode_crop(compressed_data, _compressed_image_size[i], _decompressed_buff_ptrs[i],
+                                    _decode_width, _decode_height,
+                                    original_width, original_height,
+                                    crop_x, crop_y, crop_width, crop_height,
+                                    scaledw, scaledh,
+                                    _decode_color_format) != Decoder::Status::OK)
+        {
+            return;
+        }
+        decoded_region = {{(unsigned)crop_x, (unsigned)crop_y}, {(unsigned)(crop_x + crop_width), (unsigned)(crop_y + crop_height)}};
+    }
+    else if(decoder->decode(compressed_data,_compressed_image_size[i],_decompressed_buff_ptrs[i],
+                           _decode_width, _decode_height,
+                           original_width, original_height,
+                           scaledw, scaledh,
+                           _decode_color_format) != Decoder::Status::OK)
+    {
+        return;
+    }
+
+    if(!_crop_window_generator)
+        decoded_region = {{0, 0}, {(unsigned)original_width, (unsigned)original_height}};
+    roi_width[i] = scaledw;
+    roi_height[i] = scaledh;
+}
+
+std::vector<float>
+ImageReadAndDecode::decoder_utilization()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - _decode_start_time).count();
+    std::vector<float> utilization;
+    for(auto& worker: _decode_workers)
+        utilization.push_back(elapsed > 0 ? (float)worker->busy_time / (float)elapsed : 0);
+    return utilization;
+}
+
+bool
+ImageReadAndDecode::set_crop_window_generator(std::shared_ptr<CropWindowGenerator> generator)
+{
+    for(auto& worker: _decode_workers)
+        if(generator && !worker->decoder->can_decode_crop())
+            return false;
+    _crop_window_generator = generator;
+    return true;
 }
 
 void 
-ImageReadAndDecode::reset()
+ImageReadAndDecode::reset(bool new_epoch)
 {
     // TODO: Reload images from the folder if needed
     _reader->reset();
+    if(new_epoch)
+        _epoch++;
+    _batch_index = 0;
 }
 
 size_t
@@ -110,6 +390,7 @@ ImageReadAndDecode::load(unsigned char* buff,
                          const size_t max_decoded_height,
                          std::vector<uint32_t> &roi_width,
                          std::vector<uint32_t> &roi_height,
+                         std::vector<ROI> &decoded_region,
                          RaliColorFormat output_color_format )
 {
     if(max_decoded_width == 0 || max_decoded_height == 0 )
@@ -118,78 +399,63 @@ ImageReadAndDecode::load(unsigned char* buff,
         THROW("Null pointer passed as output buffer")
     if(_reader->count() < _batch_size)
         return LoaderModuleStatus::NO_MORE_DATA_TO_READ;
+    _batch_position = {_epoch, (_batch_index++ * _shard_count + _shard_id) * _batch_size};
     // load images/frames from the disk and push them as a large image onto the buff
-    unsigned file_counter = 0;
     const auto ret = interpret_color_format(output_color_format);
     const Decoder::ColorFormat decoder_color_format = std::get<0>(ret);
     const unsigned output_planes = std::get<1>(ret);
 
-    // Decode with the height and size equal to a single image  
-    // File read is done serially since I/O parallelization does not work very well.
-    _file_load_time.start();// Debug timing
-
-    while ((file_counter != _batch_size) && _reader->count() > 0)
+    // Hand the batch to the read threads, decoding of an image starts as soon as it is read
     {
-        size_t fsize = _reader->open();
-        if (fsize == 0) {
-            WRN("Opened file " + _reader->id() + " of size 0");
-            continue;
-        }
-
-        _compressed_buff[file_counter].reserve(fsize);
-
-        _actual_read_size[file_counter] = _reader->read(_compressed_buff[file_counter].data(), fsize);
-        _image_names[file_counter] = _reader->id();
-        _reader->close();
-        _compressed_image_size[file_counter] = fsize;
-        file_counter++;
+        std::unique_lock<std::mutex> lock(_read_mutex);
+        std::fill(_slot_state.begin(), _slot_state.end(), SlotState::PENDING);
+        _slots_done = 0;
+        _next_slot_to_read = 0;
+        _file_load_time.start();// Debug timing
     }
+    _read_cv.notify_all();
 
-    _file_load_time.end();// Debug timing
     const size_t image_size = max_decoded_width * max_decoded_height * output_planes * sizeof(unsigned char);
 
     for(size_t i = 0; i < _batch_size; i++)
         _decompressed_buff_ptrs[i] = buff + image_size * i;
 
     _decode_time.start();// Debug timing
-#pragma omp parallel for num_threads(_batch_size) default(none)
-    for(size_t i= 0; i < _batch_size; i++)
-    {
-        // initialize the actual decoded height and width with the maximum
-        _actual_decoded_width[i] = max_decoded_width;
-        _actual_decoded_height[i] = max_decoded_height;
-        
-        int original_width, original_height, jpeg_sub_samp;
-        if(_decoder[i]->decode_info(_compressed_buff[i].data(), _actual_read_size[i], &original_width, &original_height, &jpeg_sub_samp ) != Decoder::Status::OK)
-        {
-            continue;
-        }
-#if 0
-        if((unsigned)original_width != max_decoded_width || (unsigned)original_height != max_decoded_height)
-            // Seeting the whole buffer to zero in case resizing to exact output dimension is not possible.
-            memset(_decompressed_buff_ptrs[i],0 , image_size);
-#endif
-
-        // decode the image and get the actual decoded image width and height
-        size_t scaledw, scaledh;
-        if(_decoder[i]->decode(_compressed_buff[i].data(),_compressed_image_size[i],_decompressed_buff_ptrs[i],
-                               max_decoded_width, max_decoded_height,
-                               original_width, original_height,
-                               scaledw, scaledh,
-                               decoder_color_format) != Decoder::Status::OK)
+    {
+        // Hand the images to the decode workers, worker w starts with images w, w + N, ... so that
+        // images are decoded in the order they are read, idle workers steal from the back of the others' queues
+        std::unique_lock<std::mutex> lock(_decode_mutex);
+        _decode_width = max_decoded_width;
+        _decode_height = max_decoded_height;
+        _decode_color_format = decoder_color_format;
+        _decode_roi_width = &roi_width;
+        _decode_roi_height = &roi_height;
+        _decoded_region = &decoded_region;
+        _images_left_to_decode = _batch_size;
+        for(size_t i = 0; i < _batch_size; i++)
         {
-            continue;
+            auto& worker = _decode_workers[i % _decode_workers.size()];
+            std::unique_lock<std::mutex> queue_lock(worker->lock);
+            worker->images.push_back(i);
         }
-
-        _actual_decoded_width[i] = scaledw;
-        _actual_decoded_height[i] = scaledh;
+        _decode_batch_id++;
+    }
+    _decode_cv.notify_all();
+    {
+        std::unique_lock<std::mutex> lock(_decode_mutex);
+        _decode_done_cv.wait(lock, [this] { return _images_left_to_decode == 0; });
     }
     for(size_t i = 0; i < _batch_size; i++)
     {
-        names[i] = _image_names[i];
-        roi_width[i] = _actual_decoded_width[i];
-        roi_height[i] = _actual_decoded_height[i];
+        if(_mapped_size[i])
+        {
+            _reader->unmap(_compressed_data[i], _mapped_size[i]);
+            _mapped_size[i] = 0;
+        }
     }
+    // The read threads are done with the names, the caller's vector is reused for the next batch
+    names.resize(_batch_size);
+    names.swap(_image_names);
 
     _decode_time.end();// Debug timing
 
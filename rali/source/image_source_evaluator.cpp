@@ -20,9 +20,74 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <boost/filesystem.hpp>
 #include "image_source_evaluator.h"
 #include "decoder_factory.h"
 #include "reader_factory.h"
+
+namespace filesys = boost::filesystem;
+
+namespace
+{
+enum class JpegHeaderStatus { OK, NEED_MORE_DATA, NOT_SUPPORTED };
+
+//! Walks the JPEG markers up to the first SOF marker, needed_size is set to how many bytes are needed if the buffer is too short
+JpegHeaderStatus jpeg_dimension(const unsigned char* buff, size_t size, int& width, int& height, size_t& needed_size)
+{
+    if(size < 2)
+    {
+        needed_size = 2;
+        return JpegHeaderStatus::NEED_MORE_DATA;
+    }
+    if(buff[0] != 0xFF || buff[1] != 0xD8)
+        return JpegHeaderStatus::NOT_SUPPORTED;
+    size_t pos = 2;
+    while(true)
+    {
+        if(pos + 4 > size)
+        {
+            needed_size = pos + 4;
+            return JpegHeaderStatus::NEED_MORE_DATA;
+        }
+        if(buff[pos] != 0xFF)
+            return JpegHeaderStatus::NOT_SUPPORTED;
+        unsigned char marker = buff[pos + 1];
+        if(marker == 0xFF) // fill byte
+        {
+            pos++;
+            continue;
+        }
+        if(marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) // markers without a payload
+        {
+            pos += 2;
+            continue;
+        }
+        if(marker == 0xD9 || marker == 0xDA) // reached the end of image or the scan data without a frame header
+            return JpegHeaderStatus::NOT_SUPPORTED;
+        size_t length = (buff[pos + 2] << 8) | buff[pos + 3];
+        // SOF0 to SOF15, except DHT (C4), JPG (C8) and DAC (CC) which share the range
+        if(marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+            if(pos + 9 > size)
+            {
+                needed_size = pos + 9;
+                return JpegHeaderStatus::NEED_MORE_DATA;
+            }
+            height = (buff[pos + 5] << 8) | buff[pos + 6];
+            width = (buff[pos + 7] << 8) | buff[pos + 8];
+            return JpegHeaderStatus::OK;
+        }
+        pos += 2 + length;
+    }
+}
+}
+
 void ImageSourceEvaluator::set_size_evaluation_policy(MaxSizeEvaluationPolicy arg)
 {
     _width_max.set_policy (arg); 
@@ -44,47 +109,209 @@ ImageSourceEvaluator::create(ReaderConfig reader_cfg, DecoderConfig decoder_cfg)
 {
     ImageSourceEvaluatorStatus status = ImageSourceEvaluatorStatus::OK;
 
-    // Can initialize it to any decoder types if needed
-    
-
-    // _header_buff.resize(COMPRESSED_SIZE);
-    _decoder = create_decoder(std::move(decoder_cfg));
-    _reader = create_reader(std::move(reader_cfg));
+    // Decoders and readers are created per scanning thread in find_max_dimension()
+    _reader_cfg = std::move(reader_cfg);
+    _decoder_cfg = std::move(decoder_cfg);
     find_max_dimension();
     return status;
 }
 
-void 
-ImageSourceEvaluator::find_max_dimension()
+bool
+ImageSourceEvaluator::read_dimension(Reader* reader, Decoder* decoder, size_t size, std::vector<unsigned char>& buff, int& width, int& height)
 {
-    _reader->reset();
+    // Reads the image in chunks, consecutive read() calls continue where the previous one stopped
+    size_t read_size = 0;
+    size_t needed_size = std::min(size, HEADER_READ_SIZE);
+    JpegHeaderStatus status = JpegHeaderStatus::NEED_MORE_DATA;
+    while(status == JpegHeaderStatus::NEED_MORE_DATA && read_size < size)
+    {
+        needed_size = std::min(size, std::max(needed_size, read_size + HEADER_READ_SIZE));
+        if(buff.size() < needed_size)
+            buff.resize(needed_size);
+        auto actual_read_size = reader->read(buff.data() + read_size, needed_size - read_size);
+        if(actual_read_size == 0)
+            return false;
+        read_size += actual_read_size;
+        status = jpeg_dimension(buff.data(), read_size, width, height, needed_size);
+    }
+    if(status == JpegHeaderStatus::OK)
+        return true;
+
+    // Not a baseline/progressive JPEG header we can walk, let the decoder look at the whole image
+    if(buff.size() < size)
+        buff.resize(size);
+    if(read_size < size)
+        read_size += reader->read(buff.data() + read_size, size - read_size);
+    int jpeg_sub_samp;
+    return decoder->decode_info(buff.data(), read_size, &width, &height, &jpeg_sub_samp) == Decoder::Status::OK;
+}
+
+void
+ImageSourceEvaluator::scan_shard(ReaderConfig reader_cfg, std::shared_ptr<Reader> reader, std::vector<std::pair<std::string, DimensionInfo>>& found)
+{
+    // Each thread reads a disjoint shard of the dataset through its own reader
+    if(!reader)
+        reader = create_reader(reader_cfg);
+    auto decoder = create_decoder(_decoder_cfg);
+    std::vector<unsigned char> buff;
 
-    while( _reader->count() ) 
+    while( reader->count() )
     {
-        size_t fsize = _reader->open();
+        // Keyed by the full path, images with the same name in different sub folders are different images.
+        // Cached images are skipped without opening them
+        std::string id;
+        size_t item_size = 0;
+        time_t mtime = 0;
+        bool peeked = reader->peek_next(id, item_size, mtime);
+        if(peeked && mtime != 0)
+        {
+            auto cached = _cached_index.find(id);
+            if(cached != _cached_index.end() && cached->second.size == item_size && cached->second.mtime == mtime)
+            {
+                reader->skip_next();
+                found.emplace_back(id, cached->second);
+                continue;
+            }
+        }
+
+        size_t fsize = reader->open();
         if( (fsize) == 0 )
             continue;
-        _header_buff.resize(fsize);
-        auto actual_read_size = _reader->read(_header_buff.data(), fsize);
-        _reader->close();
-        
-        int width, height, jpeg_sub_samp;
-        if(_decoder->decode_info(_header_buff.data(), actual_read_size, &width, &height, &jpeg_sub_samp ) != Decoder::Status::OK)
+        if(!peeked)
         {
-            WRN("Could not decode the header of the: "+ _reader->id())
+            id = reader->path();
+            item_size = fsize;
+            mtime = reader->last_modified();
+        }
+
+        int width, height;
+        bool valid = read_dimension(reader.get(), decoder.get(), fsize, buff, width, height);
+        reader->close();
+        if(!valid)
+        {
+            WRN("Could not decode the header of the: "+ id)
             continue;
         }
-        
+
         if(width <= 0 || height <=0)
             continue;
 
-        _width_max.process_sample(width);
-        _height_max.process_sample(height);
+        found.emplace_back(id, DimensionInfo{(unsigned)width, (unsigned)height, item_size, mtime});
+    }
+}
 
+void 
+ImageSourceEvaluator::find_max_dimension()
+{
+    load_index();
+
+    size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    auto reader_cfg = _reader_cfg;
+    reader_cfg.set_shard_count(thread_count);
+    reader_cfg.set_batch_count(1);
+    reader_cfg.set_loop(false);
+    // Only the first shard's reader walks (indexes) the dataset, the other shards' readers pick their items from its list
+    reader_cfg.set_shard_id(0);
+    auto first_reader = create_reader(reader_cfg);
+    reader_cfg.set_file_list(first_reader->file_list());
+    reader_cfg.set_record_index(first_reader->record_index());
+
+    std::vector<std::vector<std::pair<std::string, DimensionInfo>>> found(thread_count);
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < thread_count; i++)
+    {
+        reader_cfg.set_shard_id(i);
+        threads.emplace_back(&ImageSourceEvaluator::scan_shard, this, reader_cfg, (i == 0) ? first_reader : nullptr, std::ref(found[i]));
+    }
+    for(auto& thread: threads)
+        thread.join();
+
+    DimensionIndex index;
+    for(auto& shard: found)
+    {
+        for(auto& item: shard)
+        {
+            _width_max.process_sample(item.second.width);
+            _height_max.process_sample(item.second.height);
+        }
+        index.insert(shard.begin(), shard.end());
+    }
+    size_t cache_hits = 0;
+    for(auto& item: index)
+    {
+        auto cached = _cached_index.find(item.first);
+        if(cached != _cached_index.end() && cached->second.mtime == item.second.mtime && cached->second.size == item.second.size)
+            cache_hits++;
+    }
+    LOG("Found the dimension of " + TOSTR(index.size()) + " images, " + TOSTR(cache_hits) + " of them from " + index_file_path())
+    if(cache_hits != index.size() || index.size() != _cached_index.size())
+        save_index(index);
+}
+
+std::string
+ImageSourceEvaluator::index_file_path()
+{
+    // One index per dataset under the user's cache folder, since the dataset's own folder may not be writable
+    const char* cache_home = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if(!cache_home && !home)
+        return "";
+    filesys::path cache_dir = cache_home ? filesys::path(cache_home) : filesys::path(home) / ".cache";
+    auto source_path = filesys::absolute(filesys::path(_reader_cfg.path())).lexically_normal().string();
+    std::stringstream name;
+    name << "image_dimensions_" << std::hex << std::hash<std::string>{}(source_path + "#" + std::to_string(static_cast<int>(_reader_cfg.type()))) << ".txt";
+    return (cache_dir / "rali" / name.str()).string();
+}
+
+void
+ImageSourceEvaluator::load_index()
+{
+    _cached_index.clear();
+    auto path = index_file_path();
+    if(path.empty())
+        return;
+    std::ifstream index_file(path);
+    std::string line;
+    while(std::getline(index_file, line))
+    {
+        // Each line is: mtime size width height name, name is last since it may contain spaces
+        std::istringstream fields(line);
+        DimensionInfo info;
+        long long mtime;
+        if(!(fields >> mtime >> info.size >> info.width >> info.height))
+            continue;
+        info.mtime = mtime;
+        std::string name;
+        fields.get();
+        std::getline(fields, name);
+        if(!name.empty())
+            _cached_index[name] = info;
+    }
+}
+
+void
+ImageSourceEvaluator::save_index(const DimensionIndex& index)
+{
+    auto path = index_file_path();
+    if(path.empty())
+        return;
+    boost::system::error_code ec;
+    filesys::create_directories(filesys::path(path).parent_path(), ec);
+    // Written to a temporary file first, so concurrent pipelines reading the same dataset never see a partial index
+    auto temp_path = path + "." + std::to_string(getpid());
+    std::ofstream index_file(temp_path, std::ios::trunc);
+    if(!index_file)
+    {
+        WRN("Cannot write the image dimension index to " + path)
+        return;
     }
-    // return the reader read pointer to the begining of the resource
-    _reader->reset();
-    _reader->reset();
+    for(auto& item: index)
+        if(item.second.mtime != 0 && item.first.find('\n') == std::string::npos)
+            index_file << (long long)item.second.mtime << " " << item.second.size << " " << item.second.width << " " << item.second.height << " " << item.first << "\n";
+    index_file.close();
+    filesys::rename(temp_path, path, ec);
+    if(ec)
+        WRN("Cannot write the image dimension index to " + path)
 }
 
 void 
@@ -24,9 +24,11 @@ THE SOFTWARE.
 #include <vx_ext_amd.h>
 #include <VX/vx_types.h>
 #include <cstring>
+#include <algorithm>
 #include <sched.h>
 #include <half.hpp>
 #include "master_graph.h"
+#include "node_crop_resize.h"
 #include "parameter_factory.h"
 #include "ocl_setup.h"
 #include "meta_data_reader_factory.h"
@@ -71,7 +73,6 @@ MasterGraph::~MasterGraph()
 }
 
 MasterGraph::MasterGraph(size_t batch_size, RaliAffinity affinity, int gpu_id, size_t cpu_threads):
-        _ring_buffer(OUTPUT_RING_BUFFER_DEPTH),
         _output_tensor(nullptr),
         _graph(nullptr),
         _affinity(affinity),
@@ -83,10 +84,12 @@ MasterGraph::MasterGraph(size_t batch_size, RaliAffinity affinity, int gpu_id, s
         _process_time("Process Time", DBG_TIMING),
         _first_run(true),
         _processing(false),
-        _internal_batch_size(compute_optimum_internal_batch_size(batch_size, affinity)),
+        _internal_batch_size(compute_optimum_internal_batch_size(batch_size, affinity, cpu_threads)),
         _user_to_internal_batch_ratio (_user_batch_size/_internal_batch_size)
 {
     try {
+        if(_cpu_threads > 1)
+            _loader_options.decode_thread_count = _cpu_threads;
         vx_status status;
         _context = vxCreateContext();
         auto vx_affinity = get_ago_affinity_info(_affinity, 0, gpu_id);
@@ -204,11 +207,76 @@ MasterGraph::build()
 
     allocate_output_tensor();
 
-    _ring_buffer.init(_mem_type, _device.resources(), output_byte_size(), _output_images.size());
+    size_t tensor_buffer_size = 0;
+    if(_output_tensor_config_set)
+    {
+        if(processing_on_device())
+            WRN("Output tensor configuration is ignored for GPU affinity, tensors are converted on the device when copied")
+        else
+            tensor_buffer_size = output_byte_size() * _output_images.size() *
+                                 ((_output_tensor_config.data_type == RaliTensorDataType::FP16) ? sizeof(half) : sizeof(float));
+    }
+    auto ring_buffer_depth = _loader_options.buffer_depth(output_byte_size() * _output_images.size() + tensor_buffer_size);
+    _ring_buffer.init(_mem_type, _device.resources(), output_byte_size(), _output_images.size(), ring_buffer_depth, _augment_cpu_set, tensor_buffer_size);
+    if(_loader_options.crop_on_decode)
+        enable_crop_on_decode();
+    if(_meta_data_graph)
+        build_meta_data_graph();
     create_single_graph();
     start_processing();
     return Status::OK;
 }
+void
+MasterGraph::build_meta_data_graph()
+{
+    // The meta data follows the nodes on the path from the loader to the first output image
+    std::vector<std::shared_ptr<Node>> path;
+    for(auto it = _image_map.find(_output_images.front()); it != _image_map.end(); )
+    {
+        path.push_back(it->second);
+        if(it->second->input().empty())
+            break;
+        it = _image_map.find(it->second->input()[0]);
+    }
+    for(auto node = path.rbegin(); node != path.rend(); node++)
+        _meta_data_graph->add_node(*node);
+    _meta_data_graph->build();
+}
+
+void
+MasterGraph::enable_crop_on_decode()
+{
+    // The crop can be moved to the decoder only if the crop resize node is the sole consumer of the decoded images
+    if(_root_nodes.size() != 1 || !_loader_module)
+    {
+        WRN("Crop on decode needs a single image loader, images are decoded in full")
+        return;
+    }
+    auto loader_output = _root_nodes.front()->output()[0];
+    std::shared_ptr<CropResizeNode> crop_node = nullptr;
+    unsigned consumer_count = 0;
+    for(auto& node: _nodes)
+        for(auto& input: node->input())
+            if(input == loader_output)
+            {
+                consumer_count++;
+                crop_node = std::dynamic_pointer_cast<CropResizeNode>(node);
+            }
+    bool is_output = std::find(_output_images.begin(), _output_images.end(), loader_output) != _output_images.end();
+    if(consumer_count != 1 || !crop_node || is_output)
+    {
+        WRN("Crop on decode needs the loader's output to be only used by a crop resize node, images are decoded in full")
+        return;
+    }
+    if(!_loader_module->set_crop_window_generator(crop_node->crop_window_generator()))
+    {
+        WRN("Loader's decoder cannot decode a crop window, images are decoded in full")
+        return;
+    }
+    crop_node->set_cropped_by_decoder();
+    LOG("Crop resize is done on decode")
+}
+
 Image *
 MasterGraph::create_loader_output_image(const ImageInfo &info)
 {
@@ -272,6 +340,10 @@ MasterGraph::update_node_parameters()
     // Randomize random parameters
     ParameterFactory::instance()->renew_parameters();
 
+    // The per sample parameters are drawn from the position of the samples in the epoch, so that they don't depend on the internal batch size
+    ParameterFactory::set_sample_position({_epoch, _sample_index});
+    _sample_index += _internal_batch_size;
+
     // Apply renewed parameters to VX parameters used in augmentation
     for(auto& node: _nodes)
         node->update_parameters();
@@ -349,6 +421,8 @@ MasterGraph::reset()
 
     // resetting loader module to start from the beginning of the media and clear it's internal state/buffers
     _loader_module->reset();
+    _epoch++;
+    _sample_index = 0;
     // restart processing of the images
     _first_run = true;
     _output_routine_finished_processing = false;
@@ -374,6 +448,7 @@ MasterGraph::timing()
     Timing t = _loader_module->timing();
     t.image_process_time += _process_time.get_timing();
     t.copy_to_output += _convert_time.get_timing();
+    t.output_buffer = _ring_buffer.occupancy();
     return t;
 }
 
@@ -401,6 +476,24 @@ MasterGraph::copy_out_tensor(void *out_ptr, RaliTensorFormat format, float multi
     if(no_more_processed_data())
         return MasterGraph::Status::NO_MORE_DATA;
 
+    ScopedCpuSet pin(_output_copy_cpu_set);
+    OutputTensorConfig config = { format, output_data_type, { multiplier0, multiplier1, multiplier2 }, { offset0, offset1, offset2 }, reverse_channels };
+    if(_output_tensor_config_set && !processing_on_device())
+    {
+        if(config == _output_tensor_config)
+        {
+            // The internal processing thread has already converted the batch
+            _convert_time.start();
+            memcpy(out_ptr, _ring_buffer.get_host_tensor_read_buffer(), _ring_buffer.tensor_buffer_size());
+            _convert_time.end();
+            return Status::OK;
+        }
+        if(!_output_tensor_config_mismatch_reported)
+        {
+            WRN("Output tensor requested in a different format than the one set for the pipeline, converting it on the caller's thread")
+            _output_tensor_config_mismatch_reported = true;
+        }
+    }
     if (output_color_format() == RaliColorFormat::RGB_PLANAR)
         return MasterGraph::copy_out_tensor_planar(out_ptr,format,multiplier0, multiplier1, multiplier2, offset0, offset1, offset2, reverse_channels, output_data_type);
 
@@ -472,130 +565,7 @@ MasterGraph::copy_out_tensor(void *out_ptr, RaliTensorFormat format, float multi
             THROW("clEnqueueReadBuffer failed: " + TOSTR(status))
     }
     if(_output_image_info.mem_type() == RaliMemType::HOST)
-    {
-        float multiplier[3] = {multiplier0, multiplier1, multiplier2 };
-        float offset[3] = {offset0, offset1, offset2 };
-        size_t dest_buf_offset = 0;
-
-        auto output_buffers =_ring_buffer.get_read_buffers();
-        for( auto&& out_image: output_buffers)
-        {
-            auto in_buffer = (unsigned char*)out_image;
-            if(format == RaliTensorFormat::NHWC)
-            {
-                if(output_data_type == RaliTensorDataType::FP32)
-                {
-                    float *output_tensor_32 = static_cast<float *>(out_ptr);
-                    auto channel_size  = w * h;
-                    for(unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                        for(unsigned i = 0; i < channel_size; i++)
-                            output_tensor_32[dest_buf_offset+channel_idx+ i*c] =
-                                    offset[channel_idx] + multiplier[channel_idx]*(reverse_channels ? (float)(in_buffer[i*c+c-channel_idx-1]) : (float)(in_buffer[i*c+channel_idx]));
-                }
-                else if(output_data_type == RaliTensorDataType::FP16)
-                {
-                    half *output_tensor_16 = static_cast<half *>(out_ptr);
-                    auto channel_size  = w * h;
-                    for(unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                        for(unsigned i = 0; i < channel_size; i++)
-                            output_tensor_16[dest_buf_offset+channel_idx+ i*c] =
-                                    offset[channel_idx] + multiplier[channel_idx]*(reverse_channels ? (half)(in_buffer[i*c+c-channel_idx-1]) : (half)(in_buffer[i*c+channel_idx]));
-                }
-            }
-            if(format == RaliTensorFormat::NCHW)
-            {
-                if(output_data_type == RaliTensorDataType::FP32)
-                {
-                    float *output_tensor_32 = static_cast<float *>(out_ptr);
-                    auto channel_size  = w * h;
-                    if(c != 3)
-                    {
-                        for(unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for(unsigned i = 0; i < channel_size; i++)
-                                output_tensor_32[dest_buf_offset+channel_idx*channel_size + i] =
-                                        offset[channel_idx] + multiplier[channel_idx]*(reverse_channels ? (float)(in_buffer[c*i+c-channel_idx-1]) : (float)(in_buffer[c*i+channel_idx]));
-                    }
-                    else {
-#if (ENABLE_SIMD && __AVX2__)
-
-                        float *B_buf = output_tensor_32 + dest_buf_offset;
-                        float *G_buf = B_buf + channel_size;
-                        float *R_buf = G_buf + channel_size;
-
-                        __m256i mask_B, mask_G, mask_R;
-                        if (reverse_channels) {
-                            mask_B = _mm256_setr_epi32(0x80808000, 0x80808003, 0x80808006, 0x80808009, 0x80808000,
-                                                       0x80808003, 0x80808006, 0x80808009);
-                            mask_G = _mm256_setr_epi32(0x80808001, 0x80808004, 0x80808007, 0x8080800A, 0x80808001,
-                                                       0x80808004, 0x80808007, 0x8080800A);
-                            mask_R = _mm256_setr_epi32(0x80808002, 0x80808005, 0x80808008, 0x8080800B, 0x80808002,
-                                                       0x80808005, 0x80808008, 0x8080800B);
-                        } else {
-                            mask_R = _mm256_setr_epi32(0x80808000, 0x80808003, 0x80808006, 0x80808009, 0x80808000,
-                                                       0x80808003, 0x80808006, 0x80808009);
-                            mask_G = _mm256_setr_epi32(0x80808001, 0x80808004, 0x80808007, 0x8080800A, 0x80808001,
-                                                       0x80808004, 0x80808007, 0x8080800A);
-                            mask_B = _mm256_setr_epi32(0x80808002, 0x80808005, 0x80808008, 0x8080800B, 0x80808002,
-                                                       0x80808005, 0x80808008, 0x8080800B);
-                        }
-                        __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                        __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                        __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                        __m256 padd0 = _mm256_set1_ps(offset0);
-                        __m256 padd1 = _mm256_set1_ps(offset1);
-                        __m256 padd2 = _mm256_set1_ps(offset2);
-                        unsigned int alignedLength = (channel_size & ~7);    // multiple of 8
-                        unsigned int i = 0;
-
-                        __m256 fR, fG, fB;
-                        for (; i < alignedLength; i += 8) {
-                            __m256i pix0 = _mm256_loadu_si256((const __m256i *) in_buffer);
-                            pix0 = _mm256_permutevar8x32_epi32(pix0, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
-                            fB = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_R));
-                            fG = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_G));
-                            fR = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_B));
-                            fB = _mm256_mul_ps(fB, pmul0);
-                            fG = _mm256_mul_ps(fG, pmul1);
-                            fR = _mm256_mul_ps(fR, pmul2);
-                            fB = _mm256_add_ps(fB, padd0);
-                            fG = _mm256_add_ps(fG, padd1);
-                            fR = _mm256_add_ps(fR, padd2);
-                            _mm256_storeu_ps(B_buf, fB);
-                            _mm256_storeu_ps(G_buf, fG);
-                            _mm256_storeu_ps(R_buf, fR);
-                            B_buf += 8;
-                            G_buf += 8;
-                            R_buf += 8;
-                            in_buffer += 24;
-                        }
-                        for (; i < channel_size; i++, in_buffer += 3) {
-                            *B_buf++ = (in_buffer[0] * multiplier0) + offset0;
-                            *G_buf++ = (in_buffer[1] * multiplier1) + offset1;
-                            *R_buf++ = (in_buffer[2] * multiplier2) + offset1;
-                        }
-
-#else
-                        for(unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for(unsigned i = 0; i < channel_size; i++)
-                                output_tensor_32[dest_buf_offset+channel_idx*channel_size + i] =
-                                        offset[channel_idx] + multiplier[channel_idx]*(reverse_channels ? (float)(in_buffer[c*i+c-channel_idx-1]) : (float)(in_buffer[c*i+channel_idx]));
-#endif
-                    }
-                }
-                else if(output_data_type == RaliTensorDataType::FP16)
-                {
-                    half *output_tensor_16 = static_cast<half *>(out_ptr);
-                    auto channel_size  = w * h;
-                    for(unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                        for(unsigned i = 0; i < channel_size; i++)
-                            output_tensor_16[dest_buf_offset+channel_idx*channel_size + i] =
-                                    offset[channel_idx] + multiplier[channel_idx]*(reverse_channels ? (half)(in_buffer[c*i+c-channel_idx-1]) : (half)(in_buffer[c*i+channel_idx]));
-                }
-
-            }
-            dest_buf_offset += single_output_image_size;
-        }
-    }
+        convert_output_tensor(_tensor_converter, _ring_buffer.get_read_buffers(), out_ptr, config);
     _convert_time.end();
     return Status::OK;
 }
@@ -606,6 +576,7 @@ MasterGraph::copy_output(unsigned char *out_ptr)
     if(no_more_processed_data())
         return MasterGraph::Status::NO_MORE_DATA;
 
+    ScopedCpuSet pin(_output_copy_cpu_set);
     _convert_time.start();
     // Copies to the output context given by the user
     size_t size = output_byte_size();
@@ -689,7 +660,7 @@ void MasterGraph::output_routine()
                 if (!_processing)
                     break;
 
-                auto this_cycle_names =  _loader_module->get_id();
+                auto& this_cycle_names =  _loader_module->get_id();
 
                 if(this_cycle_names.size() != _internal_batch_size)
                     WRN("Internal problem: names count "+ TOSTR(this_cycle_names.size()))
@@ -725,7 +696,7 @@ void MasterGraph::output_routine()
 
                 //process metadata, _augmented_meta_data contains the results after the call to process
                 if (_meta_data_graph)
-                    _meta_data_graph->process();
+                    _meta_data_graph->process(_augmented_meta_data);
 
                 // concatenating metadata using the this cycle's internal batch
                 if(_augmented_meta_data)
@@ -737,6 +708,10 @@ void MasterGraph::output_routine()
                 }
             }
 
+            // Converts the batch ahead of the user's request, so that the conversion overlaps with the user's compute
+            if(_output_tensor_config_set && !processing_on_device() && _processing)
+                convert_output_tensor(_prefetch_tensor_converter, write_buffers, _ring_buffer.get_host_tensor_write_buffer(), _output_tensor_config);
+
             _ring_buffer.set_meta_data(full_batch_image_names, full_batch_meta_data);
             _ring_buffer.push(); // Image data and metadata is now stored in output the ring_buffer, increases it's level by 1
 
@@ -755,6 +730,7 @@ void MasterGraph::start_processing()
     _processing = true;
     _remaining_images_count = _loader_module->remaining_count();
     _output_thread = std::thread(&MasterGraph::output_routine, this);
+    _augment_cpu_set.apply(_output_thread.native_handle());
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
 #else
 //  Changing thread scheduling policy and it's priority does not help on latest Ubuntu builds
@@ -798,6 +774,39 @@ MetaDataBatch * MasterGraph::create_coco_meta_data_reader(const char *source_pat
     return _meta_data_reader->get_output();
 }
 
+void MasterGraph::set_loader_options(const LoaderOptions& options)
+{
+    if(_loader_module)
+        THROW("Loader options should be set before the loader is created")
+    _loader_options = options;
+}
+
+void MasterGraph::set_cpu_set(PipelineStage stage, const CpuSet& cpu_set)
+{
+    switch(stage)
+    {
+        case PipelineStage::READ:
+        case PipelineStage::DECODE:
+            if(_loader_module)
+                THROW("Read and decode CPU sets should be set before the loader is created")
+            if(stage == PipelineStage::READ)
+                _loader_options.read_cpu_set = cpu_set;
+            else
+                _loader_options.decode_cpu_set = cpu_set;
+            break;
+        case PipelineStage::AUGMENT:
+            if(_processing)
+                THROW("Augmentation CPU set should be set before the processing starts")
+            _augment_cpu_set = cpu_set;
+            _prefetch_tensor_converter.set_cpu_set(cpu_set);
+            break;
+        case PipelineStage::OUTPUT_COPY:
+            _output_copy_cpu_set = cpu_set;
+            _tensor_converter.set_cpu_set(cpu_set);
+            break;
+    }
+}
+
 MetaDataBatch * MasterGraph::create_label_reader(const char *source_path, MetaDataReaderType reader_type)
 {
     if( _meta_data_reader)
@@ -828,6 +837,10 @@ MetaDataBatch * MasterGraph::create_cifar10_label_reader(const char *source_path
     return _meta_data_reader->get_output();
 }
 
+MetaDataBatch * MasterGraph::create_tf_record_meta_data_reader(const char *source_path)
+{
+    return create_label_reader(source_path, MetaDataReaderType::TF_META_DATA_READER);
+}
 
 const std::pair<ImageNameBatch,pMetaDataBatch>& MasterGraph::meta_data()
 {
@@ -836,7 +849,7 @@ const std::pair<ImageNameBatch,pMetaDataBatch>& MasterGraph::meta_data()
     return _ring_buffer.get_meta_data();
 }
 
-size_t MasterGraph::compute_optimum_internal_batch_size(size_t user_batch_size, RaliAffinity affinity)
+size_t MasterGraph::compute_optimum_internal_batch_size(size_t user_batch_size, RaliAffinity affinity, size_t cpu_threads)
 {
     const unsigned MINIMUM_CPU_THREAD_COUNT = 2;
     const unsigned DEFAULT_SMT_COUNT = 2;
@@ -845,13 +858,13 @@ size_t MasterGraph::compute_optimum_internal_batch_size(size_t user_batch_size,
     if(affinity == RaliAffinity::GPU)
         return user_batch_size;
     
-    unsigned THREAD_COUNT = std::thread::hardware_concurrency();
+    unsigned THREAD_COUNT = (cpu_threads >= MINIMUM_CPU_THREAD_COUNT) ? cpu_threads : CpuSet().cpu_count();
     if(THREAD_COUNT >= MINIMUM_CPU_THREAD_COUNT)
         INFO("Can run " + TOSTR(THREAD_COUNT) + " threads simultaneously on this machine")
     else
     {
         THREAD_COUNT = MINIMUM_CPU_THREAD_COUNT;
-        WRN("hardware_concurrency() call failed assuming can run " + TOSTR(THREAD_COUNT) + " threads")
+        WRN("Available CPU count detection failed assuming can run " + TOSTR(THREAD_COUNT) + " threads")
     }
     size_t ret = user_batch_size;
     size_t CORE_COUNT = THREAD_COUNT / DEFAULT_SMT_COUNT;
@@ -913,151 +926,84 @@ MasterGraph::copy_out_tensor_planar(void *out_ptr, RaliTensorFormat format, floa
 
     _convert_time.start();
     // Copies to the output context given by the user, each image is copied separate for planar
-    const size_t w = output_width();
-    const size_t h = _output_image_info.height_single();
-    const size_t c = output_depth();
-    const size_t n = _output_image_info.batch_size();
-
-    const size_t single_output_image_size = output_byte_size();
-
-
     if(_output_image_info.mem_type() == RaliMemType::OCL)
     {
         THROW("copy_out_tensor_planar for GPU affinity is not implemented")
     }
     if(_output_image_info.mem_type() == RaliMemType::HOST)
-    {
-        float multiplier[3] = {multiplier0, multiplier1, multiplier2 };
-        float offset[3] = {offset0, offset1, offset2 };
-        size_t dest_buf_offset = 0;
+        convert_output_tensor(_tensor_converter, _ring_buffer.get_read_buffers(), out_ptr,
+                              { format, output_data_type, { multiplier0, multiplier1, multiplier2 }, { offset0, offset1, offset2 }, reverse_channels });
+    _convert_time.end();
+    return Status::OK;
+}
 
-        auto output_buffers =_ring_buffer.get_read_buffers();
+void MasterGraph::set_output_tensor_config(const OutputTensorConfig& config)
+{
+    if(_processing)
+        THROW("Output tensor configuration should be set before the pipeline is built")
+    _output_tensor_config = config;
+    _output_tensor_config_set = true;
+}
 
+void* MasterGraph::output_tensor_buffer()
+{
+    if(!_output_tensor_config_set || processing_on_device())
+        THROW("Output tensor buffer is only available on host when an output tensor configuration is set")
+    if(no_more_processed_data())
+        return nullptr;
+    return _ring_buffer.get_host_tensor_read_buffer();
+}
+
+void MasterGraph::convert_output_tensor(TensorConverter& converter, const std::vector<void*>& output_buffers, void* out_ptr, const OutputTensorConfig& config)
+{
+    const size_t w = output_width();
+    const size_t h = output_height();
+    const size_t c = output_depth();
+    const size_t single_output_image_size = output_byte_size();
+    const size_t element_size = (config.data_type == RaliTensorDataType::FP16) ? sizeof(half) : sizeof(float);
+    const bool nchw = (config.format == RaliTensorFormat::NCHW);
+    std::vector<TensorConverter::Span> spans;
+    size_t dest_buf_offset = 0;
+    if(output_color_format() == RaliColorFormat::RGB_PLANAR)
+    {
+        // Each image of the batch is planar and copied separately
+        const size_t n = _output_image_info.batch_size();
+        const size_t channel_size = w * _output_image_info.height_single();
         for( auto&& out_image: output_buffers)
         {
             for (unsigned batch = 0; batch < n ; batch++) {
-                const size_t batch_offset = w*h*c*batch;
-                auto in_buffer = (unsigned char *) out_image + batch_offset;
-                if (format == RaliTensorFormat::NHWC) {
-                    if (output_data_type == RaliTensorDataType::FP32) {
-                        float *output_tensor_32 = static_cast<float *>(out_ptr) + batch_offset;
-                        auto channel_size = w * h;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_32[dest_buf_offset + channel_idx + i * c] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? (float) (in_buffer[i +
-                                                                                                     (c - channel_idx -
-                                                                                                      1) *
-                                                                                                     channel_size])
-                                                                                : (float) (in_buffer[i + channel_idx *
-                                                                                                         channel_size]));
-                    } else if (output_data_type == RaliTensorDataType::FP16) {
-                        half *output_tensor_16 = static_cast<half *>(out_ptr) + batch_offset;
-                        auto channel_size = w * h;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_16[dest_buf_offset + channel_idx + i * c] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? (half) (in_buffer[
-                                                                      (c - channel_idx - 1) * channel_size + i])
-                                                                                : (half) (in_buffer[
-                                                                              channel_idx * channel_size + i]));
-                    }
-                }
-                if (format == RaliTensorFormat::NCHW) {
-                    if (output_data_type == RaliTensorDataType::FP32) {
-                        float *output_tensor_32 = static_cast<float *>(out_ptr) + batch_offset;
-                        //output_tensor_32 += batch_offset;
-                        auto channel_size = w * h;
-                        if (c != 3) {
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? (float) (in_buffer[
-                                                                          (c - channel_idx - 1) * channel_size + i])
-                                                                                    : (float) (in_buffer[
-                                                                                  channel_idx * channel_size + i]));
-                        } else {
-#if (ENABLE_SIMD && __AVX2__)
-
-                            float *B_buf = output_tensor_32 + dest_buf_offset;
-                            float *G_buf = B_buf + channel_size;
-                            float *R_buf = G_buf + channel_size;
-                            unsigned char *in_buffer_R = in_buffer;
-                            unsigned char *in_buffer_G = in_buffer + channel_size;
-                            unsigned char *in_buffer_B = in_buffer_G + channel_size;
-
-                            __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                            __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                            __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                            __m256 padd0 = _mm256_set1_ps(offset0);
-                            __m256 padd1 = _mm256_set1_ps(offset1);
-                            __m256 padd2 = _mm256_set1_ps(offset2);
-                            unsigned int alignedLength = (channel_size & ~7);    // multiple of 8
-                            unsigned int i = 0;
-
-                            __m256 fR, fG, fB;
-                            for (; i < alignedLength; i += 8) {
-                                __m128i pixR, pixG, pixB;
-                                if (reverse_channels) {
-                                    pixB = _mm_loadl_epi64((const __m128i *) in_buffer_R);
-                                    pixG = _mm_loadl_epi64((const __m128i *) in_buffer_G);
-                                    pixR = _mm_loadl_epi64((const __m128i *) in_buffer_B);
-                                } else {
-                                    pixR = _mm_loadl_epi64((const __m128i *) in_buffer_R);
-                                    pixG = _mm_loadl_epi64((const __m128i *) in_buffer_G);
-                                    pixB = _mm_loadl_epi64((const __m128i *) in_buffer_B);
-                                }
-                                fB = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixR));
-                                fG = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixG));
-                                fR = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixB));
-                                fB = _mm256_mul_ps(fB, pmul0);
-                                fG = _mm256_mul_ps(fG, pmul1);
-                                fR = _mm256_mul_ps(fR, pmul2);
-                                fB = _mm256_add_ps(fB, padd0);
-                                fG = _mm256_add_ps(fG, padd1);
-                                fR = _mm256_add_ps(fR, padd2);
-                                _mm256_storeu_ps(B_buf, fB);
-                                _mm256_storeu_ps(G_buf, fG);
-                                _mm256_storeu_ps(R_buf, fR);
-                                B_buf += 8;
-                                G_buf += 8;
-                                R_buf += 8;
-                                in_buffer_R += 8, in_buffer_G += 8, in_buffer_B += 8;
-                            }
-                            for (; i < channel_size; i++) {
-                                *B_buf++ = (*in_buffer_R++ * multiplier0) + offset0;
-                                *G_buf++ = (*in_buffer_G++ * multiplier1) + offset1;
-                                *R_buf++ = (*in_buffer_B++ * multiplier2) + offset1;
-                            }
-
-#else
-                            for(unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                                for(unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset+channel_idx*channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx]*(reverse_channels ? (float)(in_buffer[i+(c-channel_idx-1)*channel_size]) : (float)(in_buffer[i+channel_idx*channel_size]));
-#endif
-                        }
-                    } else if (output_data_type == RaliTensorDataType::FP16) {
-                        half *output_tensor_16 = static_cast<half *>(out_ptr) + batch_offset;
-                        auto channel_size = w * h;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_16[dest_buf_offset + channel_idx * channel_size + i] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? (half) (in_buffer[i +
-                                                                                                    (c - channel_idx -
-                                                                                                     1) * channel_size])
-                                                                                : (half) (in_buffer[i + channel_idx *
-                                                                                                        channel_size]));
-                    }
-                }
+                const size_t batch_offset = channel_size*c*batch;
+                TensorConverter::Span span;
+                span.src = (unsigned char *) out_image + batch_offset;
+                span.src_plane_stride = channel_size;
+                span.dst = (unsigned char *) out_ptr + (dest_buf_offset + batch_offset) * element_size;
+                span.dst_plane_stride = nchw ? channel_size : 0;
+                span.pixel_count = channel_size;
+                spans.push_back(span);
             }
             dest_buf_offset += single_output_image_size;
         }
     }
-    _convert_time.end();
-    return Status::OK;
+    else
+    {
+        // Each augmentation branch is a w x h image holding all the samples stacked on top of each other, NCHW planes span the whole branch
+        const size_t sample_pixel_count = w * _output_image_info.height_single();
+        const size_t sample_count = h / _output_image_info.height_single();
+        for( auto&& out_image: output_buffers)
+        {
+            for(size_t sample = 0; sample < sample_count; sample++)
+            {
+                TensorConverter::Span span;
+                span.src = (unsigned char*)out_image + sample * sample_pixel_count * c;
+                span.src_plane_stride = 0;
+                size_t dst_offset = dest_buf_offset + sample * sample_pixel_count * (nchw ? 1 : c);
+                span.dst = (unsigned char*)out_ptr + dst_offset * element_size;
+                span.dst_plane_stride = nchw ? w * h : 0;
+                span.pixel_count = sample_pixel_count;
+                spans.push_back(span);
+            }
+            dest_buf_offset += single_output_image_size;
+        }
+    }
+    converter.convert(spans, c, config);
 }
@@ -0,0 +1,34 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "meta_node_crop.h"
+
+void CropMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    std::vector<uint32_t> x1, y1, crop_w, crop_h;
+    _node->get_crop_param()->get_crop_origin(x1, y1);
+    _node->get_crop_param()->get_crop_dimensions(crop_w, crop_h);
+    for(size_t i = 0; i < transforms.size(); i++)
+        transforms[i] = {1, 0, -(float)x1[i],
+                         0, 1, -(float)y1[i],
+                         (float)crop_w[i], (float)crop_h[i]};
+}
@@ -0,0 +1,41 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "meta_node_crop_resize.h"
+
+void CropResizeMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    auto crop_param = _node->get_crop_param();
+    float out_width = _node->output()[0]->info().width();
+    float out_height = _node->output()[0]->info().height_single();
+    for(size_t i = 0; i < transforms.size(); i++)
+    {
+        float x, y, crop_w, crop_h;
+        crop_param->get_crop_window(i, x, y, crop_w, crop_h);
+        float scale_x = out_width / std::max(crop_w, 1.0f);
+        float scale_y = out_height / std::max(crop_h, 1.0f);
+        transforms[i] = {scale_x, 0, -x * scale_x,
+                         0, scale_y, -y * scale_y,
+                         out_width, out_height};
+    }
+}
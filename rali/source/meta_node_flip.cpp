@@ -0,0 +1,40 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "meta_node_flip.h"
+#include "rali_api_types.h"
+
+void FlipMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    auto& flip_axis = _node->get_flip_axis();
+    auto& width = _node->input()[0]->info().get_roi_width_vec();
+    auto& height = _node->input()[0]->info().get_roi_height_vec();
+    for(size_t i = 0; i < transforms.size(); i++)
+    {
+        // Axis 2 flips the image both ways
+        bool horizontal = flip_axis[i] == RALI_FLIP_HORIZONTAL || flip_axis[i] == 2;
+        bool vertical = flip_axis[i] == RALI_FLIP_VERTICAL || flip_axis[i] == 2;
+        transforms[i] = {horizontal ? -1.0f : 1.0f, 0, horizontal ? (float)width[i] : 0.0f,
+                         0, vertical ? -1.0f : 1.0f, vertical ? (float)height[i] : 0.0f,
+                         (float)width[i], (float)height[i]};
+    }
+}
@@ -0,0 +1,40 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "meta_node_loader.h"
+
+void LoaderMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    auto& regions = _loader->get_decoded_region();
+    auto& roi_width = _output->info().get_roi_width_vec();
+    auto& roi_height = _output->info().get_roi_height_vec();
+    for(size_t i = 0; i < transforms.size(); i++)
+    {
+        // The region is scaled down by the decoder to fit the loader's image
+        float scale_x = (float)roi_width[i] / (float)std::max(regions[i].p2.x - regions[i].p1.x, 1u);
+        float scale_y = (float)roi_height[i] / (float)std::max(regions[i].p2.y - regions[i].p1.y, 1u);
+        transforms[i] = {scale_x, 0, -(float)regions[i].p1.x * scale_x,
+                         0, scale_y, -(float)regions[i].p1.y * scale_y,
+                         (float)roi_width[i], (float)roi_height[i]};
+    }
+}
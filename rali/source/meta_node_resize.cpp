@@ -0,0 +1,35 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "meta_node_resize.h"
+
+void ResizeMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    auto& in_width = _node->input()[0]->info().get_roi_width_vec();
+    auto& in_height = _node->input()[0]->info().get_roi_height_vec();
+    float out_width = _node->output()[0]->info().width();
+    float out_height = _node->output()[0]->info().height_single();
+    for(size_t i = 0; i < transforms.size(); i++)
+        transforms[i] = {out_width / in_width[i], 0, 0,
+                         0, out_height / in_height[i], 0,
+                         out_width, out_height};
+}
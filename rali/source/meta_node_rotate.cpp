@@ -0,0 +1,43 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <cmath>
+#include "meta_node_rotate.h"
+
+void RotateMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    auto& angle = _node->get_angle();
+    auto& in_width = _node->input()[0]->info().get_roi_width_vec();
+    auto& in_height = _node->input()[0]->info().get_roi_height_vec();
+    float out_width = _node->output()[0]->info().width();
+    float out_height = _node->output()[0]->info().height_single();
+    for(size_t i = 0; i < transforms.size(); i++)
+    {
+        // The image is rotated about its centre, which is moved to the centre of the output image
+        float radian = angle[i] * (float)M_PI / 180.0f;
+        float cos_a = std::cos(radian), sin_a = std::sin(radian);
+        float cx = in_width[i] / 2.0f, cy = in_height[i] / 2.0f;
+        transforms[i] = {cos_a, -sin_a, out_width / 2.0f - cos_a * cx + sin_a * cy,
+                         sin_a, cos_a, out_height / 2.0f - sin_a * cx - cos_a * cy,
+                         out_width, out_height};
+    }
+}
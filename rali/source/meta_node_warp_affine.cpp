@@ -0,0 +1,37 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "meta_node_warp_affine.h"
+
+void WarpAffineMetaNode::update_transforms(std::vector<BoxTransform>& transforms)
+{
+    auto& affine = _node->get_affine();
+    float out_width = _node->output()[0]->info().width();
+    float out_height = _node->output()[0]->info().height_single();
+    for(size_t i = 0; i < transforms.size(); i++)
+    {
+        const float* coeff = affine.data() + i * 6;// {x0, y0, x1, y1, o0, o1}
+        transforms[i] = {coeff[0], coeff[2], coeff[4],
+                         coeff[1], coeff[3], coeff[5],
+                         out_width, out_height};
+    }
+}
@@ -20,12 +20,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
 #include "node_image_loader.h"
 #include "exception.h"
 
 
-ImageLoaderNode::ImageLoaderNode(Image *output, DeviceResources device_resources):
-        Node({}, {output})
+ImageLoaderNode::ImageLoaderNode(Image *output, DeviceResources device_resources, LoaderOptions loader_options):
+        Node({}, {output}),
+        _loader_options(loader_options)
 {
     _loader_module = std::make_shared<ImageLoaderSharded>(device_resources);
 }
@@ -42,7 +44,17 @@ void ImageLoaderNode::init(unsigned internal_shard_count, const std::string &sou
     auto reader_cfg = ReaderConfig(storage_type, source_path, loop);
     reader_cfg.set_shard_count(internal_shard_count);
     reader_cfg.set_batch_count(load_batch_count);
-    _loader_module->initialize(reader_cfg, DecoderConfig(decoder_type),
+    reader_cfg.set_read_thread_count(_loader_options.read_thread_count);
+    reader_cfg.set_memory_mapped(_loader_options.memory_mapped_read);
+    reader_cfg.set_cpu_set(_loader_options.read_cpu_set);
+    // The decode workers are split between the internal shards, each runs its own pool
+    auto decoder_cfg = DecoderConfig(decoder_type);
+    size_t decode_thread_count = _loader_options.decode_thread_count ? _loader_options.decode_thread_count : _loader_options.decode_cpu_set.cpu_count();
+    decoder_cfg.set_thread_count(std::max((size_t)1, decode_thread_count / internal_shard_count));
+    decoder_cfg.set_cpu_set(_loader_options.decode_cpu_set);
+    // Each internal shard buffers whole batches, the shards share the loader's half of the prefetch memory budget
+    _loader_module->set_prefetch_depth(_loader_options.buffer_depth(_outputs[0]->info().data_size(), internal_shard_count));
+    _loader_module->initialize(reader_cfg, decoder_cfg,
              mem_type,
              _batch_size);
     _loader_module->start_loading();
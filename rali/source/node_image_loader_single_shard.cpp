@@ -24,8 +24,9 @@ THE SOFTWARE.
 #include "exception.h"
 
 
-ImageLoaderSingleShardNode::ImageLoaderSingleShardNode(Image *output, DeviceResources device_resources):
-        Node({}, {output})
+ImageLoaderSingleShardNode::ImageLoaderSingleShardNode(Image *output, DeviceResources device_resources, LoaderOptions loader_options):
+        Node({}, {output}),
+        _loader_options(loader_options)
 {
     _loader_module = std::make_shared<ImageLoader>(device_resources);
 }
@@ -47,7 +48,13 @@ ImageLoaderSingleShardNode::init(unsigned shard_id, unsigned shard_count, const
     reader_cfg.set_shard_count(shard_count);
     reader_cfg.set_shard_id(shard_id);
     reader_cfg.set_batch_count(load_batch_count);
-    _loader_module->initialize(reader_cfg, DecoderConfig(decoder_type),
+    reader_cfg.set_read_thread_count(_loader_options.read_thread_count);
+    reader_cfg.set_memory_mapped(_loader_options.memory_mapped_read);
+    reader_cfg.set_cpu_set(_loader_options.read_cpu_set);
+    auto decoder_cfg = DecoderConfig(decoder_type);
+    decoder_cfg.set_thread_count(_loader_options.decode_thread_count);
+    decoder_cfg.set_cpu_set(_loader_options.decode_cpu_set);
+    _loader_module->initialize(reader_cfg, decoder_cfg,
                                mem_type,
                                _batch_size);
     _loader_module->start_loading();
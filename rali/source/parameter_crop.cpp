@@ -65,6 +65,12 @@ void CropParam::get_crop_dimensions(std::vector<uint32_t> &crop_w_dim, std::vect
     crop_w_dim = cropw_arr_val;
 }
 
+void CropParam::get_crop_origin(std::vector<uint32_t> &x1_dim, std::vector<uint32_t> &y1_dim)
+{
+    x1_dim = x1_arr_val;
+    y1_dim = y1_arr_val;
+}
+
 void CropParam::create_array(std::shared_ptr<Graph> graph)
 {
     x1_arr_val.resize(batch_size);
@@ -75,6 +81,8 @@ void CropParam::create_array(std::shared_ptr<Graph> graph)
     y2_arr_val.resize(batch_size);
     in_width.resize(batch_size);
     in_height.resize(batch_size);
+    _crop_h_factors.resize(batch_size);
+    _crop_w_factors.resize(batch_size);
 
     x1_arr =    vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT32,batch_size);
     cropw_arr = vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT32,batch_size);
@@ -148,17 +156,16 @@ void CropParam::fill_values()
         }
         else
         {
+            auto position = ParameterFactory::sample_position();
+            crop_height_factor->generate(_crop_h_factors.data(), batch_size, position, _crop_height_stream);
+            crop_width_factor->generate(_crop_w_factors.data(), batch_size, position, _crop_width_stream);
             for (uint img_idx = 0; img_idx < batch_size; img_idx++)
                 {
                     // Left-Top Random Crop
-                    crop_height_factor->renew();
-                    float crop_h_factor_ = crop_height_factor->get();
-                    crop_width_factor->renew();
-                    float crop_w_factor_ = crop_width_factor->get();   
                     x1_arr_val[img_idx] =  0 ; 
                     y1_arr_val[img_idx] =  0;
-                    cropw_arr_val[img_idx] = static_cast<size_t> (crop_w_factor_ * in_width[img_idx]);
-                    croph_arr_val[img_idx] = static_cast<size_t> (crop_h_factor_ * in_height[img_idx]);
+                    cropw_arr_val[img_idx] = static_cast<size_t> (_crop_w_factors[img_idx] * in_width[img_idx]);
+                    croph_arr_val[img_idx] = static_cast<size_t> (_crop_h_factors[img_idx] * in_height[img_idx]);
                 }
         }
     for (uint img_idx = 0; img_idx < batch_size; img_idx++)
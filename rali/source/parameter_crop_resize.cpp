@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 
 #include <cmath>
+#include <algorithm>
 #include <VX/vx.h>
 #include <VX/vx_compatibility.h>
 #include <graph.h>
@@ -75,6 +76,10 @@ void RandomCropResizeParam::create_array(std::shared_ptr<Graph> graph)
     x2.resize(batch_size);
     y1.resize(batch_size);
     y2.resize(batch_size);
+    _area_values.resize(batch_size);
+    _aspect_ratio_values.resize(batch_size);
+    _x_drift_values.resize(batch_size);
+    _y_drift_values.resize(batch_size);
     x1_arr = vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT64,batch_size);
     y1_arr = vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT64,batch_size);
     x2_arr = vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT64,batch_size);
@@ -86,25 +91,66 @@ void RandomCropResizeParam::create_array(std::shared_ptr<Graph> graph)
     update_array();
 }
 
+void RandomCropResizeParam::crop_window(const SamplePosition& position, unsigned width, unsigned height, size_t& x, size_t& y, size_t& crop_width, size_t& crop_height)
+{
+    // No shared state is touched, the decoders of all the loader threads call it concurrently
+    float area, aspect_ratio, x_center, y_center;
+    area_coeff->generate(&area, 1, position, _area_stream);
+    aspect_ratio_coeff->generate(&aspect_ratio, 1, position, _aspect_ratio_stream);
+    x_center_drift->generate(&x_center, 1, position, _x_drift_stream);
+    y_center_drift->generate(&y_center, 1, position, _y_drift_stream);
+    size_t x_2, y_2;
+    calculate_area(width, height, area, x_center, y_center, aspect_ratio, x, y, x_2, y_2);
+    x = std::min(x, (size_t)width - 1);
+    y = std::min(y, (size_t)height - 1);
+    crop_width = std::max(std::min(x_2, (size_t)width), x + 1) - x;
+    crop_height = std::max(std::min(y_2, (size_t)height), y + 1) - y;
+}
+
+void RandomCropResizeParam::generate_coeffs()
+{
+    auto position = ParameterFactory::sample_position();
+    area_coeff->generate(_area_values.data(), batch_size, position, _area_stream);
+    aspect_ratio_coeff->generate(_aspect_ratio_values.data(), batch_size, position, _aspect_ratio_stream);
+    x_center_drift->generate(_x_drift_values.data(), batch_size, position, _x_drift_stream);
+    y_center_drift->generate(_y_drift_values.data(), batch_size, position, _y_drift_stream);
+}
+
+void RandomCropResizeParam::get_crop_window(unsigned image_idx, float& x, float& y, float& width, float& height) const
+{
+    if(_cropped_by_decoder)
+    {
+        x = y = 0;
+        width = in_width[image_idx];
+        height = in_height[image_idx];
+        return;
+    }
+    x = x1[image_idx];
+    y = y1[image_idx];
+    width = x2[image_idx] - x1[image_idx];
+    height = y2[image_idx] - y1[image_idx];
+}
+
 void RandomCropResizeParam::update_array()
 {
     vx_status status = VX_SUCCESS;
+    if(!_cropped_by_decoder)
+        generate_coeffs();
     for (uint img_idx = 0; img_idx < batch_size; img_idx++)
     {
-        area_coeff->renew();
-        float area = area_coeff->get();
-        aspect_ratio_coeff->renew();
-        float aspect_ratio_temp = aspect_ratio_coeff->get();
-        x_center_drift->renew();
-        float x_center = x_center_drift->get();
-        y_center_drift->renew();
-        y_center_drift->renew();
-        float y_center = y_center_drift->get();
-        // std::cerr<<"\n area :: "<<area<<"\t ::"<<aspect_ratio_temp<<"\t ::"<<x_center<<"\t ::"<<y_center<<"\n";
+        // The images are already cropped by the decoder, the whole input is resized
+        if(_cropped_by_decoder)
+        {
+            x1_arr_val[img_idx] = x1[img_idx];
+            y1_arr_val[img_idx] = y1[img_idx];
+            x2_arr_val[img_idx] = x2[img_idx];
+            y2_arr_val[img_idx] = y2[img_idx];
+            continue;
+        }
         calculate_area_cmn(img_idx,
-                           area,
-                           x_center,
-                           y_center, aspect_ratio_temp);
+                           _area_values[img_idx],
+                           _x_drift_values[img_idx],
+                           _y_drift_values[img_idx], _aspect_ratio_values[img_idx]);
         x1_arr_val[img_idx] = x1[img_idx];
         y1_arr_val[img_idx] = y1[img_idx];
         x2_arr_val[img_idx] = x2[img_idx];
@@ -128,21 +174,13 @@ void RandomCropResizeParam::update_array()
 void RandomCropResizeParam::update_array_for_cmn() // For crop mirro normalize
 {
     vx_status status = VX_SUCCESS;
+    generate_coeffs();
     for (uint img_idx = 0; img_idx < batch_size; img_idx++)
     {
-        area_coeff->renew();
-        aspect_ratio_coeff->renew();
-        float area = area_coeff->get();
-        float aspect_ratio_temp = aspect_ratio_coeff->get();
-        x_center_drift->renew();
-        float x_center = x_center_drift->get();
-        y_center_drift->renew();
-        y_center_drift->renew();
-        float y_center = y_center_drift->get();
         calculate_area_cmn(img_idx,
-                           area,
-                           x_center,
-                           y_center, aspect_ratio_temp);
+                           _area_values[img_idx],
+                           _x_drift_values[img_idx],
+                           _y_drift_values[img_idx], _aspect_ratio_values[img_idx]);
         x1_arr_val[img_idx] = x1[img_idx];
         y1_arr_val[img_idx] = y1[img_idx];
         x2_arr_val[img_idx] = x2[img_idx] - x1[img_idx] ;
@@ -164,6 +202,13 @@ void RandomCropResizeParam::update_array_for_cmn() // For crop mirro normalize
 }
 
 void RandomCropResizeParam::calculate_area_cmn(unsigned image_idx, float area_coeff_, float x_center_drift_, float y_center_drift_, float aspect_ratio_)
+{
+    calculate_area(in_width[image_idx], in_height[image_idx], area_coeff_, x_center_drift_, y_center_drift_, aspect_ratio_,
+                   x1[image_idx], y1[image_idx], x2[image_idx], y2[image_idx]);
+}
+
+void RandomCropResizeParam::calculate_area(unsigned width, unsigned height, float area_coeff_, float x_center_drift_, float y_center_drift_, float aspect_ratio_,
+                                           size_t& x1, size_t& y1, size_t& x2, size_t& y2)
 {
 
 // +-----------------------------------------> X direction
@@ -188,27 +233,27 @@ void RandomCropResizeParam::calculate_area_cmn(unsigned image_idx, float area_co
         return arg;
     };
 
-    auto y_center = in_height[image_idx] / 2;
-    auto x_center = in_width[image_idx] / 2;
+    auto y_center = height / 2;
+    auto x_center = width / 2;
 
 
     auto temp_aspect_ratio = aspect_ratio_;
 
     float length_coeff = std::sqrt(bound(area_coeff_, RandomCropResizeParam::MIN_RANDOM_AREA_COEFF, 1.0));
     
-    auto cropped_width = (size_t)(length_coeff  * (float)in_width[image_idx] );
+    auto cropped_width = (size_t)(length_coeff  * (float)width );
     auto cropped_height = (size_t)(cropped_width / temp_aspect_ratio) ;
 
     // This will adjust to the input aspect ratio if crops are going out of bound - aspect ration will be relaxed
-    if (cropped_width > in_width[image_idx] || cropped_height > in_height[image_idx])
+    if (cropped_width > width || cropped_height > height)
     {
-        temp_aspect_ratio = ((float)in_width[image_idx]  / in_height[image_idx] );
-        cropped_width = (size_t)(length_coeff  * (float)in_width[image_idx] );
+        temp_aspect_ratio = ((float)width  / height );
+        cropped_width = (size_t)(length_coeff  * (float)width );
         cropped_height = (size_t)( (float)(cropped_width) / temp_aspect_ratio) ; 
     }
 
-    size_t y_max_drift = (in_height[image_idx] - cropped_height) / 2;
-    size_t x_max_drift = (in_width[image_idx] - cropped_width ) / 2;
+    size_t y_max_drift = (height - cropped_height) / 2;
+    size_t x_max_drift = (width - cropped_width ) / 2;
 
 
     size_t no_drift_y1 = y_center - cropped_height/2;
@@ -219,22 +264,22 @@ void RandomCropResizeParam::calculate_area_cmn(unsigned image_idx, float area_co
     float y_drift_coeff = bound(y_center_drift_, -1.0, 1.0);// in [-1 1] range
 
 
-    x1[image_idx] = (size_t)((float)no_drift_x1 + x_drift_coeff * (float)x_max_drift);
-    y1[image_idx] = (size_t)((float)no_drift_y1 + y_drift_coeff * (float)y_max_drift);
+    x1 = (size_t)((float)no_drift_x1 + x_drift_coeff * (float)x_max_drift);
+    y1 = (size_t)((float)no_drift_y1 + y_drift_coeff * (float)y_max_drift);
 
-    x1[image_idx] = x_center - cropped_width/2; // ROI centric
-    y1[image_idx] = y_center - cropped_height/2; // ROI centric
+    x1 = x_center - cropped_width/2; // ROI centric
+    y1 = y_center - cropped_height/2; // ROI centric
    
 
-    x2[image_idx] = x1[image_idx] + cropped_width ;
-    y2[image_idx] = y1[image_idx] + cropped_height ;
+    x2 = x1 + cropped_width ;
+    y2 = y1 + cropped_height ;
     
     auto check_bound = [](int arg, int min , int max)
     {
         return arg < min || arg > max;
     };
 
-    if(check_bound(x1[image_idx], 0, in_width[image_idx]) || check_bound(x2[image_idx], 0, in_width[image_idx]) || check_bound(y1[image_idx], 0, in_height[image_idx]) || check_bound(y2[image_idx], 0, in_height[image_idx]))
+    if(check_bound(x1, 0, width) || check_bound(x2, 0, width) || check_bound(y1, 0, height) || check_bound(y2, 0, height))
         // TODO: proper action required here
         WRN("Wrong crop area calculation")
 }
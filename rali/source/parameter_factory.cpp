@@ -24,8 +24,11 @@ THE SOFTWARE.
 #include <ctime>
 #include "parameter_factory.h"
 #include "parameter_simple.h"
+#include "commons.h"
 ParameterFactory* ParameterFactory::_instance = nullptr;
 std::mutex ParameterFactory::_mutex;
+thread_local SamplePosition ParameterFactory::_sample_position;
+thread_local ParameterFactory::NodeStreams ParameterFactory::_node_streams;
 
 bool validate_simple_rand_param(pParam arg)
 {
@@ -73,6 +76,7 @@ bool validate_uniform_rand_param(pParam  rand_obj)
 ParameterFactory::ParameterFactory()
 {
     _seed = 0;
+    _stream_count = 0;
 }
 
 ParameterFactory* ParameterFactory::instance() {
@@ -121,9 +125,43 @@ ParameterFactory::set_seed(unsigned seed)
     _seed = seed;
 }
 
+unsigned
+ParameterFactory::create_stream()
+{
+    if(!_node_streams.active)
+        return _stream_count++ & ~NODE_STREAM_FLAG;
+    if(_node_streams.count == (1u << NODE_STREAM_BITS) || _node_streams.node_index >= (NODE_STREAM_FLAG >> NODE_STREAM_BITS))
+        THROW("Too many random streams for node " + TOSTR(_node_streams.node_index))
+    return NODE_STREAM_FLAG | (_node_streams.node_index << NODE_STREAM_BITS) | _node_streams.count++;
+}
+
+void
+ParameterFactory::begin_node_streams(unsigned node_index)
+{
+    _node_streams = { true, node_index, 0 };
+}
+
+void
+ParameterFactory::end_node_streams()
+{
+    _node_streams = NodeStreams();
+}
+
+void
+ParameterFactory::set_sample_position(const SamplePosition& position)
+{
+    _sample_position = position;
+}
+
+SamplePosition
+ParameterFactory::sample_position()
+{
+    return _sample_position;
+}
+
 IntParam* ParameterFactory::create_uniform_int_rand_param(int start, int end)
 {
-    auto gen = new UniformRand<int>(start, end, _seed);
+    auto gen = new UniformRand<int>(start, end, _seed, create_stream());
     auto ret = new IntParam(gen, RaliParameterType::RANDOM_UNIFORM);
     _parameters.insert(gen);
     return ret;
@@ -131,7 +169,7 @@ IntParam* ParameterFactory::create_uniform_int_rand_param(int start, int end)
 
 FloatParam* ParameterFactory::create_uniform_float_rand_param(float start, float end)
 {
-    auto gen = new UniformRand<float>(start, end, _seed);
+    auto gen = new UniformRand<float>(start, end, _seed, create_stream());
     auto ret = new FloatParam(gen, RaliParameterType::RANDOM_UNIFORM);
     _parameters.insert(gen);
     return ret;
@@ -140,7 +178,7 @@ FloatParam* ParameterFactory::create_uniform_float_rand_param(float start, float
 
 IntParam* ParameterFactory::create_custom_int_rand_param(const int *value, const double *frequencies, size_t size)
 {
-    auto gen = new CustomRand<int>(value, frequencies, size, _seed);
+    auto gen = new CustomRand<int>(value, frequencies, size, _seed, create_stream());
     auto ret = new IntParam(gen, RaliParameterType::RANDOM_CUSTOM);
     _parameters.insert(gen);
     return ret;
@@ -148,7 +186,7 @@ IntParam* ParameterFactory::create_custom_int_rand_param(const int *value, const
 
 FloatParam* ParameterFactory::create_custom_float_rand_param(const float *value, const double *frequencies, size_t size)
 {
-    auto gen = new CustomRand<float>(value, frequencies, size, _seed);
+    auto gen = new CustomRand<float>(value, frequencies, size, _seed, create_stream());
     auto ret = new FloatParam(gen, RaliParameterType::RANDOM_CUSTOM);
     _parameters.insert(gen);
     return ret;
@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "philox.h"
+
+#if ENABLE_SIMD
+#if _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+namespace
+{
+constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;//!< Weyl sequence increments of the key, golden ratio
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;//!< sqrt(3) - 1
+constexpr unsigned PHILOX_ROUNDS = 10;
+
+#if (ENABLE_SIMD && __AVX2__)
+constexpr size_t SIMD_BLOCKS = 8;
+
+// Full 32x32 -> 64 bit products of the eight lanes of a, the mul_epu32 only multiplies the even lanes so the odd lanes
+// are shifted down and multiplied separately, then the low and high halves are regrouped per lane
+inline void mulhilo(__m256i a, __m256i m, __m256i& lo, __m256i& hi)
+{
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+// Generates the blocks first_block to first_block+7, out receives their words in the sequence order
+void blocks_simd(uint32_t* out, uint64_t first_block, std::array<uint32_t, 2> counter_hi, Philox4x32::Key key)
+{
+    alignas(32) uint32_t lo_words[SIMD_BLOCKS], hi_words[SIMD_BLOCKS];
+    for(size_t i = 0; i < SIMD_BLOCKS; i++)
+    {
+        lo_words[i] = static_cast<uint32_t>(first_block + i);
+        hi_words[i] = static_cast<uint32_t>((first_block + i) >> 32);
+    }
+    __m256i c0 = _mm256_load_si256((const __m256i*)lo_words);
+    __m256i c1 = _mm256_load_si256((const __m256i*)hi_words);
+    __m256i c2 = _mm256_set1_epi32(counter_hi[0]);
+    __m256i c3 = _mm256_set1_epi32(counter_hi[1]);
+    const __m256i m0 = _mm256_set1_epi32(PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi32(PHILOX_M1);
+    uint32_t k0 = key[0], k1 = key[1];
+    for(unsigned round = 0; round < PHILOX_ROUNDS; round++)
+    {
+        __m256i lo0, hi0, lo1, hi1;
+        mulhilo(c0, m0, lo0, hi0);
+        mulhilo(c2, m1, lo1, hi1);
+        c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(k0));
+        c1 = lo1;
+        c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(k1));
+        c3 = lo0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    // Transposes the four words of the eight blocks to the sequence order
+    __m256i t0 = _mm256_unpacklo_epi32(c0, c1);// b0w0 b0w1 b1w0 b1w1 | b4w0 b4w1 b5w0 b5w1
+    __m256i t1 = _mm256_unpackhi_epi32(c0, c1);// b2w0 b2w1 b3w0 b3w1 | b6 b7
+    __m256i t2 = _mm256_unpacklo_epi32(c2, c3);// b0w2 b0w3 b1w2 b1w3 | b4 b5
+    __m256i t3 = _mm256_unpackhi_epi32(c2, c3);// b2w2 b2w3 b3w2 b3w3 | b6 b7
+    __m256i b01 = _mm256_unpacklo_epi64(t0, t2);// b0 | b4
+    __m256i b11 = _mm256_unpackhi_epi64(t0, t2);// b1 | b5
+    __m256i b23 = _mm256_unpacklo_epi64(t1, t3);// b2 | b6
+    __m256i b33 = _mm256_unpackhi_epi64(t1, t3);// b3 | b7
+    _mm256_storeu_si256((__m256i*)(out +  0), _mm256_permute2x128_si256(b01, b11, 0x20));// b0 b1
+    _mm256_storeu_si256((__m256i*)(out +  8), _mm256_permute2x128_si256(b23, b33, 0x20));// b2 b3
+    _mm256_storeu_si256((__m256i*)(out + 16), _mm256_permute2x128_si256(b01, b11, 0x31));// b4 b5
+    _mm256_storeu_si256((__m256i*)(out + 24), _mm256_permute2x128_si256(b23, b33, 0x31));// b6 b7
+}
+#endif
+}
+
+Philox4x32::Counter
+Philox4x32::block(Counter counter, Key key)
+{
+    for(unsigned round = 0; round < PHILOX_ROUNDS; round++)
+    {
+        uint64_t product0 = (uint64_t)PHILOX_M0 * counter[0];
+        uint64_t product1 = (uint64_t)PHILOX_M1 * counter[2];
+        counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                   static_cast<uint32_t>(product1),
+                   static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                   static_cast<uint32_t>(product0)};
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+    return counter;
+}
+
+void
+Philox4x32::fill(uint32_t* out, size_t count, uint64_t first, std::array<uint32_t, 2> counter_hi, Key key)
+{
+    uint64_t block_idx = first / WORDS_PER_BLOCK;
+    size_t skip = first % WORDS_PER_BLOCK;// Words of the first block that precede the requested range
+#if (ENABLE_SIMD && __AVX2__)
+    // Whole groups of eight blocks are written in place, the misaligned head and the tail go through a local buffer
+    uint32_t words[SIMD_BLOCKS * WORDS_PER_BLOCK];
+    while(count > 0)
+    {
+        if(skip == 0 && count >= SIMD_BLOCKS * WORDS_PER_BLOCK)
+        {
+            blocks_simd(out, block_idx, counter_hi, key);
+            out += SIMD_BLOCKS * WORDS_PER_BLOCK;
+            count -= SIMD_BLOCKS * WORDS_PER_BLOCK;
+        }
+        else
+        {
+            blocks_simd(words, block_idx, counter_hi, key);
+            size_t n = std::min(count, SIMD_BLOCKS * WORDS_PER_BLOCK - skip);
+            std::copy_n(words + skip, n, out);
+            out += n;
+            count -= n;
+            skip = 0;
+        }
+        block_idx += SIMD_BLOCKS;
+    }
+#else
+    while(count > 0)
+    {
+        auto words = block({static_cast<uint32_t>(block_idx), static_cast<uint32_t>(block_idx >> 32), counter_hi[0], counter_hi[1]}, key);
+        size_t n = std::min(count, WORDS_PER_BLOCK - skip);
+        std::copy_n(words.begin() + skip, n, out);
+        out += n;
+        count -= n;
+        skip = 0;
+        block_idx++;
+    }
+#endif
+}
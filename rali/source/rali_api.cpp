@@ -66,6 +66,114 @@ raliCreate(
     return context;
 }
 
+RaliStatus RALI_API_CALL
+raliSetContextAttribute(RaliContext p_context, RaliContextAttribute attribute, size_t value)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        auto options = context->master_graph->loader_options();
+        switch(attribute)
+        {
+            case RALI_READ_THREAD_COUNT:
+                if(value < 1)
+                    THROW("Read thread count should be greater than or equal to one")
+                options.read_thread_count = value;
+                break;
+            case RALI_MEMORY_MAPPED_READ:
+                options.memory_mapped_read = (value != 0);
+                break;
+            case RALI_CROP_ON_DECODE:
+                options.crop_on_decode = (value != 0);
+                break;
+            case RALI_DECODE_THREAD_COUNT:
+                options.decode_thread_count = value;
+                break;
+            case RALI_PREFETCH_DEPTH:
+                if(value == 1)
+                    THROW("Prefetch depth should be 0 (automatic) or greater than one")
+                options.prefetch_depth = value;
+                break;
+            case RALI_PREFETCH_MEMORY_BUDGET:
+                if(value < 1)
+                    THROW("Prefetch memory budget should be at least 1 MB")
+                options.prefetch_memory_budget = value << 20;
+                break;
+            default:
+                THROW("Unknown context attribute " + TOSTR(attribute))
+        }
+        context->master_graph->set_loader_options(options);
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_INVALID_PARAMETER_TYPE;
+    }
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliSetStageCpuSet(RaliContext p_context, RaliPipelineStage stage, const unsigned* cpus, size_t cpu_count)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        if(cpu_count > 0 && !cpus)
+            THROW("Null CPU list passed for a non-empty CPU set")
+        CpuSet cpu_set(std::vector<unsigned>(cpus, cpus + cpu_count));
+        switch(stage)
+        {
+            case RALI_STAGE_READ:
+                context->master_graph->set_cpu_set(PipelineStage::READ, cpu_set);
+                break;
+            case RALI_STAGE_DECODE:
+                context->master_graph->set_cpu_set(PipelineStage::DECODE, cpu_set);
+                break;
+            case RALI_STAGE_AUGMENT:
+                context->master_graph->set_cpu_set(PipelineStage::AUGMENT, cpu_set);
+                break;
+            case RALI_STAGE_OUTPUT_COPY:
+                context->master_graph->set_cpu_set(PipelineStage::OUTPUT_COPY, cpu_set);
+                break;
+            default:
+                THROW("Unknown pipeline stage " + TOSTR(stage))
+        }
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_INVALID_PARAMETER_TYPE;
+    }
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliSetOutputTensorConfig(RaliContext p_context, RaliTensorLayout tensor_format, RaliTensorOutputType tensor_data_type,
+                          float multiplier0, float multiplier1, float multiplier2,
+                          float offset0, float offset1, float offset2, bool reverse_channels)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        OutputTensorConfig config;
+        config.format = (tensor_format == RALI_NHWC) ? RaliTensorFormat::NHWC : RaliTensorFormat::NCHW;
+        config.data_type = (tensor_data_type == RALI_FP16) ? RaliTensorDataType::FP16 : RaliTensorDataType::FP32;
+        config.multiplier[0] = multiplier0, config.multiplier[1] = multiplier1, config.multiplier[2] = multiplier2;
+        config.offset[0] = offset0, config.offset[1] = offset1, config.offset[2] = offset2;
+        config.reverse_channels = reverse_channels;
+        context->master_graph->set_output_tensor_config(config);
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_INVALID_PARAMETER_TYPE;
+    }
+    return RALI_OK;
+}
+
 RaliStatus RALI_API_CALL
 raliRun(RaliContext p_context)
 {
@@ -69,6 +69,22 @@ raliCopyToOutputTensor16(RaliContext p_context, half *out_ptr, RaliTensorLayout
     return RALI_OK;
 }
 
+void* RALI_API_CALL
+raliGetOutputTensorBuffer(RaliContext p_context)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        return context->master_graph->output_tensor_buffer();
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+    }
+    return nullptr;
+}
+
 RaliStatus RALI_API_CALL
 raliCopyToOutput(
         RaliContext p_context,
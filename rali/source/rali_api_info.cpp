@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
 #include "commons.h"
 #include "context.h"
 #include "rali_api.h"
@@ -118,7 +119,34 @@ RALI_API_CALL raliGetTimingInfo(RaliContext p_context)
 {
     auto context = static_cast<Context*>(p_context);
     auto info = context->timing();
-    return {info.image_read_time, info.image_decode_time, info.image_process_time, info.copy_to_output};
+    return {info.image_read_time, info.image_decode_time, info.image_process_time, info.copy_to_output, info.image_read_wait_time};
+}
+
+size_t
+RALI_API_CALL raliGetDecoderUtilization(RaliContext p_context, float* utilization, size_t count)
+{
+    auto context = static_cast<Context*>(p_context);
+    auto info = context->timing();
+    if(utilization)
+        for(size_t i = 0; i < std::min(count, info.decoder_utilization.size()); i++)
+            utilization[i] = info.decoder_utilization[i];
+    return info.decoder_utilization.size();
+}
+
+RaliBufferOccupancy
+RALI_API_CALL raliGetLoaderBufferOccupancy(RaliContext p_context)
+{
+    auto context = static_cast<Context*>(p_context);
+    auto info = context->timing().loader_buffer;
+    return {info.depth, info.batch_count, info.producer_block_count, info.consumer_block_count};
+}
+
+RaliBufferOccupancy
+RALI_API_CALL raliGetOutputBufferOccupancy(RaliContext p_context)
+{
+    auto context = static_cast<Context*>(p_context);
+    auto info = context->timing().output_buffer;
+    return {info.depth, info.batch_count, info.producer_block_count, info.consumer_block_count};
 }
 
 size_t RALI_API_CALL raliIsEmpty(RaliContext p_context)
@@ -59,6 +59,15 @@ RALI_API_CALL raliCreateTextFileBasedLabelReader(RaliContext p_context, const ch
 
 }
 
+RaliMetaData
+RALI_API_CALL raliCreateTFReader(RaliContext p_context, const char* source_path) {
+    auto context = static_cast<Context*>(p_context);
+    if (!context)
+        THROW("Invalid rali context passed to raliCreateTFReader")
+
+    return context->master_graph->create_tf_record_meta_data_reader(source_path);
+
+}
 
 void
 RALI_API_CALL raliGetImageName(RaliContext p_context,  char* buf, unsigned image_idx)
@@ -20,13 +20,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <cstring>
 #include <device_manager.h>
 #include "ring_buffer.h"
 
-RingBuffer::RingBuffer(unsigned buffer_depth):
-        BUFF_DEPTH(buffer_depth),
-        _dev_sub_buffer(buffer_depth),
-        _host_master_buffers(BUFF_DEPTH)
+RingBuffer::RingBuffer()
 {
     reset();
 }
@@ -37,6 +35,7 @@ void RingBuffer::block_if_empty()
     { // if the current read buffer is being written wait on it
         if(_dont_block)
             return;
+        _occupancy.consumer_block_count++;
         _wait_for_load.wait(lock);
     }
 }
@@ -49,9 +48,16 @@ void RingBuffer:: block_if_full()
     {
         if(_dont_block)
             return;
+        _occupancy.producer_block_count++;
         _wait_for_unload.wait(lock);
     }
 }
+
+BufferOccupancy RingBuffer::occupancy()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    return _occupancy;
+}
 std::vector<void*> RingBuffer::get_read_buffers()
 {
     block_if_empty();
@@ -69,6 +75,24 @@ void *RingBuffer::get_host_master_read_buffer() {
     return _host_master_buffers[_read_ptr];
 }
 
+void *RingBuffer::get_host_tensor_read_buffer()
+{
+    block_if_empty();
+    if(_host_tensor_buffers.empty())
+        return nullptr;
+
+    return _host_tensor_buffers[_read_ptr];
+}
+
+void *RingBuffer::get_host_tensor_write_buffer()
+{
+    // Called by the writer after get_write_buffers(), the write spot is already free
+    if(_host_tensor_buffers.empty())
+        return nullptr;
+
+    return _host_tensor_buffers[_write_ptr];
+}
+
 
 std::vector<void*> RingBuffer::get_write_buffers()
 {
@@ -97,14 +121,19 @@ void RingBuffer::unblock_writer()
     // Wake up the writer thread in case it's waiting for an unload
     _wait_for_unload.notify_all();
 }
-void RingBuffer::init(RaliMemType mem_type, DeviceResources dev, unsigned sub_buffer_size, unsigned sub_buffer_count)
+void RingBuffer::init(RaliMemType mem_type, DeviceResources dev, unsigned sub_buffer_size, unsigned sub_buffer_count, unsigned buffer_depth,
+                      const CpuSet& cpu_set, size_t tensor_buffer_size)
 {
     _mem_type = mem_type;
     _dev = dev;
     _sub_buffer_size = sub_buffer_size;
     _sub_buffer_count = sub_buffer_count;
-    if(BUFF_DEPTH < 2)
+    if(buffer_depth < 2)
         THROW ("Error internal buffer size for the ring buffer should be greater than one")
+    BUFF_DEPTH = buffer_depth;
+    _occupancy.depth = BUFF_DEPTH;
+    _dev_sub_buffer.resize(BUFF_DEPTH);
+    _host_master_buffers.resize(BUFF_DEPTH);
 
     // Allocating buffers
     if(mem_type== RaliMemType::OCL)
@@ -147,6 +176,21 @@ void RingBuffer::init(RaliMemType mem_type, DeviceResources dev, unsigned sub_bu
             for(size_t sub_buff_idx = 0; sub_buff_idx < _sub_buffer_count; sub_buff_idx++)
                 _host_sub_buffers[buffIdx][sub_buff_idx] = (unsigned char*)_host_master_buffers[buffIdx] + _sub_buffer_size * sub_buff_idx;
         }
+        _tensor_buffer_size = tensor_buffer_size;
+        if(_tensor_buffer_size)
+        {
+            _host_tensor_buffers.resize(BUFF_DEPTH);
+            for(size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++)
+                _host_tensor_buffers[buffIdx] = aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_tensor_buffer_size / MEM_ALIGNMENT + 1));
+        }
+        if(!cpu_set.empty())
+            cpu_set.run_on([this]
+            {
+                for(auto buffer: _host_master_buffers)
+                    memset(buffer, 0, _sub_buffer_size * _sub_buffer_count);
+                for(auto buffer: _host_tensor_buffers)
+                    memset(buffer, 0, _tensor_buffer_size);
+            });
     }
 }
 void RingBuffer::push()
@@ -179,6 +223,10 @@ void RingBuffer::reset()
 
 RingBuffer::~RingBuffer()
 {
+    for(auto buffer: _host_tensor_buffers)
+        free(buffer);
+    _host_tensor_buffers.clear();
+
     if(_mem_type!= RaliMemType::OCL)
         return;
 
@@ -229,6 +277,7 @@ void RingBuffer::increment_write_ptr()
     std::unique_lock<std::mutex> lock(_lock);
     _write_ptr = (_write_ptr+1)%BUFF_DEPTH;
     _level++;
+    _occupancy.batch_count++;
     lock.unlock();
     // Wake up the reader thread (in case waiting) since there is a new load to be read
     _wait_for_load.notify_all();
@@ -0,0 +1,385 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <algorithm>
+#include <half.hpp>
+#include "tensor_converter.h"
+
+#if ENABLE_SIMD
+#if _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+using half_float::half;
+
+namespace
+{
+struct Conversion
+{
+    size_t channels;
+    float multiplier[3];
+    float offset[3];
+    bool reverse_channels;
+};
+
+template<typename T>
+void convert_span_scalar(const TensorConverter::Span& span, const Conversion& conversion)
+{
+    const size_t c = conversion.channels;
+    T* dst = static_cast<T*>(span.dst);
+    for(size_t i = 0; i < span.pixel_count; i++)
+        for(size_t channel_idx = 0; channel_idx < c; channel_idx++)
+        {
+            size_t src_channel_idx = conversion.reverse_channels ? c - channel_idx - 1 : channel_idx;
+            unsigned char pixel = span.src_plane_stride ? span.src[src_channel_idx*span.src_plane_stride + i] : span.src[i*c + src_channel_idx];
+            T value = (T)(conversion.offset[channel_idx] + conversion.multiplier[channel_idx]*(float)pixel);
+            if(span.dst_plane_stride)
+                dst[channel_idx*span.dst_plane_stride + i] = value;
+            else
+                dst[i*c + channel_idx] = value;
+        }
+}
+
+#if (ENABLE_SIMD && __AVX2__)
+inline void store8(float* dst, __m256 values)
+{
+    _mm256_storeu_ps(dst, values);
+}
+
+inline void store8(half* dst, __m256 values)
+{
+#if __F16C__
+    _mm_storeu_si128((__m128i *) dst, _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+#else
+    float buffer[8];
+    _mm256_storeu_ps(buffer, values);
+    for(unsigned i = 0; i < 8; i++)
+        dst[i] = (half)buffer[i];
+#endif
+}
+
+inline __m256 u8_to_ps(__m128i pixels)
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixels));
+}
+
+/*! \brief Converts blocks of 8 pixels of 1 or 3 channel images
+ *
+ * Each block is first rearranged into 3 groups of 8 bytes in the destination order, channel planes for NCHW and
+ * interleaved bytes for NHWC, then converted to float and scaled 8 values at a time. Channel reversal is folded
+ * into the byte shuffles, or into the order the source planes are read in.
+ */
+class BlockConverter
+{
+public:
+    explicit BlockConverter(const Conversion& conversion);
+    template<typename T>
+    void convert(const unsigned char* src, size_t src_plane_stride, T* dst, size_t dst_plane_stride) const;
+private:
+    static __m128i shuffle_control(const int (&index)[8]);
+    const size_t _channels;
+    const bool _reverse;
+    __m128i _interleaved_to_plane[3][2];//!< Per destination channel, from the source bytes at 0 and at 8
+    __m128i _planar_to_interleaved[3][2];//!< Per group of destination bytes, from the first two planes and from the third
+    __m128i _interleaved_to_interleaved[3];//!< Per group of destination bytes, from the source bytes at INTERLEAVED_GROUP_BASE
+    __m256 _plane_multiplier[3], _plane_offset[3];
+    __m256 _interleaved_multiplier[3], _interleaved_offset[3];
+    constexpr static size_t INTERLEAVED_GROUP_BASE[3] = { 0, 6, 8 };//!< The 16 bytes read from there hold the 8 bytes of a group, reversed or not
+};
+
+constexpr size_t BlockConverter::INTERLEAVED_GROUP_BASE[3];
+
+__m128i BlockConverter::shuffle_control(const int (&index)[8])
+{
+    alignas(16) char control[16];
+    memset(control, 0x80, sizeof(control));
+    for(unsigned i = 0; i < 8; i++)
+        if(index[i] >= 0)
+            control[i] = (char)index[i];
+    return _mm_load_si128((const __m128i *) control);
+}
+
+BlockConverter::BlockConverter(const Conversion& conversion):
+        _channels(conversion.channels),
+        _reverse(conversion.reverse_channels)
+{
+    for(unsigned channel_idx = 0; channel_idx < 3; channel_idx++)
+    {
+        unsigned src_channel_idx = _reverse ? 2 - channel_idx : channel_idx;
+        int low[8], high[8];
+        for(unsigned p = 0; p < 8; p++)
+        {
+            int byte = 3*p + src_channel_idx;
+            low[p] = (byte < 16) ? byte : -1;
+            high[p] = (byte < 16) ? -1 : byte - 8;
+        }
+        _interleaved_to_plane[channel_idx][0] = shuffle_control(low);
+        _interleaved_to_plane[channel_idx][1] = shuffle_control(high);
+        _plane_multiplier[channel_idx] = _mm256_set1_ps(conversion.multiplier[channel_idx]);
+        _plane_offset[channel_idx] = _mm256_set1_ps(conversion.offset[channel_idx]);
+    }
+    for(unsigned group = 0; group < 3; group++)
+    {
+        int first_planes[8], last_plane[8], interleaved[8];
+        float multiplier[8], offset[8];
+        for(unsigned i = 0; i < 8; i++)
+        {
+            unsigned byte = 8*group + i, p = byte / 3, channel_idx = byte % 3;
+            unsigned src_byte = _reverse ? 3*p + 2 - channel_idx : byte;
+            first_planes[i] = (channel_idx < 2) ? p + 8*channel_idx : -1;
+            last_plane[i] = (channel_idx < 2) ? -1 : p;
+            interleaved[i] = src_byte - INTERLEAVED_GROUP_BASE[group];
+            multiplier[i] = conversion.multiplier[channel_idx];
+            offset[i] = conversion.offset[channel_idx];
+        }
+        _planar_to_interleaved[group][0] = shuffle_control(first_planes);
+        _planar_to_interleaved[group][1] = shuffle_control(last_plane);
+        _interleaved_to_interleaved[group] = shuffle_control(interleaved);
+        _interleaved_multiplier[group] = _mm256_loadu_ps(multiplier);
+        _interleaved_offset[group] = _mm256_loadu_ps(offset);
+    }
+}
+
+template<typename T>
+void BlockConverter::convert(const unsigned char* src, size_t src_plane_stride, T* dst, size_t dst_plane_stride) const
+{
+    if(_channels == 1)
+    {
+        __m256 values = u8_to_ps(_mm_loadl_epi64((const __m128i *) src));
+        store8(dst, _mm256_add_ps(_mm256_mul_ps(values, _plane_multiplier[0]), _plane_offset[0]));
+        return;
+    }
+    __m128i group[3];
+    if(src_plane_stride)
+    {
+        const unsigned char* plane[3] = { src, src + src_plane_stride, src + 2*src_plane_stride };
+        if(_reverse)
+            std::swap(plane[0], plane[2]);
+        if(dst_plane_stride)
+        {
+            for(unsigned channel_idx = 0; channel_idx < 3; channel_idx++)
+                group[channel_idx] = _mm_loadl_epi64((const __m128i *) plane[channel_idx]);
+        }
+        else
+        {
+            __m128i first_planes = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) plane[0]), _mm_loadl_epi64((const __m128i *) plane[1]));
+            __m128i last_plane = _mm_loadl_epi64((const __m128i *) plane[2]);
+            for(unsigned g = 0; g < 3; g++)
+                group[g] = _mm_or_si128(_mm_shuffle_epi8(first_planes, _planar_to_interleaved[g][0]),
+                                        _mm_shuffle_epi8(last_plane, _planar_to_interleaved[g][1]));
+        }
+    }
+    else
+    {
+        if(dst_plane_stride)
+        {
+            __m128i low = _mm_loadu_si128((const __m128i *) src);
+            __m128i high = _mm_loadu_si128((const __m128i *) (src + 8));
+            for(unsigned channel_idx = 0; channel_idx < 3; channel_idx++)
+                group[channel_idx] = _mm_or_si128(_mm_shuffle_epi8(low, _interleaved_to_plane[channel_idx][0]),
+                                                  _mm_shuffle_epi8(high, _interleaved_to_plane[channel_idx][1]));
+        }
+        else
+        {
+            for(unsigned g = 0; g < 3; g++)
+                group[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (src + INTERLEAVED_GROUP_BASE[g])), _interleaved_to_interleaved[g]);
+        }
+    }
+    if(dst_plane_stride)
+    {
+        for(unsigned channel_idx = 0; channel_idx < 3; channel_idx++)
+            store8(dst + channel_idx*dst_plane_stride,
+                   _mm256_add_ps(_mm256_mul_ps(u8_to_ps(group[channel_idx]), _plane_multiplier[channel_idx]), _plane_offset[channel_idx]));
+    }
+    else
+    {
+        for(unsigned g = 0; g < 3; g++)
+            store8(dst + 8*g, _mm256_add_ps(_mm256_mul_ps(u8_to_ps(group[g]), _interleaved_multiplier[g]), _interleaved_offset[g]));
+    }
+}
+
+template<typename T>
+void convert_span_simd(const TensorConverter::Span& span, const BlockConverter& converter, size_t channels)
+{
+    const size_t src_step = span.src_plane_stride ? 8 : 8*channels;
+    const size_t dst_step = span.dst_plane_stride ? 8 : 8*channels;
+    const unsigned char* src = span.src;
+    T* dst = static_cast<T*>(span.dst);
+    size_t i = 0;
+    for(; i + 8 <= span.pixel_count; i += 8, src += src_step, dst += dst_step)
+        converter.convert(src, span.src_plane_stride, dst, span.dst_plane_stride);
+    if(i == span.pixel_count)
+        return;
+    // The last pixels go through a zero padded block, so that they are rounded the same way as the rest of the span
+    const size_t rest = span.pixel_count - i;
+    unsigned char src_block[24] = {};
+    T dst_block[24];
+    if(span.src_plane_stride)
+    {
+        for(size_t channel_idx = 0; channel_idx < channels; channel_idx++)
+            memcpy(src_block + 8*channel_idx, src + channel_idx*span.src_plane_stride, rest);
+    }
+    else
+        memcpy(src_block, src, rest*channels);
+    converter.convert(src_block, span.src_plane_stride ? 8 : 0, dst_block, span.dst_plane_stride ? 8 : 0);
+    if(span.dst_plane_stride)
+    {
+        for(size_t channel_idx = 0; channel_idx < channels; channel_idx++)
+            std::copy(dst_block + 8*channel_idx, dst_block + 8*channel_idx + rest, dst + channel_idx*span.dst_plane_stride);
+    }
+    else
+        std::copy(dst_block, dst_block + rest*channels, dst);
+}
+#endif
+}
+
+TensorConverter::~TensorConverter()
+{
+    stop_workers();
+}
+
+void TensorConverter::set_cpu_set(const CpuSet& cpu_set)
+{
+    stop_workers();
+    _cpu_set = cpu_set;
+}
+
+void TensorConverter::start_workers()
+{
+    _started = true;
+    // The calling thread takes part in every conversion
+    size_t worker_count = _cpu_set.cpu_count() - 1;
+    for(size_t i = 0; i < worker_count; i++)
+    {
+        _workers.emplace_back(&TensorConverter::worker_routine, this, _generation);
+        _cpu_set.apply(_workers.back().native_handle());
+    }
+}
+
+void TensorConverter::stop_workers()
+{
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _stop = true;
+    }
+    _job_ready.notify_all();
+    for(auto& worker: _workers)
+        worker.join();
+    _workers.clear();
+    _stop = false;
+    _started = false;
+}
+
+void TensorConverter::worker_routine(unsigned generation)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while(true)
+    {
+        _job_ready.wait(lock, [&]{ return _stop || _generation != generation; });
+        if(_stop)
+            return;
+        generation = _generation;
+        auto job = _job;
+        auto count = _job_count;
+        lock.unlock();
+        for(size_t i; (i = _next_index++) < count;)
+            (*job)(i);
+        lock.lock();
+        if(--_busy_workers == 0)
+            _job_done.notify_one();
+    }
+}
+
+void TensorConverter::run(size_t count, const std::function<void(size_t)>& job)
+{
+    if(!_started)
+        start_workers();
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _job = &job;
+        _job_count = count;
+        _next_index = 0;
+        _busy_workers = _workers.size();
+        _generation++;
+    }
+    _job_ready.notify_all();
+    for(size_t i; (i = _next_index++) < count;)
+        job(i);
+    std::unique_lock<std::mutex> lock(_lock);
+    _job_done.wait(lock, [&]{ return _busy_workers == 0; });
+    _job = nullptr;
+}
+
+void TensorConverter::convert(const std::vector<Span>& spans, size_t channels, const OutputTensorConfig& config)
+{
+    const RaliTensorDataType data_type = config.data_type;
+    if(channels == 0 || channels > 3)
+        THROW("Tensor conversion of " + TOSTR(channels) + " channel images is not supported")
+    if(data_type != RaliTensorDataType::FP32 && data_type != RaliTensorDataType::FP16)
+        THROW("Unsupported tensor data type")
+    const size_t element_size = (data_type == RaliTensorDataType::FP16) ? sizeof(half) : sizeof(float);
+
+    // Splits the spans (usually samples) when there are too few of them to keep every worker busy
+    size_t pixel_count = 0;
+    for(auto& span: spans)
+        pixel_count += span.pixel_count;
+    const size_t split_count = 4 * _cpu_set.cpu_count();
+    const size_t piece_size = std::max(MIN_PIXELS_PER_SPAN, ((pixel_count / split_count) + 7) & ~(size_t)7);
+    std::vector<Span> pieces;
+    pieces.reserve(spans.size());
+    for(auto& span: spans)
+        for(size_t start = 0; start < span.pixel_count; start += piece_size)
+        {
+            Span piece = span;
+            piece.src += start * (span.src_plane_stride ? 1 : channels);
+            piece.dst = static_cast<unsigned char*>(span.dst) + start * (span.dst_plane_stride ? 1 : channels) * element_size;
+            piece.pixel_count = std::min(piece_size, span.pixel_count - start);
+            pieces.push_back(piece);
+        }
+
+    Conversion conversion = { channels, { config.multiplier[0], config.multiplier[1], config.multiplier[2] },
+                              { config.offset[0], config.offset[1], config.offset[2] }, config.reverse_channels };
+    std::function<void(size_t)> job;
+#if (ENABLE_SIMD && __AVX2__)
+    BlockConverter converter(conversion);
+    if(channels != 2)
+    {
+        if(data_type == RaliTensorDataType::FP16)
+            job = [&](size_t i) { convert_span_simd<half>(pieces[i], converter, channels); };
+        else
+            job = [&](size_t i) { convert_span_simd<float>(pieces[i], converter, channels); };
+    }
+    else
+#endif
+    {
+        if(data_type == RaliTensorDataType::FP16)
+            job = [&](size_t i) { convert_span_scalar<half>(pieces[i], conversion); };
+        else
+            job = [&](size_t i) { convert_span_scalar<float>(pieces[i], conversion); };
+    }
+    run(pieces.size(), job);
+}
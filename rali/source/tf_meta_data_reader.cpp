@@ -0,0 +1,120 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <utility>
+#include "commons.h"
+#include "exception.h"
+#include "tf_meta_data_reader.h"
+#include "tf_record_reader.h"
+
+using namespace std;
+
+TFMetaDataReader::TFMetaDataReader()
+{
+    _output = nullptr;
+}
+
+void TFMetaDataReader::init(const MetaDataConfig& cfg)
+{
+    _path = cfg.path();
+    _file_prefix = cfg.file_prefix();
+    _output = new LabelBatch();
+}
+
+bool TFMetaDataReader::exists(const std::string& image_name)
+{
+    return _map_content.find(image_name) != _map_content.end();
+}
+
+void TFMetaDataReader::add(std::string image_name, int label)
+{
+    pMetaData info = std::make_shared<Label>(label);
+    if(exists(image_name))
+    {
+        WRN("Entity with the same name exists")
+        return;
+    }
+    _map_content.insert(pair<std::string, std::shared_ptr<Label>>(image_name, info));
+}
+
+void TFMetaDataReader::print_map_contents()
+{
+    std::cerr << "\nMap contents: \n";
+    for (auto& elem : _map_content) {
+        std::cerr << "Name :\t " << elem.first << "\t ID:  " << elem.second->get_label() << std::endl;
+    }
+}
+
+void TFMetaDataReader::release()
+{
+    _map_content.clear();
+}
+
+void TFMetaDataReader::release(std::string image_name)
+{
+    if(!exists(image_name))
+    {
+        WRN("ERROR: Given not present in the map" + image_name);
+        return;
+    }
+    _map_content.erase(image_name);
+}
+
+void TFMetaDataReader::lookup(const std::vector<std::string>& image_names)
+{
+    if(image_names.empty())
+    {
+        WRN("No image names passed")
+        return;
+    }
+    if(image_names.size() != (unsigned)_output->size())
+        _output->resize(image_names.size());
+
+    for(unsigned i = 0; i < image_names.size(); i++)
+    {
+        auto image_name = image_names[i];
+        auto it = _map_content.find(image_name);
+        if(_map_content.end() == it)
+            THROW("ERROR: Given name not present in the map"+ image_name )
+        _output->get_label_batch()[i] = it->second->get_label();
+    }
+}
+
+void TFMetaDataReader::read_all(const std::string& path)
+{
+    // A single shard reader walking all the records once in file order, the labels are part of the records.
+    // Only the label and the file name are parsed, the encoded images are skipped without reading them
+    ReaderConfig reader_config(StorageType::TF_RECORD, path);
+    reader_config.set_file_prefix(_file_prefix);
+    TFRecordReader reader;
+    reader.initialize(reader_config);
+    for(unsigned remaining = reader.count(); remaining > 0; remaining--)
+    {
+        reader.open_label();
+        if(reader.label() < 0)
+            WRN("TFMetaDataReader:: Record " + reader.id() + " does not have a label")
+        add(reader.id(), reader.label());
+        reader.close();
+    }
+    LOG("TFMetaDataReader:: Added " + TOSTR(_map_content.size()) + " Meta map " );
+}
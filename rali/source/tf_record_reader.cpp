@@ -0,0 +1,561 @@
+/*
+Copyright (c) 2019 - 2020 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <cassert>
+#include <sys/stat.h>
+#include <cstring>
+#include <algorithm>
+#include <commons.h>
+#include "tf_record_reader.h"
+
+namespace
+{
+// TFRecord framing: uint64 length, uint32 masked crc32c of length, data[length], uint32 masked crc32c of data
+const size_t RECORD_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+const size_t RECORD_FOOTER_SIZE = sizeof(uint32_t);
+const uint32_t CRC_MASK_DELTA = 0xa282ead8;
+
+const char* IMAGE_ENCODED_KEY = "image/encoded";
+const char* IMAGE_FILENAME_KEY = "image/filename";
+const char* IMAGE_LABEL_KEY = "image/class/label";
+
+//! Bitwise CRC-32C (Castagnoli), only used on the 8 byte record lengths while indexing
+uint32_t crc32c(const unsigned char* data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for(size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+uint32_t masked_crc32c(const unsigned char* data, size_t size)
+{
+    uint32_t crc = crc32c(data, size);
+    return ((crc >> 15) | (crc << 17)) + CRC_MASK_DELTA;
+}
+
+enum WireType { VARINT = 0, FIXED64 = 1, LENGTH_DELIMITED = 2, FIXED32 = 5 };
+
+}
+
+TFRecordReader::TFRecordReader()
+{
+    _src_dir = nullptr;
+    _entity = nullptr;
+    _curr_record_idx = 0;
+    _current_fPtr = nullptr;
+    _current_file_idx = -1;
+    _read_buff_offset = 0;
+    _read_buff_size = 0;
+    _image_file_idx = -1;
+    _image_offset = 0;
+    _image_size = 0;
+    _image_read_offset = 0;
+    _last_modified = 0;
+    _last_label = -1;
+    _loop = false;
+    _file_id = 0;
+}
+
+unsigned TFRecordReader::count()
+{
+    if(_loop)
+        return _records.size();
+
+    int ret = ((int)_records.size() -_read_counter);
+    return ((ret < 0) ? 0 : ret);
+}
+
+Reader::Status TFRecordReader::initialize(ReaderConfig desc)
+{
+    _file_id = 0;
+    _folder_path = desc.path();
+    _file_prefix = desc.file_prefix();
+    _shard_id = desc.get_shard_id();
+    _shard_count = desc.get_shard_count();
+    _batch_count = desc.get_batch_size();
+    _loop = desc.loop();
+    _index = desc.record_index();
+    if(!_index)
+        _index = index_folder();
+    select_shard_records();
+    return Reader::Status::OK;
+}
+
+void TFRecordReader::incremenet_read_ptr()
+{
+    _read_counter++;
+    if(!_records.empty())
+        _curr_record_idx = (_curr_record_idx + 1) % _records.size();
+}
+
+const unsigned char* TFRecordReader::fetch(unsigned file_idx, size_t offset, size_t size, size_t read_ahead)
+{
+    if((int)file_idx == _current_file_idx &&
+       offset >= _read_buff_offset &&
+       offset + size <= _read_buff_offset + _read_buff_size)
+        return _read_buff.data() + (offset - _read_buff_offset);
+
+    if((int)file_idx != _current_file_idx)
+    {
+        release();
+        _current_fPtr = fopen(_index->file_names[file_idx].c_str(), "rb");
+        if(!_current_fPtr)
+            return nullptr;
+        // The _read_buff does the buffering, stdio would read a whole block around every field
+        setvbuf(_current_fPtr, nullptr, _IONBF, 0);
+        _current_file_idx = file_idx;
+    }
+    size_t fill_size = std::max(size, read_ahead);
+    if(fill_size > _read_buff.size())
+        _read_buff.resize(fill_size);
+    _read_buff_size = 0;
+    if(fseek(_current_fPtr, offset, SEEK_SET) != 0)
+        return nullptr;
+    _read_buff_offset = offset;
+    _read_buff_size = fread(_read_buff.data(), sizeof(unsigned char), fill_size, _current_fPtr);
+    if(_read_buff_size < size)
+        return nullptr;
+    return _read_buff.data();
+}
+
+bool TFRecordReader::read_varint(unsigned file_idx, size_t& pos, size_t end, uint64_t& value)
+{
+    size_t size = std::min(end - pos, (size_t)10);// a varint takes at most 10 bytes
+    auto ptr = fetch(file_idx, pos, size, FIELD_READ_SIZE);
+    if(!ptr)
+        return false;
+    value = 0;
+    for(unsigned i = 0; i < size; i++)
+    {
+        uint64_t byte = ptr[i];
+        value |= (byte & 0x7F) << (7 * i);
+        if(!(byte & 0x80))
+        {
+            pos += i + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TFRecordReader::read_field(unsigned file_idx, size_t& pos, size_t end, unsigned& field, unsigned& wire_type,
+                                size_t& payload, size_t& payload_size)
+{
+    uint64_t tag;
+    if(!read_varint(file_idx, pos, end, tag))
+        return false;
+    field = tag >> 3;
+    wire_type = tag & 0x7;
+    payload = pos;// for varints the payload points to the encoded value
+    payload_size = 0;
+    uint64_t value;
+    switch(wire_type)
+    {
+        case VARINT:
+            return read_varint(file_idx, pos, end, value);
+        case FIXED64:
+            pos += 8;
+            return pos <= end;
+        case FIXED32:
+            pos += 4;
+            return pos <= end;
+        case LENGTH_DELIMITED:
+            if(!read_varint(file_idx, pos, end, value) || value > (uint64_t)(end - pos))
+                return false;
+            payload = pos;
+            payload_size = value;
+            pos += value;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool TFRecordReader::parse_feature(unsigned file_idx, size_t pos, size_t end, unsigned list_field,
+                                   size_t& bytes, size_t& bytes_size, int64_t& int_value)
+{
+    unsigned field, wire_type;
+    size_t payload, payload_size;
+    while(pos < end)
+    {
+        if(!read_field(file_idx, pos, end, field, wire_type, payload, payload_size))
+            return false;
+        if(field != list_field || wire_type != LENGTH_DELIMITED)
+            continue;
+        size_t list_pos = payload;
+        size_t list_end = payload + payload_size;
+        while(list_pos < list_end)
+        {
+            if(!read_field(file_idx, list_pos, list_end, field, wire_type, payload, payload_size) || field != 1)
+                return false;
+            if(list_field == 1 && wire_type == LENGTH_DELIMITED)
+            {
+                bytes = payload;
+                bytes_size = payload_size;
+                return true;
+            }
+            uint64_t value;
+            if(list_field == 3 && wire_type == LENGTH_DELIMITED) // packed repeated int64
+            {
+                if(payload_size == 0 || !read_varint(file_idx, payload, payload + payload_size, value))
+                    return false;
+                int_value = (int64_t)value;
+                return true;
+            }
+            if(list_field == 3 && wire_type == VARINT)
+            {
+                if(!read_varint(file_idx, payload, list_end, value))
+                    return false;
+                int_value = (int64_t)value;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+unsigned TFRecordReader::parse_example(const RecordInfo& record, unsigned fields)
+{
+    unsigned file_idx = record.file_idx;
+    size_t pos = record.offset;
+    size_t end = record.offset + record.size;
+    unsigned field, wire_type;
+    size_t features, features_size;
+    unsigned found = 0;
+    // Example { Features features = 1; }
+    while(pos < end && (found & fields) != fields)
+    {
+        if(!read_field(file_idx, pos, end, field, wire_type, features, features_size))
+            break;
+        if(field != 1 || wire_type != LENGTH_DELIMITED)
+            continue;
+        // Features { map<string, Feature> feature = 1; }, each map entry is { string key = 1; Feature value = 2; }
+        size_t entry_pos = features;
+        size_t features_end = features + features_size;
+        while(entry_pos < features_end && (found & fields) != fields)
+        {
+            size_t entry, entry_size;
+            if(!read_field(file_idx, entry_pos, features_end, field, wire_type, entry, entry_size))
+                return found;
+            if(field != 1 || wire_type != LENGTH_DELIMITED)
+                continue;
+            size_t kv_pos = entry;
+            size_t kv_end = entry + entry_size;
+            size_t key = 0, key_size = 0, value = 0, value_size = 0, payload, payload_size;
+            bool has_key = false, has_value = false;
+            while(kv_pos < kv_end)
+            {
+                if(!read_field(file_idx, kv_pos, kv_end, field, wire_type, payload, payload_size))
+                    return found;
+                if(field == 1) { key = payload; key_size = payload_size; has_key = true; }
+                if(field == 2) { value = payload; value_size = payload_size; has_value = true; }
+            }
+            if(!has_key || !has_value)
+                continue;
+            auto key_ptr = fetch(file_idx, key, key_size, FIELD_READ_SIZE);
+            if(!key_ptr)
+                return found;
+            std::string key_str((const char*)key_ptr, key_size);
+            size_t bytes = 0, bytes_size = 0;
+            int64_t int_value = 0;
+            if((fields & IMAGE_FIELD) && key_str == IMAGE_ENCODED_KEY &&
+               parse_feature(file_idx, value, value + value_size, 1, bytes, bytes_size, int_value))
+            {
+                // Only located, read() reads it
+                _image_file_idx = file_idx;
+                _image_offset = bytes;
+                _image_size = bytes_size;
+                found |= IMAGE_FIELD;
+            }
+            else if((fields & FILENAME_FIELD) && key_str == IMAGE_FILENAME_KEY &&
+                    parse_feature(file_idx, value, value + value_size, 1, bytes, bytes_size, int_value))
+            {
+                auto file_name = fetch(file_idx, bytes, bytes_size, FIELD_READ_SIZE);
+                if(file_name)
+                {
+                    _last_id.assign((const char*)file_name, bytes_size);
+                    found |= FILENAME_FIELD;
+                }
+            }
+            else if((fields & LABEL_FIELD) && key_str == IMAGE_LABEL_KEY &&
+                    parse_feature(file_idx, value, value + value_size, 3, bytes, bytes_size, int_value))
+            {
+                _last_label = (int)int_value;
+                found |= LABEL_FIELD;
+            }
+        }
+    }
+    return found;
+}
+
+bool TFRecordReader::open_record(unsigned fields)
+{
+    if(_records.empty())
+        return false;
+    auto record = _records[_curr_record_idx];// Get next record
+    incremenet_read_ptr();
+    auto& file_name = _index->file_names[record.file_idx];
+    _image_file_idx = -1;
+    _image_offset = 0;
+    _image_size = 0;
+    _image_read_offset = 0;
+    _last_label = -1;
+    _last_id.clear();
+    _last_path = file_name + ":" + std::to_string(record.record_idx);
+    _last_modified = _index->file_mtimes[record.file_idx];
+
+    unsigned found = parse_example(record, fields);
+    bool ret = true;
+    if((fields & IMAGE_FIELD) && !(found & IMAGE_FIELD))
+    {
+        WRN("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] Record " + std::to_string(record.record_idx) + " in " + file_name + " does not contain " + IMAGE_ENCODED_KEY + " or could not be read")
+        _image_file_idx = -1;
+        _image_size = 0;
+        ret = false;
+    }
+
+    if(_last_id.empty())
+    {
+        _last_id = file_name;
+        auto last_slash_idx = _last_id.find_last_of("\\/");
+        if (std::string::npos != last_slash_idx)
+        {
+            _last_id.erase(0, last_slash_idx + 1);
+        }
+        _last_id.append("_");
+        _last_id.append(std::to_string(record.record_idx));
+    }
+    return ret;
+}
+
+size_t TFRecordReader::open()
+{
+    if(!open_record(IMAGE_FIELD | FILENAME_FIELD | LABEL_FIELD))
+        return 0;
+    return _image_size;
+}
+
+bool TFRecordReader::peek_next(std::string& path, size_t& size, time_t& mtime)
+{
+    if(_records.empty())
+        return false;
+    auto& record = _records[_curr_record_idx];
+    path = _index->file_names[record.file_idx] + ":" + std::to_string(record.record_idx);
+    size = record.size;
+    mtime = _index->file_mtimes[record.file_idx];
+    return true;
+}
+
+size_t TFRecordReader::read_image(unsigned char* buf, size_t read_size, size_t read_ahead)
+{
+    if(_image_file_idx < 0)
+        return 0;
+
+    // Requested read size bigger than what's left of the image? just read as many bytes as there are left
+    size_t remaining_size = _image_size - _image_read_offset;
+    read_size = (read_size > remaining_size) ? remaining_size : read_size;
+    auto data = fetch(_image_file_idx, _image_offset + _image_read_offset, read_size, read_ahead);
+    if(!data)
+    {
+        WRN("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] Failed reading " + _last_path)
+        return 0;
+    }
+    memcpy(buf, data, read_size);
+    _image_read_offset += read_size;
+    return read_size;
+}
+
+size_t TFRecordReader::read(unsigned char* buf, size_t read_size)
+{
+    // Only reads what's asked, callers looking at the image header do not pay for reading the whole record
+    return read_image(buf, read_size, 0);
+}
+
+size_t TFRecordReader::read_next(std::vector<unsigned char>& buf, std::string& id)
+{
+    std::lock_guard<std::mutex> lock(_read_next_mutex);
+    id.clear();
+    if(count() == 0)
+        return 0;
+    size_t size = open();
+    id = _last_id;
+    if(size == 0)
+        return 0;
+    if(buf.size() < size)
+        buf.resize(size);
+    // Records of a shard are mostly consecutive in the file, read a whole block ahead instead of only this image
+    size = read_image(buf.data(), size, READ_BLOCK_SIZE);
+    close();
+    return size;
+}
+
+int TFRecordReader::close()
+{
+    // The record file stays open, the next record is most likely in the same file
+    _image_file_idx = -1;
+    _image_size = 0;
+    return 0;
+}
+TFRecordReader::~TFRecordReader()
+{
+    release();
+}
+
+int
+TFRecordReader::release()
+{
+    _current_file_idx = -1;
+    _read_buff_size = 0;
+    if(!_current_fPtr)
+        return 0;
+    fclose(_current_fPtr);
+    _current_fPtr = nullptr;
+    return 0;
+}
+
+void TFRecordReader::reset()
+{
+    // Shuffles runs of _batch_count records instead of single records, so records are still read mostly
+    // sequentially from the record files after shuffling
+    std::vector<std::pair<size_t, size_t>> runs;
+    for(size_t start = 0; start < _records.size(); start += _batch_count)
+        runs.emplace_back(start, std::min(_batch_count, _records.size() - start));
+    std::random_shuffle(runs.begin(), runs.end());
+    std::vector<RecordInfo> shuffled;
+    shuffled.reserve(_records.size());
+    for(auto& run: runs)
+        shuffled.insert(shuffled.end(), _records.begin() + run.first, _records.begin() + run.first + run.second);
+    _records = std::move(shuffled);
+    _read_counter = 0;
+    _curr_record_idx = 0;
+}
+
+void TFRecordReader::index_file(TFRecordIndex& index, unsigned file_idx)
+{
+    auto& file_path = index.file_names[file_idx];
+    FILE* fp = fopen(file_path.c_str(), "rb");
+    if(!fp)
+    {
+        WRN("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] Cannot open " + file_path)
+        return;
+    }
+    // Only the record headers are read, a buffered stream would read a whole block around each of them
+    setvbuf(fp, nullptr, _IONBF, 0);
+    struct stat file_stat;
+    size_t file_size = (fstat(fileno(fp), &file_stat) == 0) ? file_stat.st_size : 0;
+    size_t offset = 0;
+    size_t record_idx = 0;
+    unsigned char header[RECORD_HEADER_SIZE];
+    while(fread(header, sizeof(unsigned char), RECORD_HEADER_SIZE, fp) == RECORD_HEADER_SIZE)
+    {
+        uint64_t record_size;
+        uint32_t length_crc;
+        memcpy(&record_size, header, sizeof(uint64_t));// TFRecord lengths are little-endian
+        memcpy(&length_crc, header + sizeof(uint64_t), sizeof(uint32_t));
+        offset += RECORD_HEADER_SIZE;
+        // A corrupted length or a truncated last record would send the reads past the end of the file later on
+        if(length_crc != masked_crc32c(header, sizeof(uint64_t)) || offset > file_size ||
+           record_size > file_size - offset || RECORD_FOOTER_SIZE > file_size - offset - record_size)
+        {
+            WRN("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] Record " + TOSTR(record_idx) + " in " + file_path + " is corrupted or truncated, ignoring the rest of the file")
+            break;
+        }
+        index.records.push_back({file_idx, offset, (size_t)record_size, record_idx});
+        record_idx++;
+        offset += record_size + RECORD_FOOTER_SIZE;
+        if(fseek(fp, offset, SEEK_SET) != 0)
+            break;
+    }
+    fclose(fp);
+}
+
+void TFRecordReader::replicate_last_image_to_fill_last_shard()
+{
+    for(size_t i = _in_batch_read_count; i < _batch_count; i++)
+        _records.push_back(_records.back());
+}
+
+std::shared_ptr<TFRecordIndex> TFRecordReader::index_folder()
+{
+    auto index = std::make_shared<TFRecordIndex>();
+    if ((_src_dir = opendir (_folder_path.c_str())) == nullptr)
+        THROW("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] ERROR: Failed opening the directory at " + _folder_path);
+
+    while((_entity = readdir (_src_dir)) != nullptr)
+    {
+        if(_entity->d_type != DT_REG)
+            continue;
+        std::string file_name(_entity->d_name);
+        if(!_file_prefix.empty() && file_name.compare(0, _file_prefix.size(), _file_prefix) != 0)
+            continue;
+        index->file_names.push_back(_folder_path + "/" + file_name);
+    }
+    closedir(_src_dir);
+    // Sorting makes the record ids, hence the sharding, the same on every node
+    std::sort(index->file_names.begin(), index->file_names.end());
+    for(auto& file_name: index->file_names)
+    {
+        struct stat file_stat;
+        index->file_mtimes.push_back(stat(file_name.c_str(), &file_stat) == 0 ? file_stat.st_mtime : 0);
+    }
+
+    for(unsigned file_idx = 0; file_idx < index->file_names.size(); file_idx++)
+        index_file(*index, file_idx);
+    return index;
+}
+
+void TFRecordReader::select_shard_records()
+{
+    for(auto& record: _index->records)
+    {
+        if(get_file_shard_id() == _shard_id)
+        {
+            _in_batch_read_count++;
+            _in_batch_read_count = (_in_batch_read_count%_batch_count == 0) ? 0 : _in_batch_read_count;
+            _records.push_back(record);
+        }
+        incremenet_file_id();
+    }
+    if(_records.empty())
+    {
+        WRN("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] Did not load any record from " + _folder_path)
+        return;
+    }
+    if(_in_batch_read_count > 0 && _in_batch_read_count < _batch_count)
+    {
+        replicate_last_image_to_fill_last_shard();
+        LOG("TFRecordReader ShardID [" + TOSTR(_shard_id) + "] Replicated the last record " + TOSTR((_batch_count - _in_batch_read_count) ) + " times to fill the last batch")
+    }
+    LOG("TFRecordReader ShardID ["+ TOSTR(_shard_id)+ "] Total of " + TOSTR(_records.size()) + " records loaded from " + TOSTR(_index->file_names.size()) + " files in " + _folder_path )
+}
+
+size_t TFRecordReader::get_file_shard_id()
+{
+    if(_batch_count == 0 || _shard_count == 0)
+        THROW("Shard (Batch) size cannot be set to 0")
+    return (_file_id / (_batch_count)) % _shard_count;
+}
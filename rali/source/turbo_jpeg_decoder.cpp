@@ -21,11 +21,22 @@ THE SOFTWARE.
 */
 
 #include <stdio.h>
+#include <cstring>
+#include <algorithm>
 #include <commons.h>
 #include "turbo_jpeg_decoder.h"
 
+void TJDecoder::error_exit(j_common_ptr cinfo)
+{
+    auto error_manager = reinterpret_cast<ErrorManager*>(cinfo->err);
+    longjmp(error_manager->setjmp_buffer, 1);
+}
+
 TJDecoder::TJDecoder(){
     m_jpegDecompressor = tjInitDecompress();
+    _crop_decompressor.err = jpeg_std_error(&_crop_error_manager.pub);
+    _crop_error_manager.pub.error_exit = error_exit;
+    jpeg_create_decompress(&_crop_decompressor);
 
 #if 0
     int num_avail_scalings = 0;
@@ -109,6 +120,93 @@ Decoder::Status TJDecoder::decode(unsigned char *input_buffer, size_t input_size
     return Status::OK;
 }
 
+Decoder::Status TJDecoder::decode_crop(unsigned char *input_buffer, size_t input_size, unsigned char *output_buffer,
+                                       size_t max_decoded_width, size_t max_decoded_height,
+                                       size_t original_image_width, size_t original_image_height,
+                                       size_t crop_x, size_t crop_y, size_t crop_width, size_t crop_height,
+                                       size_t &actual_decoded_width, size_t &actual_decoded_height,
+                                       Decoder::ColorFormat desired_decoded_color_format)
+{
+    J_COLOR_SPACE color_space = JCS_RGB;
+    unsigned planes = 3;
+    switch (desired_decoded_color_format) {
+        case Decoder::ColorFormat::GRAY:
+            color_space = JCS_GRAYSCALE;
+            planes = 1;
+        break;
+        case Decoder::ColorFormat::RGB:
+            color_space = JCS_RGB;
+            planes = 3;
+        break;
+        case Decoder::ColorFormat::BGR:
+            color_space = JCS_EXT_BGR;
+            planes = 3;
+        break;
+    };
+    if(crop_width == 0 || crop_height == 0 ||
+       crop_x + crop_width > original_image_width || crop_y + crop_height > original_image_height)
+    {
+        WRN("Crop window is out of the image bounds")
+        return Status::CONTENT_DECODE_FAILED;
+    }
+    // Same as decode(), picks the biggest scaling factor that fits the (cropped) image in the buffer
+    tjscalingfactor scaling = SCALING_FACTORS[SCALING_FACTORS_COUNT - 1];
+    for (auto scaling_factor : SCALING_FACTORS)
+    {
+        if (TJSCALED(crop_width, scaling_factor) <= max_decoded_width && TJSCALED(crop_height, scaling_factor) <= max_decoded_height)
+        {
+            scaling = scaling_factor;
+            break;
+        }
+    }
+
+    if(setjmp(_crop_error_manager.setjmp_buffer))
+    {
+        char message[JMSG_LENGTH_MAX];
+        (*_crop_decompressor.err->format_message)((j_common_ptr)&_crop_decompressor, message);
+        WRN("Jpeg image crop decode failed " + STR(message))
+        jpeg_abort_decompress(&_crop_decompressor);
+        return Status::CONTENT_DECODE_FAILED;
+    }
+    jpeg_mem_src(&_crop_decompressor, input_buffer, input_size);
+    jpeg_read_header(&_crop_decompressor, TRUE);
+    _crop_decompressor.out_color_space = color_space;
+    _crop_decompressor.scale_num = scaling.num;
+    _crop_decompressor.scale_denom = scaling.denom;
+    _crop_decompressor.dct_method = JDCT_IFAST;// Same as TJFLAG_FASTDCT
+    jpeg_start_decompress(&_crop_decompressor);
+
+    // The crop window in the scaled image coordinates
+    size_t x = crop_x * scaling.num / scaling.denom;
+    size_t y = crop_y * scaling.num / scaling.denom;
+    size_t width = std::min(std::min((size_t)TJSCALED(crop_width, scaling), max_decoded_width), (size_t)_crop_decompressor.output_width - x);
+    size_t height = std::min(std::min((size_t)TJSCALED(crop_height, scaling), max_decoded_height), (size_t)_crop_decompressor.output_height - y);
+
+    // jpeg_crop_scanline() moves the left edge to an iMCU boundary and widens the region accordingly
+    JDIMENSION region_x = x, region_width = width;
+    jpeg_crop_scanline(&_crop_decompressor, &region_x, &region_width);
+    if(y > 0)
+        jpeg_skip_scanlines(&_crop_decompressor, y);
+
+    const size_t row_size = region_width * planes;
+    if(_crop_row.size() < row_size)
+        _crop_row.resize(row_size);
+    const size_t left_offset = (x - region_x) * planes;
+    for(size_t row = 0; row < height; row++)
+    {
+        JSAMPROW row_ptr = _crop_row.data();
+        jpeg_read_scanlines(&_crop_decompressor, &row_ptr, 1);
+        memcpy(output_buffer + row * max_decoded_width * planes, _crop_row.data() + left_offset, width * planes);
+    }
+    // The rows below the window are not needed, aborting resets the decompressor for the next image
+    jpeg_abort_decompress(&_crop_decompressor);
+
+    actual_decoded_width = width;
+    actual_decoded_height = height;
+    return Status::OK;
+}
+
 TJDecoder::~TJDecoder() {
     tjDestroy(m_jpegDecompressor);
+    jpeg_destroy_decompress(&_crop_decompressor);
 }
\ No newline at end of file
@@ -40,12 +40,12 @@ using namespace cv;
 using namespace std::chrono;
 
 
-int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards);
+int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards, int memory_mapped);
 int main(int argc, const char ** argv)
 {
     // check command-line usage
     const size_t MIN_ARG_COUNT = 2;
-    printf( "Usage: rali_performance_tests <image-dataset-folder> <width> <height> test_case batch_size gpu=1/cpu=0 rgb=1/grayscale =0  \n" );
+    printf( "Usage: rali_performance_tests <image-dataset-folder> <width> <height> test_case batch_size gpu=1/cpu=0 rgb=1/grayscale =0 shard_count mmap=1/read=0 \n" );
     if(argc < MIN_ARG_COUNT)
         return -1;
 
@@ -59,6 +59,7 @@ int main(int argc, const char ** argv)
     int test_case = 0;
     int batch_size = 10;
     int shards = 4;
+    int memory_mapped = 0;
 
     if (argc >= argIdx + MIN_ARG_COUNT)
         test_case = atoi(argv[++argIdx]);
@@ -75,12 +76,15 @@ int main(int argc, const char ** argv)
     if (argc >= argIdx + MIN_ARG_COUNT)
 	shards = atoi(argv[++argIdx]);
 
-    test(test_case, path, rgb, processing_device, width, height, batch_size, shards);
+    if (argc >= argIdx + MIN_ARG_COUNT)
+        memory_mapped = atoi(argv[++argIdx]);
+
+    test(test_case, path, rgb, processing_device, width, height, batch_size, shards, memory_mapped);
 
     return 0;
 }
 
-int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards)
+int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards, int memory_mapped)
 {
     size_t num_threads = shards;
     int inputBatchSize = batch_size;
@@ -88,7 +92,7 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
     int decode_max_height = 0;
     std::cout << ">>> test case " << test_case << std::endl;
     std::cout << ">>> Running on " << (processing_device ? "GPU" : "CPU") << " , "<< (rgb ? " Color ":" Grayscale ")<< std::endl;
-    printf(">>> Batch size = %d -- shard count = %d\n", inputBatchSize, num_threads);
+    printf(">>> Batch size = %d -- shard count = %d -- %s\n", inputBatchSize, num_threads, memory_mapped ? "memory mapped read" : "read");
 
     RaliImageColor color_format = (rgb != 0) ? RaliImageColor::RALI_COLOR_RGB24 : RaliImageColor::RALI_COLOR_U8;
 
@@ -98,6 +102,8 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
         std::cout << "Could not create the Rali context\n";
         return -1;
     }
+    // Compare the run time with and without it to tell whether mapping the images pays off on this storage
+    raliSetContextAttribute(handle, RALI_MEMORY_MAPPED_READ, memory_mapped);
 
     /*>>>>>>>>>>>>>>>> Creating Rali parameters  <<<<<<<<<<<<<<<<*/
 
@@ -332,6 +338,7 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
     std::cout << "Decode   time " << rali_timing.decode_time << std::endl;
     std::cout << "Process  time " << rali_timing.process_time << std::endl;
     std::cout << "Transfer time " << rali_timing.transfer_time << std::endl;
+    std::cout << "Read wait time " << rali_timing.read_wait_time << std::endl;
     std::cout << "Total time " << dur << std::endl;
     std::cout << ">>>>> Total Elapsed Time " << dur / 1000000 << " sec " << dur % 1000000 << " us " << std::endl;
     